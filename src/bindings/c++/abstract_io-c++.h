@@ -147,6 +147,21 @@ public:
      */
     virtual sail_status_t eof(bool *result) = 0;
 
+    /*
+     * Assigns a pointer to the whole underlying I/O contents and its size. Must be implemented
+     * by I/O streams that report SAIL_IO_FEATURE_CONTIGUOUS in features(). The buffer must stay valid
+     * until the I/O stream is closed.
+     *
+     * Returns SAIL_OK on success. The default implementation returns SAIL_ERROR_NOT_IMPLEMENTED.
+     */
+    virtual sail_status_t contiguous_buffer(const void **buffer, std::size_t *buffer_size)
+    {
+        (void)buffer;
+        (void)buffer_size;
+
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
     /*
      * Finds and returns a first codec info object that can theoretically read the underlying
      * I/O stream into a valid image.
@@ -114,6 +114,15 @@ static sail_status_t wrapped_eof(void *stream, bool *result) {
     return SAIL_OK;
 }
 
+static sail_status_t wrapped_contiguous_buffer(void *stream, const void **buffer, size_t *buffer_size) {
+
+    sail::abstract_io &abstract_io = *reinterpret_cast<sail::abstract_io *&>(stream);
+
+    SAIL_TRY(abstract_io.contiguous_buffer(buffer, buffer_size));
+
+    return SAIL_OK;
+}
+
 class SAIL_HIDDEN abstract_io_adapter::pimpl
 {
 public:
@@ -132,6 +141,8 @@ public:
         sail_io.flush          = wrapped_flush;
         sail_io.close          = wrapped_close;
         sail_io.eof            = wrapped_eof;
+
+        sail_io.contiguous_buffer = (sail_io.features & SAIL_IO_FEATURE_CONTIGUOUS) ? wrapped_contiguous_buffer : nullptr;
     }
 
     sail::abstract_io &abstract_io;
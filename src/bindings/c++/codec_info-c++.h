@@ -56,6 +56,7 @@ class SAIL_EXPORT codec_info
 {
     friend class image_input;
     friend class image_output;
+    friend class transcoder;
 
 public:
     /*
@@ -116,6 +116,12 @@ public:
      */
     sail_rgb24_t background24() const;
 
+    /*
+     * Returns the maximum number of threads to convert images with.
+     * 0 or 1 means converting in the calling thread only.
+     */
+    unsigned threads() const;
+
     /*
      * Sets new or-ed SailConversionOption-s. If zero, SAIL_CONVERSION_OPTION_DROP_ALPHA is assumed.
      */
@@ -133,6 +139,13 @@ public:
      */
     void set_background(const sail_rgb24_t &rgb24);
 
+    /*
+     * Sets the maximum number of threads to convert images with. Images are split into horizontal
+     * bands converted in parallel. Small images are always converted in the calling thread.
+     * 0 or 1 means converting in the calling thread only.
+     */
+    void set_threads(unsigned threads);
+
 private:
     sail_status_t to_sail_conversion_options(sail_conversion_options **conversion_options) const;
 
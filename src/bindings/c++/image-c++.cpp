@@ -531,6 +531,116 @@ image image::convert_to(const sail::save_features &save_features, const conversi
     return img;
 }
 
+bool image::can_scale() const
+{
+    if (!is_valid()) {
+        return false;
+    }
+
+    return sail_can_scale(d->sail_image->pixel_format);
+}
+
+sail_status_t image::scale(unsigned width, unsigned height, SailScaling algorithm)
+{
+    image img;
+    SAIL_TRY(scale_to(width, height, algorithm, &img));
+
+    *this = std::move(img);
+
+    return SAIL_OK;
+}
+
+sail_status_t image::scale_to(unsigned width, unsigned height, SailScaling algorithm, sail::image *image) const
+{
+    SAIL_CHECK_PTR(image);
+
+    if (!is_valid()) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+    }
+
+    sail_image *sail_img;
+    SAIL_TRY(to_sail_image(&sail_img));
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_img->pixels = nullptr;
+        sail_destroy_image(sail_img);
+    );
+
+    sail_image *sail_image_output = nullptr;
+    SAIL_TRY(sail_scale_image(sail_img, width, height, algorithm, &sail_image_output));
+
+    *image = sail::image(sail_image_output);
+
+    sail_image_output->pixels = nullptr;
+    sail_destroy_image(sail_image_output);
+
+    return SAIL_OK;
+}
+
+image image::scale_to(unsigned width, unsigned height, SailScaling algorithm) const
+{
+    image img;
+    SAIL_TRY_OR_EXECUTE(scale_to(width, height, algorithm, &img),
+                        /* on error */ return img);
+
+    return img;
+}
+
+bool image::can_rotate() const
+{
+    if (!is_valid()) {
+        return false;
+    }
+
+    return sail_can_rotate(d->sail_image->pixel_format);
+}
+
+sail_status_t image::rotate(SailRotation rotation)
+{
+    image img;
+    SAIL_TRY(rotate_to(rotation, &img));
+
+    *this = std::move(img);
+
+    return SAIL_OK;
+}
+
+sail_status_t image::rotate_to(SailRotation rotation, sail::image *image) const
+{
+    SAIL_CHECK_PTR(image);
+
+    if (!is_valid()) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+    }
+
+    sail_image *sail_img;
+    SAIL_TRY(to_sail_image(&sail_img));
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_img->pixels = nullptr;
+        sail_destroy_image(sail_img);
+    );
+
+    sail_image *sail_image_output = nullptr;
+    SAIL_TRY(sail_rotate_image(sail_img, rotation, &sail_image_output));
+
+    *image = sail::image(sail_image_output);
+
+    sail_image_output->pixels = nullptr;
+    sail_destroy_image(sail_image_output);
+
+    return SAIL_OK;
+}
+
+image image::rotate_to(SailRotation rotation) const
+{
+    image img;
+    SAIL_TRY_OR_EXECUTE(rotate_to(rotation, &img),
+                        /* on error */ return img);
+
+    return img;
+}
+
 SailPixelFormat image::closest_pixel_format(const std::vector<SailPixelFormat> &pixel_formats) const
 {
     return sail_closest_pixel_format(d->sail_image->pixel_format, pixel_formats.data(), pixel_formats.size());
@@ -35,6 +35,8 @@
     #include "error.h"
     #include "export.h"
 
+    #include "manip_common.h"
+
     #include "iccp-c++.h"
     #include "palette-c++.h"
     #include "source_image-c++.h"
@@ -44,6 +46,8 @@
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 
+    #include <sail-manip/manip_common.h>
+
     #include <sail-c++/iccp-c++.h>
     #include <sail-c++/palette-c++.h>
     #include <sail-c++/source_image-c++.h>
@@ -552,6 +556,68 @@ public:
      */
     image convert_to(const sail::save_features &save_features, const conversion_options &options) const;
 
+    /*
+     * Returns true if the image can be scaled.
+     */
+    bool can_scale() const;
+
+    /*
+     * Scales the image to the specified dimensions with the specified filter. Use can_scale()
+     * to quickly check if the image can actually be scaled.
+     *
+     * Updates the image dimensions and bytes per line.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t scale(unsigned width, unsigned height, SailScaling algorithm);
+
+    /*
+     * Scales the image to the specified dimensions with the specified filter and saves the result
+     * in the output image. Use can_scale() to quickly check if the image can actually be scaled.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t scale_to(unsigned width, unsigned height, SailScaling algorithm, sail::image *image) const;
+
+    /*
+     * Scales the image to the specified dimensions with the specified filter and returns
+     * the resulting image. Use can_scale() to quickly check if the image can actually be scaled.
+     *
+     * Returns an invalid image on error.
+     */
+    image scale_to(unsigned width, unsigned height, SailScaling algorithm) const;
+
+    /*
+     * Returns true if the image can be rotated.
+     */
+    bool can_rotate() const;
+
+    /*
+     * Rotates the image clockwise by the specified angle. Use can_rotate() to quickly check
+     * if the image can actually be rotated.
+     *
+     * Updates the image dimensions and bytes per line.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t rotate(SailRotation rotation);
+
+    /*
+     * Rotates the image clockwise by the specified angle and saves the result in the output image.
+     * Use can_rotate() to quickly check if the image can actually be rotated.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t rotate_to(SailRotation rotation, sail::image *image) const;
+
+    /*
+     * Rotates the image clockwise by the specified angle and returns the resulting image.
+     * Use can_rotate() to quickly check if the image can actually be rotated.
+     *
+     * Returns an invalid image on error.
+     */
+    image rotate_to(SailRotation rotation) const;
+
     /*
      * Returns the closest pixel format from the list.
      *
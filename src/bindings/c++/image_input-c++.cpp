@@ -169,6 +169,26 @@ sail_status_t image_input::next_frame(sail::image *image)
     return SAIL_OK;
 }
 
+sail_status_t image_input::next_frame(void *pixels, std::size_t pixels_size, unsigned bytes_per_line, sail::image *image)
+{
+    if (d->state == nullptr) {
+        SAIL_TRY(d->start());
+    }
+
+    sail_image *sail_image = nullptr;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY(sail_load_next_frame_into(d->state, pixels, pixels_size, bytes_per_line, &sail_image));
+
+    *image = sail::image(sail_image);
+    image->set_shallow_pixels(pixels, static_cast<std::size_t>(sail_image->bytes_per_line) * sail_image->height);
+
+    return SAIL_OK;
+}
+
 image image_input::next_frame()
 {
     sail::image image;
@@ -179,6 +199,32 @@ image image_input::next_frame()
     return image;
 }
 
+sail_status_t image_input::start_frame_rows(sail::image *image)
+{
+    if (d->state == nullptr) {
+        SAIL_TRY(d->start());
+    }
+
+    sail_image *sail_image = nullptr;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY(sail_start_frame_rows(d->state, &sail_image));
+
+    *image = sail::image(sail_image);
+
+    return SAIL_OK;
+}
+
+sail_status_t image_input::read_rows(void *rows, unsigned rows_count)
+{
+    SAIL_TRY(sail_read_rows(d->state, rows, rows_count));
+
+    return SAIL_OK;
+}
+
 sail_status_t image_input::finish()
 {
     sail_status_t saved_status = SAIL_OK;
@@ -110,7 +110,20 @@ public:
      * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
      */
     sail_status_t next_frame(sail::image *image);
- 
+
+    /*
+     * Continues loading the image into the specified caller-provided buffer. Scan lines are stored
+     * with the specified 'bytes_per_line' stride. Pass 0 to use the natural scan line length.
+     * The buffer must be at least 'bytes_per_line * height' bytes long.
+     *
+     * Assigns the loaded image to the 'image' argument. The image references the buffer without
+     * owning it, so the buffer must remain valid as long as the image exists.
+     *
+     * Returns SAIL_OK on success.
+     * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+     */
+    sail_status_t next_frame(void *pixels, std::size_t pixels_size, unsigned bytes_per_line, sail::image *image);
+
     /*
      * Continues loading the image.
      *
@@ -118,6 +131,24 @@ public:
      */
     image next_frame();
 
+    /*
+     * Continues loading the image. Seeks to the next frame and assigns its properties without
+     * pixels to the 'image' argument. Read the frame pixels with read_rows() then.
+     *
+     * Returns SAIL_OK on success.
+     * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+     */
+    sail_status_t start_frame_rows(sail::image *image);
+
+    /*
+     * Reads the next 'rows_count' scan lines of the frame started by start_frame_rows() into the specified
+     * buffer. Scan lines are stored with the bytes per line of the image returned by start_frame_rows().
+     * The buffer must be at least 'bytes_per_line * rows_count' bytes long.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t read_rows(void *rows, unsigned rows_count);
+
     /*
      * Finishes loading and closes the I/O stream. Call to finish() is optional.
      *
@@ -162,6 +162,32 @@ sail_status_t image_output::next_frame(const sail::image &image)
     return SAIL_OK;
 }
 
+sail_status_t image_output::start_frame_rows(const sail::image &image)
+{
+    if (d->state == nullptr) {
+        SAIL_TRY(d->start());
+    }
+
+    sail_image *sail_image = nullptr;
+    SAIL_TRY(image.to_sail_image(&sail_image));
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_image->pixels = nullptr;
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY(sail_start_writing_frame_rows(d->state, sail_image));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_output::write_rows(const void *rows, unsigned rows_count)
+{
+    SAIL_TRY(sail_write_rows(d->state, rows, rows_count));
+
+    return SAIL_OK;
+}
+
 sail_status_t image_output::finish()
 {
     sail_status_t saved_status = SAIL_OK;
@@ -112,6 +112,23 @@ public:
      */
     sail_status_t next_frame(const sail::image &image);
 
+    /*
+     * Continues saving into the I/O target. Starts the next frame with the properties of the specified
+     * image. Its pixels are ignored. Write the frame pixels with write_rows() then.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t start_frame_rows(const sail::image &image);
+
+    /*
+     * Writes the next 'rows_count' scan lines of the frame started by start_frame_rows() from the specified
+     * buffer. Scan lines are stored with the bytes per line of the image passed to start_frame_rows().
+     * The buffer must be at least 'bytes_per_line * rows_count' bytes long.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t write_rows(const void *rows, unsigned rows_count);
+
     /*
      * Finishes saving and closes the I/O stream. Call to finish() is recommended
      * if you want to ensure the I/O stream is flushed and closed successfully.
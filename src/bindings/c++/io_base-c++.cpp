@@ -106,4 +106,15 @@ sail_status_t io_base::eof(bool *result)
     return SAIL_OK;
 }
 
+sail_status_t io_base::contiguous_buffer(const void **buffer, std::size_t *buffer_size)
+{
+    if (!(d->sail_io->features & SAIL_IO_FEATURE_CONTIGUOUS)) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
+    }
+
+    SAIL_TRY(d->sail_io->contiguous_buffer(d->sail_io->stream, buffer, buffer_size));
+
+    return SAIL_OK;
+}
+
 }
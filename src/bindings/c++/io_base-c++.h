@@ -156,6 +156,14 @@ public:
      */
     sail_status_t eof(bool *result) override;
 
+    /*
+     * Assigns a pointer to the whole underlying I/O contents and its size if the underlying I/O object
+     * supports SAIL_IO_FEATURE_CONTIGUOUS.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t contiguous_buffer(const void **buffer, std::size_t *buffer_size) override;
+
 protected:
     class pimpl;
     const std::unique_ptr<pimpl> d;
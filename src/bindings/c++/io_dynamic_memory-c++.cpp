@@ -0,0 +1,78 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdexcept>
+
+#include "sail-c++.h"
+#include "sail.h"
+
+namespace sail
+{
+
+static struct sail_io *construct_sail_io()
+{
+    struct sail_io *sail_io;
+
+    SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_write_dynamic_memory(&sail_io),
+                        /* on error */ throw std::bad_alloc());
+
+    return sail_io;
+}
+
+io_dynamic_memory::io_dynamic_memory()
+    : io_base(construct_sail_io())
+{
+}
+
+io_dynamic_memory::~io_dynamic_memory()
+{
+}
+
+sail_status_t io_dynamic_memory::take_buffer(void **buffer, std::size_t *buffer_length)
+{
+    SAIL_TRY(sail_take_buffer_from_dynamic_memory_io(d->sail_io.get(), buffer, buffer_length));
+
+    return SAIL_OK;
+}
+
+sail::arbitrary_data io_dynamic_memory::data()
+{
+    const void *buffer;
+    std::size_t buffer_length;
+
+    SAIL_TRY_OR_EXECUTE(contiguous_buffer(&buffer, &buffer_length),
+                        /* on error */ return {});
+
+    const std::uint8_t *buffer_bytes = reinterpret_cast<const std::uint8_t *>(buffer);
+
+    return sail::arbitrary_data(buffer_bytes, buffer_bytes + buffer_length);
+}
+
+codec_info io_dynamic_memory::codec_info()
+{
+    return sail::codec_info::from_magic_number(*this);
+}
+
+}
@@ -0,0 +1,84 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_IO_DYNAMIC_MEMORY_CPP_H
+#define SAIL_IO_DYNAMIC_MEMORY_CPP_H
+
+#include <cstddef> /* std::size_t */
+
+#ifdef SAIL_BUILD
+    #include "arbitrary_data-c++.h"
+    #include "io_base-c++.h"
+#else
+    #include <sail-c++/arbitrary_data-c++.h>
+    #include <sail-c++/io_base-c++.h>
+#endif
+
+namespace sail
+{
+
+/*
+ * Growable memory I/O stream. Use it to save images into memory when the resulting size
+ * is not known in advance.
+ */
+class SAIL_EXPORT io_dynamic_memory : public io_base
+{
+public:
+    /*
+     * Opens a new empty memory buffer for reading and writing. The buffer grows as data is written.
+     */
+    io_dynamic_memory();
+
+    /*
+     * Destroys the memory I/O stream and the buffer if it was not taken.
+     */
+    ~io_dynamic_memory() override;
+
+    /*
+     * Transfers the ownership of the written data to the caller. The buffer must be freed with sail_free().
+     * Assigns the number of bytes written to 'buffer_length'. The I/O stream becomes empty.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t take_buffer(void **buffer, std::size_t *buffer_length);
+
+    /*
+     * Returns a copy of the written data.
+     */
+    sail::arbitrary_data data();
+
+    /*
+     * Finds and returns a first codec info object that supports the magic number read
+     * from the memory buffer. The comparison algorithm is case insensitive. After reading
+     * a magic number, rewinds the I/O cursor position back to the previous position.
+     *
+     * Returns an invalid codec info object on error.
+     */
+    sail::codec_info codec_info() override;
+};
+
+}
+
+#endif
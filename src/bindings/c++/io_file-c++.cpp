@@ -48,8 +48,9 @@ static struct sail_io *construct_sail_io(const std::string &path, io_file::Opera
 
     switch (operation) {
         case io_file::Operation::Read:
-            SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_file(path.c_str(), &sail_io),
-                                /* on error */ throw std::bad_alloc());
+            SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_mmap(path.c_str(), &sail_io),
+                                /* on error */ SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_file(path.c_str(), &sail_io),
+                                                                   /* on error */ throw std::bad_alloc()));
         break;
         case io_file::Operation::ReadWrite:
             SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_write_file(path.c_str(), &sail_io),
@@ -65,6 +65,9 @@ load_options& load_options::operator=(const sail::load_options &load_options)
 {
     set_options(load_options.options());
     set_tuning(load_options.tuning());
+    set_output_pixel_format(load_options.output_pixel_format());
+    set_max_size(load_options.max_width(), load_options.max_height());
+    set_roi(load_options.roi_x(), load_options.roi_y(), load_options.roi_width(), load_options.roi_height());
 
     return *this;
 }
@@ -100,6 +103,41 @@ const sail::tuning& load_options::tuning() const
     return d->tuning;
 }
 
+SailPixelFormat load_options::output_pixel_format() const
+{
+    return d->sail_load_options->output_pixel_format;
+}
+
+unsigned load_options::max_width() const
+{
+    return d->sail_load_options->max_width;
+}
+
+unsigned load_options::max_height() const
+{
+    return d->sail_load_options->max_height;
+}
+
+unsigned load_options::roi_x() const
+{
+    return d->sail_load_options->roi_x;
+}
+
+unsigned load_options::roi_y() const
+{
+    return d->sail_load_options->roi_y;
+}
+
+unsigned load_options::roi_width() const
+{
+    return d->sail_load_options->roi_width;
+}
+
+unsigned load_options::roi_height() const
+{
+    return d->sail_load_options->roi_height;
+}
+
 void load_options::set_options(int options)
 {
     d->sail_load_options->options = options;
@@ -110,6 +148,25 @@ void load_options::set_tuning(const sail::tuning &tuning)
     d->tuning = tuning;
 }
 
+void load_options::set_output_pixel_format(SailPixelFormat output_pixel_format)
+{
+    d->sail_load_options->output_pixel_format = output_pixel_format;
+}
+
+void load_options::set_max_size(unsigned max_width, unsigned max_height)
+{
+    d->sail_load_options->max_width  = max_width;
+    d->sail_load_options->max_height = max_height;
+}
+
+void load_options::set_roi(unsigned roi_x, unsigned roi_y, unsigned roi_width, unsigned roi_height)
+{
+    d->sail_load_options->roi_x      = roi_x;
+    d->sail_load_options->roi_y      = roi_y;
+    d->sail_load_options->roi_width  = roi_width;
+    d->sail_load_options->roi_height = roi_height;
+}
+
 load_options::load_options(const sail_load_options *ro)
     : load_options()
 {
@@ -120,6 +177,9 @@ load_options::load_options(const sail_load_options *ro)
 
     set_options(ro->options);
     set_tuning(utils_private::c_tuning_to_cpp_tuning(ro->tuning));
+    set_output_pixel_format(ro->output_pixel_format);
+    set_max_size(ro->max_width, ro->max_height);
+    set_roi(ro->roi_x, ro->roi_y, ro->roi_width, ro->roi_height);
 }
 
 sail_status_t load_options::to_sail_load_options(sail_load_options **load_options) const
@@ -130,7 +190,14 @@ sail_status_t load_options::to_sail_load_options(sail_load_options **load_option
 
     SAIL_TRY(sail_alloc_load_options(&load_options_local));
 
-    load_options_local->options = d->sail_load_options->options;
+    load_options_local->options             = d->sail_load_options->options;
+    load_options_local->output_pixel_format = d->sail_load_options->output_pixel_format;
+    load_options_local->max_width           = d->sail_load_options->max_width;
+    load_options_local->max_height          = d->sail_load_options->max_height;
+    load_options_local->roi_x               = d->sail_load_options->roi_x;
+    load_options_local->roi_y               = d->sail_load_options->roi_y;
+    load_options_local->roi_width           = d->sail_load_options->roi_width;
+    load_options_local->roi_height          = d->sail_load_options->roi_height;
 
     SAIL_TRY_OR_CLEANUP(sail_alloc_hash_map(&load_options_local->tuning),
                         /* cleanup */ sail_destroy_load_options(load_options_local));
@@ -30,11 +30,13 @@
 #include <vector>
 
 #ifdef SAIL_BUILD
+    #include "common.h"
     #include "error.h"
     #include "export.h"
 
     #include "tuning-c++.h"
 #else
+    #include <sail-common/common.h>
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 
@@ -118,6 +120,42 @@ public:
      */
     const sail::tuning& tuning() const;
 
+    /*
+     * Returns the pixel format to load frames into. SAIL_PIXEL_FORMAT_UNKNOWN means
+     * the codec's choice, i.e. the pixel format as close to the source as possible.
+     */
+    SailPixelFormat output_pixel_format() const;
+
+    /*
+     * Returns the preferred maximum width of loaded frames. 0 means no limit.
+     */
+    unsigned max_width() const;
+
+    /*
+     * Returns the preferred maximum height of loaded frames. 0 means no limit.
+     */
+    unsigned max_height() const;
+
+    /*
+     * Returns the X coordinate of the region of interest in the source image coordinates.
+     */
+    unsigned roi_x() const;
+
+    /*
+     * Returns the Y coordinate of the region of interest in the source image coordinates.
+     */
+    unsigned roi_y() const;
+
+    /*
+     * Returns the width of the region of interest. 0 means the whole frame.
+     */
+    unsigned roi_width() const;
+
+    /*
+     * Returns the height of the region of interest. 0 means the whole frame.
+     */
+    unsigned roi_height() const;
+
     /*
      * Sets new or-ed manipulation options for loading operations. See SailOption.
      */
@@ -128,6 +166,27 @@ public:
      */
     void set_tuning(const sail::tuning &tuning);
 
+    /*
+     * Sets the pixel format to load frames into. Codecs that can decode into it natively
+     * do so. Other frames are converted row by row while loading.
+     */
+    void set_output_pixel_format(SailPixelFormat output_pixel_format);
+
+    /*
+     * Sets the preferred maximum dimensions of loaded frames. Codecs able to decode frames
+     * at a reduced resolution natively pick the smallest size that is still not less than
+     * the requested one. Other codecs ignore them. 0 means no limit.
+     */
+    void set_max_size(unsigned max_width, unsigned max_height);
+
+    /*
+     * Sets the region of interest to load from every frame in the source image coordinates.
+     * The region is clipped to the frame dimensions. Codecs able to decode just the region
+     * do so natively, other frames are cropped while loading. The preferred maximum dimensions
+     * are ignored when the region is set. 0 width or height means the whole frame.
+     */
+    void set_roi(unsigned roi_x, unsigned roi_y, unsigned roi_width, unsigned roi_height);
+
 private:
     /*
      * Makes a deep copy of the specified load options and stores the pointer for further use.
@@ -57,6 +57,7 @@
     #include "image_output-c++.h"
     #include "io_base-c++.h"
     #include "io_base_p-c++.h"
+    #include "io_dynamic_memory-c++.h"
     #include "io_file-c++.h"
     #include "io_memory-c++.h"
     #include "load_features-c++.h"
@@ -70,6 +71,7 @@
     #include "save_options-c++.h"
     #include "source_image-c++.h"
     #include "special_properties-c++.h"
+    #include "transcoder-c++.h"
     #include "tuning-c++.h"
     #include "utils-c++.h"
     #include "utils_private-c++.h"
@@ -94,6 +96,7 @@
     #include <sail-c++/image_input-c++.h>
     #include <sail-c++/image_output-c++.h>
     #include <sail-c++/io_base-c++.h>
+    #include <sail-c++/io_dynamic_memory-c++.h>
     #include <sail-c++/io_file-c++.h>
     #include <sail-c++/io_memory-c++.h>
     #include <sail-c++/load_features-c++.h>
@@ -107,6 +110,7 @@
     #include <sail-c++/save_features-c++.h>
     #include <sail-c++/save_options-c++.h>
     #include <sail-c++/special_properties-c++.h>
+    #include <sail-c++/transcoder-c++.h>
     #include <sail-c++/tuning-c++.h>
     #include <sail-c++/utils-c++.h>
     #include <sail-c++/variant-c++.h>
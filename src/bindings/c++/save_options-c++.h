@@ -55,6 +55,7 @@ class SAIL_EXPORT save_options
 {
     friend class image_output;
     friend class save_features;
+    friend class transcoder;
 
 public:
     /*
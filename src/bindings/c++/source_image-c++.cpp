@@ -69,6 +69,8 @@ source_image& source_image::operator=(const source_image &si)
     d->sail_source_image->orientation        = si.orientation();
     d->sail_source_image->compression        = si.compression();
     d->sail_source_image->interlaced         = si.interlaced();
+    d->sail_source_image->width              = si.width();
+    d->sail_source_image->height             = si.height();
     d->special_properties                    = si.special_properties();
 
     return *this;
@@ -120,6 +122,16 @@ bool source_image::interlaced() const
     return d->sail_source_image->interlaced;
 }
 
+unsigned source_image::width() const
+{
+    return d->sail_source_image->width;
+}
+
+unsigned source_image::height() const
+{
+    return d->sail_source_image->height;
+}
+
 const sail::special_properties &source_image::special_properties() const
 {
     return d->special_properties;
@@ -138,6 +150,8 @@ source_image::source_image(const sail_source_image *si)
     d->sail_source_image->orientation        = si->orientation;
     d->sail_source_image->compression        = si->compression;
     d->sail_source_image->interlaced         = si->interlaced;
+    d->sail_source_image->width              = si->width;
+    d->sail_source_image->height             = si->height;
     d->special_properties                    = utils_private::c_tuning_to_cpp_tuning(si->special_properties);
 }
 
@@ -153,6 +167,8 @@ sail_status_t source_image::to_sail_source_image(sail_source_image **source_imag
     source_image_local->orientation        = d->sail_source_image->orientation;
     source_image_local->compression        = d->sail_source_image->compression;
     source_image_local->interlaced         = d->sail_source_image->interlaced;
+    source_image_local->width              = d->sail_source_image->width;
+    source_image_local->height             = d->sail_source_image->height;
 
     SAIL_TRY_OR_CLEANUP(sail_alloc_hash_map(&source_image_local->special_properties),
                         /* cleanup */ sail_destroy_source_image(source_image_local));
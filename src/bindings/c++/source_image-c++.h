@@ -132,6 +132,24 @@ public:
      */
     bool interlaced() const;
 
+    /*
+     * Returns the source image width. It differs from the image width when the codec
+     * decodes frames at a reduced resolution. See load_options::max_width().
+     *
+     * LOAD: Set by SAIL to the original image width.
+     * SAVE: Ignored.
+     */
+    unsigned width() const;
+
+    /*
+     * Returns the source image height. It differs from the image height when the codec
+     * decodes frames at a reduced resolution. See load_options::max_height().
+     *
+     * LOAD: Set by SAIL to the original image height.
+     * SAVE: Ignored.
+     */
+    unsigned height() const;
+
     /*
      * Returns image format-specific properties that cannot be expressed
      * in a common way. For example, a cursor hot spot.
@@ -0,0 +1,112 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <memory>
+
+#include "sail-c++.h"
+#include "sail.h"
+
+namespace sail
+{
+
+class SAIL_HIDDEN transcoder::pimpl
+{
+public:
+    pimpl()
+        : override_save_options(false)
+    {
+    }
+
+    sail_status_t alloc_save_options(sail_save_options **sail_save_options) const;
+
+    bool override_save_options;
+    sail::save_options save_options;
+};
+
+sail_status_t transcoder::pimpl::alloc_save_options(sail_save_options **sail_save_options) const
+{
+    *sail_save_options = nullptr;
+
+    // NULL means the codec defaults
+    if (override_save_options) {
+        SAIL_TRY(save_options.to_sail_save_options(sail_save_options));
+    }
+
+    return SAIL_OK;
+}
+
+transcoder::transcoder()
+    : d(new pimpl)
+{
+}
+
+transcoder::~transcoder()
+{
+}
+
+transcoder& transcoder::with(const sail::save_options &save_options)
+{
+    d->override_save_options = true;
+    d->save_options          = save_options;
+
+    return *this;
+}
+
+sail_status_t transcoder::transcode(const std::string &input_path, const std::string &output_path, std::size_t *written)
+{
+    sail_save_options *sail_save_options;
+    SAIL_TRY(d->alloc_save_options(&sail_save_options));
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_save_options(sail_save_options);
+    );
+
+    SAIL_TRY(sail_transcode_file(input_path.c_str(), output_path.c_str(), sail_save_options, written));
+
+    return SAIL_OK;
+}
+
+sail_status_t transcoder::transcode(sail::abstract_io &input, const sail::codec_info &input_codec_info,
+                                    sail::abstract_io &output, const sail::codec_info &output_codec_info,
+                                    std::size_t *written)
+{
+    sail_save_options *sail_save_options;
+    SAIL_TRY(d->alloc_save_options(&sail_save_options));
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_save_options(sail_save_options);
+    );
+
+    sail::abstract_io_adapter input_adapter(input);
+    sail::abstract_io_adapter output_adapter(output);
+
+    SAIL_TRY(sail_transcode_io(&input_adapter.sail_io_c(), input_codec_info.sail_codec_info_c(),
+                               &output_adapter.sail_io_c(), output_codec_info.sail_codec_info_c(),
+                               sail_save_options, written));
+
+    return SAIL_OK;
+}
+
+}
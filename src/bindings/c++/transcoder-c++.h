@@ -0,0 +1,98 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TRANSCODER_CPP_H
+#define SAIL_TRANSCODER_CPP_H
+
+#include <cstddef> /* std::size_t */
+#include <memory>
+#include <string>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+namespace sail
+{
+
+class abstract_io;
+class codec_info;
+class save_options;
+
+/*
+ * Transcodes images from one format into another in bands of scan lines. Codecs that cannot
+ * process scan lines make libsail buffer whole frames, see sail_transcode_file(). Scan lines are
+ * converted into the closest pixel format supported by the output codec if necessary. ICC profiles
+ * and meta data are carried over when requested in the save options.
+ */
+class SAIL_EXPORT transcoder
+{
+public:
+    /*
+     * Constructs a new transcoder with the default save options of the output codec.
+     */
+    transcoder();
+
+    /*
+     * Destroys the transcoder.
+     */
+    ~transcoder();
+
+    /*
+     * Overrides the save options used to save the output image.
+     */
+    transcoder& with(const sail::save_options &save_options);
+
+    /*
+     * Transcodes the specified image file into the specified output file. Detects the image formats
+     * based on the file extensions. Assigns the number of bytes written to the 'written' argument
+     * if it's not nullptr.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t transcode(const std::string &input_path, const std::string &output_path, std::size_t *written = nullptr);
+
+    /*
+     * Transcodes the specified I/O source into the specified I/O target with the specified codecs.
+     * Assigns the number of bytes written to the 'written' argument if it's not nullptr.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t transcode(sail::abstract_io &input, const sail::codec_info &input_codec_info,
+                            sail::abstract_io &output, const sail::codec_info &output_codec_info,
+                            std::size_t *written = nullptr);
+
+private:
+    class pimpl;
+    std::unique_ptr<pimpl> d;
+};
+
+}
+
+#endif
@@ -303,38 +303,55 @@ enum SailResolutionUnit {
 enum SailCodecFeature {
 
     /* Unknown codec feature used to indicate an error in parsing functions. */
-    SAIL_CODEC_FEATURE_UNKNOWN     = 1 << 0,
+    SAIL_CODEC_FEATURE_UNKNOWN          = 1 << 0,
 
     /* Can load or save static images. */
-    SAIL_CODEC_FEATURE_STATIC      = 1 << 1,
+    SAIL_CODEC_FEATURE_STATIC           = 1 << 1,
 
     /* Can load or save animated images. */
-    SAIL_CODEC_FEATURE_ANIMATED    = 1 << 2,
+    SAIL_CODEC_FEATURE_ANIMATED         = 1 << 2,
 
     /* Can load or save multi-paged (but not animated) images. */
-    SAIL_CODEC_FEATURE_MULTI_PAGED = 1 << 3,
+    SAIL_CODEC_FEATURE_MULTI_PAGED      = 1 << 3,
 
     /* Can load or save image meta data like JPEG comments or EXIF. */
-    SAIL_CODEC_FEATURE_META_DATA   = 1 << 4,
+    SAIL_CODEC_FEATURE_META_DATA        = 1 << 4,
 
     /* Can load or save interlaced images. */
-    SAIL_CODEC_FEATURE_INTERLACED  = 1 << 5,
+    SAIL_CODEC_FEATURE_INTERLACED       = 1 << 5,
 
     /* Can load or save embedded ICC profiles. */
-    SAIL_CODEC_FEATURE_ICCP        = 1 << 6,
+    SAIL_CODEC_FEATURE_ICCP             = 1 << 6,
+
+    /*
+     * Can read the EXIF orientation into the source image orientation. Frames are loaded as stored
+     * unless SAIL_OPTION_APPLY_ORIENTATION is specified. Only EXIF stored before the pixel data is read.
+     * For example, PNG eXIf chunks after the first IDAT chunk are ignored.
+     */
+    SAIL_CODEC_FEATURE_EXIF_ORIENTATION = 1 << 7,
 };
 
 /* Read or save options. */
 enum SailOption {
 
     /* Instruction to load or save image meta data like JPEG comments or EXIF. */
-    SAIL_OPTION_META_DATA  = 1 << 0,
+    SAIL_OPTION_META_DATA         = 1 << 0,
 
     /* Instruction to save interlaced images. Specifying this option for loading operations has no effect. */
-    SAIL_OPTION_INTERLACED = 1 << 1,
+    SAIL_OPTION_INTERLACED        = 1 << 1,
 
     /* Instruction to load or save embedded ICC profile. */
-    SAIL_OPTION_ICCP       = 1 << 2,
+    SAIL_OPTION_ICCP              = 1 << 2,
+
+    /*
+     * Instruction to load frames upright, i.e. rotated and mirrored according to the EXIF orientation
+     * read by codecs with SAIL_CODEC_FEATURE_EXIF_ORIENTATION. Specifying this option for saving operations has no effect.
+     *
+     * Scan lines are oriented in small bands when the codec loads scan lines, see sail_start_frame_rows().
+     * Otherwise, for example with interlaced PNG images or a region of interest, the stored frame
+     * is loaded into a second buffer of the frame size first.
+     */
+    SAIL_OPTION_APPLY_ORIENTATION = 1 << 3,
 };
 
 #endif
@@ -499,13 +499,14 @@ enum SailResolutionUnit sail_resolution_unit_from_string(const char *str) {
 const char* sail_codec_feature_to_string(enum SailCodecFeature codec_feature) {
 
     switch (codec_feature) {
-        case SAIL_CODEC_FEATURE_UNKNOWN:     return "UNKNOWN";
-        case SAIL_CODEC_FEATURE_STATIC:      return "STATIC";
-        case SAIL_CODEC_FEATURE_ANIMATED:    return "ANIMATED";
-        case SAIL_CODEC_FEATURE_MULTI_PAGED: return "MULTI-PAGED";
-        case SAIL_CODEC_FEATURE_META_DATA:   return "META-DATA";
-        case SAIL_CODEC_FEATURE_INTERLACED:  return "INTERLACED";
-        case SAIL_CODEC_FEATURE_ICCP:        return "ICCP";
+        case SAIL_CODEC_FEATURE_UNKNOWN:          return "UNKNOWN";
+        case SAIL_CODEC_FEATURE_STATIC:           return "STATIC";
+        case SAIL_CODEC_FEATURE_ANIMATED:         return "ANIMATED";
+        case SAIL_CODEC_FEATURE_MULTI_PAGED:      return "MULTI-PAGED";
+        case SAIL_CODEC_FEATURE_META_DATA:        return "META-DATA";
+        case SAIL_CODEC_FEATURE_INTERLACED:       return "INTERLACED";
+        case SAIL_CODEC_FEATURE_ICCP:             return "ICCP";
+        case SAIL_CODEC_FEATURE_EXIF_ORIENTATION: return "EXIF-ORIENTATION";
     }
 
     return NULL;
@@ -521,6 +522,7 @@ enum SailCodecFeature sail_codec_feature_from_string(const char *str) {
         case UINT64_C(249851542786072787):   return SAIL_CODEC_FEATURE_META_DATA;
         case UINT64_C(8244927930303708800):  return SAIL_CODEC_FEATURE_INTERLACED;
         case UINT64_C(6384139556):           return SAIL_CODEC_FEATURE_ICCP;
+        case UINT64_C(12419211202472790026): return SAIL_CODEC_FEATURE_EXIF_ORIENTATION;
     }
 
     return SAIL_CODEC_FEATURE_UNKNOWN;
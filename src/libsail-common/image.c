@@ -29,6 +29,107 @@
 
 #include "sail-common.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SAIL_MIRROR_SSE2
+    #include <emmintrin.h>
+#endif
+
+/*
+ * Private functions.
+ */
+
+#if defined(SAIL_MIRROR_SSE2)
+
+/* Reverses the order of 1, 2, 4, or 8-byte pixels in a 16-byte block. */
+static inline __m128i reverse_block(__m128i block, unsigned bytes_per_pixel) {
+
+    switch (bytes_per_pixel) {
+        case 4: return _mm_shuffle_epi32(block, _MM_SHUFFLE(0, 1, 2, 3));
+        case 8: return _mm_shuffle_epi32(block, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    /* Reverse 16-bit words, then swap the bytes in every word for 1-byte pixels. */
+    block = _mm_shuffle_epi32(block, _MM_SHUFFLE(0, 1, 2, 3));
+    block = _mm_shufflelo_epi16(block, _MM_SHUFFLE(2, 3, 0, 1));
+    block = _mm_shufflehi_epi16(block, _MM_SHUFFLE(2, 3, 0, 1));
+
+    if (bytes_per_pixel == 1) {
+        block = _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+    }
+
+    return block;
+}
+
+#endif
+
+/*
+ * Reverses the pixels of every scan line. 16-byte blocks of 1, 2, 4, or 8-byte pixels are swapped
+ * from both ends of the line with SSE2 when available. The rest of the pixels are swapped byte by byte.
+ */
+static inline void mirror_rows(struct sail_image *image, unsigned bytes_per_pixel) {
+
+    for (unsigned row = 0; row < image->height; row++) {
+        unsigned char *left = (unsigned char *)image->pixels + (size_t)image->bytes_per_line * row;
+        unsigned char *right = left + (size_t)image->width * bytes_per_pixel;
+
+#if defined(SAIL_MIRROR_SSE2)
+        if (bytes_per_pixel == 1 || bytes_per_pixel == 2 || bytes_per_pixel == 4 || bytes_per_pixel == 8) {
+            for (; right - left >= 32; left += 16, right -= 16) {
+                const __m128i left_block  = _mm_loadu_si128((const __m128i *)left);
+                const __m128i right_block = _mm_loadu_si128((const __m128i *)(right - 16));
+
+                _mm_storeu_si128((__m128i *)left,         reverse_block(right_block, bytes_per_pixel));
+                _mm_storeu_si128((__m128i *)(right - 16), reverse_block(left_block,  bytes_per_pixel));
+            }
+        }
+#endif
+
+        /* Right points past the last pixel. */
+        for (right -= bytes_per_pixel; left < right; left += bytes_per_pixel, right -= bytes_per_pixel) {
+            for (unsigned i = 0; i < bytes_per_pixel; i++) {
+                const unsigned char byte = left[i];
+                left[i]  = right[i];
+                right[i] = byte;
+            }
+        }
+    }
+}
+
+/* Reverses the pixels of every scan line with pixels packed into bytes starting from the most significant bits. */
+static sail_status_t mirror_packed_rows(struct sail_image *image, unsigned bits_per_pixel) {
+
+    const unsigned mask = (1U << bits_per_pixel) - 1;
+    const unsigned bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(bytes_per_line, &ptr));
+    unsigned char *line = ptr;
+
+    for (unsigned row = 0; row < image->height; row++) {
+        unsigned char *scan = (unsigned char *)image->pixels + (size_t)image->bytes_per_line * row;
+
+        memset(line, 0, bytes_per_line);
+
+        for (unsigned column = 0; column < image->width; column++) {
+            const size_t input_bit  = (size_t)(image->width - 1 - column) * bits_per_pixel;
+            const size_t output_bit = (size_t)column * bits_per_pixel;
+
+            const unsigned value = (scan[input_bit / 8] >> (8 - bits_per_pixel - input_bit % 8)) & mask;
+            line[output_bit / 8] |= (unsigned char)(value << (8 - bits_per_pixel - output_bit % 8));
+        }
+
+        memcpy(scan, line, bytes_per_line);
+    }
+
+    sail_free(line);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_alloc_image(struct sail_image **image) {
 
     SAIL_CHECK_PTR(image);
@@ -194,22 +295,26 @@ sail_status_t sail_mirror_horizontally(struct sail_image *image) {
 
     SAIL_TRY(sail_check_image_valid(image));
 
-    const unsigned bytes_per_pixel = (sail_bits_per_pixel(image->pixel_format) + 7) / 8;
-
-    void *pixel;
-    SAIL_TRY(sail_malloc(bytes_per_pixel, &pixel));
+    const unsigned bits_per_pixel = sail_bits_per_pixel(image->pixel_format);
 
-    for (unsigned row = 0; row < image->height; row++) {
-        unsigned char *scan = (unsigned char *)image->pixels + image->bytes_per_line * row;
+    if (bits_per_pixel % 8 != 0) {
+        SAIL_TRY(mirror_packed_rows(image, bits_per_pixel));
+        return SAIL_OK;
+    }
 
-        for (unsigned col1 = 0, col2 = image->width - bytes_per_pixel; col1 < col2; col1 += bytes_per_pixel, col2 -= bytes_per_pixel) {
-            memcpy(pixel,       scan + col1, bytes_per_pixel);
-            memcpy(scan + col1, scan + col2, bytes_per_pixel);
-            memcpy(scan + col2, pixel,       bytes_per_pixel);
+    /* Specialize the most common pixel sizes to unroll the byte swaps and pick the SSE2 blocks at compile time. */
+    switch (bits_per_pixel / 8) {
+        case 1: mirror_rows(image, 1); break;
+        case 2: mirror_rows(image, 2); break;
+        case 3: mirror_rows(image, 3); break;
+        case 4: mirror_rows(image, 4); break;
+        case 6: mirror_rows(image, 6); break;
+        case 8: mirror_rows(image, 8); break;
+
+        default: {
+            mirror_rows(image, bits_per_pixel / 8);
         }
     }
 
-    sail_free(pixel);
-
     return SAIL_OK;
 }
@@ -51,6 +51,8 @@ sail_status_t sail_alloc_io(struct sail_io **io) {
     (*io)->close          = NULL;
     (*io)->eof            = NULL;
 
+    (*io)->contiguous_buffer = NULL;
+
     return SAIL_OK;
 }
 
@@ -85,6 +87,11 @@ sail_status_t sail_check_io_valid(const struct sail_io *io)
         SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_IO);
     }
 
+    if ((io->features & SAIL_IO_FEATURE_CONTIGUOUS) && io->contiguous_buffer == NULL) {
+        SAIL_LOG_ERROR("I/O object has the contiguous feature, but no contiguous buffer callback");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_IO);
+    }
+
     return SAIL_OK;
 }
 
@@ -144,6 +151,23 @@ sail_status_t sail_alloc_data_from_io_contents(struct sail_io *io, void **data,
     SAIL_CHECK_PTR(data);
     SAIL_CHECK_PTR(data_size);
 
+    /* Copy from the contiguous buffer directly without going through the read callbacks. */
+    if (io->features & SAIL_IO_FEATURE_CONTIGUOUS) {
+        const void *borrowed_data;
+        size_t borrowed_data_size;
+        void *borrowed_data_to_free;
+        SAIL_TRY(sail_borrow_data_from_io_contents(io, &borrowed_data, &borrowed_data_size, &borrowed_data_to_free));
+
+        void *data_local;
+        SAIL_TRY(sail_malloc(borrowed_data_size, &data_local));
+        memcpy(data_local, borrowed_data, borrowed_data_size);
+
+        *data = data_local;
+        *data_size = borrowed_data_size;
+
+        return SAIL_OK;
+    }
+
     /* Save the current position. */
     size_t saved_position;
     SAIL_TRY(io->tell(io->stream, &saved_position));
@@ -167,6 +191,44 @@ sail_status_t sail_alloc_data_from_io_contents(struct sail_io *io, void **data,
     return SAIL_OK;
 }
 
+sail_status_t sail_borrow_data_from_io_contents(struct sail_io *io, const void **data, size_t *data_size, void **data_to_free) {
+
+    SAIL_CHECK_PTR(io);
+    SAIL_CHECK_PTR(data);
+    SAIL_CHECK_PTR(data_size);
+    SAIL_CHECK_PTR(data_to_free);
+
+    if (!(io->features & SAIL_IO_FEATURE_CONTIGUOUS)) {
+        void *data_local;
+        SAIL_TRY(sail_alloc_data_from_io_contents(io, &data_local, data_size));
+
+        *data         = data_local;
+        *data_to_free = data_local;
+
+        return SAIL_OK;
+    }
+
+    SAIL_CHECK_PTR(io->contiguous_buffer);
+
+    size_t position;
+    SAIL_TRY(io->tell(io->stream, &position));
+
+    const void *buffer;
+    size_t buffer_size;
+    SAIL_TRY(io->contiguous_buffer(io->stream, &buffer, &buffer_size));
+
+    if (position > buffer_size) {
+        SAIL_LOG_ERROR("I/O position %lu is beyond the contiguous buffer size %lu", (unsigned long)position, (unsigned long)buffer_size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    *data         = (const unsigned char *)buffer + position;
+    *data_size    = buffer_size - position;
+    *data_to_free = NULL;
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_read_string_from_io(struct sail_io *io, char *str, size_t str_size) {
 
     SAIL_CHECK_PTR(io);
@@ -116,16 +116,31 @@ typedef sail_status_t (*sail_io_close_t)(void *stream);
 typedef sail_status_t (*sail_io_eof_t)(void *stream, bool *result);
 
 /*
- * Well-known I/O ids used in libsail for file and memory I/O classes.
+ * Assigns a pointer to the whole contents of the underlying I/O object and its size in bytes
+ * regardless of the current I/O position. The contents MUST NOT be modified and stay valid until
+ * the I/O object is closed.
+ *
+ * Only I/O objects with the SAIL_IO_FEATURE_CONTIGUOUS feature implement this callback.
+ *
+ * Returns SAIL_OK on success.
+ */
+typedef sail_status_t (*sail_io_contiguous_buffer_t)(void *stream, const void **buffer, size_t *buffer_size);
+
+/*
+ * Well-known I/O ids used in libsail for file, memory, dynamic memory, and memory-mapped file I/O classes.
  *
  * You MUST use your own unique id for custom I/O classes. For example, you can use sail_string_hash()
  * to generate a unique id and store it in the source code.
  *
- * SAIL_FILE_IO_ID   = sail_string_hash("sail-file-io-id")
- * SAIL_MEMORY_IO_ID = sail_string_hash("sail-memory-io-id")
+ * SAIL_FILE_IO_ID           = sail_string_hash("sail-file-io-id")
+ * SAIL_MEMORY_IO_ID         = sail_string_hash("sail-memory-io-id")
+ * SAIL_DYNAMIC_MEMORY_IO_ID = sail_string_hash("sail-dynamic-memory-io-id")
+ * SAIL_MMAP_IO_ID           = sail_string_hash("sail-mmap-io-id")
  */
-static const uint64_t SAIL_FILE_IO_ID   = UINT64_C(5820790535323209114);
-static const uint64_t SAIL_MEMORY_IO_ID = UINT64_C(11955407548648566675);
+static const uint64_t SAIL_FILE_IO_ID           = UINT64_C(5820790535323209114);
+static const uint64_t SAIL_MEMORY_IO_ID         = UINT64_C(11955407548648566675);
+static const uint64_t SAIL_DYNAMIC_MEMORY_IO_ID = UINT64_C(10426680660049163173);
+static const uint64_t SAIL_MMAP_IO_ID           = UINT64_C(5821120586751770661);
 
 /* I/O features. */
 enum SailIoFeature {
@@ -135,6 +150,13 @@ enum SailIoFeature {
      * must return SAIL_ERROR_NOT_IMPLEMENTED.
      */
     SAIL_IO_FEATURE_SEEKABLE = 1 << 0,
+
+    /*
+     * The whole I/O contents are available as a single read-only memory buffer
+     * through the contiguous_buffer callback. For example, memory-mapped files.
+     * When this flag is off, the contiguous_buffer callback may be NULL.
+     */
+    SAIL_IO_FEATURE_CONTIGUOUS = 1 << 1,
 };
 
 /*
@@ -207,6 +229,11 @@ struct sail_io {
      * EOF callback.
      */
     sail_io_eof_t eof;
+
+    /*
+     * Contiguous buffer callback. Optional. Must be set if the SAIL_IO_FEATURE_CONTIGUOUS feature is set.
+     */
+    sail_io_contiguous_buffer_t contiguous_buffer;
 };
 
 typedef struct sail_io sail_io_t;
@@ -263,6 +290,21 @@ SAIL_EXPORT sail_status_t sail_io_contents_into_data(struct sail_io *io, void *d
  */
 SAIL_EXPORT sail_status_t sail_alloc_data_from_io_contents(struct sail_io *io, void **data, size_t *data_size);
 
+/*
+ * Provides the I/O stream contents from the current position until EOF without changing the position.
+ *
+ * If the I/O object has the SAIL_IO_FEATURE_CONTIGUOUS feature, no memory is allocated and no data is copied.
+ * 'data' points into the I/O buffer and stays valid until the I/O object is closed. 'data_to_free' is set to NULL.
+ *
+ * Otherwise, reads the contents into a new memory buffer just like sail_alloc_data_from_io_contents() does.
+ * 'data' and 'data_to_free' both point to the allocated buffer which must be freed with sail_free().
+ *
+ * It's always safe to call sail_free(data_to_free).
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_borrow_data_from_io_contents(struct sail_io *io, const void **data, size_t *data_size, void **data_to_free);
+
 /*
  * Reads a string ended with '\n' from the I/O stream. Trailing new line characters
  * are not stripped. The string buffer size must be >= 2 to hold at least "\n".
@@ -0,0 +1,212 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+/*
+ * Private functions.
+ */
+
+static void drop_window(struct sail_io_reader *reader) {
+
+    reader->cursor          = NULL;
+    reader->end             = NULL;
+    reader->window          = NULL;
+    reader->window_position = 0;
+}
+
+/* Replaces the exhausted window with the next portion of data. The new window is empty on EOF. */
+static sail_status_t refill_window(struct sail_io_reader *reader) {
+
+    struct sail_io *io = reader->io;
+
+    /* The window always ends at the current I/O position. */
+    size_t position;
+
+    if (reader->window == NULL) {
+        SAIL_TRY(io->tell(io->stream, &position));
+    } else {
+        position = reader->window_position + (size_t)(reader->end - reader->window);
+    }
+
+    if (io->features & SAIL_IO_FEATURE_CONTIGUOUS) {
+        const void *buffer;
+        size_t buffer_size;
+        SAIL_TRY(io->contiguous_buffer(io->stream, &buffer, &buffer_size));
+
+        /* Expose the whole buffer, so seeking within it never touches the I/O object. */
+        reader->window          = buffer;
+        reader->end             = reader->window + buffer_size;
+        reader->cursor          = (position < buffer_size) ? reader->window + position : reader->end;
+        reader->window_position = 0;
+    } else {
+        if (reader->buffer == NULL) {
+            void *ptr;
+            SAIL_TRY(sail_malloc(SAIL_IO_READER_BUFFER_SIZE, &ptr));
+            reader->buffer = ptr;
+        }
+
+        size_t read_size;
+        const sail_status_t status = io->tolerant_read(io->stream, reader->buffer, SAIL_IO_READER_BUFFER_SIZE, &read_size);
+
+        if (status == SAIL_ERROR_EOF) {
+            read_size = 0;
+        } else if (status != SAIL_OK) {
+            return status;
+        }
+
+        reader->window          = reader->buffer;
+        reader->cursor          = reader->window;
+        reader->end             = reader->window + read_size;
+        reader->window_position = position;
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_alloc_io_reader(struct sail_io *io, struct sail_io_reader **reader) {
+
+    SAIL_CHECK_PTR(io);
+    SAIL_CHECK_PTR(reader);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_io_reader), &ptr));
+    struct sail_io_reader *reader_local = ptr;
+
+    reader_local->io     = io;
+    reader_local->buffer = NULL;
+    drop_window(reader_local);
+
+    *reader = reader_local;
+
+    return SAIL_OK;
+}
+
+void sail_destroy_io_reader(struct sail_io_reader *reader) {
+
+    if (reader == NULL) {
+        return;
+    }
+
+    sail_free(reader->buffer);
+    sail_free(reader);
+}
+
+sail_status_t sail_io_reader_sync(struct sail_io_reader *reader) {
+
+    SAIL_CHECK_PTR(reader);
+
+    if (reader->window == NULL) {
+        return SAIL_OK;
+    }
+
+    struct sail_io *io = reader->io;
+
+    const size_t position = reader->window_position + (size_t)(reader->cursor - reader->window);
+
+    /* A fully consumed read-ahead window leaves the I/O object exactly at the logical position. */
+    const bool in_sync = !(io->features & SAIL_IO_FEATURE_CONTIGUOUS) && reader->cursor == reader->end;
+
+    drop_window(reader);
+
+    if (!in_sync) {
+        SAIL_TRY(io->seek(io->stream, (long)position, SEEK_SET));
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_io_reader_seek(struct sail_io_reader *reader, long offset, int whence) {
+
+    SAIL_CHECK_PTR(reader);
+
+    if (reader->window != NULL) {
+        if (whence == SEEK_CUR) {
+            if ((offset >= 0 && (size_t)offset <= (size_t)(reader->end - reader->cursor)) ||
+                    (offset < 0 && (size_t)(-offset) <= (size_t)(reader->cursor - reader->window))) {
+                reader->cursor += offset;
+                return SAIL_OK;
+            }
+        } else if (whence == SEEK_SET) {
+            if (offset >= 0 && (size_t)offset >= reader->window_position &&
+                    (size_t)offset - reader->window_position <= (size_t)(reader->end - reader->window)) {
+                reader->cursor = reader->window + ((size_t)offset - reader->window_position);
+                return SAIL_OK;
+            }
+        }
+    }
+
+    SAIL_TRY(sail_io_reader_sync(reader));
+    SAIL_TRY(reader->io->seek(reader->io->stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_io_reader_strict_read_slow(struct sail_io_reader *reader, void *buf, size_t size_to_read) {
+
+    SAIL_CHECK_PTR(reader);
+    SAIL_CHECK_PTR(buf);
+
+    unsigned char *output = buf;
+
+    for (;;) {
+        const size_t available = (size_t)(reader->end - reader->cursor);
+
+        if (available >= size_to_read) {
+            memcpy(output, reader->cursor, size_to_read);
+            reader->cursor += size_to_read;
+            return SAIL_OK;
+        }
+
+        if (available > 0) {
+            memcpy(output, reader->cursor, available);
+            reader->cursor += available;
+            output         += available;
+            size_to_read   -= available;
+        }
+
+        /* Large reads go directly into the output buffer. */
+        if (!(reader->io->features & SAIL_IO_FEATURE_CONTIGUOUS) && size_to_read >= SAIL_IO_READER_BUFFER_SIZE) {
+            SAIL_TRY(sail_io_reader_sync(reader));
+            SAIL_TRY(reader->io->strict_read(reader->io->stream, output, size_to_read));
+            return SAIL_OK;
+        }
+
+        SAIL_TRY(refill_window(reader));
+
+        if (reader->cursor == reader->end) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+        }
+    }
+}
@@ -0,0 +1,222 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_IO_READER_H
+#define SAIL_IO_READER_H
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+#include <string.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_io;
+
+/*
+ * The size of the read-ahead window used for I/O objects without the SAIL_IO_FEATURE_CONTIGUOUS feature.
+ */
+#define SAIL_IO_READER_BUFFER_SIZE (64 * 1024)
+
+/*
+ * Buffered reader on top of an I/O object. Serves small reads like single bytes from a read-ahead window
+ * without calling the I/O callbacks for every read. Intended for codecs that read data in small pieces,
+ * for example, RLE decoders.
+ *
+ * If the I/O object has the SAIL_IO_FEATURE_CONTIGUOUS feature, the window is the contiguous buffer itself
+ * and no data is copied. Otherwise, the window is refilled from the I/O object in SAIL_IO_READER_BUFFER_SIZE
+ * chunks.
+ *
+ * As the reader reads ahead, the position of the underlying I/O object doesn't match the logical position
+ * of the reader. Call sail_io_reader_sync() before using the I/O object directly again.
+ *
+ * The fields are accessed by the inline functions below and must not be used directly.
+ */
+struct sail_io_reader {
+
+    struct sail_io *io;
+
+    /* The current position in the window. */
+    const unsigned char *cursor;
+
+    /* The end of the window. */
+    const unsigned char *end;
+
+    /* The start of the window or NULL if there is no window. */
+    const unsigned char *window;
+
+    /* The I/O position of the window start. */
+    size_t window_position;
+
+    /* The read-ahead buffer. Allocated on demand for I/O objects without a contiguous buffer. */
+    unsigned char *buffer;
+};
+
+typedef struct sail_io_reader sail_io_reader_t;
+
+/*
+ * Allocates a new buffered reader for the specified I/O object. The I/O object must outlive the reader.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_io_reader(struct sail_io *io, struct sail_io_reader **reader);
+
+/*
+ * Destroys the specified reader. Doesn't synchronize the underlying I/O position.
+ *
+ * Does nothing if the reader is NULL.
+ */
+SAIL_EXPORT void sail_destroy_io_reader(struct sail_io_reader *reader);
+
+/*
+ * Seeks the underlying I/O object to the logical position of the reader and drops the read-ahead window.
+ * Must be called before using the underlying I/O object directly.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_io_reader_sync(struct sail_io_reader *reader);
+
+/*
+ * Sets the logical position of the reader. Possible 'whence' values: SEEK_SET, SEEK_CUR, or SEEK_END.
+ * Doesn't touch the underlying I/O object when the new position is within the current window.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_io_reader_seek(struct sail_io_reader *reader, long offset, int whence);
+
+/*
+ * Reads the specified number of bytes when the current window doesn't hold them. Used by
+ * sail_io_reader_strict_read() and the inline functions below. Use sail_io_reader_strict_read() instead.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_io_reader_strict_read_slow(struct sail_io_reader *reader, void *buf, size_t size_to_read);
+
+/*
+ * Reads the specified number of bytes. Fails when the actual number of bytes read is smaller than requested.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_strict_read(struct sail_io_reader *reader, void *buf, size_t size_to_read) {
+
+    if ((size_t)(reader->end - reader->cursor) >= size_to_read) {
+        memcpy(buf, reader->cursor, size_to_read);
+        reader->cursor += size_to_read;
+        return SAIL_OK;
+    }
+
+    return sail_io_reader_strict_read_slow(reader, buf, size_to_read);
+}
+
+/*
+ * Reads a byte.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_read_u8(struct sail_io_reader *reader, uint8_t *value) {
+
+    if (reader->cursor != reader->end) {
+        *value = *reader->cursor++;
+        return SAIL_OK;
+    }
+
+    return sail_io_reader_strict_read_slow(reader, value, 1);
+}
+
+/*
+ * Reads a little-endian 16-bit value.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_read_u16_le(struct sail_io_reader *reader, uint16_t *value) {
+
+    unsigned char bytes[2];
+    SAIL_TRY(sail_io_reader_strict_read(reader, bytes, sizeof(bytes)));
+
+    *value = (uint16_t)(bytes[0] | (bytes[1] << 8));
+
+    return SAIL_OK;
+}
+
+/*
+ * Reads a big-endian 16-bit value.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_read_u16_be(struct sail_io_reader *reader, uint16_t *value) {
+
+    unsigned char bytes[2];
+    SAIL_TRY(sail_io_reader_strict_read(reader, bytes, sizeof(bytes)));
+
+    *value = (uint16_t)((bytes[0] << 8) | bytes[1]);
+
+    return SAIL_OK;
+}
+
+/*
+ * Reads a little-endian 32-bit value.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_read_u32_le(struct sail_io_reader *reader, uint32_t *value) {
+
+    unsigned char bytes[4];
+    SAIL_TRY(sail_io_reader_strict_read(reader, bytes, sizeof(bytes)));
+
+    *value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+
+    return SAIL_OK;
+}
+
+/*
+ * Reads a big-endian 32-bit value.
+ *
+ * Returns SAIL_OK on success.
+ */
+static inline sail_status_t sail_io_reader_read_u32_be(struct sail_io_reader *reader, uint32_t *value) {
+
+    unsigned char bytes[4];
+    SAIL_TRY(sail_io_reader_strict_read(reader, bytes, sizeof(bytes)));
+
+    *value = ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+
+    return SAIL_OK;
+}
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -36,8 +36,15 @@ sail_status_t sail_alloc_load_options(struct sail_load_options **load_options) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_load_options), &ptr));
     *load_options = ptr;
 
-    (*load_options)->options = 0;
-    (*load_options)->tuning  = NULL;
+    (*load_options)->options             = 0;
+    (*load_options)->tuning              = NULL;
+    (*load_options)->output_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN;
+    (*load_options)->max_width           = 0;
+    (*load_options)->max_height          = 0;
+    (*load_options)->roi_x               = 0;
+    (*load_options)->roi_y               = 0;
+    (*load_options)->roi_width           = 0;
+    (*load_options)->roi_height          = 0;
 
     return SAIL_OK;
 }
@@ -82,7 +89,14 @@ sail_status_t sail_copy_load_options(const struct sail_load_options *source, str
     struct sail_load_options *target_local;
     SAIL_TRY(sail_alloc_load_options(&target_local));
 
-    target_local->options = source->options;
+    target_local->options             = source->options;
+    target_local->output_pixel_format = source->output_pixel_format;
+    target_local->max_width           = source->max_width;
+    target_local->max_height          = source->max_height;
+    target_local->roi_x               = source->roi_x;
+    target_local->roi_y               = source->roi_y;
+    target_local->roi_width           = source->roi_width;
+    target_local->roi_height          = source->roi_height;
 
     if (source->tuning != NULL) {
         SAIL_TRY_OR_CLEANUP(sail_copy_hash_map(source->tuning, &target_local->tuning),
@@ -93,3 +107,23 @@ sail_status_t sail_copy_load_options(const struct sail_load_options *source, str
 
     return SAIL_OK;
 }
+
+bool sail_has_roi(const struct sail_load_options *load_options) {
+
+    return load_options != NULL && load_options->roi_width > 0 && load_options->roi_height > 0;
+}
+
+bool sail_clip_roi(const struct sail_load_options *load_options, unsigned width, unsigned height,
+                    unsigned *roi_x, unsigned *roi_y, unsigned *roi_width, unsigned *roi_height) {
+
+    if (!sail_has_roi(load_options) || load_options->roi_x >= width || load_options->roi_y >= height) {
+        return false;
+    }
+
+    *roi_x      = load_options->roi_x;
+    *roi_y      = load_options->roi_y;
+    *roi_width  = (load_options->roi_width > width - load_options->roi_x) ? width - load_options->roi_x : load_options->roi_width;
+    *roi_height = (load_options->roi_height > height - load_options->roi_y) ? height - load_options->roi_y : load_options->roi_height;
+
+    return true;
+}
@@ -26,10 +26,14 @@
 #ifndef SAIL_LOAD_OPTIONS_H
 #define SAIL_LOAD_OPTIONS_H
 
+#include <stdbool.h>
+
 #ifdef SAIL_BUILD
+    #include "common.h"
     #include "error.h"
     #include "export.h"
 #else
+    #include <sail-common/common.h>
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 #endif
@@ -64,6 +68,45 @@ struct sail_load_options {
      * or forward compatible.
      */
     struct sail_hash_map *tuning;
+
+    /*
+     * Pixel format to load frames into. Codecs that can decode into it natively do so,
+     * for example JPEG into BPP32-BGRA. Other frames are converted by libsail row by row
+     * while loading. SAIL_PIXEL_FORMAT_UNKNOWN means the codec's choice, i.e. the pixel
+     * format as close to the source as possible.
+     *
+     * Loading fails with SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT if the frame cannot be converted
+     * to the pixel format. See sail_can_convert() in libsail-manip.
+     */
+    enum SailPixelFormat output_pixel_format;
+
+    /*
+     * Preferred maximum dimensions of loaded frames. Codecs able to decode frames at
+     * a reduced resolution natively, for example JPEG with DCT scaling, pick the smallest
+     * size that is still not less than the requested one. Frames may be therefore larger
+     * than requested, but never smaller. Other codecs ignore these values. The original
+     * dimensions are available in the source image.
+     *
+     * 0 means no limit. Both 0 by default.
+     */
+    unsigned max_width;
+    unsigned max_height;
+
+    /*
+     * Region of interest to load from every frame in the source image coordinates. Loaded frames
+     * contain just this region clipped to the frame dimensions. Codecs able to decode a region
+     * natively, for example JPEG or TIFF, skip the rest of the frame. Other frames are cropped
+     * by libsail. The original dimensions are available in the source image.
+     *
+     * Loading fails with SAIL_ERROR_INVALID_ARGUMENT if the region doesn't intersect a frame.
+     * Frames are never scaled down when the region is set, i.e. max_width and max_height are ignored.
+     *
+     * Zero width or height means the whole frame. All 0 by default.
+     */
+    unsigned roi_x;
+    unsigned roi_y;
+    unsigned roi_width;
+    unsigned roi_height;
 };
 
 typedef struct sail_load_options sail_load_options_t;
@@ -95,6 +138,20 @@ SAIL_EXPORT sail_status_t sail_alloc_load_options_from_features(const struct sai
  */
 SAIL_EXPORT sail_status_t sail_copy_load_options(const struct sail_load_options *source, struct sail_load_options **target);
 
+/*
+ * Returns true if the region of interest is set in the load options.
+ */
+SAIL_EXPORT bool sail_has_roi(const struct sail_load_options *load_options);
+
+/*
+ * Clips the region of interest from the load options to the specified frame dimensions.
+ * Used by codecs to decode just the region natively.
+ *
+ * Returns true if the region of interest is set and intersects the frame.
+ */
+SAIL_EXPORT bool sail_clip_roi(const struct sail_load_options *load_options, unsigned width, unsigned height,
+                                unsigned *roi_x, unsigned *roi_y, unsigned *roi_width, unsigned *roi_height);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
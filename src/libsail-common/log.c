@@ -196,6 +196,11 @@ void sail_set_log_barrier(enum SailLogLevel max_level) {
     sail_max_log_level = max_level;
 }
 
+bool sail_log_is_enabled(enum SailLogLevel level) {
+
+    return level <= sail_max_log_level;
+}
+
 void sail_set_logger(sail_logger logger) {
 
     sail_external_logger = logger;
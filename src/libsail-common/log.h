@@ -27,6 +27,7 @@
 #define SAIL_LOG_H
 
 #include <stdarg.h>
+#include <stdbool.h>
 
 #ifdef SAIL_BUILD
     #include "export.h"
@@ -64,6 +65,12 @@ SAIL_EXPORT void sail_log(enum SailLogLevel level, const char *file, int line, c
  */
 SAIL_EXPORT void sail_set_log_barrier(enum SailLogLevel max_level);
 
+/*
+ * Returns true if messages of the specified log level pass the log barrier set by sail_set_log_barrier().
+ * Use it to avoid formatting expensive log arguments that would be filtered out anyway.
+ */
+SAIL_EXPORT bool sail_log_is_enabled(enum SailLogLevel level);
+
 /*
  * Sets an external logger to pass all filtered log messages into.
  *
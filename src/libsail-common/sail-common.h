@@ -42,6 +42,7 @@
     #include "iccp.h"
     #include "image.h"
     #include "io_common.h"
+    #include "io_reader.h"
     #include "linked_list_node.h"
     #include "load_features.h"
     #include "load_options.h"
@@ -56,6 +57,7 @@
     #include "save_options.h"
     #include "source_image.h"
     #include "string_node.h"
+    #include "trace.h"
     #include "utils.h"
     #include "variant.h"
     #include "variant_node.h"
@@ -72,6 +74,7 @@
     #include <sail-common/iccp.h>
     #include <sail-common/image.h>
     #include <sail-common/io_common.h>
+    #include <sail-common/io_reader.h>
     #include <sail-common/load_features.h>
     #include <sail-common/load_options.h>
     #include <sail-common/log.h>
@@ -85,6 +88,7 @@
     #include <sail-common/save_options.h>
     #include <sail-common/source_image.h>
     #include <sail-common/string_node.h>
+    #include <sail-common/trace.h>
     #include <sail-common/utils.h>
     #include <sail-common/variant.h>
     #include <sail-common/variant_node.h>
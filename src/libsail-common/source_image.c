@@ -42,6 +42,8 @@ sail_status_t sail_alloc_source_image(struct sail_source_image **source_image) {
     (*source_image)->orientation        = SAIL_ORIENTATION_NORMAL;
     (*source_image)->compression        = SAIL_COMPRESSION_UNKNOWN;
     (*source_image)->interlaced         = false;
+    (*source_image)->width              = 0;
+    (*source_image)->height             = 0;
     (*source_image)->special_properties = NULL;
 
     return SAIL_OK;
@@ -70,6 +72,8 @@ sail_status_t sail_copy_source_image(const struct sail_source_image *source, str
     target_local->orientation        = source->orientation;
     target_local->compression        = source->compression;
     target_local->interlaced         = source->interlaced;
+    target_local->width              = source->width;
+    target_local->height             = source->height;
 
     if (source->special_properties != NULL) {
         SAIL_TRY_OR_CLEANUP(sail_copy_hash_map(source->special_properties, &target_local->special_properties),
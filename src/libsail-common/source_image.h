@@ -92,6 +92,16 @@ struct sail_source_image {
      */
     bool interlaced;
 
+    /*
+     * Source image dimensions. They differ from the image dimensions when the codec
+     * decodes frames at a reduced resolution. See max_width and max_height in sail_load_options.
+     *
+     * LOAD: Set by SAIL to the original image dimensions.
+     * SAVE: Ignored.
+     */
+    unsigned width;
+    unsigned height;
+
     /*
      * Image format-specific properties that cannot be expressed
      * in a common way. For example, a cursor hot spot.
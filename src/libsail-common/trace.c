@@ -0,0 +1,194 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef _MSC_VER
+    /* _SH_DENYWR */
+    #include <share.h>
+#endif
+
+#include "sail-common.h"
+
+/*
+ * Private functions.
+ */
+
+static sail_trace_callback sail_external_trace_callback = NULL;
+static void *sail_external_trace_user_data = NULL;
+
+/* The file written by sail_start_chrome_trace(). */
+static FILE *sail_chrome_trace_file = NULL;
+
+static void emit_event(const struct sail_trace_event *event) {
+
+    sail_external_trace_callback(event, sail_external_trace_user_data);
+}
+
+/* Chrome needs integer thread ids. The address of a thread-local variable is unique for every running thread. */
+static unsigned long long current_thread_id(void) {
+
+    static SAIL_THREAD_LOCAL char thread_marker;
+
+    return (unsigned long long)(uintptr_t)&thread_marker;
+}
+
+/*
+ * Every event is written with a trailing comma, so events from multiple threads don't need
+ * to be synchronized more than fprintf() does. The JSON array is closed by a final metadata
+ * event in sail_stop_chrome_trace(). Chrome loads unterminated arrays as well, so traces
+ * of crashed applications are still usable.
+ */
+static void chrome_trace_callback(const struct sail_trace_event *event, void *user_data) {
+
+    FILE *fptr = user_data;
+
+    const char *codec_quote = (event->codec == NULL) ? "" : "\"";
+    const char *codec       = (event->codec == NULL) ? "null" : event->codec;
+
+    if (event->phase == SAIL_TRACE_PHASE_BEGIN) {
+        fprintf(fptr, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%llu,"
+                        "\"args\":{\"codec\":%s%s%s}},\n",
+                event->name, event->category, (unsigned long long)event->timestamp, current_thread_id(),
+                codec_quote, codec, codec_quote);
+    } else {
+        fprintf(fptr, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%llu,"
+                        "\"args\":{\"codec\":%s%s%s,\"bytes\":%llu,\"pixels\":%llu,\"status\":%d}},\n",
+                event->name, event->category, (unsigned long long)event->timestamp, current_thread_id(),
+                codec_quote, codec, codec_quote,
+                (unsigned long long)event->bytes, (unsigned long long)event->pixels, event->status);
+    }
+}
+
+/*
+ * Public functions.
+ */
+
+void sail_set_trace_callback(sail_trace_callback callback, void *user_data) {
+
+    sail_external_trace_callback  = callback;
+    sail_external_trace_user_data = user_data;
+}
+
+bool sail_trace_is_enabled(void) {
+
+    return sail_external_trace_callback != NULL;
+}
+
+void sail_trace_begin(const char *category, const char *name, const char *codec) {
+
+    if (sail_external_trace_callback == NULL) {
+        return;
+    }
+
+    const struct sail_trace_event event = {
+        .phase     = SAIL_TRACE_PHASE_BEGIN,
+        .category  = category,
+        .name      = name,
+        .codec     = codec,
+        .timestamp = sail_now_microseconds(),
+        .bytes     = 0,
+        .pixels    = 0,
+        .status    = SAIL_OK,
+    };
+
+    emit_event(&event);
+}
+
+sail_status_t sail_trace_end(const char *category, const char *name, const char *codec,
+                             uint64_t bytes, uint64_t pixels, sail_status_t status) {
+
+    if (sail_external_trace_callback == NULL) {
+        return status;
+    }
+
+    const struct sail_trace_event event = {
+        .phase     = SAIL_TRACE_PHASE_END,
+        .category  = category,
+        .name      = name,
+        .codec     = codec,
+        .timestamp = sail_now_microseconds(),
+        .bytes     = bytes,
+        .pixels    = pixels,
+        .status    = status,
+    };
+
+    emit_event(&event);
+
+    return status;
+}
+
+sail_status_t sail_start_chrome_trace(const char *path) {
+
+    SAIL_CHECK_PTR(path);
+
+    if (sail_chrome_trace_file != NULL) {
+        SAIL_LOG_ERROR("Chrome trace is already started");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+#ifdef _MSC_VER
+    FILE *fptr = _fsopen(path, "w", _SH_DENYWR);
+#else
+    FILE *fptr = fopen(path, "w");
+#endif
+
+    if (fptr == NULL) {
+        sail_print_errno("Failed to open the trace file: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    fprintf(fptr, "[\n");
+
+    sail_chrome_trace_file = fptr;
+    sail_set_trace_callback(chrome_trace_callback, fptr);
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_stop_chrome_trace(void) {
+
+    if (sail_chrome_trace_file == NULL) {
+        SAIL_LOG_ERROR("Chrome trace is not started");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    sail_set_trace_callback(NULL, NULL);
+
+    FILE *fptr = sail_chrome_trace_file;
+    sail_chrome_trace_file = NULL;
+
+    fprintf(fptr, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"sail\"}}\n]\n");
+
+    if (fclose(fptr) != 0) {
+        sail_print_errno("Failed to close the trace file: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CLOSE_FILE);
+    }
+
+    return SAIL_OK;
+}
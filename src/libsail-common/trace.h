@@ -0,0 +1,150 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TRACE_H
+#define SAIL_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Tracing. When a trace callback is set, SAIL emits pairs of begin and end events around
+ * the stages of loading and saving: codec calls, I/O callbacks, pixel allocations, and pixel format
+ * conversions. Use them to find out where the time goes. When no callback is set, every traced
+ * stage costs a single function call.
+ */
+
+enum SailTracePhase {
+
+    SAIL_TRACE_PHASE_BEGIN,
+    SAIL_TRACE_PHASE_END,
+};
+
+struct sail_trace_event {
+
+    enum SailTracePhase phase;
+
+    /*
+     * Static string with the event category:
+     *   - "codec"   - codec layout calls like "load_frame"
+     *   - "io"      - I/O callbacks like "io_read" made by codecs
+     *   - "libsail" - work done by libsail itself like "alloc_pixels"
+     *   - "manip"   - pixel format conversions, "convert", and its parallel bands, "convert_band"
+     */
+    const char *category;
+
+    /* Static string with the stage name. */
+    const char *name;
+
+    /* Codec name or NULL if the stage doesn't belong to a codec. */
+    const char *codec;
+
+    /* Timestamp in microseconds from sail_now_microseconds(). */
+    uint64_t timestamp;
+
+    /*
+     * End events only. Number of bytes read, written, or allocated, and number of pixels
+     * processed by the stage. 0 if not applicable.
+     */
+    uint64_t bytes;
+    uint64_t pixels;
+
+    /* End events only. Status of the stage. */
+    sail_status_t status;
+};
+
+typedef struct sail_trace_event sail_trace_event_t;
+
+typedef void (*sail_trace_callback)(const struct sail_trace_event *event, void *user_data);
+
+/*
+ * Sets a trace callback to pass all trace events into. Pass NULL to disable tracing.
+ * The callback may be called from multiple threads if SAIL is used from multiple threads.
+ *
+ * This function is not thread-safe. It's recommended to call it in the main thread
+ * before loading or saving images.
+ */
+SAIL_EXPORT void sail_set_trace_callback(sail_trace_callback callback, void *user_data);
+
+/*
+ * Returns true if a trace callback is set.
+ */
+SAIL_EXPORT bool sail_trace_is_enabled(void);
+
+/*
+ * Emits a begin event. Does nothing if tracing is disabled.
+ */
+SAIL_EXPORT void sail_trace_begin(const char *category, const char *name, const char *codec);
+
+/*
+ * Emits an end event. Does nothing if tracing is disabled.
+ *
+ * Returns the specified status to simplify wrapping calls into events.
+ */
+SAIL_EXPORT sail_status_t sail_trace_end(const char *category, const char *name, const char *codec,
+                                         uint64_t bytes, uint64_t pixels, sail_status_t status);
+
+/*
+ * Starts writing trace events into the specified file in the Chrome trace event format.
+ * Open the file in chrome://tracing or https://ui.perfetto.dev. Replaces the current trace callback.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_chrome_trace(const char *path);
+
+/*
+ * Finishes the trace file started with sail_start_chrome_trace() and disables tracing.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_stop_chrome_trace(void);
+
+/*
+ * Evaluates the call between begin and end events and returns its status. Bytes and pixels
+ * must not depend on the call results. The call is evaluated once.
+ */
+#define SAIL_TRACE_CALL(category, name, codec, bytes, pixels, call)                                               \
+    (sail_trace_is_enabled()                                                                                      \
+        ? (sail_trace_begin(category, name, codec), sail_trace_end(category, name, codec, bytes, pixels, (call))) \
+        : (call))
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
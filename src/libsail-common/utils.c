@@ -40,6 +40,7 @@
 #else
     #include <errno.h>
     #include <sys/time.h>
+    #include <time.h>
     #include <unistd.h>
 #endif
 
@@ -69,6 +70,18 @@ static sail_status_t hex_string_into_data(const char *str, size_t str_length, vo
     return SAIL_OK;
 }
 
+/* Reads a TIFF integer of the specified byte order. */
+static unsigned exif_uint16(const unsigned char *data, bool big_endian) {
+
+    return big_endian ? ((unsigned)data[0] << 8 | data[1]) : ((unsigned)data[1] << 8 | data[0]);
+}
+
+static uint32_t exif_uint32(const unsigned char *data, bool big_endian) {
+
+    return big_endian ? ((uint32_t)exif_uint16(data, true) << 16 | exif_uint16(data + 2, true))
+                      : ((uint32_t)exif_uint16(data + 2, false) << 16 | exif_uint16(data, false));
+}
+
 /*
  * Public functions.
  */
@@ -416,6 +429,132 @@ unsigned sail_bytes_per_line(unsigned width, enum SailPixelFormat pixel_format)
     return (unsigned)(((double)width * bits_per_pixel + 7) / 8);
 }
 
+void sail_fit_max_size(unsigned width, unsigned height, unsigned max_width, unsigned max_height,
+                        unsigned *fit_width, unsigned *fit_height) {
+
+    *fit_width  = width;
+    *fit_height = height;
+
+    if (width == 0 || height == 0 || (max_width == 0 && max_height == 0) || max_width >= width || max_height >= height) {
+        return;
+    }
+
+    /* The larger scale factor of max_width / width and max_height / height wins. */
+    if ((uint64_t)max_width * height >= (uint64_t)max_height * width) {
+        *fit_width  = max_width;
+        *fit_height = (unsigned)(((uint64_t)height * max_width + width - 1) / width);
+    } else {
+        *fit_width  = (unsigned)(((uint64_t)width * max_height + height - 1) / height);
+        *fit_height = max_height;
+    }
+
+    if (*fit_width == 0) {
+        *fit_width = 1;
+    }
+    if (*fit_height == 0) {
+        *fit_height = 1;
+    }
+}
+
+void sail_crop_scan_line(const void *scan_line, enum SailPixelFormat pixel_format, unsigned x, unsigned width, void *output) {
+
+    const unsigned bits_per_pixel = sail_bits_per_pixel(pixel_format);
+
+    if (bits_per_pixel % 8 == 0) {
+        const unsigned bytes_per_pixel = bits_per_pixel / 8;
+        memcpy(output, (const unsigned char *)scan_line + (size_t)x * bytes_per_pixel, (size_t)width * bytes_per_pixel);
+        return;
+    }
+
+    /* Pixels are packed starting from the most significant bits. */
+    const unsigned char *input = scan_line;
+    unsigned char *output_bytes = output;
+    const unsigned mask = (1U << bits_per_pixel) - 1;
+
+    memset(output, 0, sail_bytes_per_line(width, pixel_format));
+
+    for (unsigned i = 0; i < width; i++) {
+        const size_t input_bit  = (size_t)(x + i) * bits_per_pixel;
+        const size_t output_bit = (size_t)i * bits_per_pixel;
+
+        const unsigned value = (input[input_bit / 8] >> (8 - bits_per_pixel - input_bit % 8)) & mask;
+        output_bytes[output_bit / 8] |= (unsigned char)(value << (8 - bits_per_pixel - output_bit % 8));
+    }
+}
+
+enum SailOrientation sail_exif_orientation(const void *exif, size_t exif_size) {
+
+    const unsigned char *data = exif;
+
+    if (data == NULL) {
+        return SAIL_ORIENTATION_NORMAL;
+    }
+
+    if (exif_size >= 6 && memcmp(data, "Exif\0\0", 6) == 0) {
+        data += 6;
+        exif_size -= 6;
+    }
+
+    /* TIFF header: byte order, 42, and the offset of the first IFD. */
+    if (exif_size < 8) {
+        return SAIL_ORIENTATION_NORMAL;
+    }
+
+    bool big_endian;
+
+    if (data[0] == 'I' && data[1] == 'I') {
+        big_endian = false;
+    } else if (data[0] == 'M' && data[1] == 'M') {
+        big_endian = true;
+    } else {
+        return SAIL_ORIENTATION_NORMAL;
+    }
+
+    if (exif_uint16(data + 2, big_endian) != 42) {
+        return SAIL_ORIENTATION_NORMAL;
+    }
+
+    const size_t ifd_offset = exif_uint32(data + 4, big_endian);
+
+    if (ifd_offset > exif_size - 2) {
+        return SAIL_ORIENTATION_NORMAL;
+    }
+
+    const unsigned entries = exif_uint16(data + ifd_offset, big_endian);
+
+    /* IFD entries are 12 bytes long: tag, type, count, and value. */
+    for (unsigned i = 0; i < entries; i++) {
+        const size_t entry_offset = ifd_offset + 2 + (size_t)i * 12;
+
+        if (entry_offset + 12 > exif_size) {
+            break;
+        }
+
+        const unsigned char *entry = data + entry_offset;
+
+        /* Orientation of the SHORT type. */
+        if (exif_uint16(entry, big_endian) != 0x0112 || exif_uint16(entry + 2, big_endian) != 3) {
+            continue;
+        }
+
+        switch (exif_uint16(entry + 8, big_endian)) {
+            case 2: return SAIL_ORIENTATION_MIRRORED_HORIZONTALLY;
+            case 3: return SAIL_ORIENTATION_ROTATED_180;
+            case 4: return SAIL_ORIENTATION_MIRRORED_VERTICALLY;
+            case 5: return SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270;
+            case 6: return SAIL_ORIENTATION_ROTATED_90;
+            case 7: return SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90;
+            case 8: return SAIL_ORIENTATION_ROTATED_270;
+
+            default: {
+                return SAIL_ORIENTATION_NORMAL;
+            }
+        }
+    }
+
+    return SAIL_ORIENTATION_NORMAL;
+}
+
 bool sail_is_indexed(enum SailPixelFormat pixel_format) {
 
     switch (pixel_format) {
@@ -544,6 +683,44 @@ uint64_t sail_now(void) {
 #endif
 }
 
+uint64_t sail_now_microseconds(void) {
+
+#ifdef SAIL_WIN32
+    static SAIL_THREAD_LOCAL bool initialized = false;
+    static SAIL_THREAD_LOCAL LONGLONG frequency = 0;
+
+    LARGE_INTEGER li;
+
+    if (!initialized) {
+        initialized = true;
+
+        if (!QueryPerformanceFrequency(&li)) {
+            SAIL_LOG_ERROR("Failed to get the current time. Error: 0x%X", GetLastError());
+            return 0;
+        }
+
+        frequency = li.QuadPart;
+    }
+
+    if (frequency == 0 || !QueryPerformanceCounter(&li)) {
+        SAIL_LOG_ERROR("Failed to get the current time. Error: 0x%X", GetLastError());
+        return 0;
+    }
+
+    /* Split to avoid overflowing the multiplication. */
+    return (uint64_t)(li.QuadPart / frequency) * 1000000 + (uint64_t)(li.QuadPart % frequency) * 1000000 / (uint64_t)frequency;
+#else
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        sail_print_errno("Failed to get the current time: %s");
+        return 0;
+    }
+
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+#endif
+}
+
 bool sail_path_exists(const char *path) {
 
     if (path == NULL) {
@@ -149,6 +149,28 @@ SAIL_EXPORT bool sail_greater_bits_per_pixel(enum SailPixelFormat pixel_format1,
  */
 SAIL_EXPORT unsigned sail_bytes_per_line(unsigned width, enum SailPixelFormat pixel_format);
 
+/*
+ * Computes the smallest dimensions that keep the aspect ratio of the specified dimensions
+ * and are not less than the specified maximum dimensions. Used by codecs that can decode frames
+ * at an arbitrary reduced resolution natively. See max_width and max_height in sail_load_options.
+ * 0 means no limit. The computed dimensions never exceed the specified dimensions.
+ */
+SAIL_EXPORT void sail_fit_max_size(unsigned width, unsigned height, unsigned max_width, unsigned max_height,
+                                    unsigned *fit_width, unsigned *fit_height);
+
+/*
+ * Copies the specified number of pixels starting from the specified pixel of the scan line into
+ * the output scan line. Used to crop frames. Supports pixel formats with less than 8 bits per pixel.
+ */
+SAIL_EXPORT void sail_crop_scan_line(const void *scan_line, enum SailPixelFormat pixel_format, unsigned x, unsigned width, void *output);
+
+/*
+ * Returns the orientation stored in the orientation tag of the specified EXIF profile.
+ * The profile may start with "Exif\0\0". Used by codecs to fill the source image orientation.
+ * Returns SAIL_ORIENTATION_NORMAL if the profile has no valid orientation tag.
+ */
+SAIL_EXPORT enum SailOrientation sail_exif_orientation(const void *exif, size_t exif_size);
+
 /*
  * Returns true if the given pixel format is indexed and assumes having a palette.
  */
@@ -174,6 +196,12 @@ SAIL_EXPORT void sail_print_errno(const char *format);
  */
 SAIL_EXPORT uint64_t sail_now(void);
 
+/*
+ * Returns the current number of microseconds of a monotonic clock with an unspecified origin
+ * or 0 on error. Use it to measure time intervals.
+ */
+SAIL_EXPORT uint64_t sail_now_microseconds(void);
+
 /*
  * Returns true if the specified file system path exists.
  */
@@ -65,6 +65,17 @@ struct sail_conversion_options {
      * when options has SAIL_CONVERSION_OPTION_BLEND_ALPHA.
      */
     sail_rgb24_t background24;
+
+    /*
+     * Maximum number of threads to convert images with. Images are split into horizontal bands
+     * converted in parallel threads started for every conversion and joined before it returns.
+     * Small images are always converted in the calling thread. 0 or 1 means converting in the calling
+     * thread only. Has no effect when SAIL is built without SAIL_THREAD_SAFE.
+     *
+     * This field changed the size of the structure. Always allocate conversion options with
+     * sail_alloc_conversion_options() and rebuild clients built against older headers.
+     */
+    unsigned threads;
 };
 
 typedef struct sail_conversion_options sail_conversion_options_t;
@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "sail-common.h"
 
@@ -37,668 +38,1146 @@
  * Private functions.
  */
 
-struct output_context {
-    struct sail_image *image;
+/* https://en.wikipedia.org/wiki/Grayscale */
+static const double R_TO_GRAY_COEFFICIENT = 0.299;
+static const double G_TO_GRAY_COEFFICIENT = 0.587;
+static const double B_TO_GRAY_COEFFICIENT = 0.114;
+
+/*
+ * Conversion is done row by row. A (input pixel format, output pixel format, options) tuple
+ * is resolved once into a row kernel. A kernel either converts scan lines directly
+ * (swizzling RGB-like pixels), or runs the following stages over every scan line:
+ *
+ *   1. Unpack input pixels into a row of RGBA32 or RGBA64 pixels.
+ *      RGBA64 is used when either the input or the output has 16-bit components.
+ *   2. Widen RGBA32 pixels to RGBA64 when the input is 8-bit and the output is 16-bit.
+ *   3. Blend alpha into the background color when requested by the conversion options.
+ *   4. Pack RGBA32 or RGBA64 pixels into the output scan line.
+ *
+ * Stages never read input pixels they have already overwritten, so the input and
+ * output scan lines may be the same memory as long as the output pixels are not larger
+ * than the input pixels. sail_update_image() relies on that.
+ */
+struct row_kernel;
+
+typedef sail_status_t (*row_unpacker_t)(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row);
+
+typedef void (*row_filter_t)(const struct row_kernel *kernel, void *row, unsigned width);
+
+typedef void (*row_packer_t)(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width);
+
+typedef sail_status_t (*row_converter_t)(const struct row_kernel *kernel, const uint8_t *scan_input, uint8_t *scan_output, unsigned width);
+
+struct row_kernel {
+    /* Converts scan lines directly. When set, the stages below are not used. */
+    row_converter_t convert;
+
+    row_unpacker_t unpack;
+    row_filter_t widen;
+    row_filter_t blend;
+    row_packer_t pack;
+
+    /* Whether unpacked pixels are RGBA64 rather than RGBA32. */
+    bool rgba64;
+
+    /* Input component indexes and the number of components of RGB-like input pixels. */
+    int input_r;
+    int input_g;
+    int input_b;
+    int input_a;
+    unsigned input_components;
+
+    /* Output component indexes, the index of the unused component, and the number of components. */
     int r;
     int g;
     int b;
     int a;
-    const struct sail_conversion_options *options;
+    int x;
+    unsigned output_components;
+
+    sail_rgb24_t background24;
+    sail_rgb48_t background48;
+
+    /* SIMD shuffle used by direct converters of 8-bit pixels. */
+    struct swizzle swizzle;
+
+    /* Bits per palette index of indexed input pixels, or 0. */
+    unsigned index_bits;
+
+    /* Size of output pixels in bytes. Set for indexed input only. */
+    unsigned output_pixel_size;
+
+    /*
+     * Palette entries run through the stages above, i.e. fully formed output pixels
+     * indexed by palette indexes. Rebuilt for every image by the conversion plan.
+     */
+    const uint8_t *lut;
+    unsigned lut_colors;
 };
 
-typedef void (*pixel_consumer_t)(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64);
+/*
+ * Unpackers.
+ */
 
-static void pixel_consumer_gray8(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp1_grayscale(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint8_t *scan = (uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column;
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_gray8_pixel_from_uint8_values(rgba32, scan, output_context->options);
-    } else {
-        fill_gray8_pixel_from_uint16_values(rgba64, scan, output_context->options);
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++) {
+        const unsigned index = (scan_input[column >> 3] >> (7 - (column & 7))) & 1;
+        spread_gray8_to_rgba32(index == 0 ? 0 : 255, rgba32++);
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_gray16(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp2_grayscale(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint16_t *scan = (uint16_t *)((uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 2);
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_gray16_pixel_from_uint8_values(rgba32, scan, output_context->options);
-    } else {
-        fill_gray16_pixel_from_uint16_values(rgba64, scan, output_context->options);
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++) {
+        const unsigned index = (scan_input[column >> 2] >> (6 - (column & 3) * 2)) & 3;
+        spread_gray8_to_rgba32((uint8_t)(index * 85), rgba32++);
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_rgb24_kind(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp4_grayscale(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint8_t *scan = (uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 3;
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_rgb24_pixel_from_uint8_values(rgba32, scan, output_context->r, output_context->g, output_context->b, output_context->options);
-    } else {
-        fill_rgb24_pixel_from_uint16_values(rgba64, scan, output_context->r, output_context->g, output_context->b, output_context->options);
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++) {
+        const unsigned index = (scan_input[column >> 1] >> (4 - (column & 1) * 4)) & 15;
+        spread_gray8_to_rgba32((uint8_t)(index * 17), rgba32++);
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_rgb48_kind(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp8_grayscale(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint16_t *scan = (uint16_t *)((uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 6);
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_rgb48_pixel_from_uint8_values(rgba32, scan, output_context->r, output_context->g, output_context->b, output_context->options);
-    } else {
-        fill_rgb48_pixel_from_uint16_values(rgba64, scan, output_context->r, output_context->g, output_context->b, output_context->options);
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++) {
+        spread_gray8_to_rgba32(scan_input[column], rgba32++);
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_rgba32_kind(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp16_grayscale(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint8_t *scan = (uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 4;
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_rgba32_pixel_from_uint8_values(rgba32, scan, output_context->r, output_context->g, output_context->b, output_context->a, output_context->options);
-    } else {
-        fill_rgba32_pixel_from_uint16_values(rgba64, scan, output_context->r, output_context->g, output_context->b, output_context->a, output_context->options);
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba64_t *rgba64 = row;
+
+    for (unsigned column = 0; column < image->width; column++) {
+        spread_gray16_to_rgba64(scan_input16[column], rgba64++);
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_rgba64_kind(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp16_grayscale_alpha(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint16_t *scan = (uint16_t *)((uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 8);
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_rgba64_pixel_from_uint8_values(rgba32, scan, output_context->r, output_context->g, output_context->b, output_context->a, output_context->options);
-    } else {
-        fill_rgba64_pixel_from_uint16_values(rgba64, scan, output_context->r, output_context->g, output_context->b, output_context->a, output_context->options);
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++, rgba32++) {
+        spread_gray8_to_rgba32(*scan_input++, rgba32);
+        rgba32->component4 = *scan_input++;
     }
+
+    return SAIL_OK;
 }
 
-static void pixel_consumer_ycbcr(const struct output_context *output_context, unsigned row, unsigned column, const sail_rgba32_t *rgba32, const sail_rgba64_t *rgba64) {
+static sail_status_t unpack_bpp32_grayscale_alpha(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    uint8_t *scan = (uint8_t *)output_context->image->pixels + output_context->image->bytes_per_line * row + column * 3;
+    (void)kernel;
 
-    if (rgba32 != NULL) {
-        fill_ycbcr_pixel_from_uint8_values(rgba32, scan, output_context->options);
-    } else {
-        fill_ycbcr_pixel_from_uint16_values(rgba64, scan, output_context->options);
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba64_t *rgba64 = row;
+
+    for (unsigned column = 0; column < image->width; column++, rgba64++) {
+        spread_gray16_to_rgba64(*scan_input16++, rgba64);
+        rgba64->component4 = *scan_input16++;
     }
+
+    return SAIL_OK;
 }
 
-static bool verify_and_construct_rgba_indexes_silent(enum SailPixelFormat output_pixel_format, pixel_consumer_t *pixel_consumer, int *r, int *g, int *b, int *a) {
+static sail_status_t unpack_bpp16_rgb555(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    switch (output_pixel_format) {
-        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:  { *pixel_consumer = pixel_consumer_gray8;  *r = *g = *b = *a = -1; /* unused. */ break; }
-        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE: { *pixel_consumer = pixel_consumer_gray16; *r = *g = *b = *a = -1; /* unused. */ break; }
-
-        case SAIL_PIXEL_FORMAT_BPP24_RGB: { *pixel_consumer = pixel_consumer_rgb24_kind; *r = 0; *g = 1; *b = 2; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP24_BGR: { *pixel_consumer = pixel_consumer_rgb24_kind; *r = 2; *g = 1; *b = 0; *a = -1; break; }
-
-        case SAIL_PIXEL_FORMAT_BPP48_RGB: { *pixel_consumer = pixel_consumer_rgb48_kind; *r = 0; *g = 1; *b = 2; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP48_BGR: { *pixel_consumer = pixel_consumer_rgb48_kind; *r = 2; *g = 1; *b = 0; *a = -1; break; }
-
-        case SAIL_PIXEL_FORMAT_BPP32_RGBX: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 0; *g = 1; *b = 2; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP32_BGRX: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 2; *g = 1; *b = 0; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP32_XRGB: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 1; *g = 2; *b = 3; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP32_XBGR: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 3; *g = 2; *b = 1; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP32_RGBA: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 0; *g = 1; *b = 2; *a = 3;  break; }
-        case SAIL_PIXEL_FORMAT_BPP32_BGRA: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 2; *g = 1; *b = 0; *a = 3;  break; }
-        case SAIL_PIXEL_FORMAT_BPP32_ARGB: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 1; *g = 2; *b = 3; *a = 0;  break; }
-        case SAIL_PIXEL_FORMAT_BPP32_ABGR: { *pixel_consumer = pixel_consumer_rgba32_kind; *r = 3; *g = 2; *b = 1; *a = 0;  break; }
-
-        case SAIL_PIXEL_FORMAT_BPP64_RGBX: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 0; *g = 1; *b = 2; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP64_BGRX: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 2; *g = 1; *b = 0; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP64_XRGB: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 1; *g = 2; *b = 3; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP64_XBGR: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 3; *g = 2; *b = 1; *a = -1; break; }
-        case SAIL_PIXEL_FORMAT_BPP64_RGBA: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 0; *g = 1; *b = 2; *a = 3;  break; }
-        case SAIL_PIXEL_FORMAT_BPP64_BGRA: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 2; *g = 1; *b = 0; *a = 3;  break; }
-        case SAIL_PIXEL_FORMAT_BPP64_ARGB: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 1; *g = 2; *b = 3; *a = 0;  break; }
-        case SAIL_PIXEL_FORMAT_BPP64_ABGR: { *pixel_consumer = pixel_consumer_rgba64_kind; *r = 3; *g = 2; *b = 1; *a = 0;  break; }
-
-        case SAIL_PIXEL_FORMAT_BPP24_YCBCR: { *pixel_consumer = pixel_consumer_ycbcr; *r = *g = *b = *a = -1; /* unused. */ break; }
+    (void)kernel;
 
-        default: {
-            return false;
-        }
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++, rgba32++) {
+        const uint16_t value = scan_input16[column];
+
+        rgba32->component1 = (uint8_t)(((value >> 0)  & 0x1f) << 3);
+        rgba32->component2 = (uint8_t)(((value >> 5)  & 0x1f) << 3);
+        rgba32->component3 = (uint8_t)(((value >> 10) & 0x1f) << 3);
+        rgba32->component4 = 255;
     }
 
-    return true;
+    return SAIL_OK;
 }
 
-static sail_status_t verify_and_construct_rgba_indexes_verbose(enum SailPixelFormat output_pixel_format, pixel_consumer_t *pixel_consumer, int *r, int *g, int *b, int *a) {
+static sail_status_t unpack_bpp16_bgr555(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    if (verify_and_construct_rgba_indexes_silent(output_pixel_format, pixel_consumer, r, g, b, a)) {
-        return SAIL_OK;
-    } else {
-        SAIL_LOG_ERROR("Conversion to %s is not supported", sail_pixel_format_to_string(output_pixel_format));
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
-    }
-}
+    (void)kernel;
 
-static sail_status_t convert_from_bpp1_indexed_or_grayscale(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba32_t *rgba32 = row;
 
-    const bool is_indexed = image->pixel_format == SAIL_PIXEL_FORMAT_BPP1_INDEXED;
-    sail_rgba32_t rgba32;
+    for (unsigned column = 0; column < image->width; column++, rgba32++) {
+        const uint16_t value = scan_input16[column];
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        rgba32->component1 = (uint8_t)(((value >> 10) & 0x1f) << 3);
+        rgba32->component2 = (uint8_t)(((value >> 5)  & 0x1f) << 3);
+        rgba32->component3 = (uint8_t)(((value >> 0)  & 0x1f) << 3);
+        rgba32->component4 = 255;
+    }
 
-        for (unsigned column = 0; column < image->width;) {
-            unsigned bit_shift = 7;
-            unsigned bit_mask = 1 << 7;
-            const uint8_t byte = *scan_input++;
+    return SAIL_OK;
+}
 
-            while (bit_mask > 0 && column < image->width) {
-                const uint8_t index = (byte & bit_mask) >> bit_shift;
+static sail_status_t unpack_bpp16_rgb565(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-                if (is_indexed) {
-                    SAIL_TRY(get_palette_rgba32(image->palette, index, &rgba32));
-                } else {
-                    spread_gray8_to_rgba32(index == 0 ? 0 : 255, &rgba32);
-                }
+    (void)kernel;
 
-                pixel_consumer(output_context, row, column, &rgba32, NULL);
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba32_t *rgba32 = row;
 
-                bit_shift--;
-                bit_mask >>= 1;
-                column++;
-            }
-        }
+    for (unsigned column = 0; column < image->width; column++, rgba32++) {
+        const uint16_t value = scan_input16[column];
+
+        rgba32->component1 = (uint8_t)(((value >> 0)  & 0x1f) << 3);
+        rgba32->component2 = (uint8_t)(((value >> 5)  & 0x3f) << 2);
+        rgba32->component3 = (uint8_t)(((value >> 11) & 0x1f) << 3);
+        rgba32->component4 = 255;
     }
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp2_indexed_or_grayscale(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static sail_status_t unpack_bpp16_bgr565(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    const bool is_indexed = image->pixel_format == SAIL_PIXEL_FORMAT_BPP2_INDEXED;
-    sail_rgba32_t rgba32;
+    (void)kernel;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba32_t *rgba32 = row;
 
-        for (unsigned column = 0; column < image->width;) {
-            unsigned bit_shift = 6;
-            unsigned bit_mask = 3 << 6; /* 11000000 */
-            const uint8_t byte = *scan_input++;
+    for (unsigned column = 0; column < image->width; column++, rgba32++) {
+        const uint16_t value = scan_input16[column];
 
-            while (bit_mask > 0 && column < image->width) {
-                const uint8_t index = (byte & bit_mask) >> bit_shift;
+        rgba32->component1 = (uint8_t)(((value >> 11) & 0x1f) << 3);
+        rgba32->component2 = (uint8_t)(((value >> 5)  & 0x3f) << 2);
+        rgba32->component3 = (uint8_t)(((value >> 0)  & 0x1f) << 3);
+        rgba32->component4 = 255;
+    }
 
-                if (is_indexed) {
-                    SAIL_TRY(get_palette_rgba32(image->palette, index, &rgba32));
-                } else {
-                    spread_gray8_to_rgba32(index * 85, &rgba32);
-                }
+    return SAIL_OK;
+}
 
-                pixel_consumer(output_context, row, column, &rgba32, NULL);
+/* Component indexes of RGB-like pixel formats. */
+static bool rgb_kind_indexes(enum SailPixelFormat pixel_format, int *r, int *g, int *b, int *a, unsigned *components, bool *is16) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP24_RGB: { *r = 0; *g = 1; *b = 2; *a = -1; *components = 3; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP24_BGR: { *r = 2; *g = 1; *b = 0; *a = -1; *components = 3; *is16 = false; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP48_RGB: { *r = 0; *g = 1; *b = 2; *a = -1; *components = 3; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP48_BGR: { *r = 2; *g = 1; *b = 0; *a = -1; *components = 3; *is16 = true; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX: { *r = 0; *g = 1; *b = 2; *a = -1; *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX: { *r = 2; *g = 1; *b = 0; *a = -1; *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB: { *r = 1; *g = 2; *b = 3; *a = -1; *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR: { *r = 3; *g = 2; *b = 1; *a = -1; *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA: { *r = 0; *g = 1; *b = 2; *a = 3;  *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA: { *r = 2; *g = 1; *b = 0; *a = 3;  *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB: { *r = 1; *g = 2; *b = 3; *a = 0;  *components = 4; *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR: { *r = 3; *g = 2; *b = 1; *a = 0;  *components = 4; *is16 = false; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX: { *r = 0; *g = 1; *b = 2; *a = -1; *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX: { *r = 2; *g = 1; *b = 0; *a = -1; *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB: { *r = 1; *g = 2; *b = 3; *a = -1; *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR: { *r = 3; *g = 2; *b = 1; *a = -1; *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA: { *r = 0; *g = 1; *b = 2; *a = 3;  *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA: { *r = 2; *g = 1; *b = 0; *a = 3;  *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB: { *r = 1; *g = 2; *b = 3; *a = 0;  *components = 4; *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR: { *r = 3; *g = 2; *b = 1; *a = 0;  *components = 4; *is16 = true; break; }
 
-                bit_shift -= 2;
-                bit_mask >>= 2;
-                column++;
-            }
+        default: {
+            return false;
         }
     }
 
-    return SAIL_OK;
+    return true;
 }
 
-static sail_status_t convert_from_bpp4_indexed_or_grayscale(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/* Unpacks RGB-like pixels, e.g. BGR or XRGB. */
+static sail_status_t unpack_rgb_kind8(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
+
+    const int ri = kernel->input_r, gi = kernel->input_g, bi = kernel->input_b, ai = kernel->input_a;
+    const unsigned components = kernel->input_components;
 
-    const bool is_indexed = image->pixel_format == SAIL_PIXEL_FORMAT_BPP4_INDEXED;
-    sail_rgba32_t rgba32;
+    sail_rgba32_t *rgba32 = row;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    for (unsigned column = 0; column < image->width; column++, rgba32++, scan_input += components) {
+        rgba32->component1 = scan_input[ri];
+        rgba32->component2 = scan_input[gi];
+        rgba32->component3 = scan_input[bi];
+        rgba32->component4 = ai >= 0 ? scan_input[ai] : 255;
+    }
 
-        for (unsigned column = 0; column < image->width;) {
-            unsigned bit_shift = 4;
-            unsigned bit_mask = 15 << 4; /* 11110000 */
-            const uint8_t byte = *scan_input++;
+    return SAIL_OK;
+}
 
-            while (bit_mask > 0 && column < image->width) {
-                const uint8_t index = (byte & bit_mask) >> bit_shift;
+static sail_status_t unpack_rgb_kind16(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-                if (is_indexed) {
-                    SAIL_TRY(get_palette_rgba32(image->palette, index, &rgba32));
-                } else {
-                    spread_gray8_to_rgba32(index * 17, &rgba32);
-                }
+    const int ri = kernel->input_r, gi = kernel->input_g, bi = kernel->input_b, ai = kernel->input_a;
+    const unsigned components = kernel->input_components;
 
-                pixel_consumer(output_context, row, column, &rgba32, NULL);
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    sail_rgba64_t *rgba64 = row;
 
-                bit_shift -= 4;
-                bit_mask >>= 4;
-                column++;
-            }
-        }
+    for (unsigned column = 0; column < image->width; column++, rgba64++, scan_input16 += components) {
+        rgba64->component1 = scan_input16[ri];
+        rgba64->component2 = scan_input16[gi];
+        rgba64->component3 = scan_input16[bi];
+        rgba64->component4 = ai >= 0 ? scan_input16[ai] : 65535;
     }
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp8_indexed_or_grayscale(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static sail_status_t unpack_bpp32_cmyk(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    const bool is_indexed = image->pixel_format == SAIL_PIXEL_FORMAT_BPP8_INDEXED;
-    sail_rgba32_t rgba32;
+    (void)kernel;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    sail_rgba32_t *rgba32 = row;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const uint8_t index = *scan_input++;
+    for (unsigned column = 0; column < image->width; column++, scan_input += 4) {
+        convert_cmyk32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), rgba32++);
+    }
 
-            if (is_indexed) {
-                SAIL_TRY(get_palette_rgba32(image->palette, index, &rgba32));
-            } else {
-                spread_gray8_to_rgba32(index, &rgba32);
-            }
+    return SAIL_OK;
+}
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-        }
+static sail_status_t unpack_bpp24_ycbcr(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
+
+    (void)kernel;
+
+    sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < image->width; column++, scan_input += 3) {
+        convert_ycbcr24_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), rgba32++);
     }
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp16_grayscale(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
-
-    sail_rgba64_t rgba64;
+static sail_status_t unpack_bpp32_ycck(const struct row_kernel *kernel, const struct sail_image *image, const uint8_t *scan_input, void *row) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    (void)kernel;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            spread_gray16_to_rgba64(*scan_input++, &rgba64);
+    sail_rgba32_t *rgba32 = row;
 
-            pixel_consumer(output_context, row, column, NULL, &rgba64);
-        }
+    for (unsigned column = 0; column < image->width; column++, scan_input += 4) {
+        convert_ycck32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), rgba32++);
     }
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp16_grayscale_alpha(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/* After adding a new input pixel format, also update the switch in sail_can_convert(). */
+static bool construct_unpacker(enum SailPixelFormat input_pixel_format, struct row_kernel *kernel, bool *is16) {
 
-    sail_rgba32_t rgba32;
+    row_unpacker_t *unpack = &kernel->unpack;
+    *is16 = false;
+    kernel->input_r = kernel->input_g = kernel->input_b = kernel->input_a = -1;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    switch (input_pixel_format) {
+        /* Indexed pixels are gathered from the palette table by convert_indexed(). */
+        case SAIL_PIXEL_FORMAT_BPP1_INDEXED:   { kernel->index_bits = 1;          break; }
+        case SAIL_PIXEL_FORMAT_BPP2_INDEXED:   { kernel->index_bits = 2;          break; }
+        case SAIL_PIXEL_FORMAT_BPP4_INDEXED:   { kernel->index_bits = 4;          break; }
+        case SAIL_PIXEL_FORMAT_BPP8_INDEXED:   { kernel->index_bits = 8;          break; }
+
+        case SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE: { *unpack = unpack_bpp1_grayscale; break; }
+        case SAIL_PIXEL_FORMAT_BPP2_GRAYSCALE: { *unpack = unpack_bpp2_grayscale; break; }
+        case SAIL_PIXEL_FORMAT_BPP4_GRAYSCALE: { *unpack = unpack_bpp4_grayscale; break; }
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE: { *unpack = unpack_bpp8_grayscale; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:       { *unpack = unpack_bpp16_grayscale;       *is16 = true; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA: { *unpack = unpack_bpp16_grayscale_alpha;               break; }
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA: { *unpack = unpack_bpp32_grayscale_alpha; *is16 = true; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP16_RGB555: { *unpack = unpack_bpp16_rgb555; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_BGR555: { *unpack = unpack_bpp16_bgr555; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_RGB565: { *unpack = unpack_bpp16_rgb565; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_BGR565: { *unpack = unpack_bpp16_bgr565; break; }
+
+        case SAIL_PIXEL_FORMAT_BPP32_CMYK:  { *unpack = unpack_bpp32_cmyk;  break; }
+        case SAIL_PIXEL_FORMAT_BPP24_YCBCR: { *unpack = unpack_bpp24_ycbcr; break; }
+        case SAIL_PIXEL_FORMAT_BPP32_YCCK:  { *unpack = unpack_bpp32_ycck;  break; }
 
-        for (unsigned column = 0; column < image->width; column++) {
-            spread_gray8_to_rgba32(*scan_input++, &rgba32);
-            rgba32.component4 = *scan_input++;
+        default: {
+            if (!rgb_kind_indexes(input_pixel_format, &kernel->input_r, &kernel->input_g, &kernel->input_b, &kernel->input_a,
+                                    &kernel->input_components, is16)) {
+                return false;
+            }
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
+            *unpack = *is16 ? unpack_rgb_kind16 : unpack_rgb_kind8;
+            break;
         }
     }
 
-    return SAIL_OK;
+    return true;
 }
 
-static sail_status_t convert_from_bpp32_grayscale_alpha(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/*
+ * Filters.
+ */
+
+/* Widens RGBA32 pixels stored at the beginning of the row in place. */
+static void widen_rgba32_to_rgba64(const struct row_kernel *kernel, void *row, unsigned width) {
 
-    sail_rgba64_t rgba64;
+    (void)kernel;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    const sail_rgba32_t *rgba32 = row;
+    sail_rgba64_t *rgba64 = row;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            spread_gray16_to_rgba64(*scan_input++, &rgba64);
-            rgba64.component4 = *scan_input++;
+    /* Go backwards to not overwrite the pixels not widened yet. */
+    for (unsigned column = width; column > 0; column--) {
+        const sail_rgba32_t pixel = rgba32[column - 1];
 
-            pixel_consumer(output_context, row, column, NULL, &rgba64);
-        }
+        rgba64[column - 1].component1 = (uint16_t)(pixel.component1 * 257);
+        rgba64[column - 1].component2 = (uint16_t)(pixel.component2 * 257);
+        rgba64[column - 1].component3 = (uint16_t)(pixel.component3 * 257);
+        rgba64[column - 1].component4 = (uint16_t)(pixel.component4 * 257);
     }
+}
 
-    return SAIL_OK;
+/* Alpha is blended as (alpha * component + (max - alpha) * background) / max, rounded down. */
+
+/* x / 255 rounded down for x <= 65534. */
+static inline uint32_t div255(uint32_t x) {
+    return (x + 1 + (x >> 8)) >> 8;
 }
 
-static sail_status_t convert_from_bpp16_rgb555(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/* x / 65535 rounded down for x <= 65535 * 65535. */
+static inline uint32_t div65535(uint32_t x) {
+    return (x + 1 + (x >> 16)) >> 16;
+}
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+static void blend_rgba32(const struct row_kernel *kernel, void *row, unsigned width) {
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { ((*scan_input >> 0) & 0x1f) << 3, ((*scan_input >> 5) & 0x1f) << 3, ((*scan_input >> 10) & 0x1f) << 3, 255 };
+    sail_rgba32_t *rgba32 = row;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input++;
-        }
+    const uint32_t background_r = kernel->background24.component1;
+    const uint32_t background_g = kernel->background24.component2;
+    const uint32_t background_b = kernel->background24.component3;
+
+    for (unsigned column = 0; column < width; column++, rgba32++) {
+        const uint32_t alpha = rgba32->component4;
+        const uint32_t transparency = 255 - alpha;
+
+        rgba32->component1 = (uint8_t)div255(alpha * rgba32->component1 + transparency * background_r);
+        rgba32->component2 = (uint8_t)div255(alpha * rgba32->component2 + transparency * background_g);
+        rgba32->component3 = (uint8_t)div255(alpha * rgba32->component3 + transparency * background_b);
     }
+}
 
-    return SAIL_OK;
+static void blend_rgba64(const struct row_kernel *kernel, void *row, unsigned width) {
+
+    sail_rgba64_t *rgba64 = row;
+
+    const uint32_t background_r = kernel->background48.component1;
+    const uint32_t background_g = kernel->background48.component2;
+    const uint32_t background_b = kernel->background48.component3;
+
+    for (unsigned column = 0; column < width; column++, rgba64++) {
+        const uint32_t alpha = rgba64->component4;
+        const uint32_t transparency = 65535 - alpha;
+
+        rgba64->component1 = (uint16_t)div65535(alpha * rgba64->component1 + transparency * background_r);
+        rgba64->component2 = (uint16_t)div65535(alpha * rgba64->component2 + transparency * background_g);
+        rgba64->component3 = (uint16_t)div65535(alpha * rgba64->component3 + transparency * background_b);
+    }
 }
 
-static sail_status_t convert_from_bpp16_bgr555(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/*
+ * Blends 16-bit pixels that are going to be packed into 8-bit components. Blended
+ * components are rounded down to 8 bits first and stored as value * 257, so packers
+ * get exactly the same 8-bit values as if they blended the pixels themselves.
+ */
+static void blend_rgba64_to_8bit(const struct row_kernel *kernel, void *row, unsigned width) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    sail_rgba64_t *rgba64 = row;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { ((*scan_input >> 10) & 0x1f) << 3, ((*scan_input >> 5) & 0x1f) << 3, ((*scan_input >> 0) & 0x1f) << 3, 255 };
+    const uint32_t background_r = kernel->background48.component1;
+    const uint32_t background_g = kernel->background48.component2;
+    const uint32_t background_b = kernel->background48.component3;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input++;
-        }
+    for (unsigned column = 0; column < width; column++, rgba64++) {
+        const uint32_t alpha = rgba64->component4;
+        const uint32_t transparency = 65535 - alpha;
+
+        /* Opaque pixels are rounded down to 8 bits too which is exactly what packers do. */
+        rgba64->component1 = (uint16_t)(div65535(alpha * rgba64->component1 + transparency * background_r) / 257 * 257);
+        rgba64->component2 = (uint16_t)(div65535(alpha * rgba64->component2 + transparency * background_g) / 257 * 257);
+        rgba64->component3 = (uint16_t)(div65535(alpha * rgba64->component3 + transparency * background_b) / 257 * 257);
     }
+}
 
-    return SAIL_OK;
+/*
+ * Packers.
+ */
+
+static void pack_gray8_from_rgba32(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
+
+    (void)kernel;
+
+    const sail_rgba32_t *rgba32 = row;
+
+    for (unsigned column = 0; column < width; column++, rgba32++) {
+        scan_output[column] = (uint8_t)((R_TO_GRAY_COEFFICIENT * rgba32->component1) + (G_TO_GRAY_COEFFICIENT * rgba32->component2) + (B_TO_GRAY_COEFFICIENT * rgba32->component3));
+    }
 }
 
-static sail_status_t convert_from_bpp16_rgb565(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static void pack_gray8_from_rgba64(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    (void)kernel;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { ((*scan_input >> 0) & 0x1f) << 3, ((*scan_input >> 5) & 0x3f) << 2, ((*scan_input >> 11) & 0x1f) << 3, 255 };
+    const sail_rgba64_t *rgba64 = row;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input++;
-        }
+    for (unsigned column = 0; column < width; column++, rgba64++) {
+        const uint8_t r = (uint8_t)(rgba64->component1 / 257.0);
+        const uint8_t g = (uint8_t)(rgba64->component2 / 257.0);
+        const uint8_t b = (uint8_t)(rgba64->component3 / 257.0);
+
+        scan_output[column] = (uint8_t)((R_TO_GRAY_COEFFICIENT * r) + (G_TO_GRAY_COEFFICIENT * g) + (B_TO_GRAY_COEFFICIENT * b));
     }
+}
 
-    return SAIL_OK;
+static void pack_gray16_from_rgba64(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
+
+    (void)kernel;
+
+    const sail_rgba64_t *rgba64 = row;
+    uint16_t *scan_output16 = (uint16_t *)scan_output;
+
+    for (unsigned column = 0; column < width; column++, rgba64++) {
+        scan_output16[column] = (uint16_t)((R_TO_GRAY_COEFFICIENT * rgba64->component1) + (G_TO_GRAY_COEFFICIENT * rgba64->component2) + (B_TO_GRAY_COEFFICIENT * rgba64->component3));
+    }
 }
 
-static sail_status_t convert_from_bpp16_bgr565(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static void pack_rgb_kind8_from_rgba32(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
+
+    const sail_rgba32_t *rgba32 = row;
+    const int r = kernel->r, g = kernel->g, b = kernel->b, a = kernel->a, x = kernel->x;
+    const unsigned components = kernel->output_components;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    for (unsigned column = 0; column < width; column++, rgba32++, scan_output += components) {
+        const sail_rgba32_t pixel = *rgba32;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { ((*scan_input >> 11) & 0x1f) << 3, ((*scan_input >> 5) & 0x3f) << 2, ((*scan_input >> 0) & 0x1f) << 3, 255 };
+        scan_output[r] = pixel.component1;
+        scan_output[g] = pixel.component2;
+        scan_output[b] = pixel.component3;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input++;
+        if (a >= 0) {
+            scan_output[a] = pixel.component4;
+        } else if (x >= 0) {
+            scan_output[x] = 255;
         }
     }
-
-    return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp24_rgb_kind(const struct sail_image *image, int ri, int gi, int bi, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static void pack_rgb_kind8_from_rgba64(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
+
+    const sail_rgba64_t *rgba64 = row;
+    const int r = kernel->r, g = kernel->g, b = kernel->b, a = kernel->a, x = kernel->x;
+    const unsigned components = kernel->output_components;
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    for (unsigned column = 0; column < width; column++, rgba64++, scan_output += components) {
+        const sail_rgba64_t pixel = *rgba64;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { *(scan_input+ri), *(scan_input+gi), *(scan_input+bi), 255 };
+        scan_output[r] = (uint8_t)(pixel.component1 / 257.0);
+        scan_output[g] = (uint8_t)(pixel.component2 / 257.0);
+        scan_output[b] = (uint8_t)(pixel.component3 / 257.0);
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 3;
+        if (a >= 0) {
+            scan_output[a] = (uint8_t)(pixel.component4 / 257.0);
+        } else if (x >= 0) {
+            scan_output[x] = 255;
         }
     }
-
-    return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp48_rgb_kind(const struct sail_image *image, int ri, int gi, int bi, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static void pack_rgb_kind16_from_rgba64(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    const sail_rgba64_t *rgba64 = row;
+    uint16_t *scan_output16 = (uint16_t *)scan_output;
+    const int r = kernel->r, g = kernel->g, b = kernel->b, a = kernel->a, x = kernel->x;
+    const unsigned components = kernel->output_components;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba64_t rgba64 = { *(scan_input+ri), *(scan_input+gi), *(scan_input+bi), 65535 };
+    for (unsigned column = 0; column < width; column++, rgba64++, scan_output16 += components) {
+        const sail_rgba64_t pixel = *rgba64;
 
-            pixel_consumer(output_context, row, column, NULL, &rgba64);
-            scan_input += 3;
+        scan_output16[r] = pixel.component1;
+        scan_output16[g] = pixel.component2;
+        scan_output16[b] = pixel.component3;
+
+        if (a >= 0) {
+            scan_output16[a] = pixel.component4;
+        } else if (x >= 0) {
+            scan_output16[x] = 65535;
         }
     }
-
-    return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp32_rgba_kind(const struct sail_image *image, int ri, int gi, int bi, int ai, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static void pack_ycbcr_from_rgba32(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    (void)kernel;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba32_t rgba32 = { *(scan_input+ri), *(scan_input+gi), *(scan_input+bi), ai >= 0 ? *(scan_input+ai) : 255 };
+    const sail_rgba32_t *rgba32 = row;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 4;
-        }
+    for (unsigned column = 0; column < width; column++, rgba32++, scan_output += 3) {
+        const sail_rgba32_t pixel = *rgba32;
+        convert_rgba32_to_ycbcr24(&pixel, scan_output+0, scan_output+1, scan_output+2);
     }
+}
 
-    return SAIL_OK;
+static void pack_ycbcr_from_rgba64(const struct row_kernel *kernel, const void *row, uint8_t *scan_output, unsigned width) {
+
+    (void)kernel;
+
+    const sail_rgba64_t *rgba64 = row;
+
+    for (unsigned column = 0; column < width; column++, rgba64++, scan_output += 3) {
+        const sail_rgba32_t pixel = {
+            (uint8_t)(rgba64->component1 / 257.0),
+            (uint8_t)(rgba64->component2 / 257.0),
+            (uint8_t)(rgba64->component3 / 257.0),
+            255
+        };
+
+        convert_rgba32_to_ycbcr24(&pixel, scan_output+0, scan_output+1, scan_output+2);
+    }
 }
 
-static sail_status_t convert_from_bpp64_rgba_kind(const struct sail_image *image, int ri, int gi, int bi, int ai, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/*
+ * Direct converters.
+ */
+
+/* Swaps components of RGB-like pixels with the same component depth, e.g. RGB24 -> BGRA32, or spreads GRAY8 pixels. */
+static sail_status_t convert_rgb_kind8(const struct row_kernel *kernel, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    const unsigned swizzled = swizzle_row(&kernel->swizzle, scan_input, scan_output, width);
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint16_t *scan_input = (uint16_t *)((uint8_t *)image->pixels + image->bytes_per_line * row);
+    const int ri = kernel->input_r, gi = kernel->input_g, bi = kernel->input_b, ai = kernel->input_a;
+    const int r = kernel->r, g = kernel->g, b = kernel->b, a = kernel->a, x = kernel->x;
+    const unsigned input_components = kernel->input_components;
+    const unsigned output_components = kernel->output_components;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            const sail_rgba64_t rgba64 = { *(scan_input+ri), *(scan_input+gi), *(scan_input+bi), ai >= 0 ? *(scan_input+ai) : 65535 };
+    scan_input += (size_t)swizzled * input_components;
+    scan_output += (size_t)swizzled * output_components;
 
-            pixel_consumer(output_context, row, column, NULL, &rgba64);
-            scan_input += 4;
+    for (unsigned column = swizzled; column < width; column++, scan_input += input_components, scan_output += output_components) {
+        /* Read the whole pixel first as the input and the output may overlap. */
+        const uint8_t cr = scan_input[ri];
+        const uint8_t cg = scan_input[gi];
+        const uint8_t cb = scan_input[bi];
+        const uint8_t ca = ai >= 0 ? scan_input[ai] : 255;
+
+        scan_output[r] = cr;
+        scan_output[g] = cg;
+        scan_output[b] = cb;
+
+        if (a >= 0) {
+            scan_output[a] = ca;
+        } else if (x >= 0) {
+            scan_output[x] = 255;
         }
     }
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp32_cmyk(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static sail_status_t convert_rgb_kind16(const struct row_kernel *kernel, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    const uint16_t *scan_input16 = (const uint16_t *)scan_input;
+    uint16_t *scan_output16 = (uint16_t *)scan_output;
+    const int ri = kernel->input_r, gi = kernel->input_g, bi = kernel->input_b, ai = kernel->input_a;
+    const int r = kernel->r, g = kernel->g, b = kernel->b, a = kernel->a, x = kernel->x;
+    const unsigned input_components = kernel->input_components;
+    const unsigned output_components = kernel->output_components;
+
+    for (unsigned column = 0; column < width; column++, scan_input16 += input_components, scan_output16 += output_components) {
+        /* Read the whole pixel first as the input and the output may overlap. */
+        const uint16_t cr = scan_input16[ri];
+        const uint16_t cg = scan_input16[gi];
+        const uint16_t cb = scan_input16[bi];
+        const uint16_t ca = ai >= 0 ? scan_input16[ai] : 65535;
+
+        scan_output16[r] = cr;
+        scan_output16[g] = cg;
+        scan_output16[b] = cb;
+
+        if (a >= 0) {
+            scan_output16[a] = ca;
+        } else if (x >= 0) {
+            scan_output16[x] = 65535;
+        }
+    }
 
-    sail_rgba32_t rgba32;
+    return SAIL_OK;
+}
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+/*
+ * Gathers output pixels of pixel_size bytes from the palette table. Every input byte holds
+ * 8 / bits indexes, the leftmost pixel in the most significant bits. Called with constant
+ * bits and pixel_size, so the inner loop is unrolled and the copy is a single move.
+ */
+static inline sail_status_t gather_indexed(const struct row_kernel *kernel, const uint8_t *scan_input, uint8_t *scan_output, unsigned width,
+                                           unsigned bits, unsigned pixel_size) {
+
+    const uint8_t *lut = kernel->lut;
+    const unsigned lut_colors = kernel->lut_colors;
+    const unsigned indexes_per_byte = 8 / bits;
+    const unsigned mask = (1u << bits) - 1;
+    unsigned out_of_range = 0;
+    unsigned column = 0;
+
+    for (; column + indexes_per_byte <= width; column += indexes_per_byte) {
+        const unsigned byte = *scan_input++;
+
+        for (unsigned k = 0; k < indexes_per_byte; k++) {
+            const unsigned index = (byte >> (8 - bits * (k + 1))) & mask;
+            out_of_range |= (index >= lut_colors);
+            memcpy(scan_output, lut + index * pixel_size, pixel_size);
+            scan_output += pixel_size;
+        }
+    }
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_cmyk32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), &rgba32);
+    if (column < width) {
+        const unsigned byte = *scan_input;
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 4;
+        for (unsigned k = 0; column < width; column++, k++) {
+            const unsigned index = (byte >> (8 - bits * (k + 1))) & mask;
+            out_of_range |= (index >= lut_colors);
+            memcpy(scan_output, lut + index * pixel_size, pixel_size);
+            scan_output += pixel_size;
         }
     }
 
+    if (out_of_range) {
+        SAIL_LOG_ERROR("Palette index is out of range [0; %u)", lut_colors);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+    }
+
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp24_ycbcr(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+#define GATHER_INDEXED(bits)                                                                            \
+    switch (kernel->output_pixel_size) {                                                                \
+        case 1: return gather_indexed(kernel, scan_input, scan_output, width, bits, 1);                 \
+        case 2: return gather_indexed(kernel, scan_input, scan_output, width, bits, 2);                 \
+        case 3: return gather_indexed(kernel, scan_input, scan_output, width, bits, 3);                 \
+        case 4: return gather_indexed(kernel, scan_input, scan_output, width, bits, 4);                 \
+        case 6: return gather_indexed(kernel, scan_input, scan_output, width, bits, 6);                 \
+        default: return gather_indexed(kernel, scan_input, scan_output, width, bits, 8);                \
+    }
 
-    sail_rgba32_t rgba32;
+/* Converts indexed pixels with the palette table. */
+static sail_status_t convert_indexed(const struct row_kernel *kernel, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    switch (kernel->index_bits) {
+        case 1:  { GATHER_INDEXED(1); }
+        case 2:  { GATHER_INDEXED(2); }
+        case 4:  { GATHER_INDEXED(4); }
+        default: { GATHER_INDEXED(8); }
+    }
+}
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_ycbcr24_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), &rgba32);
+#undef GATHER_INDEXED
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 3;
-        }
+/*
+ * Runs the palette through the unpack stages to fill the table of output pixels.
+ * lut must hold 256 pixels of the largest output pixel size.
+ */
+static sail_status_t build_palette_lut(const struct row_kernel *kernel, const struct sail_palette *palette, uint8_t *lut) {
+
+    const unsigned max_colors = 1u << kernel->index_bits;
+    const unsigned colors = SAIL_MIN(palette->color_count, max_colors);
+    sail_rgba64_t row[256];
+
+    for (unsigned index = 0; index < colors; index++) {
+        SAIL_TRY(get_palette_rgba32(palette, index, (sail_rgba32_t *)row + index));
+    }
+
+    if (kernel->widen != NULL) {
+        kernel->widen(kernel, row, colors);
     }
+    if (kernel->blend != NULL) {
+        kernel->blend(kernel, row, colors);
+    }
+
+    kernel->pack(kernel, row, lut, colors);
+
+    /* Never used as indexes beyond the palette are rejected. */
+    memset(lut + (size_t)colors * kernel->output_pixel_size, 0, (size_t)(max_colors - colors) * kernel->output_pixel_size);
 
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp32_ycck(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+/*
+ * Kernel construction.
+ */
+
+/* After adding a new output pixel format, also update the candidate lists below. */
+static bool construct_packer(enum SailPixelFormat output_pixel_format, struct row_kernel *kernel, bool *is16, bool *has_alpha) {
+
+    kernel->r = kernel->g = kernel->b = kernel->a = kernel->x = -1;
+    kernel->output_components = 0;
+    *has_alpha = false;
 
-    sail_rgba32_t rgba32;
+    switch (output_pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:  { *is16 = false; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE: { *is16 = true;  break; }
+        case SAIL_PIXEL_FORMAT_BPP24_YCBCR:     { *is16 = false; break; }
+
+        default: {
+            int r, g, b, a;
+            unsigned components;
+
+            if (!rgb_kind_indexes(output_pixel_format, &r, &g, &b, &a, &components, is16)) {
+                return false;
+            }
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+            kernel->r = r;
+            kernel->g = g;
+            kernel->b = b;
+            kernel->a = a;
+            kernel->output_components = components;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_ycck32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), &rgba32);
+            /* Index of the unused component in RGBX-like pixels. */
+            if (a < 0 && components == 4) {
+                kernel->x = 6 - r - g - b;
+            }
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 4;
+            *has_alpha = a >= 0;
+            break;
         }
     }
 
-    return SAIL_OK;
+    return true;
 }
 
-static sail_status_t conversion_impl(
-    const struct sail_image *image,
-    struct sail_image *image_output,
-    pixel_consumer_t pixel_consumer,
-    int r, /* Index of the RED component.   */
-    int g, /* Index of the GREEN component. */
-    int b, /* Index of the BLUE component.  */
-    int a, /* Index of the ALPHA component. */
-    const struct sail_conversion_options *options) {
+static void select_packer(enum SailPixelFormat output_pixel_format, bool output_is16, struct row_kernel *kernel) {
 
-    const struct output_context output_context = { image_output, r, g, b, a, options };
+    switch (output_pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:  { kernel->pack = kernel->rgba64 ? pack_gray8_from_rgba64 : pack_gray8_from_rgba32; break; }
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE: { kernel->pack = pack_gray16_from_rgba64;                                         break; }
+        case SAIL_PIXEL_FORMAT_BPP24_YCBCR:     { kernel->pack = kernel->rgba64 ? pack_ycbcr_from_rgba64 : pack_ycbcr_from_rgba32; break; }
 
-    /* After adding a new input pixel format, also update the switch in sail_can_convert(). */
-    switch (image->pixel_format) {
-        case SAIL_PIXEL_FORMAT_BPP1_INDEXED:
-        case SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE: {
-            SAIL_TRY(convert_from_bpp1_indexed_or_grayscale(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP2_INDEXED:
-        case SAIL_PIXEL_FORMAT_BPP2_GRAYSCALE: {
-            SAIL_TRY(convert_from_bpp2_indexed_or_grayscale(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP4_INDEXED:
-        case SAIL_PIXEL_FORMAT_BPP4_GRAYSCALE: {
-            SAIL_TRY(convert_from_bpp4_indexed_or_grayscale(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP8_INDEXED:
-        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE: {
-            SAIL_TRY(convert_from_bpp8_indexed_or_grayscale(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE: {
-            SAIL_TRY(convert_from_bpp16_grayscale(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA: {
-            SAIL_TRY(convert_from_bpp16_grayscale_alpha(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA: {
-            SAIL_TRY(convert_from_bpp32_grayscale_alpha(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_RGB555: {
-            SAIL_TRY(convert_from_bpp16_rgb555(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_BGR555: {
-            SAIL_TRY(convert_from_bpp16_bgr555(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_RGB565: {
-            SAIL_TRY(convert_from_bpp16_rgb565(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP16_BGR565: {
-            SAIL_TRY(convert_from_bpp16_bgr565(image, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP24_RGB: {
-            SAIL_TRY(convert_from_bpp24_rgb_kind(image, 0, 1, 2, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP24_BGR: {
-            SAIL_TRY(convert_from_bpp24_rgb_kind(image, 2, 1, 0, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP48_RGB: {
-            SAIL_TRY(convert_from_bpp48_rgb_kind(image, 0, 1, 2, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP48_BGR: {
-            SAIL_TRY(convert_from_bpp48_rgb_kind(image, 2, 1, 0, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_RGBX: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 0, 1, 2, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_BGRX: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 2, 1, 0, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_XRGB: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 1, 2, 3, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_XBGR: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 3, 2, 1, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_RGBA: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 0, 1, 2, 3, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_BGRA: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 2, 1, 0, 3, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_ARGB: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 1, 2, 3, 0, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP32_ABGR: {
-            SAIL_TRY(convert_from_bpp32_rgba_kind(image, 3, 2, 1, 0, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_RGBX: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 0, 1, 2, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_BGRX: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 2, 1, 0, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_XRGB: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 1, 2, 3, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_XBGR: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 3, 2, 1, -1, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_RGBA: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 0, 1, 2, 3, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_BGRA: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 2, 1, 0, 3, pixel_consumer, &output_context));
-            break;
-        }
-        case SAIL_PIXEL_FORMAT_BPP64_ARGB: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 1, 2, 3, 0, pixel_consumer, &output_context));
+        default: {
+            if (output_is16) {
+                kernel->pack = pack_rgb_kind16_from_rgba64;
+            } else {
+                kernel->pack = kernel->rgba64 ? pack_rgb_kind8_from_rgba64 : pack_rgb_kind8_from_rgba32;
+            }
             break;
         }
-        case SAIL_PIXEL_FORMAT_BPP64_ABGR: {
-            SAIL_TRY(convert_from_bpp64_rgba_kind(image, 3, 2, 1, 0, pixel_consumer, &output_context));
-            break;
+    }
+}
+
+static bool construct_row_kernel_silent(enum SailPixelFormat input_pixel_format,
+                                        enum SailPixelFormat output_pixel_format,
+                                        const struct sail_conversion_options *options,
+                                        struct row_kernel *kernel,
+                                        bool *input_supported) {
+
+    memset(kernel, 0, sizeof(*kernel));
+
+    bool output_is16, output_has_alpha;
+    if (!construct_packer(output_pixel_format, kernel, &output_is16, &output_has_alpha)) {
+        *input_supported = true;
+        return false;
+    }
+
+    bool input_is16;
+    if (!construct_unpacker(input_pixel_format, kernel, &input_is16)) {
+        *input_supported = false;
+        return false;
+    }
+
+    *input_supported = true;
+
+    const bool blend_alpha = options != NULL && (options->options & SAIL_CONVERSION_OPTION_BLEND_ALPHA) && !output_has_alpha;
+
+    if (blend_alpha) {
+        kernel->background24 = options->background24;
+        kernel->background48 = options->background48;
+    }
+
+    /* GRAY8 pixels are spread into 8-bit RGB-like pixels directly. */
+    if (input_pixel_format == SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE && kernel->output_components > 0 && !output_is16) {
+        kernel->input_r = kernel->input_g = kernel->input_b = 0;
+        kernel->input_a = -1;
+        kernel->input_components = 1;
+    }
+
+    /* RGB-like pixels with the same component depth are swizzled directly. */
+    if (kernel->input_components > 0 && kernel->output_components > 0 && input_is16 == output_is16 && !(blend_alpha && kernel->input_a >= 0)) {
+        if (output_is16) {
+            kernel->convert = convert_rgb_kind16;
+        } else {
+            const int input_indexes[4] = { kernel->input_r, kernel->input_g, kernel->input_b, kernel->input_a };
+            const int output_indexes[4] = { kernel->r, kernel->g, kernel->b, kernel->a };
+
+            init_swizzle(kernel->input_components, input_indexes, kernel->output_components, output_indexes, kernel->x, &kernel->swizzle);
+            kernel->convert = convert_rgb_kind8;
         }
-        case SAIL_PIXEL_FORMAT_BPP32_CMYK: {
-            SAIL_TRY(convert_from_bpp32_cmyk(image, pixel_consumer, &output_context));
-            break;
+
+        return true;
+    }
+
+    kernel->rgba64 = input_is16 || output_is16;
+    kernel->widen = (!input_is16 && output_is16) ? widen_rgba32_to_rgba64 : NULL;
+
+    if (blend_alpha) {
+        if (!kernel->rgba64) {
+            kernel->blend = blend_rgba32;
+        } else if (output_is16) {
+            kernel->blend = blend_rgba64;
+        } else {
+            kernel->blend = blend_rgba64_to_8bit;
         }
-        case SAIL_PIXEL_FORMAT_BPP24_YCBCR: {
-            SAIL_TRY(convert_from_bpp24_ycbcr(image, pixel_consumer, &output_context));
-            break;
+    }
+
+    select_packer(output_pixel_format, output_is16, kernel);
+
+    if (kernel->index_bits > 0) {
+        kernel->output_pixel_size = sail_bits_per_pixel(output_pixel_format) / 8;
+        kernel->convert = convert_indexed;
+    }
+
+    return true;
+}
+
+static sail_status_t construct_row_kernel_verbose(enum SailPixelFormat input_pixel_format,
+                                                  enum SailPixelFormat output_pixel_format,
+                                                  const struct sail_conversion_options *options,
+                                                  struct row_kernel *kernel) {
+
+    bool input_supported;
+
+    if (construct_row_kernel_silent(input_pixel_format, output_pixel_format, options, kernel, &input_supported)) {
+        return SAIL_OK;
+    }
+
+    if (input_supported) {
+        SAIL_LOG_ERROR("Conversion to %s is not supported", sail_pixel_format_to_string(output_pixel_format));
+    } else {
+        SAIL_LOG_ERROR("Conversion from %s is not currently supported", sail_pixel_format_to_string(input_pixel_format));
+    }
+
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+}
+
+/* Images smaller than this are converted in a single band. */
+static const size_t MIN_PIXELS_PER_BAND = 256 * 1024;
+
+/*
+ * A row kernel compiled for a specific image width. Row kernels don't depend on the image height,
+ * so a plan converts images of any height, e.g. bands of scan lines of different heights.
+ * Bands are horizontal strips of rows converted in parallel. Every band has its own row buffer.
+ */
+struct sail_conversion_plan {
+    struct row_kernel kernel;
+
+    enum SailPixelFormat input_pixel_format;
+    enum SailPixelFormat output_pixel_format;
+    unsigned width;
+
+    /* The maximum number of bands converted in parallel. */
+    unsigned max_bands;
+
+    /* max_bands * width RGBA64 pixels, or NULL if the kernel converts scan lines directly. */
+    void *rows;
+
+    /* Palette table of indexed conversions. */
+    uint8_t lut[256 * sizeof(sail_rgba64_t)];
+};
+
+static unsigned max_bands_count(const struct sail_conversion_options *options) {
+
+    const unsigned count = (options == NULL || options->threads == 0) ? 1 : options->threads;
+
+    return SAIL_MIN(count, (unsigned)SAIL_PARALLEL_RUN_MAX_TASKS);
+}
+
+static unsigned bands_count(const struct sail_conversion_plan *plan, unsigned height) {
+
+    size_t count = plan->max_bands;
+
+    count = SAIL_MIN(count, (size_t)plan->width * height / MIN_PIXELS_PER_BAND);
+    count = SAIL_MIN(count, (size_t)height);
+
+    return (count == 0) ? 1 : (unsigned)count;
+}
+
+static sail_status_t alloc_conversion_plan(enum SailPixelFormat input_pixel_format,
+                                           unsigned width,
+                                           enum SailPixelFormat output_pixel_format,
+                                           const struct sail_conversion_options *options,
+                                           struct sail_conversion_plan **plan) {
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_conversion_plan), &ptr));
+    struct sail_conversion_plan *plan_local = ptr;
+
+    SAIL_TRY_OR_CLEANUP(construct_row_kernel_verbose(input_pixel_format, output_pixel_format, options, &plan_local->kernel),
+                        /* cleanup */ sail_free(plan_local));
+
+    plan_local->input_pixel_format  = input_pixel_format;
+    plan_local->output_pixel_format = output_pixel_format;
+    plan_local->width               = width;
+    plan_local->max_bands           = max_bands_count(options);
+    plan_local->rows                = NULL;
+    plan_local->kernel.lut          = plan_local->lut;
+
+    if (plan_local->kernel.convert == NULL) {
+        SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)plan_local->max_bands * width * sizeof(sail_rgba64_t), &plan_local->rows),
+                            /* cleanup */ sail_free(plan_local));
+    }
+
+    *plan = plan_local;
+
+    return SAIL_OK;
+}
+
+/*
+ * Converts the image rows [first_row, first_row + rows). The output pixels may be the image pixels
+ * with the same bytes per line when the output pixels are not larger than the input pixels.
+ */
+static sail_status_t convert_rows(const struct row_kernel *kernel, const struct sail_image *image,
+                                  void *pixels, unsigned bytes_per_line,
+                                  unsigned first_row, unsigned rows, void *row) {
+
+    for (unsigned row_index = first_row; row_index < first_row + rows; row_index++) {
+        const uint8_t *scan_input = (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * row_index;
+        uint8_t *scan_output = (uint8_t *)pixels + (size_t)bytes_per_line * row_index;
+
+        if (kernel->convert != NULL) {
+            SAIL_TRY(kernel->convert(kernel, scan_input, scan_output, image->width));
+            continue;
         }
-        case SAIL_PIXEL_FORMAT_BPP32_YCCK: {
-            SAIL_TRY(convert_from_bpp32_ycck(image, pixel_consumer, &output_context));
-            break;
+
+        SAIL_TRY(kernel->unpack(kernel, image, scan_input, row));
+
+        if (kernel->widen != NULL) {
+            kernel->widen(kernel, row, image->width);
         }
-        default: {
-            SAIL_LOG_ERROR("Conversion from %s is not currently supported", sail_pixel_format_to_string(image->pixel_format));
-            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+        if (kernel->blend != NULL) {
+            kernel->blend(kernel, row, image->width);
         }
+
+        kernel->pack(kernel, row, scan_output, image->width);
+    }
+
+    return SAIL_OK;
+}
+
+struct bands {
+    const struct sail_conversion_plan *plan;
+    const struct sail_image *image;
+    void *pixels;
+    unsigned bytes_per_line;
+    unsigned count;
+
+    sail_status_t status[SAIL_PARALLEL_RUN_MAX_TASKS];
+};
+
+static void *band_row(const struct sail_conversion_plan *plan, unsigned index) {
+
+    return (plan->rows == NULL) ? NULL : (sail_rgba64_t *)plan->rows + (size_t)plan->width * index;
+}
+
+static void convert_band(void *context, unsigned index) {
+
+    struct bands *bands = context;
+    const struct sail_conversion_plan *plan = bands->plan;
+
+    /* Spread the remainder rows over the bands. */
+    const unsigned height = bands->image->height;
+    const unsigned first_row = (unsigned)((uint64_t)height * index / bands->count);
+    const unsigned last_row = (unsigned)((uint64_t)height * (index + 1) / bands->count);
+
+    bands->status[index] = SAIL_TRACE_CALL("manip", "convert_band", NULL,
+                                           (uint64_t)bands->bytes_per_line * (last_row - first_row),
+                                           (uint64_t)bands->image->width * (last_row - first_row),
+                                           convert_rows(&plan->kernel, bands->image, bands->pixels, bands->bytes_per_line,
+                                                        first_row, last_row - first_row, band_row(plan, index)));
+}
+
+/*
+ * Converts the image rows in bands in parallel threads. Every row is converted
+ * independently, so the output pixels may still be the image pixels.
+ */
+static sail_status_t convert_bands(struct sail_conversion_plan *plan, const struct sail_image *image,
+                                   void *pixels, unsigned bytes_per_line) {
+
+    /* Palettes differ from image to image, e.g. local palettes of animation frames. */
+    if (plan->kernel.index_bits > 0) {
+        SAIL_TRY(build_palette_lut(&plan->kernel, image->palette, plan->lut));
+        plan->kernel.lut_colors = image->palette->color_count;
+    }
+
+    const unsigned count = bands_count(plan, image->height);
+
+    if (count == 1) {
+        SAIL_TRY(convert_rows(&plan->kernel, image, pixels, bytes_per_line, 0, image->height, band_row(plan, 0)));
+        return SAIL_OK;
+    }
+
+    struct bands bands = { plan, image, pixels, bytes_per_line, count, { SAIL_OK } };
+
+    parallel_run(convert_band, &bands, count);
+
+    for (unsigned i = 0; i < count; i++) {
+        SAIL_TRY(bands.status[i]);
     }
 
     return SAIL_OK;
 }
 
+/* Converts the image rows between "convert" trace events. */
+static sail_status_t conversion_impl(struct sail_conversion_plan *plan, const struct sail_image *image,
+                                     void *pixels, unsigned bytes_per_line) {
+
+    SAIL_TRY(SAIL_TRACE_CALL("manip", "convert", NULL, (uint64_t)bytes_per_line * image->height, (uint64_t)image->width * image->height,
+                             convert_bands(plan, image, pixels, bytes_per_line)));
+
+    return SAIL_OK;
+}
+
 /*
  * Public functions.
  */
@@ -720,22 +1199,26 @@ sail_status_t sail_convert_image_with_options(const struct sail_image *image,
     SAIL_TRY(sail_check_image_valid(image));
     SAIL_CHECK_PTR(image_output);
 
-    int r, g, b, a;
-    pixel_consumer_t pixel_consumer;
-    SAIL_TRY(verify_and_construct_rgba_indexes_verbose(output_pixel_format, &pixel_consumer, &r, &g, &b, &a));
+    struct sail_conversion_plan *plan;
+    SAIL_TRY(alloc_conversion_plan(image->pixel_format, image->width, output_pixel_format, options, &plan));
 
     struct sail_image *image_local;
-    SAIL_TRY(sail_copy_image_skeleton(image, &image_local));
+    SAIL_TRY_OR_CLEANUP(sail_copy_image_skeleton(image, &image_local),
+                        /* cleanup */ sail_destroy_conversion_plan(plan));
 
     image_local->pixel_format = output_pixel_format;
     image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
 
     const size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
     SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
-                        /* cleanup */ sail_destroy_image(image_local));
+                        /* cleanup */ sail_destroy_image(image_local),
+                                      sail_destroy_conversion_plan(plan));
+
+    SAIL_TRY_OR_CLEANUP(conversion_impl(plan, image, image_local->pixels, image_local->bytes_per_line),
+                        /* cleanup */ sail_destroy_image(image_local),
+                                      sail_destroy_conversion_plan(plan));
 
-    SAIL_TRY_OR_CLEANUP(conversion_impl(image, image_local, pixel_consumer, r, g, b, a, options),
-                        /* cleanup */ sail_destroy_image(image_local));
+    sail_destroy_conversion_plan(plan);
 
     *image_output = image_local;
 
@@ -755,11 +1238,16 @@ sail_status_t sail_update_image_with_options(struct sail_image *image,
 
     SAIL_TRY(sail_check_image_valid(image));
 
-    int r, g, b, a;
-    pixel_consumer_t pixel_consumer;
-    SAIL_TRY(verify_and_construct_rgba_indexes_verbose(output_pixel_format, &pixel_consumer, &r, &g, &b, &a));
-
+    /* Nothing to convert. Only reject output pixel formats that are never supported. */
     if (image->pixel_format == output_pixel_format) {
+        struct row_kernel kernel;
+        bool output_is16, output_has_alpha;
+
+        if (!construct_packer(output_pixel_format, &kernel, &output_is16, &output_has_alpha)) {
+            SAIL_LOG_ERROR("Conversion to %s is not supported", sail_pixel_format_to_string(output_pixel_format));
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+        }
+
         return SAIL_OK;
     }
 
@@ -771,16 +1259,100 @@ sail_status_t sail_update_image_with_options(struct sail_image *image,
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
     }
 
-    SAIL_TRY(conversion_impl(image, image, pixel_consumer, r, g, b, a, options));
+    struct sail_conversion_plan *plan;
+    SAIL_TRY(alloc_conversion_plan(image->pixel_format, image->width, output_pixel_format, options, &plan));
+
+    SAIL_TRY_OR_CLEANUP(conversion_impl(plan, image, image->pixels, image->bytes_per_line),
+                        /* cleanup */ sail_destroy_conversion_plan(plan));
+
+    sail_destroy_conversion_plan(plan);
 
     image->pixel_format = output_pixel_format;
 
     return SAIL_OK;
 }
 
+sail_status_t sail_alloc_conversion_plan(enum SailPixelFormat input_pixel_format,
+                                         unsigned width,
+                                         enum SailPixelFormat output_pixel_format,
+                                         const struct sail_conversion_options *options,
+                                         struct sail_conversion_plan **plan) {
+
+    SAIL_CHECK_PTR(plan);
+
+    if (width == 0) {
+        SAIL_LOG_ERROR("Conversion plan width must be positive");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    SAIL_TRY(alloc_conversion_plan(input_pixel_format, width, output_pixel_format, options, plan));
+
+    return SAIL_OK;
+}
+
+void sail_destroy_conversion_plan(struct sail_conversion_plan *plan) {
+
+    if (plan == NULL) {
+        return;
+    }
+
+    sail_free(plan->rows);
+    sail_free(plan);
+}
+
+sail_status_t sail_convert_image_with_plan(struct sail_conversion_plan *plan,
+                                           const struct sail_image *image,
+                                           struct sail_image *image_output) {
+
+    SAIL_CHECK_PTR(plan);
+    SAIL_CHECK_PTR(image);
+    SAIL_CHECK_PTR(image_output);
+
+    if (image_output->width != plan->width || image_output->height != image->height || image_output->pixel_format != plan->output_pixel_format) {
+        SAIL_LOG_ERROR("The output image doesn't match the conversion plan");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    SAIL_TRY(sail_check_image_valid(image_output));
+
+    SAIL_TRY(sail_convert_image_with_plan_to_buffer(plan, image, image_output->pixels,
+                                                    (size_t)image_output->bytes_per_line * image_output->height,
+                                                    image_output->bytes_per_line));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_convert_image_with_plan_to_buffer(struct sail_conversion_plan *plan,
+                                                     const struct sail_image *image,
+                                                     void *pixels,
+                                                     size_t pixels_size,
+                                                     unsigned bytes_per_line) {
+
+    SAIL_CHECK_PTR(plan);
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(pixels);
+
+    if (image->width != plan->width || image->pixel_format != plan->input_pixel_format) {
+        SAIL_LOG_ERROR("The %u pixels wide %s image doesn't match the %u pixels wide %s conversion plan",
+                        image->width, sail_pixel_format_to_string(image->pixel_format),
+                        plan->width, sail_pixel_format_to_string(plan->input_pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (bytes_per_line < sail_bytes_per_line(plan->width, plan->output_pixel_format) || pixels_size < (size_t)bytes_per_line * image->height) {
+        SAIL_LOG_ERROR("The output buffer is too small for %ux%u %s pixels",
+                        image->width, image->height, sail_pixel_format_to_string(plan->output_pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    SAIL_TRY(conversion_impl(plan, image, pixels, bytes_per_line));
+
+    return SAIL_OK;
+}
+
 bool sail_can_convert(enum SailPixelFormat input_pixel_format, enum SailPixelFormat output_pixel_format) {
 
-    /* After adding a new input pixel format, also update the switch in conversion_impl(). */
+    /* After adding a new input pixel format, also update the switch in construct_unpacker(). */
     switch (input_pixel_format) {
         case SAIL_PIXEL_FORMAT_BPP1_INDEXED:
         case SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE:
@@ -819,9 +1391,9 @@ bool sail_can_convert(enum SailPixelFormat input_pixel_format, enum SailPixelFor
         case SAIL_PIXEL_FORMAT_BPP64_ABGR:
         case SAIL_PIXEL_FORMAT_BPP32_CMYK:
         case SAIL_PIXEL_FORMAT_BPP24_YCBCR: {
-            int r, g, b, a;
-            pixel_consumer_t pixel_consumer;
-            return verify_and_construct_rgba_indexes_silent(output_pixel_format, &pixel_consumer, &r, &g, &b, &a);
+            struct row_kernel kernel;
+            bool input_supported;
+            return construct_row_kernel_silent(input_pixel_format, output_pixel_format, NULL /* options */, &kernel, &input_supported);
         }
         default: {
             return false;
@@ -44,6 +44,7 @@ extern "C" {
 #endif
 
 struct sail_conversion_options;
+struct sail_conversion_plan;
 struct sail_image;
 struct sail_save_features;
 
@@ -54,9 +55,12 @@ struct sail_save_features;
  * when converting RGBA pixels to RGB. If you need to control this behavior,
  * use sail_convert_image_with_options().
  *
- * The conversion procedure may be slow. It converts every pixel into the BPP32-RGBA or
- * BPP64-RGBA formats first, and only then to the requested output format. No platform-specific
- * instructions (like AVX or SSE) are used.
+ * RGB-like pixels with the same component depth are swizzled directly. 8-bit components
+ * are shuffled with SSSE3 or AVX2 on x86 and NEON on AArch64 when the CPU supports them.
+ * Set the SAIL_FORCE_SIMD environment variable to "none", "ssse3" or "avx2" on x86, or "neon"
+ * on AArch64 to limit the instructions used. Other values are ignored with a warning.
+ * Other pixels are unpacked into 8-bit or 16-bit RGBA scan lines and packed into the output
+ * pixel format.
  *
  * The image ICC profile is not involved in the conversion procedure.
  *
@@ -107,9 +111,7 @@ SAIL_EXPORT sail_status_t sail_convert_image(const struct sail_image *image,
  *
  * Options (which may be NULL) control the conversion behavior.
  *
- * The conversion procedure may be slow. It converts every pixel into the BPP32-RGBA or
- * BPP64-RGBA formats first, and only then to the requested output format. No platform-specific
- * instructions (like AVX or SSE) are used.
+ * Pixels are converted the same way as in sail_convert_image().
  *
  * The image ICC profile (if any) is not involved into the conversion procedure.
  *
@@ -167,9 +169,7 @@ SAIL_EXPORT sail_status_t sail_convert_image_with_options(const struct sail_imag
  * Doesn't reallocate pixels. For example, when updating 100x100 BPP32-RGBA image
  * to BPP24-RGB, the resulting pixel data will have 10'000 unused bytes at the end.
  *
- * The updating procedure may be slow. It converts every pixel into the BPP32-RGBA or
- * BPP64-RGBA formats first, and only then to the requested output format. No platform-specific
- * instructions (like AVX or SSE) are used.
+ * Pixels are converted the same way as in sail_convert_image().
  *
  * The image ICC profile (if any) is not involved into the conversion procedure.
  *
@@ -221,9 +221,7 @@ SAIL_EXPORT sail_status_t sail_update_image(struct sail_image *image, enum SailP
  * Doesn't reallocate pixels. For example, when updating 100x100 BPP32-RGBA image
  * to BPP24-RGB, the resulting pixel data will have 10'000 unused bytes at the end.
  *
- * The updating procedure may be slow. It converts every pixel into the BPP32-RGBA or
- * BPP64-RGBA formats first, and only then to the requested output format. No platform-specific
- * instructions (like AVX or SSE) are used.
+ * Pixels are converted the same way as in sail_convert_image().
  *
  * The image ICC profile (if any) is not involved into the conversion procedure.
  *
@@ -268,6 +266,61 @@ SAIL_EXPORT sail_status_t sail_update_image_with_options(struct sail_image *imag
                                                          enum SailPixelFormat output_pixel_format,
                                                          const struct sail_conversion_options *options);
 
+/*
+ * Compiles a plan to convert images of the specified width and pixel format to the output
+ * pixel format. Use it to convert many images of the same kind, like animation frames
+ * or bands of scan lines. The plan resolves the conversion and allocates its working
+ * buffers once. The images may have any height.
+ *
+ * Options (which may be NULL) control the conversion behavior. The options are copied
+ * into the plan, so they can be destroyed right after this call.
+ *
+ * Supports the same input and output pixel formats as sail_convert_image().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_conversion_plan(enum SailPixelFormat input_pixel_format,
+                                                     unsigned width,
+                                                     enum SailPixelFormat output_pixel_format,
+                                                     const struct sail_conversion_options *options,
+                                                     struct sail_conversion_plan **plan);
+
+/*
+ * Destroys the specified conversion plan and all its internal allocated memory buffers.
+ * The plan MUST NOT be used anymore after calling this function. Does nothing if the plan is NULL.
+ */
+SAIL_EXPORT void sail_destroy_conversion_plan(struct sail_conversion_plan *plan);
+
+/*
+ * Converts the image with the plan into the pixels of the caller-owned output image.
+ * The image and the output image must match the width and the pixel formats of the plan,
+ * and must have the same height.
+ * The output image must have allocated pixels. Its other properties stay as is.
+ *
+ * A plan MUST NOT be used by multiple threads simultaneously.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_convert_image_with_plan(struct sail_conversion_plan *plan,
+                                                       const struct sail_image *image,
+                                                       struct sail_image *image_output);
+
+/*
+ * Converts the image with the plan into the caller-provided pixel buffer. The image must match
+ * the width and the input pixel format of the plan. The buffer must not overlap the image
+ * pixels. bytes_per_line must be at least sail_bytes_per_line() of the output pixel format,
+ * and pixels_size must be at least bytes_per_line * height.
+ *
+ * A plan MUST NOT be used by multiple threads simultaneously.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_convert_image_with_plan_to_buffer(struct sail_conversion_plan *plan,
+                                                                 const struct sail_image *image,
+                                                                 void *pixels,
+                                                                 size_t pixels_size,
+                                                                 unsigned bytes_per_line);
+
 /*
  * Returns true if the conversion or updating functions can convert or update from the input
  * pixel format to the output pixel format.
@@ -51,4 +51,36 @@ enum SailConversionOption {
     SAIL_CONVERSION_OPTION_BLEND_ALPHA = 1 << 1,
 };
 
+/*
+ * Filters to resample images with.
+ */
+enum SailScaling {
+
+    /*
+     * Averages the input pixels covered by every output pixel. The fastest filter.
+     * Replicates pixels when upscaling.
+     */
+    SAIL_SCALING_BOX,
+
+    /*
+     * Triangle filter. Interpolates linearly when upscaling.
+     */
+    SAIL_SCALING_BILINEAR,
+
+    /*
+     * Windowed sinc filter with three lobes. The sharpest and the slowest filter.
+     */
+    SAIL_SCALING_LANCZOS3,
+};
+
+/*
+ * Clockwise rotation angles.
+ */
+enum SailRotation {
+
+    SAIL_ROTATION_90,
+    SAIL_ROTATION_180,
+    SAIL_ROTATION_270,
+};
+
 #endif
@@ -0,0 +1,147 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sail-common.h"
+
+#include "sail-manip.h"
+
+#ifdef SAIL_THREAD_SAFE
+
+#ifdef SAIL_WIN32
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+/* A task run in its own worker thread. */
+struct worker {
+    parallel_task_t task;
+    void *context;
+    unsigned index;
+};
+
+#ifdef SAIL_WIN32
+typedef HANDLE worker_thread_t;
+
+static DWORD WINAPI worker_thread(LPVOID arg) {
+
+    const struct worker *worker = arg;
+
+    worker->task(worker->context, worker->index);
+
+    return 0;
+}
+
+static bool start_worker(struct worker *worker, worker_thread_t *thread) {
+
+    *thread = CreateThread(NULL, 0, worker_thread, worker, 0, NULL);
+
+    if (*thread == NULL) {
+        SAIL_LOG_WARNING("Failed to start a conversion thread. Error: 0x%X", GetLastError());
+        return false;
+    }
+
+    return true;
+}
+
+static void join_worker(worker_thread_t thread) {
+
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+typedef pthread_t worker_thread_t;
+
+static void* worker_thread(void *arg) {
+
+    const struct worker *worker = arg;
+
+    worker->task(worker->context, worker->index);
+
+    return NULL;
+}
+
+static bool start_worker(struct worker *worker, worker_thread_t *thread) {
+
+    int res;
+
+    if ((res = pthread_create(thread, NULL, worker_thread, worker)) != 0) {
+        SAIL_LOG_WARNING("Failed to start a conversion thread. Error: %d", res);
+        return false;
+    }
+
+    return true;
+}
+
+static void join_worker(worker_thread_t thread) {
+
+    pthread_join(thread, NULL);
+}
+#endif
+
+void parallel_run(parallel_task_t task, void *context, unsigned tasks) {
+
+    if (tasks == 0) {
+        return;
+    }
+
+    if (tasks > SAIL_PARALLEL_RUN_MAX_TASKS) {
+        tasks = SAIL_PARALLEL_RUN_MAX_TASKS;
+    }
+
+    struct worker workers[SAIL_PARALLEL_RUN_MAX_TASKS];
+    worker_thread_t threads[SAIL_PARALLEL_RUN_MAX_TASKS];
+    bool started[SAIL_PARALLEL_RUN_MAX_TASKS];
+
+    /* Task 0 is run by the calling thread. Stop starting workers after the first failure. */
+    for (unsigned index = 1; index < tasks; index++) {
+        workers[index] = (struct worker){ task, context, index };
+        started[index] = (index == 1 || started[index - 1]) && start_worker(&workers[index], &threads[index]);
+    }
+
+    task(context, 0);
+
+    /* Tasks without a worker are run in the calling thread. */
+    for (unsigned index = 1; index < tasks; index++) {
+        if (started[index]) {
+            join_worker(threads[index]);
+        } else {
+            task(context, index);
+        }
+    }
+}
+
+#else
+
+void parallel_run(parallel_task_t task, void *context, unsigned tasks) {
+
+    for (unsigned index = 0; index < tasks; index++) {
+        task(context, index);
+    }
+}
+
+#endif
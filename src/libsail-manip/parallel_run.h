@@ -0,0 +1,52 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SAIL_PARALLEL_RUN_H
+#define SAIL_PARALLEL_RUN_H
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+#else
+    #include <sail-common/export.h>
+#endif
+
+/*
+ * Parallel execution of conversion bands. There is no persistent pool: worker threads are started
+ * for every parallel_run() call and joined before it returns, so no threads outlive the call.
+ */
+
+/* Maximum number of tasks in a single parallel_run() call. */
+#define SAIL_PARALLEL_RUN_MAX_TASKS 64
+
+typedef void (*parallel_task_t)(void *context, unsigned index);
+
+/*
+ * Runs task(context, 0) ... task(context, tasks - 1) in parallel and waits for all of them
+ * to finish. Every task runs in its own thread, task 0 in the calling thread. If workers cannot
+ * be started, or SAIL is built without SAIL_THREAD_SAFE, the tasks are run sequentially
+ * in the calling thread.
+ */
+SAIL_HIDDEN void parallel_run(parallel_task_t task, void *context, unsigned tasks);
+
+#endif
@@ -0,0 +1,387 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "sail-manip.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SAIL_ROTATE_SSE2
+    #include <emmintrin.h>
+#endif
+
+/*
+ * Private functions.
+ */
+
+/*
+ * Pixels are transposed in square tiles of this size. Transposing reads the input columns,
+ * and a tile keeps all the input rows it touches in the cache.
+ */
+#define TILE_SIZE 64
+
+#if defined(SAIL_ROTATE_SSE2)
+
+/* 8x8 blocks of 8-bit pixels. */
+static inline void transpose_block8(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride) {
+
+    __m128i r[8];
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = _mm_loadl_epi64((const __m128i *)(input + input_stride * (ptrdiff_t)i));
+    }
+
+    const __m128i a0 = _mm_unpacklo_epi8(r[0], r[1]);
+    const __m128i a1 = _mm_unpacklo_epi8(r[2], r[3]);
+    const __m128i a2 = _mm_unpacklo_epi8(r[4], r[5]);
+    const __m128i a3 = _mm_unpacklo_epi8(r[6], r[7]);
+
+    const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+
+    /* Every vector holds two output rows. */
+    const __m128i c[4] = {
+        _mm_unpacklo_epi32(b0, b2),
+        _mm_unpackhi_epi32(b0, b2),
+        _mm_unpacklo_epi32(b1, b3),
+        _mm_unpackhi_epi32(b1, b3),
+    };
+
+    for (unsigned i = 0; i < 4; i++) {
+        _mm_storel_epi64((__m128i *)(output + output_stride * (ptrdiff_t)(i * 2)),     c[i]);
+        _mm_storel_epi64((__m128i *)(output + output_stride * (ptrdiff_t)(i * 2 + 1)), _mm_srli_si128(c[i], 8));
+    }
+}
+
+/* 8x8 blocks of 16-bit pixels. */
+static inline void transpose_block16(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride) {
+
+    __m128i r[8];
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = _mm_loadu_si128((const __m128i *)(input + input_stride * (ptrdiff_t)i));
+    }
+
+    __m128i a[8];
+    for (unsigned i = 0; i < 4; i++) {
+        a[i * 2]     = _mm_unpacklo_epi16(r[i * 2], r[i * 2 + 1]);
+        a[i * 2 + 1] = _mm_unpackhi_epi16(r[i * 2], r[i * 2 + 1]);
+    }
+
+    const __m128i b[8] = {
+        _mm_unpacklo_epi32(a[0], a[2]),
+        _mm_unpackhi_epi32(a[0], a[2]),
+        _mm_unpacklo_epi32(a[1], a[3]),
+        _mm_unpackhi_epi32(a[1], a[3]),
+        _mm_unpacklo_epi32(a[4], a[6]),
+        _mm_unpackhi_epi32(a[4], a[6]),
+        _mm_unpacklo_epi32(a[5], a[7]),
+        _mm_unpackhi_epi32(a[5], a[7]),
+    };
+
+    for (unsigned i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(output + output_stride * (ptrdiff_t)(i * 2)),     _mm_unpacklo_epi64(b[i], b[i + 4]));
+        _mm_storeu_si128((__m128i *)(output + output_stride * (ptrdiff_t)(i * 2 + 1)), _mm_unpackhi_epi64(b[i], b[i + 4]));
+    }
+}
+
+/* 4x4 blocks of 32-bit pixels. */
+static inline void transpose_block32(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride) {
+
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(input));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(input + input_stride));
+    const __m128i r2 = _mm_loadu_si128((const __m128i *)(input + input_stride * 2));
+    const __m128i r3 = _mm_loadu_si128((const __m128i *)(input + input_stride * 3));
+
+    const __m128i a0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i a1 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i a2 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i a3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128((__m128i *)(output),                     _mm_unpacklo_epi64(a0, a1));
+    _mm_storeu_si128((__m128i *)(output + output_stride),     _mm_unpackhi_epi64(a0, a1));
+    _mm_storeu_si128((__m128i *)(output + output_stride * 2), _mm_unpacklo_epi64(a2, a3));
+    _mm_storeu_si128((__m128i *)(output + output_stride * 3), _mm_unpackhi_epi64(a2, a3));
+}
+
+/* 2x2 blocks of 64-bit pixels. */
+static inline void transpose_block64(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride) {
+
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(input));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(input + input_stride));
+
+    _mm_storeu_si128((__m128i *)(output),                 _mm_unpacklo_epi64(r0, r1));
+    _mm_storeu_si128((__m128i *)(output + output_stride), _mm_unpackhi_epi64(r0, r1));
+}
+
+#endif
+
+/* Returns the size of SIMD blocks for the pixel size, or 0 if there are no SIMD blocks. */
+static inline unsigned block_size(unsigned bytes_per_pixel) {
+
+#if defined(SAIL_ROTATE_SSE2)
+    switch (bytes_per_pixel) {
+        case 1: return 8;
+        case 2: return 8;
+        case 4: return 4;
+        case 8: return 2;
+    }
+#else
+    (void)bytes_per_pixel;
+#endif
+
+    return 0;
+}
+
+static inline void transpose_block(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride, unsigned bytes_per_pixel) {
+
+#if defined(SAIL_ROTATE_SSE2)
+    switch (bytes_per_pixel) {
+        case 1: transpose_block8(input, input_stride, output, output_stride);  break;
+        case 2: transpose_block16(input, input_stride, output, output_stride); break;
+        case 4: transpose_block32(input, input_stride, output, output_stride); break;
+        case 8: transpose_block64(input, input_stride, output, output_stride); break;
+    }
+#else
+    (void)input;
+    (void)input_stride;
+    (void)output;
+    (void)output_stride;
+    (void)bytes_per_pixel;
+#endif
+}
+
+/* Transposes the input rows [y0, y1) and columns [x0, x1) pixel by pixel. */
+static inline void transpose_pixels_scalar(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride,
+                                           unsigned x0, unsigned x1, unsigned y0, unsigned y1, unsigned bytes_per_pixel) {
+
+    for (unsigned x = x0; x < x1; x++) {
+        const uint8_t *pixel = input + input_stride * (ptrdiff_t)y0 + (ptrdiff_t)x * bytes_per_pixel;
+        uint8_t *scan = output + output_stride * (ptrdiff_t)x + (ptrdiff_t)y0 * bytes_per_pixel;
+
+        for (unsigned y = y0; y < y1; y++, pixel += input_stride, scan += bytes_per_pixel) {
+            memcpy(scan, pixel, bytes_per_pixel);
+        }
+    }
+}
+
+/*
+ * Transposes width x height input pixels into height x width output pixels tile by tile.
+ * Strides are in bytes. Negative strides walk the rows upwards, which turns transposing
+ * into rotating. The pixel size is a constant in every caller.
+ */
+static inline void transpose_tiles(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride,
+                                   unsigned width, unsigned height, unsigned bytes_per_pixel) {
+
+    const unsigned block = block_size(bytes_per_pixel);
+
+    for (unsigned tile_y = 0; tile_y < height; tile_y += TILE_SIZE) {
+        const unsigned last_y = SAIL_MIN(tile_y + TILE_SIZE, height);
+
+        for (unsigned tile_x = 0; tile_x < width; tile_x += TILE_SIZE) {
+            const unsigned last_x = SAIL_MIN(tile_x + TILE_SIZE, width);
+
+            unsigned blocks_x = tile_x;
+            unsigned blocks_y = tile_y;
+
+            if (block > 0) {
+                blocks_x = tile_x + (last_x - tile_x) / block * block;
+                blocks_y = tile_y + (last_y - tile_y) / block * block;
+
+                for (unsigned y = tile_y; y < blocks_y; y += block) {
+                    for (unsigned x = tile_x; x < blocks_x; x += block) {
+                        transpose_block(input + input_stride * (ptrdiff_t)y + (ptrdiff_t)x * bytes_per_pixel, input_stride,
+                                        output + output_stride * (ptrdiff_t)x + (ptrdiff_t)y * bytes_per_pixel, output_stride,
+                                        bytes_per_pixel);
+                    }
+                }
+            }
+
+            /* The right and the bottom edges of the image. */
+            transpose_pixels_scalar(input, input_stride, output, output_stride, blocks_x, last_x, tile_y, blocks_y, bytes_per_pixel);
+            transpose_pixels_scalar(input, input_stride, output, output_stride, tile_x, last_x, blocks_y, last_y, bytes_per_pixel);
+        }
+    }
+}
+
+static void transpose_pixels(const uint8_t *input, ptrdiff_t input_stride, uint8_t *output, ptrdiff_t output_stride,
+                             unsigned width, unsigned height, unsigned bytes_per_pixel) {
+
+    /* Specialize the most common pixel sizes. */
+    switch (bytes_per_pixel) {
+        case 1: transpose_tiles(input, input_stride, output, output_stride, width, height, 1); break;
+        case 2: transpose_tiles(input, input_stride, output, output_stride, width, height, 2); break;
+        case 3: transpose_tiles(input, input_stride, output, output_stride, width, height, 3); break;
+        case 4: transpose_tiles(input, input_stride, output, output_stride, width, height, 4); break;
+        case 6: transpose_tiles(input, input_stride, output, output_stride, width, height, 6); break;
+        case 8: transpose_tiles(input, input_stride, output, output_stride, width, height, 8); break;
+
+        default: {
+            transpose_tiles(input, input_stride, output, output_stride, width, height, bytes_per_pixel);
+        }
+    }
+}
+
+/* Copies the input rows bottom to top reversing every row. */
+static inline void reverse_rows(const struct sail_image *image, struct sail_image *image_output, unsigned bytes_per_pixel) {
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *pixel = (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * (image->height - 1 - row)
+                                    + (size_t)(image->width - 1) * bytes_per_pixel;
+        uint8_t *scan = (uint8_t *)image_output->pixels + (size_t)image_output->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, pixel -= bytes_per_pixel, scan += bytes_per_pixel) {
+            memcpy(scan, pixel, bytes_per_pixel);
+        }
+    }
+}
+
+static void rotate_pixels_180(const struct sail_image *image, struct sail_image *image_output, unsigned bytes_per_pixel) {
+
+    switch (bytes_per_pixel) {
+        case 1: reverse_rows(image, image_output, 1); break;
+        case 2: reverse_rows(image, image_output, 2); break;
+        case 3: reverse_rows(image, image_output, 3); break;
+        case 4: reverse_rows(image, image_output, 4); break;
+        case 6: reverse_rows(image, image_output, 6); break;
+        case 8: reverse_rows(image, image_output, 8); break;
+
+        default: {
+            reverse_rows(image, image_output, bytes_per_pixel);
+        }
+    }
+}
+
+/* Allocates the output image with the swapped dimensions and resolution when needed. */
+static sail_status_t alloc_rotated_image(const struct sail_image *image, bool swap_dimensions,
+                                         unsigned *bytes_per_pixel, struct sail_image **image_output) {
+
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(image_output);
+
+    if (!sail_can_rotate(image->pixel_format)) {
+        SAIL_LOG_ERROR("Rotating %s pixel format is not supported", sail_pixel_format_to_string(image->pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_copy_image_skeleton(image, &image_local));
+
+    if (swap_dimensions) {
+        image_local->width  = image->height;
+        image_local->height = image->width;
+
+        if (image_local->resolution != NULL) {
+            const double x = image_local->resolution->x;
+            image_local->resolution->x = image_local->resolution->y;
+            image_local->resolution->y = x;
+        }
+    }
+
+    image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)image_local->bytes_per_line * image_local->height, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    *bytes_per_pixel = sail_bits_per_pixel(image->pixel_format) / 8;
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_rotate_image(const struct sail_image *image,
+                                enum SailRotation rotation,
+                                struct sail_image **image_output) {
+
+    if (rotation != SAIL_ROTATION_90 && rotation != SAIL_ROTATION_180 && rotation != SAIL_ROTATION_270) {
+        SAIL_LOG_ERROR("Unknown rotation %d", rotation);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    struct sail_image *image_local;
+    unsigned bytes_per_pixel;
+    SAIL_TRY(alloc_rotated_image(image, rotation != SAIL_ROTATION_180, &bytes_per_pixel, &image_local));
+
+    const uint8_t *pixels = image->pixels;
+    const ptrdiff_t bytes_per_line = image->bytes_per_line;
+    uint8_t *pixels_output = image_local->pixels;
+    const ptrdiff_t bytes_per_line_output = image_local->bytes_per_line;
+
+    switch (rotation) {
+        /* Transpose the input read bottom to top. */
+        case SAIL_ROTATION_90: {
+            transpose_pixels(pixels + bytes_per_line * (ptrdiff_t)(image->height - 1), -bytes_per_line,
+                             pixels_output, bytes_per_line_output,
+                             image->width, image->height, bytes_per_pixel);
+            break;
+        }
+        case SAIL_ROTATION_180: {
+            rotate_pixels_180(image, image_local, bytes_per_pixel);
+            break;
+        }
+        /* Transpose the input and write the output bottom to top. */
+        case SAIL_ROTATION_270: {
+            transpose_pixels(pixels, bytes_per_line,
+                             pixels_output + bytes_per_line_output * (ptrdiff_t)(image_local->height - 1), -bytes_per_line_output,
+                             image->width, image->height, bytes_per_pixel);
+            break;
+        }
+    }
+
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_transpose_image(const struct sail_image *image, struct sail_image **image_output) {
+
+    struct sail_image *image_local;
+    unsigned bytes_per_pixel;
+    SAIL_TRY(alloc_rotated_image(image, true, &bytes_per_pixel, &image_local));
+
+    transpose_pixels(image->pixels, image->bytes_per_line,
+                     image_local->pixels, image_local->bytes_per_line,
+                     image->width, image->height, bytes_per_pixel);
+
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+bool sail_can_rotate(enum SailPixelFormat pixel_format) {
+
+    const unsigned bits_per_pixel = sail_bits_per_pixel(pixel_format);
+
+    return bits_per_pixel != 0 && bits_per_pixel % 8 == 0;
+}
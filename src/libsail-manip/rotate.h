@@ -0,0 +1,90 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_ROTATE_H
+#define SAIL_ROTATE_H
+
+#include <stdbool.h>
+
+#ifdef SAIL_BUILD
+    #include "common.h"
+    #include "error.h"
+    #include "export.h"
+
+    #include "manip_common.h"
+#else
+    #include <sail-common/common.h>
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+
+    #include <sail-manip/manip_common.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_image;
+
+/*
+ * Rotates the input image clockwise by the specified angle and saves the result in the output image.
+ *
+ * The resulting image gets swapped dimensions and resolution when rotated by 90 or 270 degrees,
+ * and updated bytes per line. Other properties are copied from the original image.
+ *
+ * Allowed input pixel formats:
+ *   - Pixel formats with 8 bits per pixel or more. See sail_can_rotate().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_rotate_image(const struct sail_image *image,
+                                            enum SailRotation rotation,
+                                            struct sail_image **image_output);
+
+/*
+ * Transposes the input image, i.e. flips it over its main diagonal, and saves the result
+ * in the output image.
+ *
+ * The resulting image gets swapped dimensions and resolution, and updated bytes per line.
+ * Other properties are copied from the original image.
+ *
+ * Allowed input pixel formats:
+ *   - Pixel formats with 8 bits per pixel or more. See sail_can_rotate().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_transpose_image(const struct sail_image *image, struct sail_image **image_output);
+
+/*
+ * Returns true if the rotation and transposition functions can process images of the specified pixel format.
+ */
+SAIL_EXPORT bool sail_can_rotate(enum SailPixelFormat pixel_format);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
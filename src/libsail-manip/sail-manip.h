@@ -36,6 +36,10 @@
     #include "convert.h"
     #include "manip_common.h"
     #include "manip_utils.h"
+    #include "parallel_run.h"
+    #include "rotate.h"
+    #include "scale.h"
+    #include "swizzle.h"
     #include "ycbcr.h"
     #include "ycck.h"
 #else
@@ -44,6 +48,8 @@
     #include <sail-manip/conversion_options.h>
     #include <sail-manip/convert.h>
     #include <sail-manip/manip_common.h>
+    #include <sail-manip/rotate.h>
+    #include <sail-manip/scale.h>
 #endif
 
 #endif
@@ -0,0 +1,1126 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "sail-manip.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SAIL_SCALE_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #define SAIL_SCALE_NEON
+    #include <arm_neon.h>
+#endif
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+/*
+ * Private functions.
+ */
+
+/*
+ * Filter weights are 16-bit fixed-point numbers with this number of fractional bits.
+ * 16-bit weights multiplied by 8-bit components map to SIMD multiply-add instructions,
+ * and sums of 16-bit components still fit 32 bits.
+ */
+#define SCALE_PRECISION_BITS 14
+
+static const int32_t SCALE_ONE   = (int32_t)1 << SCALE_PRECISION_BITS;
+static const int32_t SCALE_ROUND = (int32_t)1 << (SCALE_PRECISION_BITS - 1);
+
+/*
+ * Images downscaled more than twice this gap are reduced by integer factors first
+ * by averaging blocks of pixels. The filters then resample at most 2x-4x, which keeps
+ * the number of taps and the weights precision reasonable.
+ */
+static const unsigned REDUCING_GAP = 2;
+
+/* Maximum reducing factor to keep the block sums within 32 bits. */
+static const unsigned MAX_REDUCING_FACTOR = 256;
+
+/* Passes smaller than this number of operations are run in a single band. */
+static const size_t MIN_OPERATIONS_PER_BAND = 1024 * 1024;
+
+typedef double (*scale_filter_t)(double x);
+
+static double box_filter(double x) {
+
+    return (x > -0.5 && x <= 0.5) ? 1.0 : 0.0;
+}
+
+static double bilinear_filter(double x) {
+
+    x = fabs(x);
+
+    return (x < 1.0) ? 1.0 - x : 0.0;
+}
+
+static double sinc(double x) {
+
+    if (x == 0.0) {
+        return 1.0;
+    }
+
+    x *= M_PI;
+
+    return sin(x) / x;
+}
+
+static double lanczos3_filter(double x) {
+
+    return (x > -3.0 && x < 3.0) ? sinc(x) * sinc(x / 3.0) : 0.0;
+}
+
+static sail_status_t filter_from_algorithm(enum SailScaling algorithm, scale_filter_t *filter, double *support) {
+
+    switch (algorithm) {
+        case SAIL_SCALING_BOX:      *filter = box_filter;      *support = 0.5; return SAIL_OK;
+        case SAIL_SCALING_BILINEAR: *filter = bilinear_filter; *support = 1.0; return SAIL_OK;
+        case SAIL_SCALING_LANCZOS3: *filter = lanczos3_filter; *support = 3.0; return SAIL_OK;
+    }
+
+    SAIL_LOG_ERROR("Unknown scaling algorithm %d", algorithm);
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+}
+
+/*
+ * Returns the number of color components, their depth in bits, and the index
+ * of the alpha component or -1.
+ */
+static bool pixel_format_layout(enum SailPixelFormat pixel_format, unsigned *components, unsigned *depth, int *alpha) {
+
+    *alpha = -1;
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:        *components = 1; *depth = 8;  return true;
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:       *components = 1; *depth = 16; return true;
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA: *components = 2; *depth = 8;  *alpha = 1; return true;
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA: *components = 2; *depth = 16; *alpha = 1; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:
+        case SAIL_PIXEL_FORMAT_BPP24_BGR: *components = 3; *depth = 8; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:
+        case SAIL_PIXEL_FORMAT_BPP48_BGR: *components = 3; *depth = 16; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR: *components = 4; *depth = 8; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA: *components = 4; *depth = 8; *alpha = 3; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR: *components = 4; *depth = 8; *alpha = 0; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR: *components = 4; *depth = 16; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA: *components = 4; *depth = 16; *alpha = 3; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR: *components = 4; *depth = 16; *alpha = 0; return true;
+
+        default: {
+            return false;
+        }
+    }
+}
+
+/*
+ * Filter weights of a single pass. Every output pixel is a weighted sum of count[i]
+ * input pixels starting at first[i]. Weights of every output pixel sum up to SCALE_ONE
+ * and are stored with the fixed stride of taps, so passes loop over them without gaps.
+ */
+struct scale_coefficients {
+    unsigned taps;
+    unsigned *first;
+    unsigned *count;
+    int16_t *weights;
+};
+
+static void destroy_scale_coefficients(struct scale_coefficients *coefficients) {
+
+    sail_free(coefficients->weights);
+    sail_free(coefficients->count);
+    sail_free(coefficients->first);
+}
+
+static sail_status_t compute_scale_coefficients(unsigned input_size, unsigned output_size,
+                                                scale_filter_t filter, double support,
+                                                struct scale_coefficients *coefficients) {
+
+    const double scale        = (double)input_size / output_size;
+    /* Stretch the filter when downscaling to cover all the input pixels. */
+    const double filter_scale = SAIL_MAX(scale, 1.0);
+    const double radius       = support * filter_scale;
+
+    coefficients->taps    = (unsigned)ceil(radius) * 2 + 1;
+    coefficients->first   = NULL;
+    coefficients->count   = NULL;
+    coefficients->weights = NULL;
+
+    void *ptr;
+    double *kernel;
+    SAIL_TRY(sail_malloc(sizeof(double) * coefficients->taps, &ptr));
+    kernel = ptr;
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(unsigned) * output_size, &ptr),
+                        /* cleanup */ sail_free(kernel));
+    coefficients->first = ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(unsigned) * output_size, &ptr),
+                        /* cleanup */ sail_free(kernel),
+                                      destroy_scale_coefficients(coefficients));
+    coefficients->count = ptr;
+    SAIL_TRY_OR_CLEANUP(sail_calloc((size_t)output_size * coefficients->taps, sizeof(int16_t), &ptr),
+                        /* cleanup */ sail_free(kernel),
+                                      destroy_scale_coefficients(coefficients));
+    coefficients->weights = ptr;
+
+    for (unsigned output = 0; output < output_size; output++) {
+        const double center = (output + 0.5) * scale;
+
+        const double min = SAIL_MAX(center - radius + 0.5, 0.0);
+        const double max = SAIL_MIN(center + radius + 0.5, (double)input_size);
+
+        const unsigned first = (unsigned)min;
+        unsigned count = SAIL_MIN((unsigned)max - first, coefficients->taps);
+
+        double total = 0;
+
+        for (unsigned k = 0; k < count; k++) {
+            kernel[k] = filter((first + k - center + 0.5) / filter_scale);
+            total += kernel[k];
+        }
+
+        /* Upscaling with the box filter could miss all the input pixels at the edges. */
+        if (count == 0 || total == 0) {
+            kernel[0] = 1;
+            total = 1;
+            count = 1;
+        }
+
+        int16_t *weights = coefficients->weights + (size_t)output * coefficients->taps;
+        int32_t sum = 0;
+        unsigned largest = 0;
+
+        for (unsigned k = 0; k < count; k++) {
+            weights[k] = (int16_t)lround(kernel[k] / total * SCALE_ONE);
+            sum += weights[k];
+
+            if (weights[k] > weights[largest]) {
+                largest = k;
+            }
+        }
+
+        /* Rounding errors must not change the brightness. */
+        weights[largest] = (int16_t)(weights[largest] + SCALE_ONE - sum);
+
+        coefficients->first[output] = SAIL_MIN(first, input_size - count);
+        coefficients->count[output] = count;
+    }
+
+    sail_free(kernel);
+
+    return SAIL_OK;
+}
+
+static inline uint8_t clamp8(int32_t value) {
+
+    if (value <= 0) {
+        return 0;
+    }
+
+    value >>= SCALE_PRECISION_BITS;
+
+    return (value > UINT8_MAX) ? UINT8_MAX : (uint8_t)value;
+}
+
+static inline uint16_t clamp16(int32_t value) {
+
+    if (value <= 0) {
+        return 0;
+    }
+
+    value >>= SCALE_PRECISION_BITS;
+
+    return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value;
+}
+
+/*
+ * Horizontal passes. The number of components is a constant in every caller, so compilers
+ * unroll the innermost loop.
+ */
+static inline void scale_row8(const struct scale_coefficients *coefficients, const uint8_t *input,
+                              uint8_t *output, unsigned width, unsigned components) {
+
+    for (unsigned x = 0; x < width; x++, output += components) {
+        const uint8_t *pixel = input + (size_t)coefficients->first[x] * components;
+        const int16_t *weights = coefficients->weights + (size_t)x * coefficients->taps;
+        const unsigned count = coefficients->count[x];
+
+        int32_t sum[4] = { SCALE_ROUND, SCALE_ROUND, SCALE_ROUND, SCALE_ROUND };
+
+        for (unsigned k = 0; k < count; k++, pixel += components) {
+            for (unsigned c = 0; c < components; c++) {
+                sum[c] += weights[k] * (int16_t)pixel[c];
+            }
+        }
+
+        for (unsigned c = 0; c < components; c++) {
+            output[c] = clamp8(sum[c]);
+        }
+    }
+}
+
+static inline void scale_row16(const struct scale_coefficients *coefficients, const uint16_t *input,
+                               uint16_t *output, unsigned width, unsigned components) {
+
+    for (unsigned x = 0; x < width; x++, output += components) {
+        const uint16_t *pixel = input + (size_t)coefficients->first[x] * components;
+        const int16_t *weights = coefficients->weights + (size_t)x * coefficients->taps;
+        const unsigned count = coefficients->count[x];
+
+        int32_t sum[4] = { SCALE_ROUND, SCALE_ROUND, SCALE_ROUND, SCALE_ROUND };
+
+        for (unsigned k = 0; k < count; k++, pixel += components) {
+            for (unsigned c = 0; c < components; c++) {
+                sum[c] += weights[k] * (int32_t)pixel[c];
+            }
+        }
+
+        for (unsigned c = 0; c < components; c++) {
+            output[c] = clamp16(sum[c]);
+        }
+    }
+}
+
+#if defined(SAIL_SCALE_SSE2)
+/*
+ * Horizontal pass of 8-bit pixels with 4 components. Pairs of neighbor input pixels are interleaved
+ * component by component, so _mm_madd_epi16() multiplies them by pairs of weights at once.
+ */
+static void scale_row8x4(const struct scale_coefficients *coefficients, const uint8_t *input,
+                         uint8_t *output, unsigned width) {
+
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned x = 0; x < width; x++, output += 4) {
+        const uint8_t *pixel = input + (size_t)coefficients->first[x] * 4;
+        const int16_t *weights = coefficients->weights + (size_t)x * coefficients->taps;
+        const unsigned count = coefficients->count[x];
+
+        __m128i sum = _mm_set1_epi32(SCALE_ROUND);
+        unsigned k = 0;
+
+        for (; k + 2 <= count; k += 2, pixel += 8) {
+            const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)pixel), zero);
+            const __m128i pairs  = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+            const __m128i weight = _mm_set1_epi32((int32_t)((uint32_t)(uint16_t)weights[k] | ((uint32_t)(uint16_t)weights[k + 1] << 16)));
+
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, weight));
+        }
+
+        if (k < count) {
+            int32_t value;
+            memcpy(&value, pixel, sizeof(value));
+
+            const __m128i pairs  = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+            const __m128i weight = _mm_set1_epi32((uint16_t)weights[k]);
+
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, weight));
+        }
+
+        /* Saturating packs clamp the sums like clamp8(). */
+        const __m128i packed = _mm_packs_epi32(_mm_srai_epi32(sum, SCALE_PRECISION_BITS), zero);
+        const int32_t value = _mm_cvtsi128_si32(_mm_packus_epi16(packed, zero));
+        memcpy(output, &value, sizeof(value));
+    }
+}
+#elif defined(SAIL_SCALE_NEON)
+/* Horizontal pass of 8-bit pixels with 4 components. */
+static void scale_row8x4(const struct scale_coefficients *coefficients, const uint8_t *input,
+                         uint8_t *output, unsigned width) {
+
+    for (unsigned x = 0; x < width; x++, output += 4) {
+        const uint8_t *pixel = input + (size_t)coefficients->first[x] * 4;
+        const int16_t *weights = coefficients->weights + (size_t)x * coefficients->taps;
+        const unsigned count = coefficients->count[x];
+
+        int32x4_t sum = vdupq_n_s32(SCALE_ROUND);
+
+        for (unsigned k = 0; k < count; k++, pixel += 4) {
+            uint32_t value;
+            memcpy(&value, pixel, sizeof(value));
+
+            const int16x8_t components = vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value))));
+            sum = vmlal_n_s16(sum, vget_low_s16(components), weights[k]);
+        }
+
+        /* Saturating narrows clamp the sums like clamp8(). */
+        const uint16x4_t narrowed = vqmovun_s32(vshrq_n_s32(sum, SCALE_PRECISION_BITS));
+        const uint32_t value = vget_lane_u32(vreinterpret_u32_u8(vqmovn_u16(vcombine_u16(narrowed, narrowed))), 0);
+        memcpy(output, &value, sizeof(value));
+    }
+}
+#endif
+
+static void scale_row(const struct scale_coefficients *coefficients, const void *input, void *output,
+                      unsigned width, unsigned components, unsigned depth) {
+
+    if (depth == 8) {
+        switch (components) {
+            case 1: scale_row8(coefficients, input, output, width, 1); break;
+            case 2: scale_row8(coefficients, input, output, width, 2); break;
+            case 3: scale_row8(coefficients, input, output, width, 3); break;
+#if defined(SAIL_SCALE_SSE2) || defined(SAIL_SCALE_NEON)
+            case 4: scale_row8x4(coefficients, input, output, width); break;
+#else
+            case 4: scale_row8(coefficients, input, output, width, 4); break;
+#endif
+        }
+    } else {
+        switch (components) {
+            case 1: scale_row16(coefficients, input, output, width, 1); break;
+            case 2: scale_row16(coefficients, input, output, width, 2); break;
+            case 3: scale_row16(coefficients, input, output, width, 3); break;
+            case 4: scale_row16(coefficients, input, output, width, 4); break;
+        }
+    }
+}
+
+#if defined(SAIL_SCALE_SSE2)
+/*
+ * Vertical pass of 8-bit components in blocks of 16 with the sums kept in registers. Components
+ * are zero-extended into pairs of (component, 0) to multiply them by pairs of (weight, 0)
+ * with _mm_madd_epi16(). Returns the number of components scaled.
+ */
+static unsigned scale_column8_simd(const int16_t *weights, unsigned count,
+                                   const uint8_t *row, unsigned input_bytes_per_line,
+                                   uint8_t *output, unsigned length) {
+
+    const __m128i zero = _mm_setzero_si128();
+    unsigned i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i sum0 = _mm_set1_epi32(SCALE_ROUND);
+        __m128i sum1 = sum0;
+        __m128i sum2 = sum0;
+        __m128i sum3 = sum0;
+
+        const uint8_t *components = row + i;
+
+        for (unsigned k = 0; k < count; k++, components += input_bytes_per_line) {
+            const __m128i weight = _mm_set1_epi32((uint16_t)weights[k]);
+            const __m128i block  = _mm_loadu_si128((const __m128i *)components);
+            const __m128i low    = _mm_unpacklo_epi8(block, zero);
+            const __m128i high   = _mm_unpackhi_epi8(block, zero);
+
+            sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi16(low,  zero), weight));
+            sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi16(low,  zero), weight));
+            sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_unpacklo_epi16(high, zero), weight));
+            sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_unpackhi_epi16(high, zero), weight));
+        }
+
+        /* Saturating packs clamp the sums like clamp8(). */
+        const __m128i low  = _mm_packs_epi32(_mm_srai_epi32(sum0, SCALE_PRECISION_BITS), _mm_srai_epi32(sum1, SCALE_PRECISION_BITS));
+        const __m128i high = _mm_packs_epi32(_mm_srai_epi32(sum2, SCALE_PRECISION_BITS), _mm_srai_epi32(sum3, SCALE_PRECISION_BITS));
+
+        _mm_storeu_si128((__m128i *)(output + i), _mm_packus_epi16(low, high));
+    }
+
+    return i;
+}
+#elif defined(SAIL_SCALE_NEON)
+/*
+ * Vertical pass of 8-bit components in blocks of 8 with the sums kept in registers.
+ * Returns the number of components scaled.
+ */
+static unsigned scale_column8_simd(const int16_t *weights, unsigned count,
+                                   const uint8_t *row, unsigned input_bytes_per_line,
+                                   uint8_t *output, unsigned length) {
+
+    unsigned i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        int32x4_t sum0 = vdupq_n_s32(SCALE_ROUND);
+        int32x4_t sum1 = sum0;
+
+        const uint8_t *components = row + i;
+
+        for (unsigned k = 0; k < count; k++, components += input_bytes_per_line) {
+            const int16x8_t block = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(components)));
+
+            sum0 = vmlal_n_s16(sum0, vget_low_s16(block),  weights[k]);
+            sum1 = vmlal_n_s16(sum1, vget_high_s16(block), weights[k]);
+        }
+
+        /* Saturating narrows clamp the sums like clamp8(). */
+        const uint16x8_t narrowed = vcombine_u16(vqmovun_s32(vshrq_n_s32(sum0, SCALE_PRECISION_BITS)),
+                                                 vqmovun_s32(vshrq_n_s32(sum1, SCALE_PRECISION_BITS)));
+
+        vst1_u8(output + i, vqmovn_u16(narrowed));
+    }
+
+    return i;
+}
+#endif
+
+/*
+ * Vertical passes. Every input row is accumulated into a whole output row at once,
+ * so the loops over the row components are plain vectorizable loops. 8-bit components
+ * are scaled with SSE2 or NEON when available, and the loops only scale the remaining ones.
+ */
+static void scale_column8(const struct scale_coefficients *coefficients, unsigned y,
+                          const uint8_t *input, unsigned input_bytes_per_line,
+                          uint8_t *output, unsigned length, int32_t *sum) {
+
+    const int16_t *weights = coefficients->weights + (size_t)y * coefficients->taps;
+    const uint8_t *row = input + (size_t)coefficients->first[y] * input_bytes_per_line;
+
+#if defined(SAIL_SCALE_SSE2) || defined(SAIL_SCALE_NEON)
+    const unsigned start = scale_column8_simd(weights, coefficients->count[y], row, input_bytes_per_line, output, length);
+#else
+    const unsigned start = 0;
+#endif
+
+    for (unsigned i = start; i < length; i++) {
+        sum[i] = SCALE_ROUND;
+    }
+
+    for (unsigned k = 0; k < coefficients->count[y]; k++, row += input_bytes_per_line) {
+        const int16_t weight = weights[k];
+
+        for (unsigned i = start; i < length; i++) {
+            sum[i] += weight * (int16_t)row[i];
+        }
+    }
+
+    for (unsigned i = start; i < length; i++) {
+        output[i] = clamp8(sum[i]);
+    }
+}
+
+static void scale_column16(const struct scale_coefficients *coefficients, unsigned y,
+                           const uint8_t *input, unsigned input_bytes_per_line,
+                           uint16_t *output, unsigned length, int32_t *sum) {
+
+    const int16_t *weights = coefficients->weights + (size_t)y * coefficients->taps;
+    const uint8_t *row = input + (size_t)coefficients->first[y] * input_bytes_per_line;
+
+    for (unsigned i = 0; i < length; i++) {
+        sum[i] = SCALE_ROUND;
+    }
+
+    for (unsigned k = 0; k < coefficients->count[y]; k++, row += input_bytes_per_line) {
+        const int32_t weight = weights[k];
+        const uint16_t *row16 = (const uint16_t *)row;
+
+        for (unsigned i = 0; i < length; i++) {
+            sum[i] += weight * (int32_t)row16[i];
+        }
+    }
+
+    for (unsigned i = 0; i < length; i++) {
+        output[i] = clamp16(sum[i]);
+    }
+}
+
+/*
+ * A single pass over horizontal bands of rows. The horizontal pass scales the rows
+ * of the input image, the vertical pass produces the rows of the output image.
+ */
+struct scale_pass {
+    const struct scale_coefficients *coefficients;
+    bool vertical;
+    unsigned components;
+    unsigned depth;
+
+    const uint8_t *input;
+    unsigned input_bytes_per_line;
+    uint8_t *output;
+    unsigned output_bytes_per_line;
+    unsigned output_width;
+    unsigned rows;
+
+    unsigned bands;
+    /* Row accumulators of every band of the vertical pass. */
+    void *sums;
+};
+
+static void scale_band(void *context, unsigned index) {
+
+    const struct scale_pass *pass = context;
+
+    /* Spread the remainder rows over the bands. */
+    const unsigned first_row = (unsigned)((uint64_t)pass->rows * index / pass->bands);
+    const unsigned last_row = (unsigned)((uint64_t)pass->rows * (index + 1) / pass->bands);
+
+    const unsigned length = pass->output_width * pass->components;
+
+    for (unsigned row = first_row; row < last_row; row++) {
+        uint8_t *output = pass->output + (size_t)row * pass->output_bytes_per_line;
+
+        if (!pass->vertical) {
+            scale_row(pass->coefficients, pass->input + (size_t)row * pass->input_bytes_per_line, output,
+                      pass->output_width, pass->components, pass->depth);
+        } else if (pass->depth == 8) {
+            scale_column8(pass->coefficients, row, pass->input, pass->input_bytes_per_line,
+                          output, length, (int32_t *)pass->sums + (size_t)length * index);
+        } else {
+            scale_column16(pass->coefficients, row, pass->input, pass->input_bytes_per_line,
+                           (uint16_t *)output, length, (int32_t *)pass->sums + (size_t)length * index);
+        }
+    }
+}
+
+static unsigned bands_count(unsigned rows, unsigned output_width, unsigned taps, const struct sail_conversion_options *options) {
+
+    size_t count = (options == NULL || options->threads == 0) ? 1 : options->threads;
+
+    count = SAIL_MIN(count, (size_t)rows * output_width * taps / MIN_OPERATIONS_PER_BAND);
+    count = SAIL_MIN(count, (size_t)rows);
+    count = SAIL_MIN(count, (size_t)SAIL_PARALLEL_RUN_MAX_TASKS);
+
+    return (count == 0) ? 1 : (unsigned)count;
+}
+
+static sail_status_t run_scale_pass(struct scale_pass *pass, const struct sail_conversion_options *options) {
+
+    pass->bands = bands_count(pass->rows, pass->output_width, pass->coefficients->taps, options);
+    pass->sums  = NULL;
+
+    if (pass->vertical) {
+        SAIL_TRY(sail_malloc((size_t)pass->bands * pass->output_width * pass->components * sizeof(int32_t), &pass->sums));
+    }
+
+    if (pass->bands == 1) {
+        scale_band(pass, 0);
+    } else {
+        parallel_run(scale_band, pass, pass->bands);
+    }
+
+    sail_free(pass->sums);
+
+    return SAIL_OK;
+}
+
+/*
+ * Reduces images by integer factors averaging blocks of pixels. The last blocks
+ * are smaller when the dimensions are not multiples of the factors.
+ */
+struct reduce_pass {
+    const struct sail_image *image;
+    struct sail_image *image_output;
+    unsigned factor_x;
+    unsigned factor_y;
+    unsigned components;
+    unsigned depth;
+
+    unsigned bands;
+    /* Column sums of every band. */
+    uint32_t *sums;
+};
+
+static void reduce_band(void *context, unsigned index) {
+
+    const struct reduce_pass *pass = context;
+    const struct sail_image *image = pass->image;
+    struct sail_image *image_output = pass->image_output;
+    const unsigned components = pass->components;
+
+    const unsigned first_row = (unsigned)((uint64_t)image_output->height * index / pass->bands);
+    const unsigned last_row = (unsigned)((uint64_t)image_output->height * (index + 1) / pass->bands);
+
+    const unsigned length = image->width * components;
+    uint32_t *sums = pass->sums + (size_t)length * index;
+
+    for (unsigned row = first_row; row < last_row; row++) {
+        const unsigned input_row = row * pass->factor_y;
+        const unsigned rows = SAIL_MIN(pass->factor_y, image->height - input_row);
+
+        for (unsigned i = 0; i < length; i++) {
+            sums[i] = 0;
+        }
+
+        for (unsigned r = 0; r < rows; r++) {
+            const uint8_t *scan = (const uint8_t *)image->pixels + (size_t)(input_row + r) * image->bytes_per_line;
+
+            if (pass->depth == 8) {
+                for (unsigned i = 0; i < length; i++) {
+                    sums[i] += scan[i];
+                }
+            } else {
+                const uint16_t *scan16 = (const uint16_t *)scan;
+
+                for (unsigned i = 0; i < length; i++) {
+                    sums[i] += scan16[i];
+                }
+            }
+        }
+
+        uint8_t *scan_output = (uint8_t *)image_output->pixels + (size_t)row * image_output->bytes_per_line;
+
+        for (unsigned column = 0; column < image_output->width; column++) {
+            const unsigned input_column = column * pass->factor_x;
+            const unsigned columns = SAIL_MIN(pass->factor_x, image->width - input_column);
+            const uint32_t pixels = columns * rows;
+
+            for (unsigned c = 0; c < components; c++) {
+                uint32_t sum = pixels / 2;
+
+                for (unsigned k = 0; k < columns; k++) {
+                    sum += sums[(input_column + k) * components + c];
+                }
+
+                if (pass->depth == 8) {
+                    scan_output[column * components + c] = (uint8_t)(sum / pixels);
+                } else {
+                    ((uint16_t *)scan_output)[column * components + c] = (uint16_t)(sum / pixels);
+                }
+            }
+        }
+    }
+}
+
+static sail_status_t reduce_image(const struct sail_image *image, unsigned factor_x, unsigned factor_y,
+                                  unsigned components, unsigned depth, const struct sail_conversion_options *options,
+                                  struct sail_image **image_output) {
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_alloc_image(&image_local));
+
+    image_local->width          = (image->width + factor_x - 1) / factor_x;
+    image_local->height         = (image->height + factor_y - 1) / factor_y;
+    image_local->pixel_format   = image->pixel_format;
+    image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)image_local->bytes_per_line * image_local->height, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    struct reduce_pass pass = {
+        image, image_local,
+        factor_x, factor_y,
+        components, depth,
+        bands_count(image_local->height, image->width, factor_y, options),
+        NULL
+    };
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)pass.bands * image->width * components * sizeof(uint32_t), &ptr),
+                        /* cleanup */ sail_destroy_image(image_local));
+    pass.sums = ptr;
+
+    if (pass.bands == 1) {
+        reduce_band(&pass, 0);
+    } else {
+        parallel_run(reduce_band, &pass, pass.bands);
+    }
+
+    sail_free(pass.sums);
+
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+static unsigned reducing_factor(unsigned input_size, unsigned output_size) {
+
+    const unsigned factor = input_size / output_size / REDUCING_GAP;
+
+    return SAIL_MIN(factor, MAX_REDUCING_FACTOR);
+}
+
+/* Scales the pixels in a single direction into output_width x output_height pixels. */
+static sail_status_t scale_pixels(bool vertical,
+                                  const uint8_t *input, unsigned input_bytes_per_line, unsigned input_size,
+                                  uint8_t *output, unsigned output_bytes_per_line, unsigned output_width, unsigned output_height,
+                                  scale_filter_t filter, double support, unsigned components, unsigned depth,
+                                  const struct sail_conversion_options *options) {
+
+    struct scale_coefficients coefficients;
+    SAIL_TRY(compute_scale_coefficients(input_size, vertical ? output_height : output_width, filter, support, &coefficients));
+
+    struct scale_pass pass = {
+        &coefficients, vertical, components, depth,
+        input, input_bytes_per_line,
+        output, output_bytes_per_line,
+        output_width, output_height,
+        0, NULL
+    };
+
+    SAIL_TRY_OR_CLEANUP(run_scale_pass(&pass, options),
+                        /* cleanup */ destroy_scale_coefficients(&coefficients));
+
+    destroy_scale_coefficients(&coefficients);
+
+    return SAIL_OK;
+}
+
+static sail_status_t resample_image(const struct sail_image *image, struct sail_image *image_output,
+                                      scale_filter_t filter, double support, unsigned components, unsigned depth,
+                                      const struct sail_conversion_options *options) {
+
+    const bool scale_horizontally = image_output->width != image->width;
+    const bool scale_vertically = image_output->height != image->height;
+
+    if (!scale_horizontally || !scale_vertically) {
+        SAIL_TRY(scale_pixels(scale_vertically,
+                              image->pixels, image->bytes_per_line, scale_vertically ? image->height : image->width,
+                              image_output->pixels, image_output->bytes_per_line, image_output->width, image_output->height,
+                              filter, support, components, depth, options));
+        return SAIL_OK;
+    }
+
+    /*
+     * Vertical passes vectorize better than horizontal ones. When shrinking the height,
+     * scale vertically first to leave fewer rows for the horizontal pass.
+     */
+    const bool vertical_first = image_output->height < image->height;
+
+    const unsigned intermediate_width = vertical_first ? image->width : image_output->width;
+    const unsigned intermediate_height = vertical_first ? image_output->height : image->height;
+    const unsigned intermediate_bytes_per_line = intermediate_width * components * (depth / 8);
+
+    void *intermediate;
+    SAIL_TRY(sail_malloc((size_t)intermediate_bytes_per_line * intermediate_height, &intermediate));
+
+    SAIL_TRY_OR_CLEANUP(scale_pixels(vertical_first,
+                                     image->pixels, image->bytes_per_line, vertical_first ? image->height : image->width,
+                                     intermediate, intermediate_bytes_per_line, intermediate_width, intermediate_height,
+                                     filter, support, components, depth, options),
+                        /* cleanup */ sail_free(intermediate));
+
+    SAIL_TRY_OR_CLEANUP(scale_pixels(!vertical_first,
+                                     intermediate, intermediate_bytes_per_line, vertical_first ? image->width : image->height,
+                                     image_output->pixels, image_output->bytes_per_line, image_output->width, image_output->height,
+                                     filter, support, components, depth, options),
+                        /* cleanup */ sail_free(intermediate));
+
+    sail_free(intermediate);
+
+    return SAIL_OK;
+}
+
+static sail_status_t scale_image_impl(const struct sail_image *image, struct sail_image *image_output,
+                                      scale_filter_t filter, double support, unsigned components, unsigned depth,
+                                      const struct sail_conversion_options *options) {
+
+    const unsigned factor_x = reducing_factor(image->width, image_output->width);
+    const unsigned factor_y = reducing_factor(image->height, image_output->height);
+
+    if (factor_x < 2 && factor_y < 2) {
+        SAIL_TRY(resample_image(image, image_output, filter, support, components, depth, options));
+        return SAIL_OK;
+    }
+
+    struct sail_image *image_reduced;
+    SAIL_TRY(reduce_image(image, SAIL_MAX(factor_x, 1), SAIL_MAX(factor_y, 1), components, depth, options, &image_reduced));
+
+    if (image_reduced->width == image_output->width && image_reduced->height == image_output->height) {
+        memcpy(image_output->pixels, image_reduced->pixels, (size_t)image_reduced->bytes_per_line * image_reduced->height);
+    } else {
+        SAIL_TRY_OR_CLEANUP(resample_image(image_reduced, image_output, filter, support, components, depth, options),
+                            /* cleanup */ sail_destroy_image(image_reduced));
+    }
+
+    sail_destroy_image(image_reduced);
+
+    return SAIL_OK;
+}
+
+/*
+ * Colors of pixel formats with alpha are filtered premultiplied by alpha, so transparent
+ * pixels don't bleed their colors into the visible ones. 8-bit pixels are premultiplied
+ * into 16-bit ones to convert them back without losing precision.
+ */
+static enum SailPixelFormat premultiplied_pixel_format(enum SailPixelFormat pixel_format) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA: return SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA;
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:            return SAIL_PIXEL_FORMAT_BPP64_RGBA;
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:            return SAIL_PIXEL_FORMAT_BPP64_BGRA;
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:            return SAIL_PIXEL_FORMAT_BPP64_ARGB;
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:            return SAIL_PIXEL_FORMAT_BPP64_ABGR;
+
+        default: {
+            return pixel_format;
+        }
+    }
+}
+
+static void premultiply_row8(const uint8_t *input, uint16_t *output, unsigned width, unsigned components, unsigned alpha) {
+
+    for (unsigned x = 0; x < width; x++, input += components, output += components) {
+        const uint32_t a = input[alpha];
+
+        for (unsigned c = 0; c < components; c++) {
+            output[c] = (uint16_t)((c == alpha) ? a * 257 : (input[c] * a * 257 + 127) / 255);
+        }
+    }
+}
+
+static void premultiply_row16(const uint16_t *input, uint16_t *output, unsigned width, unsigned components, unsigned alpha) {
+
+    for (unsigned x = 0; x < width; x++, input += components, output += components) {
+        const uint32_t a = input[alpha];
+
+        for (unsigned c = 0; c < components; c++) {
+            output[c] = (uint16_t)((c == alpha) ? a : (input[c] * a + 32767) / 65535);
+        }
+    }
+}
+
+static void unpremultiply_row8(const uint16_t *input, uint8_t *output, unsigned width, unsigned components, unsigned alpha) {
+
+    for (unsigned x = 0; x < width; x++, input += components, output += components) {
+        const uint32_t a = input[alpha];
+        const uint8_t a8 = (uint8_t)((a + 128) / 257);
+
+        for (unsigned c = 0; c < components; c++) {
+            /* Filters with negative lobes may produce colors above alpha. */
+            output[c] = (c == alpha) ? a8 : (a8 == 0) ? 0 : (uint8_t)SAIL_MIN((input[c] * 255U + a / 2) / a, 255U);
+        }
+    }
+}
+
+static void unpremultiply_row16(const uint16_t *input, uint16_t *output, unsigned width, unsigned components, unsigned alpha) {
+
+    for (unsigned x = 0; x < width; x++, input += components, output += components) {
+        const uint32_t a = input[alpha];
+
+        for (unsigned c = 0; c < components; c++) {
+            output[c] = (c == alpha) ? (uint16_t)a : (a == 0) ? 0 : (uint16_t)SAIL_MIN((input[c] * 65535U + a / 2) / a, 65535U);
+        }
+    }
+}
+
+/*
+ * Premultiplies the image into the 16-bit output image, or converts the premultiplied 16-bit
+ * image back into the output image. The images may be the same.
+ */
+struct alpha_pass {
+    const struct sail_image *image;
+    struct sail_image *image_output;
+    bool premultiply;
+    unsigned components;
+    unsigned depth;
+    unsigned alpha;
+
+    unsigned bands;
+};
+
+static void alpha_band(void *context, unsigned index) {
+
+    const struct alpha_pass *pass = context;
+    const struct sail_image *image = pass->image;
+    struct sail_image *image_output = pass->image_output;
+
+    const unsigned first_row = (unsigned)((uint64_t)image->height * index / pass->bands);
+    const unsigned last_row = (unsigned)((uint64_t)image->height * (index + 1) / pass->bands);
+
+    for (unsigned row = first_row; row < last_row; row++) {
+        const uint8_t *scan = (const uint8_t *)image->pixels + (size_t)row * image->bytes_per_line;
+        uint8_t *scan_output = (uint8_t *)image_output->pixels + (size_t)row * image_output->bytes_per_line;
+
+        if (pass->premultiply) {
+            if (pass->depth == 8) {
+                premultiply_row8(scan, (uint16_t *)scan_output, image->width, pass->components, pass->alpha);
+            } else {
+                premultiply_row16((const uint16_t *)scan, (uint16_t *)scan_output, image->width, pass->components, pass->alpha);
+            }
+        } else {
+            if (pass->depth == 8) {
+                unpremultiply_row8((const uint16_t *)scan, scan_output, image->width, pass->components, pass->alpha);
+            } else {
+                unpremultiply_row16((const uint16_t *)scan, (uint16_t *)scan_output, image->width, pass->components, pass->alpha);
+            }
+        }
+    }
+}
+
+static void run_alpha_pass(const struct sail_image *image, struct sail_image *image_output, bool premultiply,
+                           unsigned components, unsigned depth, unsigned alpha,
+                           const struct sail_conversion_options *options) {
+
+    struct alpha_pass pass = {
+        image, image_output, premultiply,
+        components, depth, alpha,
+        bands_count(image->height, image->width, components, options)
+    };
+
+    if (pass.bands == 1) {
+        alpha_band(&pass, 0);
+    } else {
+        parallel_run(alpha_band, &pass, pass.bands);
+    }
+}
+
+static sail_status_t alloc_premultiplied_image(unsigned width, unsigned height, enum SailPixelFormat pixel_format,
+                                               struct sail_image **image) {
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_alloc_image(&image_local));
+
+    image_local->width          = width;
+    image_local->height         = height;
+    image_local->pixel_format   = premultiplied_pixel_format(pixel_format);
+    image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)image_local->bytes_per_line * image_local->height, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+/* Scales the image premultiplied by alpha. 16-bit images are converted back in place. */
+static sail_status_t scale_premultiplied_image(const struct sail_image *image, struct sail_image *image_output,
+                                               scale_filter_t filter, double support,
+                                               unsigned components, unsigned depth, unsigned alpha,
+                                               const struct sail_conversion_options *options) {
+
+    struct sail_image *image_premultiplied;
+    SAIL_TRY(alloc_premultiplied_image(image->width, image->height, image->pixel_format, &image_premultiplied));
+
+    run_alpha_pass(image, image_premultiplied, true /* premultiply */, components, depth, alpha, options);
+
+    /* 8-bit images are scaled into a 16-bit image and converted back. */
+    struct sail_image *image_scaled_wide = NULL;
+
+    if (depth == 8) {
+        SAIL_TRY_OR_CLEANUP(alloc_premultiplied_image(image_output->width, image_output->height, image_output->pixel_format, &image_scaled_wide),
+                            /* cleanup */ sail_destroy_image(image_premultiplied));
+    }
+
+    struct sail_image *image_scaled = (image_scaled_wide != NULL) ? image_scaled_wide : image_output;
+
+    SAIL_TRY_OR_CLEANUP(scale_image_impl(image_premultiplied, image_scaled, filter, support, components, 16, options),
+                        /* cleanup */ sail_destroy_image(image_scaled_wide),
+                                      sail_destroy_image(image_premultiplied));
+
+    sail_destroy_image(image_premultiplied);
+
+    run_alpha_pass(image_scaled, image_output, false /* premultiply */, components, depth, alpha, options);
+
+    sail_destroy_image(image_scaled_wide);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_scale_image(const struct sail_image *image,
+                               unsigned width,
+                               unsigned height,
+                               enum SailScaling algorithm,
+                               struct sail_image **image_output) {
+
+    SAIL_TRY(sail_scale_image_with_options(image, width, height, algorithm, NULL /* options */, image_output));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_scale_image_with_options(const struct sail_image *image,
+                                            unsigned width,
+                                            unsigned height,
+                                            enum SailScaling algorithm,
+                                            const struct sail_conversion_options *options,
+                                            struct sail_image **image_output) {
+
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(image_output);
+
+    if (width == 0 || height == 0) {
+        SAIL_LOG_ERROR("Cannot scale to %ux%u", width, height);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    unsigned components;
+    unsigned depth;
+    int alpha;
+
+    if (!pixel_format_layout(image->pixel_format, &components, &depth, &alpha)) {
+        SAIL_LOG_ERROR("Scaling %s pixel format is not supported", sail_pixel_format_to_string(image->pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    scale_filter_t filter;
+    double support;
+    SAIL_TRY(filter_from_algorithm(algorithm, &filter, &support));
+
+    if (width == image->width && height == image->height) {
+        SAIL_TRY(sail_copy_image(image, image_output));
+        return SAIL_OK;
+    }
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_copy_image_skeleton(image, &image_local));
+
+    image_local->width = width;
+    image_local->height = height;
+    image_local->bytes_per_line = sail_bytes_per_line(width, image_local->pixel_format);
+
+    const size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    if (alpha < 0) {
+        SAIL_TRY_OR_CLEANUP(scale_image_impl(image, image_local, filter, support, components, depth, options),
+                            /* cleanup */ sail_destroy_image(image_local));
+    } else {
+        SAIL_TRY_OR_CLEANUP(scale_premultiplied_image(image, image_local, filter, support, components, depth, (unsigned)alpha, options),
+                            /* cleanup */ sail_destroy_image(image_local));
+    }
+
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+bool sail_can_scale(enum SailPixelFormat pixel_format) {
+
+    unsigned components;
+    unsigned depth;
+    int alpha;
+
+    return pixel_format_layout(pixel_format, &components, &depth, &alpha);
+}
@@ -0,0 +1,119 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_SCALE_H
+#define SAIL_SCALE_H
+
+#include <stdbool.h>
+
+#ifdef SAIL_BUILD
+    #include "common.h"
+    #include "error.h"
+    #include "export.h"
+
+    #include "manip_common.h"
+#else
+    #include <sail-common/common.h>
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+
+    #include <sail-manip/manip_common.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_conversion_options;
+struct sail_image;
+
+/*
+ * Scales the input image to the specified dimensions with the specified filter
+ * and saves the result in the output image.
+ *
+ * The image is resampled in two separable passes, horizontal and vertical, with fixed-point
+ * filter weights. Colors of pixel formats with alpha are premultiplied by alpha before filtering
+ * and divided by the filtered alpha afterwards, so transparent pixels don't bleed their colors
+ * into the visible ones. 8-bit pixels are filtered as 16-bit ones in this case.
+ *
+ * When downscaling more than four times, the image is first reduced by an integer factor
+ * by averaging blocks of pixels, and the filter resamples the rest. This is much faster
+ * and the result is visually the same.
+ *
+ * The resulting image gets the new dimensions and bytes per line. Other properties are copied from
+ * the original image.
+ *
+ * Allowed pixel formats:
+ *   - SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE
+ *   - SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE
+ *   - SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA
+ *   - SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA
+ *
+ *   - SAIL_PIXEL_FORMAT_BPP24_RGB
+ *   - SAIL_PIXEL_FORMAT_BPP24_BGR
+ *
+ *   - SAIL_PIXEL_FORMAT_BPP48_RGB
+ *   - SAIL_PIXEL_FORMAT_BPP48_BGR
+ *
+ *   - SAIL_PIXEL_FORMAT_BPP32_RGBX and other 32-bit RGB pixel formats
+ *   - SAIL_PIXEL_FORMAT_BPP64_RGBX and other 64-bit RGB pixel formats
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_scale_image(const struct sail_image *image,
+                                           unsigned width,
+                                           unsigned height,
+                                           enum SailScaling algorithm,
+                                           struct sail_image **image_output);
+
+/*
+ * Scales the input image to the specified dimensions with the specified filter
+ * and saves the result in the output image.
+ *
+ * Options (which may be NULL) control the number of threads to scale the image with.
+ * Other options are ignored. Rows are split into horizontal bands scaled in parallel.
+ *
+ * See sail_scale_image() for the allowed pixel formats.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_scale_image_with_options(const struct sail_image *image,
+                                                        unsigned width,
+                                                        unsigned height,
+                                                        enum SailScaling algorithm,
+                                                        const struct sail_conversion_options *options,
+                                                        struct sail_image **image_output);
+
+/*
+ * Returns true if the scaling functions can scale images of the specified pixel format.
+ */
+SAIL_EXPORT bool sail_can_scale(enum SailPixelFormat pixel_format);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
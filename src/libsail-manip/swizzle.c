@@ -0,0 +1,282 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail-manip.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define SAIL_SWIZZLE_X86
+    #define SAIL_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define SAIL_SWIZZLE_X86
+    #define SAIL_TARGET(isa)
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #define SAIL_SWIZZLE_NEON
+#endif
+
+#if defined(SAIL_SWIZZLE_X86)
+    #include <immintrin.h>
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#elif defined(SAIL_SWIZZLE_NEON)
+    #include <arm_neon.h>
+#endif
+
+/*
+ * Private functions.
+ */
+
+#if defined(SAIL_SWIZZLE_X86) || defined(SAIL_SWIZZLE_NEON)
+/*
+ * Returns the highest SIMD level allowed by the SAIL_FORCE_SIMD environment variable:
+ * 0 for "none", 1 for "ssse3" on x86 or "neon" on AArch64, 2 for "avx2" on x86. Allows testing
+ * every implementation on the same CPU. Other values don't limit the level.
+ */
+static int max_simd_level(void) {
+
+    const char *simd = getenv("SAIL_FORCE_SIMD");
+
+    if (simd == NULL || *simd == '\0') {
+        return INT_MAX;
+    } else if (strcmp(simd, "none") == 0) {
+        return 0;
+#if defined(SAIL_SWIZZLE_X86)
+    } else if (strcmp(simd, "ssse3") == 0) {
+        return 1;
+    } else if (strcmp(simd, "avx2") == 0) {
+        return 2;
+#else
+    } else if (strcmp(simd, "neon") == 0) {
+        return 1;
+#endif
+    } else {
+        SAIL_LOG_WARNING("Ignoring unsupported SAIL_FORCE_SIMD value '%s'", simd);
+        return INT_MAX;
+    }
+}
+#endif
+
+#if defined(SAIL_SWIZZLE_X86)
+
+static bool cpu_supports_ssse3(void) {
+
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+
+    return (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+static bool cpu_supports_avx2(void) {
+
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+
+    /* OSXSAVE and AVX. */
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return false;
+    }
+
+    /* The OS saves the YMM registers. */
+    if ((_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+SAIL_TARGET("ssse3")
+static unsigned swizzle_row_ssse3(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    const __m128i shuffle = _mm_loadu_si128((const __m128i *)swizzle->shuffle);
+    const __m128i fill = _mm_loadu_si128((const __m128i *)swizzle->fill);
+
+    const size_t input_step = (size_t)swizzle->pixels * swizzle->input_components;
+    const size_t output_step = (size_t)swizzle->pixels * swizzle->output_components;
+
+    unsigned column = 0;
+
+    while ((size_t)(width - column) * swizzle->input_components >= 16 && (size_t)(width - column) * swizzle->output_components >= 16) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)scan_input);
+        _mm_storeu_si128((__m128i *)scan_output, _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill));
+
+        scan_input += input_step;
+        scan_output += output_step;
+        column += swizzle->pixels;
+    }
+
+    return column;
+}
+
+/* Shuffles two 16-byte steps at once. Both lanes are loaded before storing anything. */
+SAIL_TARGET("avx2")
+static unsigned swizzle_row_avx2(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    const __m128i shuffle128 = _mm_loadu_si128((const __m128i *)swizzle->shuffle);
+    const __m128i fill128 = _mm_loadu_si128((const __m128i *)swizzle->fill);
+    const __m256i shuffle = _mm256_inserti128_si256(_mm256_castsi128_si256(shuffle128), shuffle128, 1);
+    const __m256i fill = _mm256_inserti128_si256(_mm256_castsi128_si256(fill128), fill128, 1);
+
+    const size_t input_step = (size_t)swizzle->pixels * swizzle->input_components;
+    const size_t output_step = (size_t)swizzle->pixels * swizzle->output_components;
+
+    unsigned column = 0;
+
+    while ((size_t)(width - column) * swizzle->input_components >= input_step + 16 &&
+            (size_t)(width - column) * swizzle->output_components >= output_step + 16) {
+        const __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)scan_input)),
+                                                        _mm_loadu_si128((const __m128i *)(scan_input + input_step)), 1);
+        const __m256i result = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill);
+
+        _mm_storeu_si128((__m128i *)scan_output, _mm256_castsi256_si128(result));
+        _mm_storeu_si128((__m128i *)(scan_output + output_step), _mm256_extracti128_si256(result, 1));
+
+        scan_input += input_step * 2;
+        scan_output += output_step * 2;
+        column += swizzle->pixels * 2;
+    }
+
+    /* Odd step. */
+    return column + swizzle_row_ssse3(swizzle, scan_input, scan_output, width - column);
+}
+
+#elif defined(SAIL_SWIZZLE_NEON)
+
+static unsigned swizzle_row_neon(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    /* Indexes out of range, e.g. 0x80, produce zeros like in SSSE3. */
+    const uint8x16_t shuffle = vld1q_u8(swizzle->shuffle);
+    const uint8x16_t fill = vld1q_u8(swizzle->fill);
+
+    const size_t input_step = (size_t)swizzle->pixels * swizzle->input_components;
+    const size_t output_step = (size_t)swizzle->pixels * swizzle->output_components;
+
+    unsigned column = 0;
+
+    while ((size_t)(width - column) * swizzle->input_components >= 16 && (size_t)(width - column) * swizzle->output_components >= 16) {
+        const uint8x16_t pixels = vld1q_u8(scan_input);
+        vst1q_u8(scan_output, vorrq_u8(vqtbl1q_u8(pixels, shuffle), fill));
+
+        scan_input += input_step;
+        scan_output += output_step;
+        column += swizzle->pixels;
+    }
+
+    return column;
+}
+
+#endif
+
+/*
+ * Public functions.
+ */
+
+void init_swizzle(unsigned input_components, const int input_indexes[4],
+                  unsigned output_components, const int output_indexes[4], int x,
+                  struct swizzle *swizzle) {
+
+    swizzle->input_components = input_components;
+    swizzle->output_components = output_components;
+    swizzle->pixels = 16 / SAIL_MAX(input_components, output_components);
+
+    /*
+     * Bytes past the shuffled pixels are copied from the input as is. That keeps
+     * the input intact when shuffling in place with the same pixel size.
+     */
+    for (unsigned i = 0; i < 16; i++) {
+        swizzle->shuffle[i] = (uint8_t)i;
+        swizzle->fill[i] = 0;
+    }
+
+    for (unsigned pixel = 0; pixel < swizzle->pixels; pixel++) {
+        for (unsigned component = 0; component < 4; component++) {
+            const int output_index = output_indexes[component];
+
+            if (output_index < 0) {
+                continue;
+            }
+
+            const unsigned i = pixel * output_components + (unsigned)output_index;
+
+            if (input_indexes[component] >= 0) {
+                swizzle->shuffle[i] = (uint8_t)(pixel * input_components + (unsigned)input_indexes[component]);
+            } else {
+                swizzle->shuffle[i] = 0x80;
+                swizzle->fill[i] = 255;
+            }
+        }
+
+        if (x >= 0) {
+            const unsigned i = pixel * output_components + (unsigned)x;
+
+            swizzle->shuffle[i] = 0x80;
+            swizzle->fill[i] = 255;
+        }
+    }
+
+#if defined(SAIL_SWIZZLE_X86)
+    const int simd_level = max_simd_level();
+
+    if (simd_level >= 2 && cpu_supports_avx2()) {
+        swizzle->row = swizzle_row_avx2;
+    } else if (simd_level >= 1 && cpu_supports_ssse3()) {
+        swizzle->row = swizzle_row_ssse3;
+    } else {
+        swizzle->row = NULL;
+    }
+#elif defined(SAIL_SWIZZLE_NEON)
+    swizzle->row = (max_simd_level() >= 1) ? swizzle_row_neon : NULL;
+#else
+    swizzle->row = NULL;
+#endif
+}
+
+unsigned swizzle_row(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    if (swizzle->row == NULL) {
+        return 0;
+    }
+
+    return swizzle->row(swizzle, scan_input, scan_output, width);
+}
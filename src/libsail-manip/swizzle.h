@@ -0,0 +1,78 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_SWIZZLE_H
+#define SAIL_SWIZZLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+#else
+    #include <sail-common/export.h>
+#endif
+
+struct swizzle;
+
+typedef unsigned (*swizzle_row_t)(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width);
+
+/*
+ * Byte shuffle of pixels with 8-bit components, e.g. RGB24 -> BGRA32 or GRAY8 -> RGB24.
+ * Run with SIMD instructions when the CPU supports them.
+ */
+struct swizzle {
+    /* SIMD implementation or NULL if there is none. */
+    swizzle_row_t row;
+
+    /* Input byte index for every output byte, or 0x80 to take the byte from fill. */
+    uint8_t shuffle[16];
+    uint8_t fill[16];
+
+    unsigned input_components;
+    unsigned output_components;
+
+    /* Number of pixels shuffled in a single 16-byte step. */
+    unsigned pixels;
+};
+
+/*
+ * Initializes the swizzle. Input and output component indexes are given in RGBA order.
+ * Negative indexes mean the component is missing. x is the index of the unused output
+ * component filled with 255, or -1. Grayscale input uses the same index for R, G, and B.
+ */
+SAIL_HIDDEN void init_swizzle(unsigned input_components, const int input_indexes[4],
+                              unsigned output_components, const int output_indexes[4], int x,
+                              struct swizzle *swizzle);
+
+/*
+ * Shuffles as many leading pixels of the scan line as possible with SIMD instructions.
+ * The input and the output may be the same memory if the output pixels are not larger than
+ * the input pixels. Returns the number of pixels shuffled. The rest must be converted
+ * by the caller.
+ */
+SAIL_HIDDEN unsigned swizzle_row(const struct swizzle *swizzle, const uint8_t *scan_input, uint8_t *scan_output, unsigned width);
+
+#endif
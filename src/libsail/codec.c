@@ -104,16 +104,22 @@ static sail_status_t load_codec_from_file(const struct sail_codec_info *codec_in
     codec->handle = handle;
 
 #ifdef SAIL_WIN32
-    #define SAIL_RESOLVE_FUNC GetProcAddress
+    #define SAIL_RESOLVE_ADDRESS(target, handle, symbol, full_symbol_name) \
+        target = (symbol##_t)GetProcAddress(handle, full_symbol_name)
     #define SAIL_RESOLVE_LOG_ERROR(symbol) \
         SAIL_LOG_ERROR("Failed to resolve '%s' in '%s'. Error: 0x%X", symbol, codec_info->path, GetLastError())
 #else
-    #define SAIL_RESOLVE_FUNC dlsym
+    /* ISO C doesn't allow casting object pointers to function pointers, so copy the address. */
+    #define SAIL_RESOLVE_ADDRESS(target, handle, symbol, full_symbol_name) \
+        {                                                                   \
+            void *address = dlsym(handle, full_symbol_name);                \
+            memcpy(&target, &address, sizeof(address));                     \
+        } do{} while(0)
     #define SAIL_RESOLVE_LOG_ERROR(symbol) \
         SAIL_LOG_ERROR("Failed to resolve '%s' in '%s': %s", symbol, codec_info->path, dlerror())
 #endif
 
-#define SAIL_RESOLVE(target, handle, symbol, name)                                 \
+#define SAIL_RESOLVE_IMPL(target, handle, symbol, name, optional)                  \
     {                                                                              \
         char *full_symbol_name;                                                    \
         SAIL_TRY(sail_concat(&full_symbol_name, 3, #symbol, "_", name));           \
@@ -121,25 +127,35 @@ static sail_status_t load_codec_from_file(const struct sail_codec_info *codec_in
         /* To avoid copying name, make the whole string lower-case. */             \
         sail_to_lower(full_symbol_name);                                           \
                                                                                    \
-        target = (symbol##_t)SAIL_RESOLVE_FUNC(handle, full_symbol_name);          \
+        SAIL_RESOLVE_ADDRESS(target, handle, symbol, full_symbol_name);            \
                                                                                    \
         if (target == NULL) {                                                      \
-            SAIL_RESOLVE_LOG_ERROR(full_symbol_name);                              \
-            sail_free(full_symbol_name);                                           \
-            SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_SYMBOL_RESOLVE);                  \
+            if (optional) {                                                        \
+                SAIL_LOG_DEBUG("Optional '%s' is not found", full_symbol_name);    \
+            } else {                                                               \
+                SAIL_RESOLVE_LOG_ERROR(full_symbol_name);                          \
+                sail_free(full_symbol_name);                                       \
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_SYMBOL_RESOLVE);              \
+            }                                                                      \
         }                                                                          \
                                                                                    \
         sail_free(full_symbol_name);                                               \
     } do{} while(0)
 
+#define SAIL_RESOLVE(target, handle, symbol, name)          SAIL_RESOLVE_IMPL(target, handle, symbol, name, false)
+/* Optional functions may be missing in third-party codecs. */
+#define SAIL_RESOLVE_OPTIONAL(target, handle, symbol, name) SAIL_RESOLVE_IMPL(target, handle, symbol, name, true)
+
     SAIL_RESOLVE(codec->v8->load_init,            handle, sail_codec_load_init_v8,            codec_info->name);
     SAIL_RESOLVE(codec->v8->load_seek_next_frame, handle, sail_codec_load_seek_next_frame_v8, codec_info->name);
     SAIL_RESOLVE(codec->v8->load_frame,           handle, sail_codec_load_frame_v8,           codec_info->name);
+    SAIL_RESOLVE_OPTIONAL(codec->v8->load_rows,   handle, sail_codec_load_rows_v8,            codec_info->name);
     SAIL_RESOLVE(codec->v8->load_finish,          handle, sail_codec_load_finish_v8,          codec_info->name);
 
     SAIL_RESOLVE(codec->v8->save_init,            handle, sail_codec_save_init_v8,            codec_info->name);
     SAIL_RESOLVE(codec->v8->save_seek_next_frame, handle, sail_codec_save_seek_next_frame_v8, codec_info->name);
     SAIL_RESOLVE(codec->v8->save_frame,           handle, sail_codec_save_frame_v8,           codec_info->name);
+    SAIL_RESOLVE_OPTIONAL(codec->v8->save_rows,   handle, sail_codec_save_rows_v8,            codec_info->name);
     SAIL_RESOLVE(codec->v8->save_finish,          handle, sail_codec_save_finish_v8,          codec_info->name);
 
     return SAIL_OK;
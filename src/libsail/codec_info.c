@@ -32,6 +32,28 @@
 #include "sail-common.h"
 #include "sail.h"
 
+/*
+ * Private functions.
+ */
+
+/* \xFF\xDD => "ff dd" + string terminator. The output buffer must be at least length * 3 bytes long. */
+static void hex_magic_number(const unsigned char *buffer, size_t length, char *output) {
+
+    static const char hex_digits[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < length; i++) {
+        *output++ = hex_digits[buffer[i] >> 4];
+        *output++ = hex_digits[buffer[i] & 0xF];
+        *output++ = ' ';
+    }
+
+    *(output-1) = '\0';
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_codec_info_from_path(const char *path, const struct sail_codec_info **codec_info) {
 
     SAIL_CHECK_PTR(path);
@@ -122,80 +144,29 @@ sail_status_t sail_codec_info_by_magic_number_from_io(struct sail_io *io, const
     /* Seek back. */
     SAIL_TRY(io->seek(io->stream, (long)saved_offset, SEEK_SET));
 
-    /* \xFF\xDD => "FF DD" + string terminator. */
-    char hex_numbers[sizeof(buffer) * 3 + 1];
+    /* Find the codec info. */
+    const sail_status_t status = magic_number_index_find(context->magic_number_index, buffer, codec_info);
 
-    /* Debug print. */
-    {
-        char *hex_numbers_ptr = hex_numbers;
+    /* Debug print. Skip formatting the string when nobody is going to see it. */
+    if (status == SAIL_OK) {
+        if (sail_log_is_enabled(SAIL_LOG_LEVEL_DEBUG)) {
+            char hex_numbers[sizeof(buffer) * 3];
+            hex_magic_number(buffer, sizeof(buffer), hex_numbers);
 
-        for (size_t i = 0; i < sizeof(buffer); i++, hex_numbers_ptr += 3) {
-#ifdef _MSC_VER
-            sprintf_s(hex_numbers_ptr, 4, "%02x ", buffer[i]);
-#else
-            sprintf(hex_numbers_ptr, "%02x ", buffer[i]);
-#endif
+            SAIL_LOG_DEBUG("Read magic number: '%s'", hex_numbers);
+            SAIL_LOG_DEBUG("Found codec info: %s", (*codec_info)->name);
         }
 
-        *(hex_numbers_ptr-1) = '\0';
-        SAIL_LOG_DEBUG("Read magic number: '%s'", hex_numbers);
+        return SAIL_OK;
     }
 
-    /* Find the codec info. */
-    for (struct sail_codec_bundle_node *codec_bundle_node = context->codec_bundle_node; codec_bundle_node != NULL; codec_bundle_node = codec_bundle_node->next) {
-        const struct sail_codec_bundle *codec_bundle = codec_bundle_node->codec_bundle;
-        const struct sail_string_node *magic_number_node = codec_bundle->codec_info->magic_number_node;
-
-        /*
-         * Split "ab cd" into bytes and compare individual bytes against the read magic number.
-         * Additionally, we support "??" pattern matching any byte. For example, "?? ?? 66 74"
-         * matches both "00 20 66 74" and "20 30 66 74".
-         */
-        while (magic_number_node != NULL) {
-            size_t buffer_index = 0;
-            const char *magic = magic_number_node->string;
-            char hex_byte[3];
-            int bytes_consumed = 0;
-            bool mismatch = false;
-
-            SAIL_LOG_TRACE("Check against %s magic '%s'", codec_bundle->codec_info->name, magic);
-
-#ifdef _MSC_VER
-            while (buffer_index < sizeof(buffer) && sscanf_s(magic, "%2s%n", hex_byte, (unsigned)sizeof(hex_byte), &bytes_consumed) == 1) {
-#else
-            while (buffer_index < sizeof(buffer) && sscanf(magic, "%2s%n", hex_byte, &bytes_consumed) == 1) {
-#endif
-                if (hex_byte[0] == '?') {
-                    SAIL_LOG_TRACE("Skipping ? character");
-                } else {
-                    unsigned byte = 0;
-
-#ifdef _MSC_VER
-                    if (sscanf_s(hex_byte, "%02x", &byte) != 1 || byte != buffer[buffer_index]) {
-#else
-                    if (sscanf(hex_byte, "%02x", &byte) != 1 || byte != buffer[buffer_index]) {
-#endif
-                        SAIL_LOG_TRACE("Character mismatch %02x != %02x", buffer[buffer_index], byte);
-                        mismatch = true;
-                        break;
-                    }
-                }
-
-                magic += bytes_consumed;
-                buffer_index++;
-            }
+    if (sail_log_is_enabled(SAIL_LOG_LEVEL_ERROR)) {
+        char hex_numbers[sizeof(buffer) * 3];
+        hex_magic_number(buffer, sizeof(buffer), hex_numbers);
 
-            if (mismatch) {
-                magic_number_node = magic_number_node->next;
-            } else {
-                *codec_info = codec_bundle->codec_info;
-                SAIL_LOG_DEBUG("Found codec info: %s", (*codec_info)->name);
-                return SAIL_OK;
-            }
-        }
+        SAIL_LOG_ERROR("Magic number '%s' is not supported by any codec", hex_numbers);
     }
 
-    SAIL_LOG_ERROR("Magic number '%s' is not supported by any codec", hex_numbers);
     SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
 }
 
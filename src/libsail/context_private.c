@@ -193,8 +193,9 @@ static sail_status_t alloc_context(struct sail_context **context) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_context), &ptr));
     *context = ptr;
 
-    (*context)->initialized     = false;
-    (*context)->codec_bundle_node = NULL;
+    (*context)->initialized        = false;
+    (*context)->codec_bundle_node  = NULL;
+    (*context)->magic_number_index = NULL;
 
     return SAIL_OK;
 }
@@ -219,6 +220,7 @@ static sail_status_t destroy_context(struct sail_context *context) {
         return SAIL_OK;
     }
 
+    destroy_magic_number_index(context->magic_number_index);
     destroy_codec_bundle_node_chain(context->codec_bundle_node);
     sail_free(context);
 
@@ -775,6 +777,8 @@ static sail_status_t init_context(struct sail_context *context, int flags) {
 
     SAIL_TRY(print_enumerated_codecs(context));
 
+    SAIL_TRY(alloc_magic_number_index(context->codec_bundle_node, &context->magic_number_index));
+
     if (flags & SAIL_FLAG_PRELOAD_CODECS) {
         SAIL_TRY(preload_codecs(context));
     }
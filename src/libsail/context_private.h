@@ -37,6 +37,7 @@
 #endif
 
 struct sail_codec_bundle_node;
+struct sail_magic_number_index;
 
 /*
  * Context is a main entry point to start working with SAIL. It enumerates codec info objects which could be
@@ -49,6 +50,9 @@ struct sail_context {
 
     /* Linked list of found codec info objects. */
     struct sail_codec_bundle_node *codec_bundle_node;
+
+    /* Magic numbers of the found codecs compiled for fast matching. */
+    struct sail_magic_number_index *magic_number_index;
 };
 
 typedef struct sail_context sail_context_t;
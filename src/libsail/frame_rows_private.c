@@ -0,0 +1,368 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail-manip.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+/*
+ * Streams native scan lines from the codec into the buffer. Codecs write packed scan lines,
+ * so padded scan lines are read one by one. Returns SAIL_ERROR_NOT_IMPLEMENTED when the frame
+ * must be buffered instead.
+ */
+static sail_status_t stream_native_rows(struct hidden_state *state_of_mind, struct frame_rows *frame_rows,
+                                        void *rows, unsigned rows_count, unsigned bytes_per_line) {
+
+    struct sail_image *image = frame_rows->image;
+
+    /* Frames cropped or oriented by libsail are buffered. */
+    if (frame_rows->frame_pixels != NULL || state_of_mind->codec->v8->load_rows == NULL ||
+            state_of_mind->crop_source_width != 0 || state_of_mind->orientation != SAIL_ORIENTATION_NORMAL) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    const unsigned rows_per_call = (bytes_per_line == image->bytes_per_line) ? rows_count : 1;
+
+    for (unsigned row = 0; row < rows_count; row += rows_per_call) {
+        unsigned char *row_pixels = (unsigned char *)rows + (size_t)row * bytes_per_line;
+
+        const sail_status_t status = SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "load_rows", (uint64_t)image->width * rows_per_call,
+                                                            state_of_mind->codec->v8->load_rows(state_of_mind->state, image, row_pixels, rows_per_call));
+
+        if (status == SAIL_OK) {
+            continue;
+        }
+
+        /* Codecs may refuse to stream only before the first scan line. */
+        if (status == SAIL_ERROR_NOT_IMPLEMENTED && frame_rows->next_row == 0 && row == 0) {
+            return SAIL_ERROR_NOT_IMPLEMENTED;
+        }
+
+        SAIL_LOG_ERROR("Failed to read scan lines from %s codec", state_of_mind->codec_info->name);
+        return (status == SAIL_ERROR_NOT_IMPLEMENTED) ? SAIL_ERROR_UNDERLYING_CODEC : status;
+    }
+
+    return SAIL_OK;
+}
+
+/* Loads the whole frame when the codec cannot stream it. */
+static sail_status_t buffer_frame(struct hidden_state *state_of_mind, struct frame_rows *frame_rows) {
+
+    if (frame_rows->frame_pixels != NULL) {
+        return SAIL_OK;
+    }
+
+    struct sail_image *image = frame_rows->image;
+
+    SAIL_LOG_DEBUG("%s codec cannot stream scan lines, buffering the whole frame", state_of_mind->codec_info->name);
+
+    SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &frame_rows->frame_pixels));
+
+    image->pixels = frame_rows->frame_pixels;
+
+    SAIL_TRY_OR_CLEANUP(load_codec_frame(state_of_mind, image),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(frame_rows->frame_pixels),
+                                      frame_rows->frame_pixels = NULL);
+
+    image->pixels = NULL;
+
+    return SAIL_OK;
+}
+
+/* Makes sure the band fits the specified number of scan lines and the conversion plan exists. */
+static sail_status_t prepare_band(struct frame_rows *frame_rows, unsigned rows_count) {
+
+    const struct sail_image *image = frame_rows->image;
+
+    if (frame_rows->band_rows < rows_count) {
+        SAIL_TRY(sail_realloc((size_t)rows_count * image->bytes_per_line, &frame_rows->band));
+        frame_rows->band_rows = rows_count;
+    }
+
+    if (frame_rows->plan == NULL) {
+        SAIL_TRY(sail_alloc_conversion_plan(image->pixel_format, image->width,
+                                            frame_rows->output_pixel_format, NULL /* options */, &frame_rows->plan));
+    }
+
+    return SAIL_OK;
+}
+
+/* Writes native scan lines streaming them into the codec or buffering the whole frame. */
+static sail_status_t write_native_rows(struct hidden_state *state_of_mind, struct frame_rows *frame_rows, const void *rows, unsigned rows_count) {
+
+    struct sail_image *image = frame_rows->image;
+
+    if (frame_rows->frame_pixels == NULL && state_of_mind->codec->v8->save_rows != NULL) {
+        const sail_status_t status = SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_rows", (uint64_t)image->width * rows_count,
+                                                            state_of_mind->codec->v8->save_rows(state_of_mind->state, image, rows, rows_count));
+
+        if (status == SAIL_OK) {
+            return SAIL_OK;
+        }
+
+        if (status != SAIL_ERROR_NOT_IMPLEMENTED || frame_rows->next_row > 0) {
+            SAIL_LOG_ERROR("Failed to write scan lines into %s codec", state_of_mind->codec_info->name);
+            return status;
+        }
+    }
+
+    if (frame_rows->frame_pixels == NULL) {
+        SAIL_LOG_DEBUG("%s codec cannot stream scan lines, buffering the whole frame", state_of_mind->codec_info->name);
+
+        SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &frame_rows->frame_pixels));
+    }
+
+    memcpy((unsigned char *)frame_rows->frame_pixels + (size_t)frame_rows->next_row * image->bytes_per_line,
+           rows,
+           (size_t)rows_count * image->bytes_per_line);
+
+    /* Write the buffered frame after the last scan line. */
+    if (frame_rows->next_row + rows_count == image->height) {
+        image->pixels = frame_rows->frame_pixels;
+
+        /* Codecs without save_rows() may need pixels to seek. */
+        if (state_of_mind->codec->v8->save_rows == NULL) {
+            SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_seek_next_frame", 0,
+                                    state_of_mind->codec->v8->save_seek_next_frame(state_of_mind->state, image)),
+                                /* cleanup */ image->pixels = NULL);
+        }
+
+        SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_frame", (uint64_t)image->width * image->height,
+                                state_of_mind->codec->v8->save_frame(state_of_mind->state, image)),
+                            /* cleanup */ image->pixels = NULL);
+
+        image->pixels = NULL;
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t init_frame_rows(struct frame_rows *frame_rows, struct sail_image *image, enum SailPixelFormat output_pixel_format) {
+
+    SAIL_CHECK_PTR(frame_rows);
+    SAIL_CHECK_PTR(image);
+
+    if (output_pixel_format != image->pixel_format && !sail_can_convert(image->pixel_format, output_pixel_format)) {
+        SAIL_LOG_ERROR("Cannot convert %s frames into %s",
+                        sail_pixel_format_to_string(image->pixel_format), sail_pixel_format_to_string(output_pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    frame_rows->image                 = image;
+    frame_rows->output_pixel_format   = output_pixel_format;
+    frame_rows->output_bytes_per_line = sail_bytes_per_line(image->width, output_pixel_format);
+    frame_rows->next_row              = 0;
+    frame_rows->frame_pixels          = NULL;
+    frame_rows->band                  = NULL;
+    frame_rows->band_rows             = 0;
+    frame_rows->plan                  = NULL;
+
+    return SAIL_OK;
+}
+
+void release_frame_rows(struct frame_rows *frame_rows) {
+
+    if (frame_rows == NULL) {
+        return;
+    }
+
+    sail_destroy_conversion_plan(frame_rows->plan);
+    sail_free(frame_rows->band);
+    sail_free(frame_rows->frame_pixels);
+
+    frame_rows->plan         = NULL;
+    frame_rows->band         = NULL;
+    frame_rows->band_rows    = 0;
+    frame_rows->frame_pixels = NULL;
+}
+
+sail_status_t alloc_frame_rows(struct sail_image *image, enum SailPixelFormat output_pixel_format, struct frame_rows **frame_rows) {
+
+    SAIL_CHECK_PTR(frame_rows);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct frame_rows), &ptr));
+    struct frame_rows *frame_rows_local = ptr;
+
+    SAIL_TRY_OR_CLEANUP(init_frame_rows(frame_rows_local, image, output_pixel_format),
+                        /* cleanup */ sail_free(frame_rows_local));
+
+    *frame_rows = frame_rows_local;
+
+    return SAIL_OK;
+}
+
+void destroy_frame_rows(struct frame_rows *frame_rows) {
+
+    if (frame_rows == NULL) {
+        return;
+    }
+
+    release_frame_rows(frame_rows);
+    sail_destroy_image(frame_rows->image);
+
+    sail_free(frame_rows);
+}
+
+sail_status_t read_frame_rows_into(struct hidden_state *state_of_mind, struct frame_rows *frame_rows,
+                                   void *rows, unsigned rows_count, unsigned bytes_per_line) {
+
+    SAIL_CHECK_PTR(state_of_mind);
+    SAIL_CHECK_PTR(frame_rows);
+    SAIL_CHECK_PTR(rows);
+
+    const struct sail_image *image = frame_rows->image;
+
+    if (rows_count == 0) {
+        return SAIL_OK;
+    }
+
+    const bool convert = frame_rows->output_pixel_format != image->pixel_format;
+
+    /* Converted scan lines go through the band, native ones go straight into the buffer. */
+    void *native_rows;
+    unsigned native_bytes_per_line;
+
+    if (convert) {
+        SAIL_TRY(prepare_band(frame_rows, rows_count));
+        native_rows           = frame_rows->band;
+        native_bytes_per_line = image->bytes_per_line;
+    } else {
+        native_rows           = rows;
+        native_bytes_per_line = bytes_per_line;
+    }
+
+    const sail_status_t status = stream_native_rows(state_of_mind, frame_rows, native_rows, rows_count, native_bytes_per_line);
+
+    if (status == SAIL_ERROR_NOT_IMPLEMENTED) {
+        SAIL_TRY(buffer_frame(state_of_mind, frame_rows));
+
+        native_rows = (unsigned char *)frame_rows->frame_pixels + (size_t)frame_rows->next_row * image->bytes_per_line;
+
+        if (!convert) {
+            for (unsigned row = 0; row < rows_count; row++) {
+                memcpy((unsigned char *)rows + (size_t)row * bytes_per_line,
+                       (const unsigned char *)native_rows + (size_t)row * image->bytes_per_line,
+                       image->bytes_per_line);
+            }
+        }
+    } else {
+        SAIL_TRY(status);
+    }
+
+    if (convert) {
+        /* A shallow view of the native scan lines. */
+        struct sail_image band_image = *image;
+        band_image.height = rows_count;
+        band_image.pixels = native_rows;
+
+        SAIL_TRY(sail_convert_image_with_plan_to_buffer(frame_rows->plan, &band_image, rows,
+                                                        (size_t)rows_count * bytes_per_line,
+                                                        bytes_per_line));
+    }
+
+    frame_rows->next_row += rows_count;
+
+    /* Release the buffered frame early. */
+    if (frame_rows->next_row == image->height) {
+        sail_free(frame_rows->frame_pixels);
+        frame_rows->frame_pixels = NULL;
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t read_frame_rows(struct hidden_state *state_of_mind, void *rows, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state_of_mind);
+    SAIL_CHECK_PTR(rows);
+
+    struct frame_rows *frame_rows = state_of_mind->frame_rows;
+
+    if (frame_rows == NULL) {
+        SAIL_LOG_ERROR("No frame is started. Call sail_start_frame_rows() first");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    const struct sail_image *image = frame_rows->image;
+
+    if (rows_count > image->height - frame_rows->next_row) {
+        SAIL_LOG_ERROR("Cannot read %u scan lines, only %u scan lines left", rows_count, image->height - frame_rows->next_row);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    SAIL_TRY(read_frame_rows_into(state_of_mind, frame_rows, rows, rows_count, frame_rows->output_bytes_per_line));
+
+    return SAIL_OK;
+}
+
+sail_status_t write_frame_rows(struct hidden_state *state_of_mind, const void *rows, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state_of_mind);
+    SAIL_CHECK_PTR(rows);
+
+    struct frame_rows *frame_rows = state_of_mind->frame_rows;
+
+    if (frame_rows == NULL) {
+        SAIL_LOG_ERROR("No frame is started. Call sail_start_writing_frame_rows() first");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    const struct sail_image *image = frame_rows->image;
+
+    if (rows_count > image->height - frame_rows->next_row) {
+        SAIL_LOG_ERROR("Cannot write %u scan lines, only %u scan lines left", rows_count, image->height - frame_rows->next_row);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (rows_count == 0) {
+        return SAIL_OK;
+    }
+
+    SAIL_TRY(write_native_rows(state_of_mind, frame_rows, rows, rows_count));
+
+    frame_rows->next_row += rows_count;
+
+    /* Release the buffered frame early. */
+    if (frame_rows->next_row == image->height) {
+        sail_free(frame_rows->frame_pixels);
+        frame_rows->frame_pixels = NULL;
+    }
+
+    return SAIL_OK;
+}
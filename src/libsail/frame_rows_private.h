@@ -0,0 +1,117 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_FRAME_ROWS_PRIVATE_H
+#define SAIL_FRAME_ROWS_PRIVATE_H
+
+#ifdef SAIL_BUILD
+    #include "common.h"
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/common.h>
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct hidden_state;
+struct sail_conversion_plan;
+struct sail_image;
+
+/*
+ * A frame read in bands of scan lines with sail_read_rows() or written with sail_write_rows().
+ */
+struct frame_rows {
+
+    /* The frame as the codec decodes or encodes it. The pixels are always NULL. */
+    struct sail_image *image;
+
+    /* The pixel format and the scan line length of the rows returned to the caller. */
+    enum SailPixelFormat output_pixel_format;
+    unsigned output_bytes_per_line;
+
+    /* The next scan line to read or write. */
+    unsigned next_row;
+
+    /* The whole frame when the codec cannot decode or encode it scan line by scan line. */
+    void *frame_pixels;
+
+    /* Native scan lines and the plan to convert them into the output pixel format. */
+    void *band;
+    unsigned band_rows;
+    struct sail_conversion_plan *plan;
+};
+
+/*
+ * Initializes the frame rows to read the specified frame into the specified output pixel format.
+ * Doesn't take the ownership of the image.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t init_frame_rows(struct frame_rows *frame_rows, struct sail_image *image, enum SailPixelFormat output_pixel_format);
+
+/*
+ * Frees the buffers and the conversion plan of the initialized frame rows. Doesn't destroy the image.
+ */
+SAIL_HIDDEN void release_frame_rows(struct frame_rows *frame_rows);
+
+/*
+ * Allocates new frame rows to read the specified frame into the specified output pixel format.
+ * Takes the ownership of the image.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_frame_rows(struct sail_image *image, enum SailPixelFormat output_pixel_format, struct frame_rows **frame_rows);
+
+/*
+ * Destroys the specified frame rows. Does nothing if the frame rows is NULL.
+ */
+SAIL_HIDDEN void destroy_frame_rows(struct frame_rows *frame_rows);
+
+/*
+ * Reads the next scan lines of the frame into the buffer. The scan lines are placed bytes_per_line
+ * bytes apart, which must be at least frame_rows->output_bytes_per_line. Doesn't check
+ * the number of scan lines left.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t read_frame_rows_into(struct hidden_state *state_of_mind, struct frame_rows *frame_rows,
+                                               void *rows, unsigned rows_count, unsigned bytes_per_line);
+
+/*
+ * Reads the next scan lines of the frame started by sail_start_frame_rows() into the buffer.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t read_frame_rows(struct hidden_state *state_of_mind, void *rows, unsigned rows_count);
+
+/*
+ * Writes the next scan lines of the frame started by sail_start_writing_frame_rows() from the buffer.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t write_frame_rows(struct hidden_state *state_of_mind, const void *rows, unsigned rows_count);
+
+#endif
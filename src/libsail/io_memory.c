@@ -26,12 +26,16 @@
 #include "config.h"
 
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "sail.h"
 
+/* The first allocation size of dynamic memory buffers. */
+#define SAIL_DYNAMIC_MEMORY_INITIAL_LENGTH (64 * 1024)
+
 struct mem_io_buffer_info {
 
     /* Total buffer size. */
@@ -238,6 +242,148 @@ static sail_status_t io_memory_eof(void *stream, bool *result) {
     return SAIL_OK;
 }
 
+static sail_status_t io_memory_read_contiguous_buffer(void *stream, const void **buffer, size_t *buffer_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_size);
+
+    const struct mem_io_read_stream *mem_io_read_stream = (struct mem_io_read_stream *)stream;
+
+    *buffer      = mem_io_read_stream->buffer;
+    *buffer_size = mem_io_read_stream->mem_io_buffer_info.accessible_length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_memory_write_contiguous_buffer(void *stream, const void **buffer, size_t *buffer_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_size);
+
+    const struct mem_io_write_stream *mem_io_write_stream = (struct mem_io_write_stream *)stream;
+
+    *buffer      = mem_io_write_stream->buffer;
+    *buffer_size = mem_io_write_stream->mem_io_buffer_info.accessible_length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_dynamic_memory_tolerant_write(void *stream, const void *buf, size_t size_to_write, size_t *written_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buf);
+    SAIL_CHECK_PTR(written_size);
+
+    struct mem_io_write_stream *mem_io_write_stream = (struct mem_io_write_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_write_stream->mem_io_buffer_info;
+
+    *written_size = 0;
+
+    const size_t new_pos = mem_io_buffer_info->pos + size_to_write;
+
+    if (new_pos < mem_io_buffer_info->pos) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+
+    /* Grow geometrically to keep the number of reallocations logarithmic. */
+    if (new_pos > mem_io_buffer_info->length) {
+        size_t new_length = (mem_io_buffer_info->length < SAIL_DYNAMIC_MEMORY_INITIAL_LENGTH)
+                                ? SAIL_DYNAMIC_MEMORY_INITIAL_LENGTH
+                                : mem_io_buffer_info->length;
+
+        while (new_length < new_pos) {
+            new_length = (new_length > SIZE_MAX / 2) ? new_pos : new_length * 2;
+        }
+
+        SAIL_TRY(sail_realloc(new_length, &mem_io_write_stream->buffer));
+        mem_io_buffer_info->length = new_length;
+    }
+
+    /* Zero the gap left by seeking past the end. */
+    if (mem_io_buffer_info->pos > mem_io_buffer_info->accessible_length) {
+        memset((char *)mem_io_write_stream->buffer + mem_io_buffer_info->accessible_length,
+                0,
+                mem_io_buffer_info->pos - mem_io_buffer_info->accessible_length);
+    }
+
+    memcpy((char *)mem_io_write_stream->buffer + mem_io_buffer_info->pos, buf, size_to_write);
+    mem_io_buffer_info->pos = new_pos;
+
+    if (new_pos > mem_io_buffer_info->accessible_length) {
+        mem_io_buffer_info->accessible_length = new_pos;
+    }
+
+    *written_size = size_to_write;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_dynamic_memory_strict_write(void *stream, const void *buf, size_t size_to_write) {
+
+    size_t written_size;
+
+    SAIL_TRY(io_dynamic_memory_tolerant_write(stream, buf, size_to_write, &written_size));
+
+    if (written_size != size_to_write) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_dynamic_memory_seek(void *stream, long offset, int whence) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mem_io_buffer_info *mem_io_buffer_info = (struct mem_io_buffer_info *)stream;
+
+    long base;
+
+    switch (whence) {
+        case SEEK_SET: {
+            base = 0;
+            break;
+        }
+
+        case SEEK_CUR: {
+            base = (long)mem_io_buffer_info->pos;
+            break;
+        }
+
+        case SEEK_END: {
+            base = (long)mem_io_buffer_info->accessible_length;
+            break;
+        }
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < -base) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    /* Seeking past the end is allowed. The buffer grows on the next write. */
+    mem_io_buffer_info->pos = (size_t)(base + offset);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_dynamic_memory_close(void *stream) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mem_io_write_stream *mem_io_write_stream = (struct mem_io_write_stream *)stream;
+
+    sail_free(mem_io_write_stream->buffer);
+    sail_free(mem_io_write_stream);
+
+    return SAIL_OK;
+}
+
 /*
  * Public functions.
  */
@@ -262,17 +408,19 @@ sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t length, struc
     mem_io_read_stream->mem_io_buffer_info.pos               = 0;
     mem_io_read_stream->buffer                               = buffer;
 
-    io_local->id             = SAIL_MEMORY_IO_ID;
-    io_local->stream         = mem_io_read_stream;
-    io_local->tolerant_read  = io_memory_tolerant_read;
-    io_local->strict_read    = io_memory_strict_read;
-    io_local->tolerant_write = sail_io_noop_tolerant_write;
-    io_local->strict_write   = sail_io_noop_strict_write;
-    io_local->seek           = io_memory_seek;
-    io_local->tell           = io_memory_tell;
-    io_local->flush          = sail_io_noop_flush;
-    io_local->close          = io_memory_close;
-    io_local->eof            = io_memory_eof;
+    io_local->id                = SAIL_MEMORY_IO_ID;
+    io_local->features          = SAIL_IO_FEATURE_CONTIGUOUS;
+    io_local->stream            = mem_io_read_stream;
+    io_local->tolerant_read     = io_memory_tolerant_read;
+    io_local->strict_read       = io_memory_strict_read;
+    io_local->tolerant_write    = sail_io_noop_tolerant_write;
+    io_local->strict_write      = sail_io_noop_strict_write;
+    io_local->seek              = io_memory_seek;
+    io_local->tell              = io_memory_tell;
+    io_local->flush             = sail_io_noop_flush;
+    io_local->close             = io_memory_close;
+    io_local->eof               = io_memory_eof;
+    io_local->contiguous_buffer = io_memory_read_contiguous_buffer;
 
     *io = io_local;
 
@@ -299,20 +447,92 @@ sail_status_t sail_alloc_io_read_write_memory(void *buffer, size_t length, struc
     mem_io_write_stream->mem_io_buffer_info.pos               = 0;
     mem_io_write_stream->buffer                               = buffer;
 
-    io_local->id             = SAIL_MEMORY_IO_ID;
-    io_local->features       = SAIL_IO_FEATURE_SEEKABLE;
-    io_local->stream         = mem_io_write_stream;
-    io_local->tolerant_read  = io_memory_tolerant_read;
-    io_local->strict_read    = io_memory_strict_read;
-    io_local->tolerant_write = io_memory_tolerant_write;
-    io_local->strict_write   = io_memory_strict_write;
-    io_local->seek           = io_memory_seek;
-    io_local->tell           = io_memory_tell;
-    io_local->flush          = io_memory_flush;
-    io_local->close          = io_memory_close;
-    io_local->eof            = io_memory_eof;
+    io_local->id                = SAIL_MEMORY_IO_ID;
+    io_local->features          = SAIL_IO_FEATURE_SEEKABLE | SAIL_IO_FEATURE_CONTIGUOUS;
+    io_local->stream            = mem_io_write_stream;
+    io_local->tolerant_read     = io_memory_tolerant_read;
+    io_local->strict_read       = io_memory_strict_read;
+    io_local->tolerant_write    = io_memory_tolerant_write;
+    io_local->strict_write      = io_memory_strict_write;
+    io_local->seek              = io_memory_seek;
+    io_local->tell              = io_memory_tell;
+    io_local->flush             = io_memory_flush;
+    io_local->close             = io_memory_close;
+    io_local->eof               = io_memory_eof;
+    io_local->contiguous_buffer = io_memory_write_contiguous_buffer;
+
+    *io = io_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_alloc_io_read_write_dynamic_memory(struct sail_io **io) {
+
+    SAIL_CHECK_PTR(io);
+
+    SAIL_LOG_DEBUG("Opening dynamic memory buffer for reading/writing");
+
+    struct sail_io *io_local;
+    SAIL_TRY(sail_alloc_io(&io_local));
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct mem_io_write_stream), &ptr),
+                        /* cleanup */ sail_destroy_io(io_local));
+    struct mem_io_write_stream *mem_io_write_stream = ptr;
+
+    mem_io_write_stream->mem_io_buffer_info.length            = 0;
+    mem_io_write_stream->mem_io_buffer_info.accessible_length = 0;
+    mem_io_write_stream->mem_io_buffer_info.pos               = 0;
+    mem_io_write_stream->buffer                               = NULL;
+
+    io_local->id                = SAIL_DYNAMIC_MEMORY_IO_ID;
+    io_local->features          = SAIL_IO_FEATURE_SEEKABLE | SAIL_IO_FEATURE_CONTIGUOUS;
+    io_local->stream            = mem_io_write_stream;
+    io_local->tolerant_read     = io_memory_tolerant_read;
+    io_local->strict_read       = io_memory_strict_read;
+    io_local->tolerant_write    = io_dynamic_memory_tolerant_write;
+    io_local->strict_write      = io_dynamic_memory_strict_write;
+    io_local->seek              = io_dynamic_memory_seek;
+    io_local->tell              = io_memory_tell;
+    io_local->flush             = io_memory_flush;
+    io_local->close             = io_dynamic_memory_close;
+    io_local->eof               = io_memory_eof;
+    io_local->contiguous_buffer = io_memory_write_contiguous_buffer;
 
     *io = io_local;
 
     return SAIL_OK;
 }
+
+sail_status_t sail_take_buffer_from_dynamic_memory_io(struct sail_io *io, void **buffer, size_t *buffer_length) {
+
+    SAIL_CHECK_PTR(io);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+
+    if (io->id != SAIL_DYNAMIC_MEMORY_IO_ID) {
+        SAIL_LOG_ERROR("The I/O object is not a dynamic memory I/O object");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_IO);
+    }
+
+    struct mem_io_write_stream *mem_io_write_stream = io->stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_write_stream->mem_io_buffer_info;
+
+    /* Release the unused capacity. */
+    if (mem_io_buffer_info->accessible_length == 0) {
+        sail_free(mem_io_write_stream->buffer);
+        mem_io_write_stream->buffer = NULL;
+    } else if (mem_io_buffer_info->accessible_length < mem_io_buffer_info->length) {
+        SAIL_TRY(sail_realloc(mem_io_buffer_info->accessible_length, &mem_io_write_stream->buffer));
+    }
+
+    *buffer        = mem_io_write_stream->buffer;
+    *buffer_length = mem_io_buffer_info->accessible_length;
+
+    mem_io_write_stream->buffer           = NULL;
+    mem_io_buffer_info->length            = 0;
+    mem_io_buffer_info->accessible_length = 0;
+    mem_io_buffer_info->pos               = 0;
+
+    return SAIL_OK;
+}
@@ -56,6 +56,28 @@ SAIL_EXPORT sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t l
  */
 SAIL_EXPORT sail_status_t sail_alloc_io_read_write_memory(void *buffer, size_t length, struct sail_io **io);
 
+/*
+ * Allocates a new growable memory buffer and a new I/O object for it. The buffer is initially empty
+ * and grows geometrically as data is written. Use it to save images into memory when the resulting
+ * size is not known in advance. The I/O object has the SAIL_DYNAMIC_MEMORY_IO_ID id.
+ *
+ * Take the written data with sail_take_buffer_from_dynamic_memory_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_io_read_write_dynamic_memory(struct sail_io **io);
+
+/*
+ * Transfers the ownership of the data written into the dynamic memory I/O object to the caller.
+ * The buffer must be freed with sail_free(). Assigns the number of bytes written to 'buffer_length'.
+ * The I/O object becomes empty and can be used again.
+ *
+ * 'buffer' is set to NULL if nothing was written.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_take_buffer_from_dynamic_memory_io(struct sail_io *io, void **buffer, size_t *buffer_length);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
@@ -0,0 +1,336 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "sail.h"
+
+struct mmap_io_stream {
+
+    /* Mapped file contents. */
+    const void *buffer;
+
+    /* Mapped file size. */
+    size_t length;
+
+    /* Current stream position. */
+    size_t pos;
+
+#ifdef SAIL_WIN32
+    HANDLE mapping;
+#endif
+};
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t io_mmap_tolerant_read(void *stream, void *buf, size_t size_to_read, size_t *read_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buf);
+    SAIL_CHECK_PTR(read_size);
+
+    struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+
+    *read_size = 0;
+
+    if (mmap_io_stream->pos >= mmap_io_stream->length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    const size_t actual_size_to_read = (size_to_read > mmap_io_stream->length - mmap_io_stream->pos)
+                                        ? mmap_io_stream->length - mmap_io_stream->pos
+                                        : size_to_read;
+
+    memcpy(buf, (const char *)mmap_io_stream->buffer + mmap_io_stream->pos, actual_size_to_read);
+    mmap_io_stream->pos += actual_size_to_read;
+
+    *read_size = actual_size_to_read;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_strict_read(void *stream, void *buf, size_t size_to_read) {
+
+    size_t read_size;
+
+    SAIL_TRY(io_mmap_tolerant_read(stream, buf, size_to_read, &read_size));
+
+    if (read_size != size_to_read) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_seek(void *stream, long offset, int whence) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+
+    long base;
+
+    switch (whence) {
+        case SEEK_SET: base = 0;                                  break;
+        case SEEK_CUR: base = (long)mmap_io_stream->pos;          break;
+        case SEEK_END: base = (long)mmap_io_stream->length;       break;
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < -base) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    /* Seeking beyond the end is allowed, reading from there reports EOF. */
+    mmap_io_stream->pos = (size_t)(base + offset);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_tell(void *stream, size_t *offset) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+
+    *offset = mmap_io_stream->pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_close(void *stream) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+    bool ok;
+
+#ifdef SAIL_WIN32
+    ok = UnmapViewOfFile(mmap_io_stream->buffer) != 0;
+    ok = CloseHandle(mmap_io_stream->mapping) != 0 && ok;
+#else
+    ok = munmap((void *)mmap_io_stream->buffer, mmap_io_stream->length) == 0;
+#endif
+
+    sail_free(mmap_io_stream);
+
+    if (!ok) {
+        SAIL_LOG_ERROR("Failed to unmap the file");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CLOSE_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_eof(void *stream, bool *result) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(result);
+
+    const struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+
+    *result = mmap_io_stream->pos >= mmap_io_stream->length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_contiguous_buffer(void *stream, const void **buffer, size_t *buffer_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_size);
+
+    const struct mmap_io_stream *mmap_io_stream = (struct mmap_io_stream *)stream;
+
+    *buffer      = mmap_io_stream->buffer;
+    *buffer_size = mmap_io_stream->length;
+
+    return SAIL_OK;
+}
+
+/*
+ * Maps the whole file. Failures are logged as debug messages only: the caller falls back
+ * to ordinary reads, which report the error if the file cannot be read at all.
+ */
+#ifdef SAIL_WIN32
+static sail_status_t map_file(const char *path, struct mmap_io_stream *mmap_io_stream) {
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        SAIL_LOG_DEBUG("Cannot open '%s' for mapping. Error: 0x%X", path, GetLastError());
+        return SAIL_ERROR_OPEN_FILE;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size)) {
+        SAIL_LOG_DEBUG("Cannot get the size of '%s'. Error: 0x%X", path, GetLastError());
+        CloseHandle(file);
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    /* Empty files and files larger than the address space. */
+    if (file_size.QuadPart == 0 || (unsigned long long)file_size.QuadPart > (size_t)-1) {
+        SAIL_LOG_DEBUG("Cannot map '%s' of size %lld", path, (long long)file_size.QuadPart);
+        CloseHandle(file);
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    /* The mapping holds its own reference to the file. */
+    CloseHandle(file);
+
+    if (mapping == NULL) {
+        SAIL_LOG_DEBUG("Cannot create a mapping of '%s'. Error: 0x%X", path, GetLastError());
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    const void *buffer = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (buffer == NULL) {
+        SAIL_LOG_DEBUG("Cannot map '%s'. Error: 0x%X", path, GetLastError());
+        CloseHandle(mapping);
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    mmap_io_stream->buffer  = buffer;
+    mmap_io_stream->length  = (size_t)file_size.QuadPart;
+    mmap_io_stream->mapping = mapping;
+
+    return SAIL_OK;
+}
+#else
+static sail_status_t map_file(const char *path, struct mmap_io_stream *mmap_io_stream) {
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        SAIL_LOG_DEBUG("Cannot open '%s' for mapping: %s", path, strerror(errno));
+        return SAIL_ERROR_OPEN_FILE;
+    }
+
+    struct stat file_stat;
+
+    if (fstat(fd, &file_stat) != 0) {
+        SAIL_LOG_DEBUG("Cannot get the size of '%s': %s", path, strerror(errno));
+        close(fd);
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    /* Pipes, devices, and empty files. */
+    if (!S_ISREG(file_stat.st_mode) || file_stat.st_size <= 0) {
+        SAIL_LOG_DEBUG("Cannot map '%s': not a regular file or empty", path);
+        close(fd);
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    const size_t length = (size_t)file_stat.st_size;
+    void *buffer = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping holds its own reference to the file. */
+    close(fd);
+
+    /* Some file systems don't support mapping. */
+    if (buffer == MAP_FAILED) {
+        SAIL_LOG_DEBUG("Cannot map '%s': %s", path, strerror(errno));
+        return SAIL_ERROR_READ_FILE;
+    }
+
+    /* Image data is usually parsed front to back. */
+#ifdef POSIX_MADV_SEQUENTIAL
+    (void)posix_madvise(buffer, length, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    mmap_io_stream->buffer = buffer;
+    mmap_io_stream->length = length;
+
+    return SAIL_OK;
+}
+#endif
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_alloc_io_read_mmap(const char *path, struct sail_io **io) {
+
+    SAIL_CHECK_PTR(path);
+    SAIL_CHECK_PTR(io);
+
+    SAIL_LOG_DEBUG("Mapping file '%s' for reading", path);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct mmap_io_stream), &ptr));
+    struct mmap_io_stream *mmap_io_stream = ptr;
+
+    mmap_io_stream->pos = 0;
+
+    SAIL_TRY_OR_CLEANUP(map_file(path, mmap_io_stream),
+                        /* cleanup */ sail_free(mmap_io_stream));
+
+    struct sail_io *io_local;
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(&io_local),
+                        /* cleanup */ io_mmap_close(mmap_io_stream));
+
+    io_local->id                = SAIL_MMAP_IO_ID;
+    io_local->features          = SAIL_IO_FEATURE_SEEKABLE | SAIL_IO_FEATURE_CONTIGUOUS;
+    io_local->stream            = mmap_io_stream;
+    io_local->tolerant_read     = io_mmap_tolerant_read;
+    io_local->strict_read       = io_mmap_strict_read;
+    io_local->tolerant_write    = sail_io_noop_tolerant_write;
+    io_local->strict_write      = sail_io_noop_strict_write;
+    io_local->seek              = io_mmap_seek;
+    io_local->tell              = io_mmap_tell;
+    io_local->flush             = sail_io_noop_flush;
+    io_local->close             = io_mmap_close;
+    io_local->eof               = io_mmap_eof;
+    io_local->contiguous_buffer = io_mmap_contiguous_buffer;
+
+    *io = io_local;
+
+    return SAIL_OK;
+}
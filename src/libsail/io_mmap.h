@@ -0,0 +1,65 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_IO_MMAP_H
+#define SAIL_IO_MMAP_H
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_io;
+
+/*
+ * Maps the specified image file into memory for reading and allocates a new I/O object for it.
+ * The I/O object has the SAIL_IO_FEATURE_CONTIGUOUS feature, so codecs that need the whole file
+ * in memory use the mapping directly without copying it.
+ *
+ * Empty files and files that cannot be mapped (pipes, for example) are not supported.
+ * On any failure, including a missing file, the function returns an error and logs only
+ * a debug message, so the caller can quietly fall back to sail_alloc_io_read_file(),
+ * which reports the error.
+ *
+ * Warning: Truncating the file by another process while it's mapped may crash the application
+ *          with SIGBUS on Unix systems. Use sail_alloc_io_read_file() if that's a concern.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_io_read_mmap(const char *path, struct sail_io **io);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
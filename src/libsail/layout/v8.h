@@ -117,12 +117,36 @@ sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_seek_next_frame_v8)(void
  * This function MUST:
  *   - Read the image pixels into sail_image.pixels.
  *   - Output pixels with the origin in the top left corner (i.e. not flipped).
- *   - Output pixels in format as close to the source as possible.
+ *   - Output pixels in format as close to the source as possible, or in load_options->output_pixel_format
+ *     if the codec has chosen to decode into it natively in sail_codec_load_seek_next_frame_vx().
+ *     libsail converts the pixels into the requested output pixel format otherwise.
  *
  * Returns SAIL_OK on success.
  */
 sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_frame_v8)(void *state, struct sail_image *image);
 
+/*
+ * Reads the next scan lines of the current frame into the specified buffer. Allows libsail to stream
+ * huge frames in bands without allocating the whole frame. Optional for third-party codecs.
+ *
+ * libsail, a caller of this function, guarantees the following:
+ *   - The state is valid and points to the state allocated by sail_codec_load_init_vx().
+ *   - The image points to the image allocated by sail_codec_load_seek_next_frame_vx(). Its pixels are NULL.
+ *   - The rows buffer holds at least rows_count * image->bytes_per_line bytes.
+ *   - The requested scan lines don't exceed the frame height.
+ *   - Either this function or sail_codec_load_frame_vx() is used for a frame, never both.
+ *
+ * This function MUST:
+ *   - Read the next rows_count scan lines into the buffer with the image->bytes_per_line stride.
+ *   - Output pixels with the origin in the top left corner (i.e. not flipped).
+ *   - Return SAIL_ERROR_NOT_IMPLEMENTED without reading anything on the first call for a frame
+ *     when the frame cannot be decoded scan line by scan line. libsail falls back to sail_codec_load_frame_vx()
+ *     in this case.
+ *
+ * Returns SAIL_OK on success.
+ */
+sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_rows_v8)(void *state, const struct sail_image *image, void *rows, unsigned rows_count);
+
 /*
  * Finilizes loading operation. No more loadings are possible after calling this function.
  * This function doesn't close the io stream. It just stops decoding. Use io->close() or sail_destroy_io()
@@ -194,6 +218,32 @@ sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_seek_next_frame_v8)(void
  */
 sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_frame_v8)(void *state, const struct sail_image *image);
 
+/*
+ * Writes the next scan lines of the current frame from the specified buffer. Allows libsail to save
+ * huge frames in bands without holding the whole frame. Optional for third-party codecs.
+ *
+ * When a codec exports this function, libsail calls sail_codec_save_seek_next_frame_vx() with an image
+ * without pixels before writing any scan lines. Such codecs MUST NOT access the image pixels
+ * in sail_codec_save_seek_next_frame_vx().
+ *
+ * libsail, a caller of this function, guarantees the following:
+ *   - The state is valid and points to the state allocated by sail_codec_save_init_vx().
+ *   - The image is the image passed to sail_codec_save_seek_next_frame_vx(). Its pixels are NULL.
+ *   - The rows buffer holds at least rows_count * image->bytes_per_line bytes.
+ *   - The written scan lines don't exceed the frame height.
+ *   - Either this function or sail_codec_save_frame_vx() is used for a frame, never both.
+ *
+ * This function MUST:
+ *   - Write the next rows_count scan lines stored with the image->bytes_per_line stride into the IO.
+ *   - Finish the frame after writing the last scan line.
+ *   - Return SAIL_ERROR_NOT_IMPLEMENTED without writing anything on the first call for a frame
+ *     when the frame cannot be encoded scan line by scan line. libsail buffers the whole frame and falls
+ *     back to sail_codec_save_frame_vx() in this case.
+ *
+ * Returns SAIL_OK on success.
+ */
+sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_rows_v8)(void *state, const struct sail_image *image, const void *rows, unsigned rows_count);
+
 /*
  * Finilizes saving operation. No more savings are possible after calling this function.
  * This function doesn't close the io stream. Use io->close() or sail_destroy_io() to actually
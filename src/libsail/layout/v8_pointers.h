@@ -39,6 +39,7 @@
 typedef sail_status_t (*sail_codec_load_init_v8_t)(struct sail_io *io, const struct sail_load_options *load_options, void **state);
 typedef sail_status_t (*sail_codec_load_seek_next_frame_v8_t)(void *state, struct sail_image **image);
 typedef sail_status_t (*sail_codec_load_frame_v8_t)(void *state, struct sail_image *image);
+typedef sail_status_t (*sail_codec_load_rows_v8_t)(void *state, const struct sail_image *image, void *rows, unsigned rows_count);
 typedef sail_status_t (*sail_codec_load_finish_v8_t)(void **state);
 
 /*
@@ -48,6 +49,7 @@ typedef sail_status_t (*sail_codec_load_finish_v8_t)(void **state);
 typedef sail_status_t (*sail_codec_save_init_v8_t)(struct sail_io *io, const struct sail_save_options *save_options, void **state);
 typedef sail_status_t (*sail_codec_save_seek_next_frame_v8_t)(void *state, const struct sail_image *image);
 typedef sail_status_t (*sail_codec_save_frame_v8_t)(void *state, const struct sail_image *image);
+typedef sail_status_t (*sail_codec_save_rows_v8_t)(void *state, const struct sail_image *image, const void *rows, unsigned rows_count);
 typedef sail_status_t (*sail_codec_save_finish_v8_t)(void **state);
 
 #endif
@@ -0,0 +1,261 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+static int hex_digit_value(char c) {
+
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+
+/*
+ * Compiles "ab cd ?? ef" into bytes and a mask. "??" matches any byte.
+ */
+static sail_status_t compile_magic_number(const char *magic, struct sail_compiled_magic_number *compiled_magic_number) {
+
+    memset(compiled_magic_number->bytes, 0, sizeof(compiled_magic_number->bytes));
+    memset(compiled_magic_number->mask,  0, sizeof(compiled_magic_number->mask));
+    compiled_magic_number->length = 0;
+
+    const char *ptr = magic;
+
+    while (true) {
+        while (isspace((unsigned char)*ptr)) {
+            ptr++;
+        }
+
+        if (*ptr == '\0') {
+            break;
+        }
+
+        const char *token = ptr;
+
+        while (*ptr != '\0' && !isspace((unsigned char)*ptr)) {
+            ptr++;
+        }
+
+        const size_t token_length = ptr - token;
+
+        if (compiled_magic_number->length >= SAIL_MAGIC_BUFFER_SIZE) {
+            SAIL_LOG_ERROR("Magic number '%s' is longer than %u bytes", magic, SAIL_MAGIC_BUFFER_SIZE);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+        }
+
+        if (token[0] == '?' && (token_length == 1 || (token_length == 2 && token[1] == '?'))) {
+            compiled_magic_number->length++;
+            continue;
+        }
+
+        const int high = hex_digit_value(token[0]);
+        const int low  = (token_length == 2) ? hex_digit_value(token[1]) : -1;
+
+        if (token_length != 2 || high < 0 || low < 0) {
+            SAIL_LOG_ERROR("Magic number '%s' contains invalid byte '%.*s'", magic, (int)token_length, token);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+        }
+
+        compiled_magic_number->bytes[compiled_magic_number->length] = (unsigned char)(high << 4 | low);
+        compiled_magic_number->mask[compiled_magic_number->length]  = 0xFF;
+        compiled_magic_number->length++;
+    }
+
+    return SAIL_OK;
+}
+
+static bool first_byte_matches(const struct sail_compiled_magic_number *compiled_magic_number, unsigned byte) {
+
+    return compiled_magic_number->length == 0 ||
+            compiled_magic_number->mask[0] == 0 ||
+            compiled_magic_number->bytes[0] == byte;
+}
+
+static sail_status_t build_first_byte_dispatch(struct sail_magic_number_index *magic_number_index) {
+
+    /* Count the candidates per first byte. */
+    size_t total = 0;
+
+    for (unsigned byte = 0; byte < 256; byte++) {
+        magic_number_index->first_byte_offsets[byte] = total;
+
+        for (size_t i = 0; i < magic_number_index->magic_numbers_length; i++) {
+            if (first_byte_matches(&magic_number_index->magic_numbers[i], byte)) {
+                total++;
+            }
+        }
+    }
+
+    magic_number_index->first_byte_offsets[256] = total;
+
+    if (total == 0) {
+        return SAIL_OK;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(total * sizeof(size_t), &ptr));
+    magic_number_index->indexes = ptr;
+
+    /* Fill the candidates preserving the codec priority order. */
+    size_t *indexes = magic_number_index->indexes;
+
+    for (unsigned byte = 0; byte < 256; byte++) {
+        for (size_t i = 0; i < magic_number_index->magic_numbers_length; i++) {
+            if (first_byte_matches(&magic_number_index->magic_numbers[i], byte)) {
+                *indexes++ = i;
+            }
+        }
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t alloc_magic_number_index_impl(const struct sail_codec_bundle_node *codec_bundle_node,
+                                                   struct sail_magic_number_index *magic_number_index) {
+
+    /* Count the magic numbers. */
+    size_t magic_numbers_length = 0;
+
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        for (const struct sail_string_node *magic_number_node = node->codec_bundle->codec_info->magic_number_node;
+                magic_number_node != NULL;
+                magic_number_node = magic_number_node->next) {
+            magic_numbers_length++;
+        }
+    }
+
+    if (magic_numbers_length > 0) {
+        void *ptr;
+        SAIL_TRY(sail_malloc(magic_numbers_length * sizeof(struct sail_compiled_magic_number), &ptr));
+        magic_number_index->magic_numbers = ptr;
+    }
+
+    /* Compile the magic numbers in the codec priority order. */
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_bundle->codec_info;
+
+        for (const struct sail_string_node *magic_number_node = codec_info->magic_number_node;
+                magic_number_node != NULL;
+                magic_number_node = magic_number_node->next) {
+            struct sail_compiled_magic_number *compiled_magic_number =
+                &magic_number_index->magic_numbers[magic_number_index->magic_numbers_length];
+
+            SAIL_TRY_OR_EXECUTE(compile_magic_number(magic_number_node->string, compiled_magic_number),
+                                /* on error */ SAIL_LOG_ERROR("Skipping %s magic number '%s'", codec_info->name, magic_number_node->string);
+                                               continue);
+
+            compiled_magic_number->codec_info = codec_info;
+            magic_number_index->magic_numbers_length++;
+        }
+    }
+
+    SAIL_TRY(build_first_byte_dispatch(magic_number_index));
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_magic_number_index(const struct sail_codec_bundle_node *codec_bundle_node,
+                                       struct sail_magic_number_index **magic_number_index) {
+
+    SAIL_CHECK_PTR(magic_number_index);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_magic_number_index), &ptr));
+    struct sail_magic_number_index *magic_number_index_local = ptr;
+
+    magic_number_index_local->magic_numbers        = NULL;
+    magic_number_index_local->magic_numbers_length = 0;
+    magic_number_index_local->indexes              = NULL;
+    memset(magic_number_index_local->first_byte_offsets, 0, sizeof(magic_number_index_local->first_byte_offsets));
+
+    SAIL_TRY_OR_CLEANUP(alloc_magic_number_index_impl(codec_bundle_node, magic_number_index_local),
+                        /* cleanup */ destroy_magic_number_index(magic_number_index_local));
+
+    *magic_number_index = magic_number_index_local;
+
+    return SAIL_OK;
+}
+
+void destroy_magic_number_index(struct sail_magic_number_index *magic_number_index) {
+
+    if (magic_number_index == NULL) {
+        return;
+    }
+
+    sail_free(magic_number_index->magic_numbers);
+    sail_free(magic_number_index->indexes);
+    sail_free(magic_number_index);
+}
+
+sail_status_t magic_number_index_find(const struct sail_magic_number_index *magic_number_index,
+                                      const unsigned char buffer[SAIL_MAGIC_BUFFER_SIZE],
+                                      const struct sail_codec_info **codec_info) {
+
+    SAIL_CHECK_PTR(magic_number_index);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(codec_info);
+
+    const size_t begin = magic_number_index->first_byte_offsets[buffer[0]];
+    const size_t end   = magic_number_index->first_byte_offsets[buffer[0] + 1];
+
+    for (size_t i = begin; i < end; i++) {
+        const struct sail_compiled_magic_number *compiled_magic_number =
+            &magic_number_index->magic_numbers[magic_number_index->indexes[i]];
+
+        unsigned char diff = 0;
+
+        for (unsigned k = 0; k < compiled_magic_number->length; k++) {
+            diff |= (buffer[k] ^ compiled_magic_number->bytes[k]) & compiled_magic_number->mask[k];
+        }
+
+        if (diff == 0) {
+            *codec_info = compiled_magic_number->codec_info;
+            return SAIL_OK;
+        }
+    }
+
+    return SAIL_ERROR_CODEC_NOT_FOUND;
+}
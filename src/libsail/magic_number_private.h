@@ -0,0 +1,95 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_MAGIC_NUMBER_PRIVATE_H
+#define SAIL_MAGIC_NUMBER_PRIVATE_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct sail_codec_bundle_node;
+struct sail_codec_info;
+
+/*
+ * A magic number compiled from a string like "?? ?? 66 74" into a byte array and a mask.
+ * A zero mask byte means "match any byte".
+ */
+struct sail_compiled_magic_number {
+
+    unsigned char bytes[SAIL_MAGIC_BUFFER_SIZE];
+    unsigned char mask[SAIL_MAGIC_BUFFER_SIZE];
+
+    /* Number of significant bytes. */
+    unsigned length;
+
+    const struct sail_codec_info *codec_info;
+};
+
+/*
+ * Magic numbers of all the enumerated codecs compiled once per context. The magic numbers are stored
+ * in the codec priority order. first_byte_offsets[] is a dispatch table by the first byte of the input data:
+ * the indexes of the magic numbers that could match the first byte B are stored in
+ * indexes[first_byte_offsets[B] .. first_byte_offsets[B+1]).
+ */
+struct sail_magic_number_index {
+
+    struct sail_compiled_magic_number *magic_numbers;
+    size_t magic_numbers_length;
+
+    size_t first_byte_offsets[256 + 1];
+    size_t *indexes;
+};
+
+/*
+ * Compiles the magic numbers of all the codecs in the specified list into a new index.
+ * Invalid magic numbers are logged and skipped.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_magic_number_index(const struct sail_codec_bundle_node *codec_bundle_node,
+                                                   struct sail_magic_number_index **magic_number_index);
+
+/*
+ * Destroys the specified magic number index.
+ */
+SAIL_HIDDEN void destroy_magic_number_index(struct sail_magic_number_index *magic_number_index);
+
+/*
+ * Finds a first codec info which magic number matches the specified buffer of SAIL_MAGIC_BUFFER_SIZE bytes.
+ *
+ * Returns SAIL_OK on success or SAIL_ERROR_CODEC_NOT_FOUND.
+ */
+SAIL_HIDDEN sail_status_t magic_number_index_find(const struct sail_magic_number_index *magic_number_index,
+                                                  const unsigned char buffer[SAIL_MAGIC_BUFFER_SIZE],
+                                                  const struct sail_codec_info **codec_info);
+
+#endif
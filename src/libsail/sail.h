@@ -42,16 +42,21 @@
     #include "codec_priority.h"
     #include "context.h"
     #include "context_private.h"
+    #include "frame_rows_private.h"
     #include "ini.h"
     #include "io_file.h"
     #include "io_memory.h"
+    #include "io_mmap.h"
     #include "io_noop.h"
+    #include "magic_number_private.h"
     #include "sail_advanced.h"
     #include "sail_deep_diver.h"
     #include "sail_junior.h"
     #include "sail_private.h"
     #include "sail_technical_diver.h"
     #include "sail_technical_diver_private.h"
+    #include "trace_private.h"
+    #include "transcode.h"
     #ifdef SAIL_THREAD_SAFE
     #include "threading.h"
     #endif
@@ -65,11 +70,13 @@
     #include <sail/context.h>
     #include <sail/io_file.h>
     #include <sail/io_memory.h>
+    #include <sail/io_mmap.h>
     #include <sail/io_noop.h>
     #include <sail/sail_advanced.h>
     #include <sail/sail_deep_diver.h>
     #include <sail/sail_junior.h>
     #include <sail/sail_technical_diver.h>
+    #include <sail/transcode.h>
 #endif
 
 #endif
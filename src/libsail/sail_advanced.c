@@ -29,8 +29,101 @@
 #include <stdlib.h>
 
 #include "sail-common.h"
+#include "sail-manip.h"
 #include "sail.h"
 
+/*
+ * Private functions.
+ */
+
+static enum SailPixelFormat output_pixel_format(const struct hidden_state *state_of_mind, const struct sail_image *image) {
+
+    return (state_of_mind->output_pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN) ? image->pixel_format : state_of_mind->output_pixel_format;
+}
+
+static sail_status_t seek_next_frame(struct hidden_state *state_of_mind, struct sail_image **image) {
+
+    /* Frames read with sail_read_rows() end here. */
+    destroy_frame_rows(state_of_mind->frame_rows);
+    state_of_mind->frame_rows = NULL;
+
+    struct sail_image *image_local;
+    SAIL_TRY(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "load_seek_next_frame", 0,
+                                   state_of_mind->codec->v8->load_seek_next_frame(state_of_mind->state, &image_local)));
+
+    if (image_local->pixels != NULL) {
+        SAIL_LOG_ERROR("Internal error in %s codec: codecs must not allocate pixels", state_of_mind->codec_info->name);
+        sail_destroy_image(image_local);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    fill_source_image_dimensions(image_local);
+
+    SAIL_TRY_OR_CLEANUP(prepare_crop(state_of_mind, image_local),
+                        /* cleanup */ sail_destroy_image(image_local));
+    SAIL_TRY_OR_CLEANUP(prepare_orientation(state_of_mind, image_local),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+/* The number of scan lines read at once when the frame is read in bands. */
+static const unsigned SAIL_LOAD_BAND_ROWS = 16;
+
+/*
+ * Reads the frame pixels into the buffer converting them into the requested output pixel format
+ * when the codec cannot decode into it natively. The image pixels stay NULL.
+ */
+static sail_status_t load_frame(struct hidden_state *state_of_mind, struct sail_image *image, void *pixels, unsigned bytes_per_line) {
+
+    const enum SailPixelFormat output = output_pixel_format(state_of_mind, image);
+
+    /* The codec decodes straight into the buffer. */
+    if (output == image->pixel_format && bytes_per_line == image->bytes_per_line) {
+        image->pixels = pixels;
+
+        SAIL_TRY_OR_CLEANUP(load_codec_frame(state_of_mind, image),
+                            /* cleanup */ image->pixels = NULL);
+
+        image->pixels = NULL;
+
+        return SAIL_OK;
+    }
+
+    /*
+     * Read padded or converted scan lines in small bands straight into their places
+     * in the buffer, so the converted frame is written once and never read back.
+     */
+    struct frame_rows frame_rows;
+    SAIL_TRY(init_frame_rows(&frame_rows, image, output));
+
+    for (unsigned row = 0; row < image->height; row += SAIL_LOAD_BAND_ROWS) {
+        const unsigned rows_count = (image->height - row < SAIL_LOAD_BAND_ROWS) ? image->height - row : SAIL_LOAD_BAND_ROWS;
+
+        SAIL_TRY_OR_CLEANUP(read_frame_rows_into(state_of_mind, &frame_rows, (unsigned char *)pixels + (size_t)row * bytes_per_line,
+                                                 rows_count, bytes_per_line),
+                            /* cleanup */ release_frame_rows(&frame_rows));
+    }
+
+    release_frame_rows(&frame_rows);
+
+    image->pixel_format   = output;
+    image->bytes_per_line = bytes_per_line;
+
+    if (!sail_is_indexed(output)) {
+        sail_destroy_palette(image->palette);
+        image->palette = NULL;
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **image, const struct sail_codec_info **codec_info) {
 
     SAIL_CHECK_PTR(io);
@@ -46,19 +139,36 @@ sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **image, const
     struct sail_load_options *load_options_local;
     SAIL_TRY(sail_alloc_load_options_from_features((*codec_info_local)->load_features, &load_options_local));
 
+    struct sail_io *io_trace = NULL;
+
+    if (sail_trace_is_enabled()) {
+        SAIL_TRY_OR_CLEANUP(alloc_io_trace(io, (*codec_info_local)->name, &io_trace),
+                            /* cleanup */ sail_destroy_load_options(load_options_local));
+    }
+
     void *state = NULL;
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_init(io, load_options_local, &state),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_init", 0,
+                            codec->v8->load_init((io_trace == NULL) ? io : io_trace, load_options_local, &state)),
                         /* cleanup */ codec->v8->load_finish(&state),
+                                      sail_destroy_io(io_trace),
                                       sail_destroy_load_options(load_options_local));
 
     sail_destroy_load_options(load_options_local);
 
     struct sail_image *image_local;
 
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_seek_next_frame(state, &image_local),
-                        /* cleanup */ codec->v8->load_finish(&state));
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_finish(&state),
-                        /* ceanup */ sail_destroy_image(image_local));
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_seek_next_frame", 0,
+                            codec->v8->load_seek_next_frame(state, &image_local)),
+                        /* cleanup */ codec->v8->load_finish(&state),
+                                      sail_destroy_io(io_trace));
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_finish", 0,
+                            codec->v8->load_finish(&state)),
+                        /* ceanup */ sail_destroy_image(image_local),
+                                     sail_destroy_io(io_trace));
+
+    sail_destroy_io(io_trace);
+
+    fill_source_image_dimensions(image_local);
 
     *image = image_local;
 
@@ -106,20 +216,64 @@ sail_status_t sail_load_next_frame(void *state, struct sail_image **image) {
     SAIL_CHECK_PTR(state_of_mind->codec);
 
     struct sail_image *image_local;
-    SAIL_TRY(state_of_mind->codec->v8->load_seek_next_frame(state_of_mind->state, &image_local));
+    SAIL_TRY(seek_next_frame(state_of_mind, &image_local));
 
-    if (image_local->pixels != NULL) {
-        SAIL_LOG_ERROR("Internal error in %s codec: codecs must not allocate pixels", state_of_mind->codec_info->name);
-        sail_destroy_image(image_local);
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
-    }
+    const unsigned bytes_per_line = sail_bytes_per_line(image_local->width, output_pixel_format(state_of_mind, image_local));
 
     /* Allocate pixels. */
-    const size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
-    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
+    const size_t pixels_size = (size_t)image_local->height * bytes_per_line;
+    void *pixels;
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CALL("libsail", "alloc_pixels", state_of_mind->codec_info->name, pixels_size, 0,
+                            sail_malloc(pixels_size, &pixels)),
                         /* cleanup */ sail_destroy_image(image_local));
 
-    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->load_frame(state_of_mind->state, image_local),
+    SAIL_TRY_OR_CLEANUP(load_frame(state_of_mind, image_local, pixels, bytes_per_line),
+                        /* cleanup */ sail_free(pixels),
+                                      sail_destroy_image(image_local));
+
+    image_local->pixels = pixels;
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_load_next_frame_into(void *state, void *pixels, size_t pixels_size, unsigned bytes_per_line,
+                                        struct sail_image **image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(pixels);
+    SAIL_CHECK_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    struct sail_image *image_local;
+    SAIL_TRY(seek_next_frame(state_of_mind, &image_local));
+
+    const unsigned natural_bytes_per_line = sail_bytes_per_line(image_local->width, output_pixel_format(state_of_mind, image_local));
+    const unsigned bytes_per_line_local = (bytes_per_line == 0) ? natural_bytes_per_line : bytes_per_line;
+
+    if (bytes_per_line_local < natural_bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than the natural %u bytes per line", bytes_per_line_local, natural_bytes_per_line);
+        sail_destroy_image(image_local);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    const size_t required_pixels_size = (size_t)image_local->height * bytes_per_line_local;
+
+    if (pixels_size < required_pixels_size) {
+        SAIL_LOG_ERROR("The pixel buffer of %lu bytes is too small, %lu bytes required",
+                        (unsigned long)pixels_size, (unsigned long)required_pixels_size);
+        sail_destroy_image(image_local);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* The caller's pixels are never freed. */
+    SAIL_TRY_OR_CLEANUP(load_frame(state_of_mind, image_local, pixels, bytes_per_line_local),
                         /* cleanup */ sail_destroy_image(image_local));
 
     *image = image_local;
@@ -127,6 +281,62 @@ sail_status_t sail_load_next_frame(void *state, struct sail_image **image) {
     return SAIL_OK;
 }
 
+sail_status_t sail_start_frame_rows(void *state, struct sail_image **image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    struct sail_image *image_native;
+    SAIL_TRY(seek_next_frame(state_of_mind, &image_native));
+
+    struct sail_image *image_local;
+    SAIL_TRY_OR_CLEANUP(sail_copy_image(image_native, &image_local),
+                        /* cleanup */ sail_destroy_image(image_native));
+
+    const enum SailPixelFormat output = output_pixel_format(state_of_mind, image_native);
+
+    /* Takes the ownership of the native image. */
+    SAIL_TRY_OR_CLEANUP(alloc_frame_rows(image_native, output, &state_of_mind->frame_rows),
+                        /* cleanup */ sail_destroy_image(image_local),
+                                      sail_destroy_image(image_native));
+
+    if (output != image_local->pixel_format) {
+        image_local->pixel_format   = output;
+        image_local->bytes_per_line = state_of_mind->frame_rows->output_bytes_per_line;
+
+        if (!sail_is_indexed(output)) {
+            sail_destroy_palette(image_local->palette);
+            image_local->palette = NULL;
+        }
+    }
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_read_rows(void *state, void *rows, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(rows);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    SAIL_TRY(read_frame_rows(state_of_mind, rows, rows_count));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_loading(void *state) {
 
     /* Not an error. */
@@ -142,7 +352,8 @@ sail_status_t sail_stop_loading(void *state) {
         return SAIL_OK;
     }
 
-    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->load_finish(&state_of_mind->state),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "load_finish", 0,
+                            state_of_mind->codec->v8->load_finish(&state_of_mind->state)),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
 
     destroy_hidden_state(state_of_mind);
@@ -164,6 +375,13 @@ sail_status_t sail_start_saving_into_memory(void *buffer, size_t buffer_length,
     return SAIL_OK;
 }
 
+sail_status_t sail_start_saving_into_dynamic_memory(const struct sail_codec_info *codec_info, void **state) {
+
+    SAIL_TRY(sail_start_saving_into_dynamic_memory_with_options(codec_info, NULL, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_write_next_frame(void *state, const struct sail_image *image) {
 
     SAIL_CHECK_PTR(state);
@@ -180,8 +398,104 @@ sail_status_t sail_write_next_frame(void *state, const struct sail_image *image)
     SAIL_TRY(allowed_write_output_pixel_format(state_of_mind->codec_info->save_features,
                                                 image->pixel_format));
 
-    SAIL_TRY(state_of_mind->codec->v8->save_seek_next_frame(state_of_mind->state, image));
-    SAIL_TRY(state_of_mind->codec->v8->save_frame(state_of_mind->state, image));
+    /* Frames written with sail_write_rows() end here. */
+    destroy_frame_rows(state_of_mind->frame_rows);
+    state_of_mind->frame_rows = NULL;
+
+    SAIL_TRY(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_seek_next_frame", 0,
+                                   state_of_mind->codec->v8->save_seek_next_frame(state_of_mind->state, image)));
+    SAIL_TRY(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_frame", (uint64_t)image->width * image->height,
+                                   state_of_mind->codec->v8->save_frame(state_of_mind->state, image)));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_start_writing_frame_rows(void *state, const struct sail_image *image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec_info);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    SAIL_TRY(sail_check_image_skeleton_valid(image));
+
+    /* Check if we actually able to save the requested pixel format. */
+    SAIL_TRY(allowed_write_output_pixel_format(state_of_mind->codec_info->save_features,
+                                                image->pixel_format));
+
+    destroy_frame_rows(state_of_mind->frame_rows);
+    state_of_mind->frame_rows = NULL;
+
+    /* Copy everything but pixels. */
+    struct sail_image image_without_pixels = *image;
+    image_without_pixels.pixels = NULL;
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_copy_image(&image_without_pixels, &image_local));
+
+    /* Codecs without save_rows() seek after the whole frame is buffered. */
+    if (state_of_mind->codec->v8->save_rows != NULL) {
+        SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_seek_next_frame", 0,
+                                state_of_mind->codec->v8->save_seek_next_frame(state_of_mind->state, image_local)),
+                            /* cleanup */ sail_destroy_image(image_local));
+    }
+
+    /* Takes the ownership of the image. */
+    SAIL_TRY_OR_CLEANUP(alloc_frame_rows(image_local, image_local->pixel_format, &state_of_mind->frame_rows),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_write_rows(void *state, const void *rows, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(rows);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    SAIL_TRY(write_frame_rows(state_of_mind, rows, rows_count));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_write_next_frame_from_rows(void *state, const struct sail_image *image, unsigned band_rows,
+                                              sail_row_provider_t provider, void *user_data) {
+
+    SAIL_CHECK_PTR(image);
+    SAIL_CHECK_PTR(provider);
+
+    if (band_rows == 0) {
+        SAIL_LOG_ERROR("Band must have at least one scan line");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    SAIL_TRY(sail_start_writing_frame_rows(state, image));
+
+    const unsigned rows_in_band = (band_rows < image->height) ? band_rows : image->height;
+
+    void *rows;
+    SAIL_TRY(sail_malloc((size_t)rows_in_band * image->bytes_per_line, &rows));
+
+    for (unsigned row = 0; row < image->height; row += rows_in_band) {
+        const unsigned rows_count = (image->height - row < rows_in_band) ? image->height - row : rows_in_band;
+
+        SAIL_TRY_OR_CLEANUP(provider(row, rows, rows_count, user_data),
+                            /* cleanup */ sail_free(rows));
+        SAIL_TRY_OR_CLEANUP(sail_write_rows(state, rows, rows_count),
+                            /* cleanup */ sail_free(rows));
+    }
+
+    sail_free(rows);
 
     return SAIL_OK;
 }
@@ -192,3 +506,35 @@ sail_status_t sail_stop_saving(void *state) {
 
     return SAIL_OK;
 }
+
+sail_status_t sail_stop_saving_into_dynamic_memory(void *state, void **buffer, size_t *buffer_length) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+    struct sail_io *io = state_of_mind->io;
+
+    if (io == NULL || io->id != SAIL_DYNAMIC_MEMORY_IO_ID) {
+        SAIL_LOG_ERROR("Saving was not started with sail_start_saving_into_dynamic_memory()");
+        stop_saving(state, NULL);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_IO);
+    }
+
+    /* Keep the I/O object alive to take the buffer from it. */
+    const bool own_io = state_of_mind->own_io;
+    state_of_mind->own_io = false;
+
+    SAIL_TRY_OR_CLEANUP(stop_saving(state, NULL),
+                        /* cleanup */ if (own_io) sail_destroy_io(io));
+
+    SAIL_TRY_OR_CLEANUP(sail_take_buffer_from_dynamic_memory_io(io, buffer, buffer_length),
+                        /* cleanup */ if (own_io) sail_destroy_io(io));
+
+    if (own_io) {
+        sail_destroy_io(io);
+    }
+
+    return SAIL_OK;
+}
@@ -115,6 +115,62 @@ SAIL_EXPORT sail_status_t sail_start_loading_from_memory(const void *buffer, siz
  */
 SAIL_EXPORT sail_status_t sail_load_next_frame(void *state, struct sail_image **image);
 
+/*
+ * Continues loading the file started by sail_start_loading_from_file() and brothers. Decodes the frame
+ * pixels into the specified caller-provided buffer instead of allocating a new one. Useful to decode
+ * into pooled or mapped memory like texture upload buffers.
+ *
+ * Scan lines are stored with the specified 'bytes_per_line' stride. It must be greater or equal
+ * to the natural scan line length of the frame. Pass 0 to use the natural scan line length
+ * returned by sail_bytes_per_line().
+ *
+ * The buffer must be at least 'bytes_per_line * height' bytes long. Frame dimensions are usually
+ * known in advance with sail_probe_file() and brothers. If the buffer is too small, the frame is
+ * skipped and SAIL_ERROR_INVALID_ARGUMENT is returned.
+ *
+ * Assigns the loaded image properties to the 'image' argument. Its pixels are set to NULL as the caller
+ * owns them. Its bytes per line are set to the stride used.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ */
+SAIL_EXPORT sail_status_t sail_load_next_frame_into(void *state, void *pixels, size_t pixels_size, unsigned bytes_per_line,
+                                                    struct sail_image **image);
+
+/*
+ * Continues loading the file started by sail_start_loading_from_file() and brothers. Seeks to the next
+ * frame and assigns its properties without pixels to the 'image' argument. Read the frame pixels with
+ * sail_read_rows() then. Useful to process huge frames in bands of scan lines without holding
+ * the whole frame in memory.
+ *
+ * JPEG, PNG, BMP, TGA, TIFF, and PCX codecs decode scan lines on demand. For other codecs
+ * and frames that cannot be streamed, like interlaced PNG or RLE-compressed bottom-up BMP frames,
+ * libsail buffers the whole frame on the first read.
+ *
+ * Typical usage: sail_start_loading_from_file() ->
+ *                sail_start_frame_rows()        ->
+ *                sail_read_rows()               ->
+ *                ...
+ *                sail_read_rows()               ->
+ *                sail_stop_loading().
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ */
+SAIL_EXPORT sail_status_t sail_start_frame_rows(void *state, struct sail_image **image);
+
+/*
+ * Reads the next 'rows_count' scan lines of the frame started by sail_start_frame_rows() into the specified
+ * buffer. Scan lines are stored with the bytes per line of the image returned by sail_start_frame_rows().
+ * The buffer must be at least 'bytes_per_line * rows_count' bytes long.
+ *
+ * Read all the scan lines before continuing to the next frame.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when more scan lines are requested than left in the frame.
+ */
+SAIL_EXPORT sail_status_t sail_read_rows(void *state, void *rows, unsigned rows_count);
+
 /*
  * Stops loading the file started by sail_start_loading_from_file() and brothers.
  * Does nothing if the state is NULL.
@@ -164,6 +220,23 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_file(const char *path, const st
 SAIL_EXPORT sail_status_t sail_start_saving_into_memory(void *buffer, size_t buffer_length,
                                                         const struct sail_codec_info *codec_info, void **state);
 
+/*
+ * Starts saving into a growable memory buffer allocated by SAIL. Use it when the size of the saved image
+ * is not known in advance. Finish saving with sail_stop_saving_into_dynamic_memory() to take the buffer.
+ *
+ * Typical usage: sail_codec_info_from_extension()         ->
+ *                sail_start_saving_into_dynamic_memory()  ->
+ *                sail_write_next_frame()                  ->
+ *                sail_stop_saving_into_dynamic_memory().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_saving_into_dynamic_memory. States must be used per image.
+ * DO NOT use the same state to start saving multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_saving_into_dynamic_memory(const struct sail_codec_info *codec_info, void **state);
+
 /*
  * Continues saving started by sail_start_saving_into_file() and brothers. Writes the specified
  * image into the underlying I/O target.
@@ -176,6 +249,57 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_memory(void *buffer, size_t buf
  */
 SAIL_EXPORT sail_status_t sail_write_next_frame(void *state, const struct sail_image *image);
 
+/*
+ * Continues saving started by sail_start_saving_into_file() and brothers. Starts the next frame
+ * with the properties of the specified image. Its pixels are ignored and may be NULL. Write the frame
+ * pixels with sail_write_rows() then. Useful to save huge generated frames in bands of scan lines
+ * without holding the whole frame in memory.
+ *
+ * JPEG, PNG, and TIFF codecs encode scan lines as they are written. For other codecs and
+ * frames that cannot be streamed, like interlaced PNG, libsail buffers the whole frame and writes
+ * it after the last scan line.
+ *
+ * Typical usage: sail_start_saving_into_file()   ->
+ *                sail_start_writing_frame_rows() ->
+ *                sail_write_rows()               ->
+ *                ...
+ *                sail_write_rows()               ->
+ *                sail_stop_saving().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_writing_frame_rows(void *state, const struct sail_image *image);
+
+/*
+ * Writes the next 'rows_count' scan lines of the frame started by sail_start_writing_frame_rows()
+ * from the specified buffer. Scan lines are stored with the bytes per line of the image passed to
+ * sail_start_writing_frame_rows(). The buffer must be at least 'bytes_per_line * rows_count' bytes long.
+ *
+ * Write all the scan lines before continuing to the next frame or stopping saving.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when more scan lines are written than left in the frame.
+ */
+SAIL_EXPORT sail_status_t sail_write_rows(void *state, const void *rows, unsigned rows_count);
+
+/*
+ * Row provider for sail_write_next_frame_from_rows(). Must fill 'rows_count' scan lines starting
+ * with 'first_row' into the specified buffer with the bytes per line of the image being saved.
+ *
+ * Returns SAIL_OK on success. Any other value stops saving the frame and is returned to the caller.
+ */
+typedef sail_status_t (*sail_row_provider_t)(unsigned first_row, void *rows, unsigned rows_count, void *user_data);
+
+/*
+ * Continues saving started by sail_start_saving_into_file() and brothers. Writes the next frame
+ * with the properties of the specified image pulling its scan lines from the row provider in bands
+ * of 'band_rows' scan lines. The image pixels are ignored and may be NULL.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_write_next_frame_from_rows(void *state, const struct sail_image *image, unsigned band_rows,
+                                                          sail_row_provider_t provider, void *user_data);
+
 /*
  * Stops saving started by sail_start_saving_into_file() and brothers. Closes the underlying I/O target.
  * Does nothing if the state is NULL.
@@ -187,6 +311,17 @@ SAIL_EXPORT sail_status_t sail_write_next_frame(void *state, const struct sail_i
  */
 SAIL_EXPORT sail_status_t sail_stop_saving(void *state);
 
+/*
+ * Stops saving started by sail_start_saving_into_dynamic_memory() and brothers. Transfers the ownership
+ * of the saved data to the caller. The buffer must be freed with sail_free(). Assigns the number of bytes
+ * written to 'buffer_length'.
+ *
+ * The state is destroyed even if this function fails.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_stop_saving_into_dynamic_memory(void *state, void **buffer, size_t *buffer_length);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
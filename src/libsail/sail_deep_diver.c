@@ -44,7 +44,7 @@ sail_status_t sail_start_loading_from_file_with_options(const char *path, const
     }
 
     struct sail_io *io;
-    SAIL_TRY(sail_alloc_io_read_file(path, &io));
+    SAIL_TRY(alloc_io_read_file_for_loading(path, &io));
 
     SAIL_TRY(start_loading_io_with_options(io, true, codec_info_local, load_options, state));
 
@@ -110,6 +110,20 @@ sail_status_t sail_start_saving_into_memory_with_options(void *buffer, size_t bu
     return SAIL_OK;
 }
 
+sail_status_t sail_start_saving_into_dynamic_memory_with_options(const struct sail_codec_info *codec_info,
+                                                                 const struct sail_save_options *save_options,
+                                                                 void **state) {
+    SAIL_CHECK_PTR(codec_info);
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_write_dynamic_memory(&io));
+
+    /* The I/O object will be destroyed in this function. */
+    SAIL_TRY(start_saving_io_with_options(io, true, codec_info, save_options, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_saving_with_written(void *state, size_t *written) {
 
     SAIL_TRY(stop_saving(state, written));
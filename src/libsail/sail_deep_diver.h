@@ -138,6 +138,27 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_memory_with_options(void *buffe
                                                                      const struct sail_codec_info *codec_info,
                                                                      const struct sail_save_options *save_options, void **state);
 
+/*
+ * Starts saving into a growable memory buffer allocated by SAIL with the specified save options.
+ * If you do not need specific save options, just pass NULL. Codec-specific defaults will be used in this case.
+ *
+ * The save options are deep copied.
+ *
+ * Typical usage: sail_codec_info_from_extension()                     ->
+ *                sail_start_saving_into_dynamic_memory_with_options() ->
+ *                sail_write_next_frame()                              ->
+ *                sail_stop_saving_into_dynamic_memory().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_saving_into_dynamic_memory. States must be used per image.
+ * DO NOT use the same state to start saving multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_saving_into_dynamic_memory_with_options(const struct sail_codec_info *codec_info,
+                                                                             const struct sail_save_options *save_options,
+                                                                             void **state);
+
 
 /*
  * Stops saving started by sail_start_saving_into_file() and brothers. Closes the underlying I/O target.
@@ -37,7 +37,7 @@
 static sail_status_t probe_file_with_io(const char *path, struct sail_image **image, const struct sail_codec_info **codec_info) {
 
     struct sail_io *io;
-    SAIL_TRY(sail_alloc_io_read_file(path, &io));
+    SAIL_TRY(alloc_io_read_file_for_loading(path, &io));
 
     SAIL_TRY_OR_CLEANUP(sail_probe_io(io, image, codec_info),
                         /* cleanup */ sail_destroy_io(io));
@@ -68,12 +68,22 @@ sail_status_t sail_probe_file(const char *path, struct sail_image **image, const
     SAIL_TRY(sail_alloc_load_options_from_features((*codec_info_local)->load_features, &load_options_local));
 
     struct sail_io *io;
-    SAIL_TRY_OR_CLEANUP(sail_alloc_io_read_file(path, &io),
+    SAIL_TRY_OR_CLEANUP(alloc_io_read_file_for_loading(path, &io),
                         /* cleanup */ sail_destroy_load_options(load_options_local));
 
+    struct sail_io *io_trace = NULL;
+
+    if (sail_trace_is_enabled()) {
+        SAIL_TRY_OR_CLEANUP(alloc_io_trace(io, (*codec_info_local)->name, &io_trace),
+                            /* cleanup */ sail_destroy_io(io),
+                                          sail_destroy_load_options(load_options_local));
+    }
+
     void *state = NULL;
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_init(io, load_options_local, &state),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_init", 0,
+                            codec->v8->load_init((io_trace == NULL) ? io : io_trace, load_options_local, &state)),
                         /* cleanup */ codec->v8->load_finish(&state),
+                                      sail_destroy_io(io_trace),
                                       sail_destroy_io(io),
                                       sail_destroy_load_options(load_options_local));
 
@@ -81,16 +91,23 @@ sail_status_t sail_probe_file(const char *path, struct sail_image **image, const
 
     struct sail_image *image_local;
 
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_seek_next_frame(state, &image_local),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_seek_next_frame", 0,
+                            codec->v8->load_seek_next_frame(state, &image_local)),
                         /* cleanup */ codec->v8->load_finish(&state),
+                                      sail_destroy_io(io_trace),
                                       sail_destroy_io(io));
 
-    SAIL_TRY_OR_CLEANUP(codec->v8->load_finish(&state),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(*codec_info_local, "load_finish", 0,
+                            codec->v8->load_finish(&state)),
                         /* cleanup */ sail_destroy_image(image_local),
+                                      sail_destroy_io(io_trace),
                                       sail_destroy_io(io));
 
+    sail_destroy_io(io_trace);
     sail_destroy_io(io);
 
+    fill_source_image_dimensions(image_local);
+
     *image = image_local;
 
     return SAIL_OK;
@@ -177,3 +194,24 @@ sail_status_t sail_save_into_memory(void *buffer, size_t buffer_length, const st
 
     return SAIL_OK;
 }
+
+sail_status_t sail_save_into_dynamic_memory(const struct sail_image *image, const struct sail_codec_info *codec_info,
+                                            void **buffer, size_t *buffer_length) {
+
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(codec_info);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+
+    void *state = NULL;
+
+    SAIL_TRY_OR_CLEANUP(sail_start_saving_into_dynamic_memory(codec_info, &state),
+                        sail_stop_saving(state));
+
+    SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, image),
+                        sail_stop_saving(state));
+
+    SAIL_TRY(sail_stop_saving_into_dynamic_memory(state, buffer, buffer_length));
+
+    return SAIL_OK;
+}
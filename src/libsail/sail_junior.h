@@ -103,6 +103,24 @@ SAIL_EXPORT sail_status_t sail_save_into_file(const char *path, const struct sai
  */
 SAIL_EXPORT sail_status_t sail_save_into_memory(void *buffer, size_t buffer_length, const struct sail_image *image, size_t *written);
 
+/*
+ * Saves the specified image into a new memory buffer allocated by SAIL using the specified codec.
+ * The buffer grows as needed, so there is no need to guess the resulting size. Transfers the ownership
+ * of the buffer to the caller. The buffer must be freed with sail_free(). Assigns the number of bytes
+ * written to 'buffer_length'.
+ *
+ * If the selected image format doesn't support the image pixel format, an error is returned.
+ * Consider converting the image into a supported image format beforehand with functions
+ * from sail-manip.
+ *
+ * Typical usage: sail_codec_info_from_extension() ->
+ *                sail_save_into_dynamic_memory().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_save_into_dynamic_memory(const struct sail_image *image, const struct sail_codec_info *codec_info,
+                                                        void **buffer, size_t *buffer_length);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
@@ -74,6 +74,98 @@ static sail_status_t load_codec_by_codec_info_unsafe(const struct sail_codec_inf
     return SAIL_OK;
 }
 
+/* Returns true if the orientation rotates frames by 90 or 270 degrees. */
+static bool orientation_swaps_dimensions(enum SailOrientation orientation) {
+
+    switch (orientation) {
+        case SAIL_ORIENTATION_ROTATED_90:
+        case SAIL_ORIENTATION_ROTATED_270:
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90:
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270: {
+            return true;
+        }
+
+        default: {
+            return false;
+        }
+    }
+}
+
+/*
+ * Computes where the stored pixels go in the upright frame: the offset of the first stored pixel,
+ * and the offsets between horizontally and vertically adjacent stored pixels.
+ */
+static void orientation_steps(enum SailOrientation orientation, const struct sail_image *image, unsigned bytes_per_pixel,
+                                ptrdiff_t *origin, ptrdiff_t *x_step, ptrdiff_t *y_step) {
+
+    const ptrdiff_t pixel = bytes_per_pixel;
+    const ptrdiff_t line  = image->bytes_per_line;
+    const ptrdiff_t last_pixel = (ptrdiff_t)(image->width - 1) * pixel;
+    const ptrdiff_t last_line  = (ptrdiff_t)(image->height - 1) * line;
+
+    switch (orientation) {
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY:             *origin = last_pixel;             *x_step = -pixel; *y_step = line;   break;
+        case SAIL_ORIENTATION_MIRRORED_VERTICALLY:               *origin = last_line;              *x_step = pixel;  *y_step = -line;  break;
+        case SAIL_ORIENTATION_ROTATED_180:                       *origin = last_line + last_pixel; *x_step = -pixel; *y_step = -line;  break;
+        case SAIL_ORIENTATION_ROTATED_90:                        *origin = last_pixel;             *x_step = line;   *y_step = -pixel; break;
+        case SAIL_ORIENTATION_ROTATED_270:                       *origin = last_line;              *x_step = -line;  *y_step = pixel;  break;
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90:  *origin = last_line + last_pixel; *x_step = -line;  *y_step = -pixel; break;
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270: *origin = 0;                      *x_step = line;   *y_step = pixel;  break;
+
+        default: {
+            *origin = 0;
+            *x_step = pixel;
+            *y_step = line;
+        }
+    }
+}
+
+/*
+ * Copies stored scan lines into the upright frame. Frames rotated by 90 or 270 degrees are written
+ * column by column, so every output scan line is written with consecutive stores.
+ */
+static inline void orient_rows(const unsigned char *rows, unsigned bytes_per_line, unsigned width, unsigned rows_count,
+                                unsigned char *output, ptrdiff_t x_step, ptrdiff_t y_step, unsigned bytes_per_pixel) {
+
+    if (x_step == (ptrdiff_t)bytes_per_pixel || x_step == -(ptrdiff_t)bytes_per_pixel) {
+        for (unsigned row = 0; row < rows_count; row++) {
+            const unsigned char *pixel = rows + (size_t)row * bytes_per_line;
+            unsigned char *scan = output + (ptrdiff_t)row * y_step;
+
+            for (unsigned column = 0; column < width; column++, pixel += bytes_per_pixel, scan += x_step) {
+                memcpy(scan, pixel, bytes_per_pixel);
+            }
+        }
+    } else {
+        for (unsigned column = 0; column < width; column++) {
+            const unsigned char *pixel = rows + (size_t)column * bytes_per_pixel;
+            unsigned char *scan = output + (ptrdiff_t)column * x_step;
+
+            for (unsigned row = 0; row < rows_count; row++, pixel += bytes_per_line, scan += y_step) {
+                memcpy(scan, pixel, bytes_per_pixel);
+            }
+        }
+    }
+}
+
+static void orient_rows_any(const unsigned char *rows, unsigned bytes_per_line, unsigned width, unsigned rows_count,
+                            unsigned char *output, ptrdiff_t x_step, ptrdiff_t y_step, unsigned bytes_per_pixel) {
+
+    /* Specialize the most common pixel sizes. */
+    switch (bytes_per_pixel) {
+        case 1: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 1); break;
+        case 2: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 2); break;
+        case 3: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 3); break;
+        case 4: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 4); break;
+        case 6: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 6); break;
+        case 8: orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, 8); break;
+
+        default: {
+            orient_rows(rows, bytes_per_line, width, rows_count, output, x_step, y_step, bytes_per_pixel);
+        }
+    }
+}
+
 /*
  * Public functions.
  */
@@ -93,17 +185,33 @@ sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info,
     return SAIL_OK;
 }
 
+sail_status_t alloc_io_read_file_for_loading(const char *path, struct sail_io **io) {
+
+    SAIL_CHECK_PTR(path);
+    SAIL_CHECK_PTR(io);
+
+    SAIL_TRY_OR_EXECUTE(sail_alloc_io_read_mmap(path, io),
+                        /* on error */ SAIL_LOG_DEBUG("Falling back to reading the file '%s' with stdio", path);
+                                       SAIL_TRY(sail_alloc_io_read_file(path, io)));
+
+    return SAIL_OK;
+}
+
 void destroy_hidden_state(struct hidden_state *state) {
 
     if (state == NULL) {
         return;
     }
 
+    sail_destroy_io(state->io_trace);
+
     if (state->own_io) {
         sail_destroy_io(state->io);
     }
 
     sail_destroy_save_options(state->save_options);
+    sail_destroy_load_options(state->load_options);
+    destroy_frame_rows(state->frame_rows);
 
     /* This state must be freed and zeroed by codecs. We free it just in case to avoid memory leaks. */
     sail_free(state->state);
@@ -130,7 +238,8 @@ sail_status_t stop_saving(void *state, size_t *written) {
         return SAIL_OK;
     }
 
-    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->save_finish(&state_of_mind->state),
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state_of_mind->codec_info, "save_finish", 0,
+                            state_of_mind->codec->v8->save_finish(&state_of_mind->state)),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
 
     if (written != NULL) {
@@ -158,3 +267,305 @@ sail_status_t allowed_write_output_pixel_format(const struct sail_save_features
     print_unsupported_write_pixel_format(pixel_format);
     SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
 }
+
+void fill_source_image_dimensions(struct sail_image *image) {
+
+    if (image->source_image == NULL) {
+        return;
+    }
+
+    if (image->source_image->width == 0 && image->source_image->height == 0) {
+        image->source_image->width  = image->width;
+        image->source_image->height = image->height;
+    }
+}
+
+sail_status_t prepare_crop(struct hidden_state *state, struct sail_image *image) {
+
+    state->crop_source_width = 0;
+
+    if (!sail_has_roi(state->load_options)) {
+        return SAIL_OK;
+    }
+
+    const unsigned source_width  = image->source_image->width;
+    const unsigned source_height = image->source_image->height;
+
+    unsigned roi_x, roi_y, roi_width, roi_height;
+
+    if (!sail_clip_roi(state->load_options, source_width, source_height, &roi_x, &roi_y, &roi_width, &roi_height)) {
+        SAIL_LOG_ERROR("The region of interest doesn't intersect the %ux%u frame", source_width, source_height);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* Cropped natively by the codec. */
+    if (image->width == roi_width && image->height == roi_height) {
+        return SAIL_OK;
+    }
+
+    if (image->width != source_width || image->height != source_height) {
+        SAIL_LOG_ERROR("Internal error in %s codec: %ux%u frame doesn't match neither the %ux%u source image nor the %ux%u region of interest",
+                        state->codec_info->name, image->width, image->height, source_width, source_height, roi_width, roi_height);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    SAIL_LOG_DEBUG("%s codec cannot crop frames, cropping %ux%u region at %u,%u", state->codec_info->name, roi_width, roi_height, roi_x, roi_y);
+
+    state->crop_x                     = roi_x;
+    state->crop_y                     = roi_y;
+    state->crop_source_width          = image->width;
+    state->crop_source_height         = image->height;
+    state->crop_source_bytes_per_line = image->bytes_per_line;
+
+    image->width          = roi_width;
+    image->height         = roi_height;
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    return SAIL_OK;
+}
+
+/*
+ * Reads the scan lines down to the bottom of the region of interest one by one, so the rest of the frame
+ * is never decoded. Returns SAIL_ERROR_NOT_IMPLEMENTED if the codec cannot stream scan lines.
+ * The image has the source dimensions.
+ */
+static sail_status_t load_cropped_rows(struct hidden_state *state, struct sail_image *image,
+                                        void *pixels, unsigned bytes_per_line, unsigned roi_width, unsigned roi_height) {
+
+    if (state->codec->v8->load_rows == NULL) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    void *scan_line;
+    SAIL_TRY(sail_malloc(image->bytes_per_line, &scan_line));
+
+    for (unsigned row = 0; row < state->crop_y + roi_height; row++) {
+        const sail_status_t status = SAIL_TRACE_CODEC_CALL(state->codec_info, "load_rows", image->width,
+                                                            state->codec->v8->load_rows(state->state, image, scan_line, 1));
+
+        if (status != SAIL_OK) {
+            sail_free(scan_line);
+
+            if (status == SAIL_ERROR_NOT_IMPLEMENTED && row == 0) {
+                return status;
+            }
+
+            SAIL_LOG_ERROR("Failed to read scan lines from %s codec", state->codec_info->name);
+            return (status == SAIL_ERROR_NOT_IMPLEMENTED) ? SAIL_ERROR_UNDERLYING_CODEC : status;
+        }
+
+        if (row >= state->crop_y) {
+            sail_crop_scan_line(scan_line, image->pixel_format, state->crop_x, roi_width,
+                                (unsigned char *)pixels + (size_t)(row - state->crop_y) * bytes_per_line);
+        }
+    }
+
+    sail_free(scan_line);
+
+    return SAIL_OK;
+}
+
+/* Reads the whole frame and crops it. */
+static sail_status_t load_cropped_frame(struct hidden_state *state, struct sail_image *image,
+                                        void *pixels, unsigned bytes_per_line, unsigned roi_width, unsigned roi_height) {
+
+    void *source_pixels;
+    SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &source_pixels));
+
+    image->pixels = source_pixels;
+
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(state->codec_info, "load_frame", (uint64_t)image->width * image->height,
+                            state->codec->v8->load_frame(state->state, image)),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(source_pixels));
+
+    image->pixels = NULL;
+
+    for (unsigned row = 0; row < roi_height; row++) {
+        sail_crop_scan_line((const unsigned char *)source_pixels + (size_t)(state->crop_y + row) * image->bytes_per_line,
+                            image->pixel_format, state->crop_x, roi_width,
+                            (unsigned char *)pixels + (size_t)row * bytes_per_line);
+    }
+
+    sail_free(source_pixels);
+
+    return SAIL_OK;
+}
+
+/* Loads the frame as stored cropping it to the region of interest if necessary. */
+static sail_status_t load_stored_frame(struct hidden_state *state, struct sail_image *image) {
+
+    if (state->crop_source_width == 0) {
+        SAIL_TRY(SAIL_TRACE_CODEC_CALL(state->codec_info, "load_frame", (uint64_t)image->width * image->height,
+                                       state->codec->v8->load_frame(state->state, image)));
+        return SAIL_OK;
+    }
+
+    void *pixels                  = image->pixels;
+    const unsigned roi_width      = image->width;
+    const unsigned roi_height     = image->height;
+    const unsigned bytes_per_line = image->bytes_per_line;
+
+    /* Codecs decode frames of the source dimensions. */
+    image->width          = state->crop_source_width;
+    image->height         = state->crop_source_height;
+    image->bytes_per_line = state->crop_source_bytes_per_line;
+    image->pixels         = NULL;
+
+    sail_status_t status = load_cropped_rows(state, image, pixels, bytes_per_line, roi_width, roi_height);
+
+    if (status == SAIL_ERROR_NOT_IMPLEMENTED) {
+        status = load_cropped_frame(state, image, pixels, bytes_per_line, roi_width, roi_height);
+    }
+
+    image->width          = roi_width;
+    image->height         = roi_height;
+    image->bytes_per_line = bytes_per_line;
+    image->pixels         = pixels;
+
+    return status;
+}
+
+/*
+ * Reads stored scan lines in bands and writes them into their upright positions in the pixels,
+ * so no temporary frame is needed. Returns SAIL_ERROR_NOT_IMPLEMENTED if the codec cannot stream
+ * scan lines. The image has the stored dimensions.
+ */
+static sail_status_t load_oriented_rows(struct hidden_state *state, struct sail_image *image,
+                                        unsigned char *origin, ptrdiff_t x_step, ptrdiff_t y_step, unsigned bytes_per_pixel) {
+
+    if (state->codec->v8->load_rows == NULL || state->crop_source_width != 0) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /* Bands let the column by column writes fill whole cache lines. */
+    const unsigned band_rows = SAIL_MIN(image->height, 16U);
+
+    void *band;
+    SAIL_TRY(sail_malloc((size_t)band_rows * image->bytes_per_line, &band));
+
+    for (unsigned row = 0; row < image->height; row += band_rows) {
+        const unsigned rows_count = SAIL_MIN(band_rows, image->height - row);
+        const sail_status_t status = SAIL_TRACE_CODEC_CALL(state->codec_info, "load_rows", (uint64_t)image->width * rows_count,
+                                                            state->codec->v8->load_rows(state->state, image, band, rows_count));
+
+        if (status != SAIL_OK) {
+            sail_free(band);
+
+            if (status == SAIL_ERROR_NOT_IMPLEMENTED && row == 0) {
+                return status;
+            }
+
+            SAIL_LOG_ERROR("Failed to read scan lines from %s codec", state->codec_info->name);
+            return (status == SAIL_ERROR_NOT_IMPLEMENTED) ? SAIL_ERROR_UNDERLYING_CODEC : status;
+        }
+
+        orient_rows_any(band, image->bytes_per_line, image->width, rows_count,
+                        origin + (ptrdiff_t)row * y_step, x_step, y_step, bytes_per_pixel);
+    }
+
+    sail_free(band);
+
+    return SAIL_OK;
+}
+
+/* Reads the whole stored frame and writes it upright into the pixels. */
+static sail_status_t load_oriented_frame(struct hidden_state *state, struct sail_image *image,
+                                            unsigned char *origin, ptrdiff_t x_step, ptrdiff_t y_step, unsigned bytes_per_pixel) {
+
+    void *stored_pixels;
+    SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &stored_pixels));
+
+    image->pixels = stored_pixels;
+
+    SAIL_TRY_OR_CLEANUP(load_stored_frame(state, image),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(stored_pixels));
+
+    image->pixels = NULL;
+
+    orient_rows_any(stored_pixels, image->bytes_per_line, image->width, image->height,
+                    origin, x_step, y_step, bytes_per_pixel);
+
+    sail_free(stored_pixels);
+
+    return SAIL_OK;
+}
+
+sail_status_t prepare_orientation(struct hidden_state *state, struct sail_image *image) {
+
+    state->orientation = SAIL_ORIENTATION_NORMAL;
+
+    /* Other codecs either load frames upright or know nothing about the orientation. */
+    if (state->load_options == NULL || (state->load_options->options & SAIL_OPTION_APPLY_ORIENTATION) == 0 ||
+            (state->codec_info->load_features->features & SAIL_CODEC_FEATURE_EXIF_ORIENTATION) == 0 ||
+            image->source_image == NULL || image->source_image->orientation == SAIL_ORIENTATION_NORMAL) {
+        return SAIL_OK;
+    }
+
+    if (sail_bits_per_pixel(image->pixel_format) % 8 != 0) {
+        SAIL_LOG_WARNING("Cannot apply %s orientation to %s pixels, loading the frame as stored",
+                            sail_orientation_to_string(image->source_image->orientation),
+                            sail_pixel_format_to_string(image->pixel_format));
+        return SAIL_OK;
+    }
+
+    SAIL_LOG_DEBUG("Applying %s orientation", sail_orientation_to_string(image->source_image->orientation));
+
+    state->orientation = image->source_image->orientation;
+
+    if (orientation_swaps_dimensions(state->orientation)) {
+        const unsigned width = image->width;
+        image->width          = image->height;
+        image->height         = width;
+        image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+        if (image->resolution != NULL) {
+            const double x = image->resolution->x;
+            image->resolution->x = image->resolution->y;
+            image->resolution->y = x;
+        }
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t load_codec_frame(struct hidden_state *state, struct sail_image *image) {
+
+    if (state->orientation == SAIL_ORIENTATION_NORMAL) {
+        SAIL_TRY(load_stored_frame(state, image));
+        return SAIL_OK;
+    }
+
+    const unsigned bytes_per_pixel = sail_bits_per_pixel(image->pixel_format) / 8;
+
+    ptrdiff_t origin, x_step, y_step;
+    orientation_steps(state->orientation, image, bytes_per_pixel, &origin, &x_step, &y_step);
+
+    unsigned char *pixels         = image->pixels;
+    const unsigned width          = image->width;
+    const unsigned height         = image->height;
+    const unsigned bytes_per_line = image->bytes_per_line;
+
+    /* Codecs decode frames of the stored dimensions. */
+    if (orientation_swaps_dimensions(state->orientation)) {
+        image->width  = height;
+        image->height = width;
+    }
+
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+    image->pixels         = NULL;
+
+    sail_status_t status = load_oriented_rows(state, image, pixels + origin, x_step, y_step, bytes_per_pixel);
+
+    if (status == SAIL_ERROR_NOT_IMPLEMENTED) {
+        status = load_oriented_frame(state, image, pixels + origin, x_step, y_step, bytes_per_pixel);
+    }
+
+    image->width          = width;
+    image->height         = height;
+    image->bytes_per_line = bytes_per_line;
+    image->pixels         = pixels;
+
+    return status;
+}
@@ -39,6 +39,7 @@
     #include <sail-common/export.h>
 #endif
 
+struct frame_rows;
 struct sail_codec_info;
 struct sail_codec;
 struct sail_save_features;
@@ -48,12 +49,43 @@ struct hidden_state {
     struct sail_io *io;
     bool own_io;
 
+    /* The I/O object passed to the codec when tracing is enabled. Forwards all the calls to io. */
+    struct sail_io *io_trace;
+
     /*
      * Save operations use save options to check if the interlaced mode was requested on later stages.
      * It's also used to check if the supplied pixel format is supported.
      */
     struct sail_save_options *save_options;
 
+    /* Load operations use load options to crop frames to the region of interest. */
+    struct sail_load_options *load_options;
+
+    /*
+     * Load operations convert frames into this pixel format when codecs cannot decode into it natively.
+     * SAIL_PIXEL_FORMAT_UNKNOWN means no conversion.
+     */
+    enum SailPixelFormat output_pixel_format;
+
+    /* The frame being read with sail_read_rows(). */
+    struct frame_rows *frame_rows;
+
+    /*
+     * The region of interest of the current frame and the frame dimensions as the codec decodes it
+     * when the codec cannot crop the region natively. Zero crop_source_width means no cropping.
+     */
+    unsigned crop_x;
+    unsigned crop_y;
+    unsigned crop_source_width;
+    unsigned crop_source_height;
+    unsigned crop_source_bytes_per_line;
+
+    /*
+     * The orientation libsail applies to the current frame with SAIL_OPTION_APPLY_ORIENTATION.
+     * SAIL_ORIENTATION_NORMAL means the frame is loaded as stored.
+     */
+    enum SailOrientation orientation;
+
     /* Local state passed to codec loading and saving functions. */
     void *state;
 
@@ -65,10 +97,49 @@ struct hidden_state {
 SAIL_HIDDEN sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info,
                                                     const struct sail_codec **codec);
 
+/*
+ * Opens the specified file for loading. Maps the file into memory with sail_alloc_io_read_mmap()
+ * and falls back to sail_alloc_io_read_file() if the file cannot be mapped.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_read_file_for_loading(const char *path, struct sail_io **io);
+
 SAIL_HIDDEN void destroy_hidden_state(struct hidden_state *state);
 
 SAIL_HIDDEN sail_status_t stop_saving(void *state, size_t *written);
 
 SAIL_HIDDEN sail_status_t allowed_write_output_pixel_format(const struct sail_save_features *save_features, enum SailPixelFormat pixel_format);
 
+/*
+ * Sets the source image dimensions to the image dimensions if the codec hasn't set them,
+ * i.e. if the codec always decodes frames at the original resolution.
+ */
+SAIL_HIDDEN void fill_source_image_dimensions(struct sail_image *image);
+
+/*
+ * Crops the image returned by the codec to the region of interest from the load options if the codec
+ * hasn't done it natively. The image gets the dimensions of the region.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t prepare_crop(struct hidden_state *state, struct sail_image *image);
+
+/*
+ * Prepares the image returned by the codec to be loaded upright when SAIL_OPTION_APPLY_ORIENTATION
+ * is specified. The image gets swapped dimensions when the orientation rotates it by 90 or 270 degrees.
+ * Must be called after prepare_crop().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t prepare_orientation(struct hidden_state *state, struct sail_image *image);
+
+/*
+ * Loads the frame pixels into the image pixels cropping the frame to the region of interest
+ * and applying the orientation if necessary.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t load_codec_frame(struct hidden_state *state, struct sail_image *image);
+
 #endif
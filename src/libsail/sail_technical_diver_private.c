@@ -77,32 +77,48 @@ sail_status_t start_loading_io_with_options(struct sail_io *io, bool own_io,
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io           = io;
-    state_of_mind->own_io       = own_io;
-    state_of_mind->save_options = NULL;
-    state_of_mind->state        = NULL;
-    state_of_mind->codec_info   = codec_info;
-    state_of_mind->codec        = NULL;
+    state_of_mind->io                  = io;
+    state_of_mind->own_io              = own_io;
+    state_of_mind->io_trace            = NULL;
+    state_of_mind->save_options        = NULL;
+    state_of_mind->load_options        = NULL;
+    state_of_mind->output_pixel_format = (load_options == NULL) ? SAIL_PIXEL_FORMAT_UNKNOWN : load_options->output_pixel_format;
+    state_of_mind->frame_rows          = NULL;
+    state_of_mind->crop_source_width   = 0;
+    state_of_mind->orientation         = SAIL_ORIENTATION_NORMAL;
+    state_of_mind->state               = NULL;
+    state_of_mind->codec_info          = codec_info;
+    state_of_mind->codec               = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
 
     if (load_options == NULL) {
-        struct sail_load_options *load_options_local = NULL;
-
-        SAIL_TRY_OR_CLEANUP(sail_alloc_load_options_from_features(state_of_mind->codec_info->load_features, &load_options_local),
+        SAIL_TRY_OR_CLEANUP(sail_alloc_load_options_from_features(state_of_mind->codec_info->load_features, &state_of_mind->load_options),
                             /* cleanup */ destroy_hidden_state(state_of_mind));
-        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->load_init(state_of_mind->io, load_options_local, &state_of_mind->state),
-                            /* cleanup */ sail_destroy_load_options(load_options_local),
-                                          state_of_mind->codec->v8->load_finish(&state_of_mind->state),
-                                          destroy_hidden_state(state_of_mind));
-        sail_destroy_load_options(load_options_local);
     } else {
-        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->load_init(state_of_mind->io, load_options, &state_of_mind->state),
-                            /* cleanup */ state_of_mind->codec->v8->load_finish(&state_of_mind->state),
-                                          destroy_hidden_state(state_of_mind));
+        SAIL_TRY_OR_CLEANUP(sail_copy_load_options(load_options, &state_of_mind->load_options),
+                            /* cleanup */ destroy_hidden_state(state_of_mind));
+    }
+
+    /* The region of interest is in the source image coordinates, so frames are never scaled down with it. */
+    if (sail_has_roi(state_of_mind->load_options)) {
+        state_of_mind->load_options->max_width  = 0;
+        state_of_mind->load_options->max_height = 0;
+    }
+
+    if (sail_trace_is_enabled()) {
+        SAIL_TRY_OR_CLEANUP(alloc_io_trace(state_of_mind->io, codec_info->name, &state_of_mind->io_trace),
+                            /* cleanup */ destroy_hidden_state(state_of_mind));
     }
 
+    struct sail_io *codec_io = (state_of_mind->io_trace == NULL) ? state_of_mind->io : state_of_mind->io_trace;
+
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(codec_info, "load_init", 0,
+                            state_of_mind->codec->v8->load_init(codec_io, state_of_mind->load_options, &state_of_mind->state)),
+                        /* cleanup */ state_of_mind->codec->v8->load_finish(&state_of_mind->state),
+                                      destroy_hidden_state(state_of_mind));
+
     *state = state_of_mind;
 
     return SAIL_OK;
@@ -131,12 +147,18 @@ sail_status_t start_saving_io_with_options(struct sail_io *io, bool own_io,
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io           = io;
-    state_of_mind->own_io       = own_io;
-    state_of_mind->save_options = NULL;
-    state_of_mind->state        = NULL;
-    state_of_mind->codec_info   = codec_info;
-    state_of_mind->codec        = NULL;
+    state_of_mind->io                  = io;
+    state_of_mind->own_io              = own_io;
+    state_of_mind->io_trace            = NULL;
+    state_of_mind->save_options        = NULL;
+    state_of_mind->load_options        = NULL;
+    state_of_mind->output_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN;
+    state_of_mind->frame_rows          = NULL;
+    state_of_mind->crop_source_width   = 0;
+    state_of_mind->orientation         = SAIL_ORIENTATION_NORMAL;
+    state_of_mind->state               = NULL;
+    state_of_mind->codec_info          = codec_info;
+    state_of_mind->codec               = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
@@ -149,7 +171,15 @@ sail_status_t start_saving_io_with_options(struct sail_io *io, bool own_io,
                             /* cleanup */ destroy_hidden_state(state_of_mind));
     }
 
-    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v8->save_init(state_of_mind->io, state_of_mind->save_options, &state_of_mind->state),
+    if (sail_trace_is_enabled()) {
+        SAIL_TRY_OR_CLEANUP(alloc_io_trace(state_of_mind->io, codec_info->name, &state_of_mind->io_trace),
+                            /* cleanup */ destroy_hidden_state(state_of_mind));
+    }
+
+    struct sail_io *codec_io = (state_of_mind->io_trace == NULL) ? state_of_mind->io : state_of_mind->io_trace;
+
+    SAIL_TRY_OR_CLEANUP(SAIL_TRACE_CODEC_CALL(codec_info, "save_init", 0,
+                            state_of_mind->codec->v8->save_init(codec_io, state_of_mind->save_options, &state_of_mind->state)),
                         /* cleanup */ state_of_mind->codec->v8->save_finish(&state_of_mind->state),
                                       destroy_hidden_state(state_of_mind));
 
@@ -0,0 +1,174 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include "sail-common.h"
+#include "sail.h"
+
+/* sail_string_hash("sail-trace-io") */
+static const uint64_t SAIL_TRACE_IO_ID = UINT64_C(3630325697206942991);
+
+struct io_trace_stream {
+
+    struct sail_io *io;
+    const char *codec;
+};
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t io_trace_tolerant_read(void *stream, void *buf, size_t size_to_read, size_t *read_size) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    sail_trace_begin("io", "io_read", trace_stream->codec);
+    const sail_status_t status = io->tolerant_read(io->stream, buf, size_to_read, read_size);
+
+    return sail_trace_end("io", "io_read", trace_stream->codec, (status == SAIL_OK) ? *read_size : 0, 0, status);
+}
+
+static sail_status_t io_trace_strict_read(void *stream, void *buf, size_t size_to_read) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    sail_trace_begin("io", "io_read", trace_stream->codec);
+    const sail_status_t status = io->strict_read(io->stream, buf, size_to_read);
+
+    return sail_trace_end("io", "io_read", trace_stream->codec, (status == SAIL_OK) ? size_to_read : 0, 0, status);
+}
+
+static sail_status_t io_trace_tolerant_write(void *stream, const void *buf, size_t size_to_write, size_t *written_size) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    sail_trace_begin("io", "io_write", trace_stream->codec);
+    const sail_status_t status = io->tolerant_write(io->stream, buf, size_to_write, written_size);
+
+    return sail_trace_end("io", "io_write", trace_stream->codec, (status == SAIL_OK) ? *written_size : 0, 0, status);
+}
+
+static sail_status_t io_trace_strict_write(void *stream, const void *buf, size_t size_to_write) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    sail_trace_begin("io", "io_write", trace_stream->codec);
+    const sail_status_t status = io->strict_write(io->stream, buf, size_to_write);
+
+    return sail_trace_end("io", "io_write", trace_stream->codec, (status == SAIL_OK) ? size_to_write : 0, 0, status);
+}
+
+static sail_status_t io_trace_seek(void *stream, long offset, int whence) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    return SAIL_TRACE_CALL("io", "io_seek", trace_stream->codec, 0, 0, io->seek(io->stream, offset, whence));
+}
+
+static sail_status_t io_trace_tell(void *stream, size_t *offset) {
+
+    const struct io_trace_stream *trace_stream = stream;
+
+    return trace_stream->io->tell(trace_stream->io->stream, offset);
+}
+
+static sail_status_t io_trace_flush(void *stream) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    return SAIL_TRACE_CALL("io", "io_flush", trace_stream->codec, 0, 0, io->flush(io->stream));
+}
+
+static sail_status_t io_trace_close(void *stream) {
+
+    /* The traced I/O object is owned by the caller. */
+    sail_free(stream);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_trace_eof(void *stream, bool *result) {
+
+    const struct io_trace_stream *trace_stream = stream;
+
+    return trace_stream->io->eof(trace_stream->io->stream, result);
+}
+
+static sail_status_t io_trace_contiguous_buffer(void *stream, const void **buffer, size_t *buffer_size) {
+
+    const struct io_trace_stream *trace_stream = stream;
+    struct sail_io *io = trace_stream->io;
+
+    sail_trace_begin("io", "io_contiguous_buffer", trace_stream->codec);
+    const sail_status_t status = io->contiguous_buffer(io->stream, buffer, buffer_size);
+
+    return sail_trace_end("io", "io_contiguous_buffer", trace_stream->codec, (status == SAIL_OK) ? *buffer_size : 0, 0, status);
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_io_trace(struct sail_io *io, const char *codec, struct sail_io **io_trace) {
+
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_CHECK_PTR(io_trace);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct io_trace_stream), &ptr));
+    struct io_trace_stream *trace_stream = ptr;
+
+    trace_stream->io    = io;
+    trace_stream->codec = codec;
+
+    struct sail_io *io_trace_local;
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(&io_trace_local),
+                        /* cleanup */ sail_free(trace_stream));
+
+    io_trace_local->id                = SAIL_TRACE_IO_ID;
+    io_trace_local->features          = io->features;
+    io_trace_local->stream            = trace_stream;
+    io_trace_local->tolerant_read     = io_trace_tolerant_read;
+    io_trace_local->strict_read       = io_trace_strict_read;
+    io_trace_local->tolerant_write    = io_trace_tolerant_write;
+    io_trace_local->strict_write      = io_trace_strict_write;
+    io_trace_local->seek              = io_trace_seek;
+    io_trace_local->tell              = io_trace_tell;
+    io_trace_local->flush             = io_trace_flush;
+    io_trace_local->close             = io_trace_close;
+    io_trace_local->eof               = io_trace_eof;
+    io_trace_local->contiguous_buffer = (io->contiguous_buffer == NULL) ? NULL : io_trace_contiguous_buffer;
+
+    *io_trace = io_trace_local;
+
+    return SAIL_OK;
+}
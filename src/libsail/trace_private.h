@@ -0,0 +1,58 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TRACE_PRIVATE_H
+#define SAIL_TRACE_PRIVATE_H
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+    #include "trace.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+    #include <sail-common/trace.h>
+#endif
+
+struct sail_io;
+
+/*
+ * Calls the codec layout function between begin and end trace events of the "codec" category.
+ * Evaluates to the call status.
+ */
+#define SAIL_TRACE_CODEC_CALL(codec_info, stage, pixels, call) \
+    SAIL_TRACE_CALL("codec", stage, (codec_info)->name, 0, pixels, call)
+
+/*
+ * Allocates a new I/O object that forwards all the calls to the specified I/O object and wraps
+ * reads, writes, seeks, and flushes into trace events of the "io" category. Tell and EOF calls
+ * are forwarded without events as they're called too often to be interesting. Destroying
+ * the new I/O object doesn't destroy the specified one.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_trace(struct sail_io *io, const char *codec, struct sail_io **io_trace);
+
+#endif
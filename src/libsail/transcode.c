@@ -0,0 +1,268 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sail-common.h"
+#include "sail-manip.h"
+#include "sail.h"
+
+/* The number of scan lines decoded, converted, and encoded at once. */
+static const unsigned SAIL_TRANSCODE_BAND_ROWS = 64;
+
+/*
+ * Private functions.
+ */
+
+/* Loads ICC profiles and meta data only when they are requested to be saved. */
+static sail_status_t alloc_load_options_for_saving(const struct sail_codec_info *codec_info, const struct sail_save_options *save_options,
+                                                   struct sail_load_options **load_options) {
+
+    struct sail_load_options *load_options_local;
+    SAIL_TRY(sail_alloc_load_options_from_features(codec_info->load_features, &load_options_local));
+
+    const int carried_options = SAIL_OPTION_META_DATA | SAIL_OPTION_ICCP;
+
+    load_options_local->options = (load_options_local->options & ~carried_options) | (save_options->options & carried_options);
+
+    *load_options = load_options_local;
+
+    return SAIL_OK;
+}
+
+/* Transcodes the scan lines of the started frames in bands. */
+static sail_status_t transcode_rows(void *load_state, void *save_state, const struct sail_image *image, const struct sail_image *output_image) {
+
+    const unsigned rows_in_band = (image->height < SAIL_TRANSCODE_BAND_ROWS) ? image->height : SAIL_TRANSCODE_BAND_ROWS;
+    const bool convert = image->pixel_format != output_image->pixel_format;
+
+    void *band = NULL;
+    void *output_band = NULL;
+    struct sail_conversion_plan *plan = NULL;
+
+    sail_status_t status = sail_malloc((size_t)rows_in_band * image->bytes_per_line, &band);
+
+    /* The plan converts the last shorter band too. */
+    if (status == SAIL_OK && convert) {
+        status = sail_malloc((size_t)rows_in_band * output_image->bytes_per_line, &output_band);
+
+        if (status == SAIL_OK) {
+            status = sail_alloc_conversion_plan(image->pixel_format, image->width, output_image->pixel_format, NULL /* options */, &plan);
+        }
+    }
+
+    for (unsigned row = 0; status == SAIL_OK && row < image->height; row += rows_in_band) {
+        const unsigned rows_count = (image->height - row < rows_in_band) ? image->height - row : rows_in_band;
+
+        status = sail_read_rows(load_state, band, rows_count);
+
+        if (status != SAIL_OK) {
+            break;
+        }
+
+        if (convert) {
+            /* A shallow view of the band. */
+            struct sail_image band_image = *image;
+            band_image.height = rows_count;
+            band_image.pixels = band;
+
+            status = sail_convert_image_with_plan_to_buffer(plan, &band_image, output_band,
+                                                            (size_t)rows_count * output_image->bytes_per_line,
+                                                            output_image->bytes_per_line);
+
+            if (status == SAIL_OK) {
+                status = sail_write_rows(save_state, output_band, rows_count);
+            }
+        } else {
+            status = sail_write_rows(save_state, band, rows_count);
+        }
+    }
+
+    sail_destroy_conversion_plan(plan);
+    sail_free(output_band);
+    sail_free(band);
+
+    return status;
+}
+
+/* Transcodes the next frame. */
+static sail_status_t transcode_frame(void *load_state, void *save_state, const struct sail_save_features *save_features) {
+
+    struct sail_image *image;
+    SAIL_TRY(sail_start_frame_rows(load_state, &image));
+
+    const enum SailPixelFormat output_pixel_format = sail_closest_pixel_format_from_save_features(image->pixel_format, save_features);
+
+    if (output_pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN) {
+        SAIL_LOG_ERROR("Failed to find a pixel format to save %s frames", sail_pixel_format_to_string(image->pixel_format));
+        sail_destroy_image(image);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    struct sail_image *output_image;
+    SAIL_TRY_OR_CLEANUP(sail_copy_image(image, &output_image),
+                        /* cleanup */ sail_destroy_image(image));
+
+    if (output_pixel_format != image->pixel_format) {
+        output_image->pixel_format   = output_pixel_format;
+        output_image->bytes_per_line = sail_bytes_per_line(output_image->width, output_pixel_format);
+
+        if (!sail_is_indexed(output_pixel_format)) {
+            sail_destroy_palette(output_image->palette);
+            output_image->palette = NULL;
+        }
+    }
+
+    SAIL_TRY_OR_CLEANUP(sail_start_writing_frame_rows(save_state, output_image),
+                        /* cleanup */ sail_destroy_image(output_image),
+                                      sail_destroy_image(image));
+
+    SAIL_TRY_OR_CLEANUP(transcode_rows(load_state, save_state, image, output_image),
+                        /* cleanup */ sail_destroy_image(output_image),
+                                      sail_destroy_image(image));
+
+    sail_destroy_image(output_image);
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+/* Transcodes all the frames the output codec accepts and stops loading and saving. */
+static sail_status_t transcode_and_stop(void *load_state, void *save_state, const struct sail_codec_info *output_codec_info, size_t *written) {
+
+    const bool multi_frame = output_codec_info->save_features->features & (SAIL_CODEC_FEATURE_ANIMATED | SAIL_CODEC_FEATURE_MULTI_PAGED);
+
+    sail_status_t status;
+    unsigned frames = 0;
+
+    while ((status = transcode_frame(load_state, save_state, output_codec_info->save_features)) == SAIL_OK) {
+        frames++;
+
+        if (!multi_frame) {
+            break;
+        }
+    }
+
+    /* No more frames is not an error after the first frame. */
+    if (status == SAIL_ERROR_NO_MORE_FRAMES && frames > 0) {
+        status = SAIL_OK;
+    }
+
+    sail_stop_loading(load_state);
+
+    if (status == SAIL_OK) {
+        SAIL_TRY(sail_stop_saving_with_written(save_state, written));
+    } else {
+        sail_stop_saving(save_state);
+    }
+
+    return status;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_transcode_file(const char *input_path, const char *output_path,
+                                  const struct sail_save_options *save_options, size_t *written) {
+
+    SAIL_CHECK_PTR(input_path);
+    SAIL_CHECK_PTR(output_path);
+
+    const struct sail_codec_info *input_codec_info;
+    SAIL_TRY(sail_codec_info_from_path(input_path, &input_codec_info));
+
+    const struct sail_codec_info *output_codec_info;
+    SAIL_TRY(sail_codec_info_from_path(output_path, &output_codec_info));
+
+    struct sail_save_options *save_options_local = NULL;
+
+    if (save_options == NULL) {
+        SAIL_TRY(sail_alloc_save_options_from_features(output_codec_info->save_features, &save_options_local));
+        save_options = save_options_local;
+    }
+
+    struct sail_load_options *load_options;
+    SAIL_TRY_OR_CLEANUP(alloc_load_options_for_saving(input_codec_info, save_options, &load_options),
+                        /* cleanup */ sail_destroy_save_options(save_options_local));
+
+    void *load_state = NULL;
+    SAIL_TRY_OR_CLEANUP(sail_start_loading_from_file_with_options(input_path, input_codec_info, load_options, &load_state),
+                        /* cleanup */ sail_destroy_load_options(load_options),
+                                      sail_destroy_save_options(save_options_local));
+
+    sail_destroy_load_options(load_options);
+
+    void *save_state = NULL;
+    SAIL_TRY_OR_CLEANUP(sail_start_saving_into_file_with_options(output_path, output_codec_info, save_options, &save_state),
+                        /* cleanup */ sail_stop_loading(load_state),
+                                      sail_destroy_save_options(save_options_local));
+
+    sail_destroy_save_options(save_options_local);
+
+    SAIL_TRY(transcode_and_stop(load_state, save_state, output_codec_info, written));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_transcode_io(struct sail_io *input_io, const struct sail_codec_info *input_codec_info,
+                                struct sail_io *output_io, const struct sail_codec_info *output_codec_info,
+                                const struct sail_save_options *save_options, size_t *written) {
+
+    SAIL_CHECK_PTR(input_io);
+    SAIL_CHECK_PTR(input_codec_info);
+    SAIL_CHECK_PTR(output_io);
+    SAIL_CHECK_PTR(output_codec_info);
+
+    struct sail_save_options *save_options_local = NULL;
+
+    if (save_options == NULL) {
+        SAIL_TRY(sail_alloc_save_options_from_features(output_codec_info->save_features, &save_options_local));
+        save_options = save_options_local;
+    }
+
+    struct sail_load_options *load_options;
+    SAIL_TRY_OR_CLEANUP(alloc_load_options_for_saving(input_codec_info, save_options, &load_options),
+                        /* cleanup */ sail_destroy_save_options(save_options_local));
+
+    void *load_state = NULL;
+    SAIL_TRY_OR_CLEANUP(sail_start_loading_from_io_with_options(input_io, input_codec_info, load_options, &load_state),
+                        /* cleanup */ sail_destroy_load_options(load_options),
+                                      sail_destroy_save_options(save_options_local));
+
+    sail_destroy_load_options(load_options);
+
+    void *save_state = NULL;
+    SAIL_TRY_OR_CLEANUP(sail_start_saving_into_io_with_options(output_io, output_codec_info, save_options, &save_state),
+                        /* cleanup */ sail_stop_loading(load_state),
+                                      sail_destroy_save_options(save_options_local));
+
+    sail_destroy_save_options(save_options_local);
+
+    SAIL_TRY(transcode_and_stop(load_state, save_state, output_codec_info, written));
+
+    return SAIL_OK;
+}
@@ -0,0 +1,86 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TRANSCODE_H
+#define SAIL_TRANSCODE_H
+
+#include <stddef.h> /* size_t */
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_codec_info;
+struct sail_io;
+struct sail_save_options;
+
+/*
+ * Transcodes the specified image file into the specified output file. Detects the image formats
+ * based on the file extensions.
+ *
+ * Frames are decoded, converted, and encoded in bands of a few scan lines. Memory use is bounded
+ * by the bands only when both codecs process scan lines, see sail_start_frame_rows() and
+ * sail_start_writing_frame_rows(): BMP, JPEG, PCX, PNG, TGA, and TIFF load scan lines, and JPEG,
+ * non-interlaced PNG, and TIFF save them. Otherwise, libsail buffers the whole frame on the input
+ * side, the output side, or both, so a frame may take up to twice its size in memory.
+ *
+ * Scan lines are converted into the closest pixel format supported by the output
+ * codec if necessary. ICC profiles and meta data are carried over when requested in the save options.
+ * Only the first frame is transcoded when the output codec doesn't support multiple frames.
+ *
+ * If you don't need specific save options, just pass NULL. Codec-specific defaults will be used
+ * in this case.
+ *
+ * Assigns the number of bytes written to the 'written' argument. Pass NULL if you don't need it.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_transcode_file(const char *input_path, const char *output_path,
+                                              const struct sail_save_options *save_options, size_t *written);
+
+/*
+ * Transcodes the specified I/O source into the specified I/O target with the specified codecs.
+ * Works like sail_transcode_file(). Doesn't close the I/O streams.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_transcode_io(struct sail_io *input_io, const struct sail_codec_info *input_codec_info,
+                                            struct sail_io *output_io, const struct sail_codec_info *output_codec_info,
+                                            const struct sail_save_options *save_options, size_t *written);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -128,6 +128,11 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_avif(struct sail_io *io, const
     avif_state->avif_context.io = io;
     avif_state->avif_io->data = &avif_state->avif_context;
 
+    /* Data returned from a contiguous buffer stays valid until the I/O is closed. */
+    if (io->features & SAIL_IO_FEATURE_CONTIGUOUS) {
+        avif_state->avif_io->persistent = AVIF_TRUE;
+    }
+
     avifResult avif_result = avifDecoderParse(avif_state->avif_decoder);
 
     if (avif_result != AVIF_RESULT_OK) {
@@ -161,7 +166,11 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_avif(void *state, s
                         /* cleanup */ sail_destroy_image(image_local));
 
     avifRGBImageSetDefaults(&avif_state->rgb_image, avif_image);
-    avif_state->rgb_image.depth = avif_private_round_depth(avif_state->rgb_image.depth);
+
+    /* libavif converts YUV straight into the requested RGB pixel format. */
+    if (!avif_private_rgb_format(avif_state->load_options->output_pixel_format, &avif_state->rgb_image.format, &avif_state->rgb_image.depth)) {
+        avif_state->rgb_image.depth = avif_private_round_depth(avif_state->rgb_image.depth);
+    }
 
     image_local->source_image->pixel_format =
         avif_private_sail_pixel_format(avif_image->yuvFormat, avif_image->depth, avif_image->alphaPlane != NULL);
@@ -203,6 +212,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_avif(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_avif(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_avif(void **state) {
 
     struct avif_state *avif_state = *state;
@@ -243,6 +262,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_avif(void *state, const struc
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_avif(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_avif(void **state) {
 
     (void)state;
@@ -41,6 +41,12 @@ SAIL_HIDDEN enum SailChromaSubsampling avif_private_sail_chroma_subsampling(enum
 
 SAIL_HIDDEN enum SailPixelFormat avif_private_rgb_sail_pixel_format(enum avifRGBFormat rgb_pixel_format, uint32_t depth);
 
+/*
+ * Finds the RGB format and depth libavif converts frames into to get the specified pixel format.
+ * Returns false if libavif cannot produce the pixel format.
+ */
+SAIL_HIDDEN bool avif_private_rgb_format(enum SailPixelFormat pixel_format, enum avifRGBFormat *rgb_pixel_format, uint32_t *depth);
+
 SAIL_HIDDEN uint32_t avif_private_round_depth(uint32_t depth);
 
 SAIL_HIDDEN sail_status_t avif_private_fetch_iccp(const struct avifRWData *avif_iccp, struct sail_iccp **iccp);
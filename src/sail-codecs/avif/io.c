@@ -39,6 +39,25 @@ avifResult avif_private_read_proc(struct avifIO *io, uint32_t read_flags, uint64
     SAIL_LOG_TRACE("AVIF: Read at offset %ld size %lu", (long)offset, (unsigned long)size);
 
     struct sail_avif_context *avif_context = io->data;
+
+    /* Point libavif right into the contiguous buffer if the I/O provides it. */
+    if (avif_context->io->features & SAIL_IO_FEATURE_CONTIGUOUS) {
+        const void *buffer;
+        size_t buffer_size;
+        SAIL_TRY_OR_EXECUTE(avif_context->io->contiguous_buffer(avif_context->io->stream, &buffer, &buffer_size),
+                            /* on error */ return AVIF_RESULT_IO_ERROR);
+
+        if (offset > buffer_size) {
+            SAIL_LOG_ERROR("AVIF: Read offset %ld is beyond the buffer size %lu", (long)offset, (unsigned long)buffer_size);
+            return AVIF_RESULT_IO_ERROR;
+        }
+
+        out->data = (const uint8_t *)buffer + offset;
+        out->size = (buffer_size - (size_t)offset < size) ? buffer_size - (size_t)offset : size;
+
+        return AVIF_RESULT_OK;
+    }
+
     SAIL_TRY_OR_EXECUTE(avif_context->io->seek(avif_context->io->stream, (long)offset, SEEK_SET),
                         /* on error */ return AVIF_RESULT_IO_ERROR);
 
@@ -117,6 +117,14 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_bmp(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_bmp(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    struct bmp_state *bmp_state = state;
+
+    /* SAIL_ERROR_NOT_IMPLEMENTED is passed as is to let libsail fall back to loading the whole frame. */
+    return bmp_private_read_rows(bmp_state->common_bmp_state, bmp_state->io, image, rows, rows_count);
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_bmp(void **state) {
 
     struct bmp_state *bmp_state = *state;
@@ -162,6 +170,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_bmp(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_bmp(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_bmp(void **state) {
 
     (void)state;
@@ -89,12 +89,19 @@ struct bmp_state {
 
     struct sail_iccp *iccp;
 
+    /* Buffered reader for pixel data. */
+    struct sail_io_reader *io_reader;
+
     sail_rgb24_t *palette;
     unsigned palette_count;
     unsigned bytes_in_row;
     /* Number of bytes to pad scan lines to 4-byte boundary. */
     unsigned pad_bytes;
     bool flipped;
+
+    /* Scan line streaming. */
+    size_t pixels_offset;
+    unsigned next_row;
 };
 
 static sail_status_t alloc_bmp_state(struct bmp_state **bmp_state) {
@@ -111,11 +118,14 @@ static sail_status_t alloc_bmp_state(struct bmp_state **bmp_state) {
     (*bmp_state)->save_options     = NULL;
     (*bmp_state)->bmp_load_options = 0;
     (*bmp_state)->iccp             = NULL;
+    (*bmp_state)->io_reader        = NULL;
     (*bmp_state)->palette          = NULL;
     (*bmp_state)->palette_count    = 0;
     (*bmp_state)->bytes_in_row     = 0;
     (*bmp_state)->pad_bytes        = 0;
     (*bmp_state)->flipped          = false;
+    (*bmp_state)->pixels_offset    = 0;
+    (*bmp_state)->next_row         = 0;
 
     return SAIL_OK;
 }
@@ -128,6 +138,8 @@ static void destroy_bmp_state(struct bmp_state *bmp_state) {
 
     sail_destroy_iccp(bmp_state->iccp);
 
+    sail_destroy_io_reader(bmp_state->io_reader);
+
     sail_free(bmp_state->palette);
 
     sail_free(bmp_state);
@@ -185,6 +197,152 @@ static sail_status_t read_bmp_headers(struct sail_io *io, struct bmp_state *bmp_
     return SAIL_OK;
 }
 
+/* Reads a single scan line. */
+static sail_status_t read_scan_line(struct bmp_state *bmp_state, const struct sail_image *image, unsigned char *scan) {
+
+    struct sail_io_reader *io_reader = bmp_state->io_reader;
+
+    /* RLE-encoded images don't need to skip pad bytes. */
+    bool skip_pad_bytes = true;
+
+    for (unsigned pixel_index = 0; pixel_index < image->width;) {
+        if (bmp_state->version >= SAIL_BMP_V3 && bmp_state->v3.compression == SAIL_BI_RLE4) {
+            skip_pad_bytes = false;
+
+            uint8_t marker;
+            SAIL_TRY(sail_io_reader_read_u8(io_reader, &marker));
+
+            if (marker == SAIL_BMP_UNENCODED_RUN_MARKER) {
+                uint8_t count_or_marker;
+                SAIL_TRY(sail_io_reader_read_u8(io_reader, &count_or_marker));
+
+                if (count_or_marker == SAIL_BMP_END_OF_SCAN_LINE_MARKER) {
+                    /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
+                    pixel_index = image->width + 1;
+                } else if (count_or_marker == SAIL_BMP_END_OF_RLE_DATA_MARKER) {
+                    SAIL_LOG_ERROR("BMP: Unexpected end-of-rle-data marker");
+                    SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+                } else if (count_or_marker == SAIL_BMP_DELTA_MARKER) {
+                    SAIL_LOG_ERROR("BMP: Delta marker is not supported");
+                    SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_FORMAT);
+                } else {
+                    bool read_byte = true;
+                    uint8_t byte = 0;
+                    uint8_t index;
+
+                    for (uint8_t k = 0; k < count_or_marker; k++) {
+                        if (read_byte) {
+                            SAIL_TRY(sail_io_reader_read_u8(io_reader, &byte));
+                            index = (byte >> 4) & 0xf;
+                            read_byte = false;
+                        } else {
+                            index = byte & 0xf;
+                            read_byte = true;
+                        }
+
+                        *scan++ = index;
+                    }
+
+                    /* Odd number of bytes is accompanied with an additional byte. */
+                    uint8_t number_of_unencoded_bytes = (count_or_marker + 1) / 2;
+                    if ((number_of_unencoded_bytes % 2) != 0) {
+                        SAIL_TRY(sail_io_reader_seek(io_reader, 1, SEEK_CUR));
+                    }
+
+                    pixel_index += count_or_marker;
+                }
+            } else {
+                /* Normal RLE: count + value. */
+                bool high_4_bits = true;
+                uint8_t index;
+
+                uint8_t byte;
+                SAIL_TRY(sail_io_reader_read_u8(io_reader, &byte));
+
+                for (uint8_t k = 0; k < marker; k++) {
+                    if (high_4_bits) {
+                        index = (byte >> 4) & 0xf;
+                        high_4_bits = false;
+                    } else {
+                        index = byte & 0xf;
+                        high_4_bits = true;
+                    }
+
+                    *scan++ = index;
+                }
+
+                pixel_index += marker;
+            }
+
+            /* Read a possible end-of-scan-line marker at the end of line. */
+            if (pixel_index == image->width) {
+                SAIL_TRY(bmp_private_skip_end_of_scan_line(io_reader));
+            }
+        } else if (bmp_state->version >= SAIL_BMP_V3 && bmp_state->v3.compression == SAIL_BI_RLE8) {
+            skip_pad_bytes = false;
+
+            uint8_t marker;
+            SAIL_TRY(sail_io_reader_read_u8(io_reader, &marker));
+
+            if (marker == SAIL_BMP_UNENCODED_RUN_MARKER) {
+                uint8_t count_or_marker;
+                SAIL_TRY(sail_io_reader_read_u8(io_reader, &count_or_marker));
+
+                if (count_or_marker == SAIL_BMP_END_OF_SCAN_LINE_MARKER) {
+                    /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
+                    pixel_index = image->width + 1;
+                } else if (count_or_marker == SAIL_BMP_END_OF_RLE_DATA_MARKER) {
+                    SAIL_LOG_ERROR("BMP: Unexpected end-of-rle-data marker");
+                    SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+                } else if (count_or_marker == SAIL_BMP_DELTA_MARKER) {
+                    SAIL_LOG_ERROR("BMP: Delta marker is not supported");
+                    SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_FORMAT);
+                } else {
+                    for (uint8_t k = 0; k < count_or_marker; k++) {
+                        uint8_t index;
+                        SAIL_TRY(sail_io_reader_read_u8(io_reader, &index));
+
+                        *scan++ = index;
+                    }
+
+                    /* Odd number of pixels is accompanied with an additional byte. */
+                    if ((count_or_marker % 2) != 0) {
+                        SAIL_TRY(sail_io_reader_seek(io_reader, 1, SEEK_CUR));
+                    }
+
+                    pixel_index += count_or_marker;
+                }
+            } else {
+                /* Normal RLE: count + value. */
+                uint8_t index;
+                SAIL_TRY(sail_io_reader_read_u8(io_reader, &index));
+
+                for (uint8_t k = 0; k < marker; k++) {
+                    *scan++ = index;
+                }
+
+                pixel_index += marker;
+            }
+
+            /* Read a possible end-of-scan-line marker at the end of line. */
+            if (pixel_index == image->width) {
+                SAIL_TRY(bmp_private_skip_end_of_scan_line(io_reader));
+            }
+        } else {
+            /* Read a whole scan line. */
+            SAIL_TRY(sail_io_reader_strict_read(io_reader, scan, bmp_state->bytes_in_row));
+            pixel_index += image->width;
+        }
+    }
+
+    /* Skip pad bytes. */
+    if (skip_pad_bytes) {
+        SAIL_TRY(sail_io_reader_seek(io_reader, bmp_state->pad_bytes, SEEK_CUR));
+    }
+
+    return SAIL_OK;
+}
+
 /*
  * Decoding functions.
  */
@@ -201,6 +359,8 @@ sail_status_t bmp_private_read_init(struct sail_io *io, const struct sail_load_o
 
     bmp_state->bmp_load_options = bmp_load_options;
 
+    SAIL_TRY(sail_alloc_io_reader(io, &bmp_state->io_reader));
+
     if (bmp_load_options & SAIL_READ_BMP_FILE_HEADER) {
         /* "BM" or 0x02. */
         uint16_t magic;
@@ -376,6 +536,11 @@ sail_status_t bmp_private_read_seek_next_frame(void *state, struct sail_io *io,
         }
     }
 
+    /* Remember where scan lines start to stream bottom-up frames. */
+    SAIL_TRY_OR_CLEANUP(io->tell(io->stream, &bmp_state->pixels_offset),
+                        /* cleanup */ sail_destroy_image(image_local));
+    bmp_state->next_row = 0;
+
     *image = image_local;
 
     return SAIL_OK;
@@ -383,148 +548,50 @@ sail_status_t bmp_private_read_seek_next_frame(void *state, struct sail_io *io,
 
 sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sail_image *image) {
 
-    struct bmp_state *bmp_state = state;
+    (void)io;
 
-    /* RLE-encoded images don't need to skip pad bytes. */
-    bool skip_pad_bytes = true;
+    struct bmp_state *bmp_state = state;
 
     for (unsigned i = image->height; i > 0; i--) {
         unsigned char *scan = (unsigned char *)image->pixels + image->bytes_per_line * (bmp_state->flipped ? (i - 1) : (image->height - i));
 
-        for (unsigned pixel_index = 0; pixel_index < image->width;) {
-            if (bmp_state->version >= SAIL_BMP_V3 && bmp_state->v3.compression == SAIL_BI_RLE4) {
-                skip_pad_bytes = false;
-
-                uint8_t marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
-
-                if (marker == SAIL_BMP_UNENCODED_RUN_MARKER) {
-                    uint8_t count_or_marker;
-                    SAIL_TRY(io->strict_read(io->stream, &count_or_marker, sizeof(count_or_marker)));
-
-                    if (count_or_marker == SAIL_BMP_END_OF_SCAN_LINE_MARKER) {
-                        /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
-                        pixel_index = image->width + 1;
-                    } else if (count_or_marker == SAIL_BMP_END_OF_RLE_DATA_MARKER) {
-                        SAIL_LOG_ERROR("BMP: Unexpected end-of-rle-data marker");
-                        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
-                    } else if (count_or_marker == SAIL_BMP_DELTA_MARKER) {
-                        SAIL_LOG_ERROR("BMP: Delta marker is not supported");
-                        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_FORMAT);
-                    } else {
-                        bool read_byte = true;
-                        uint8_t byte = 0;
-                        uint8_t index;
-
-                        for (uint8_t k = 0; k < count_or_marker; k++) {
-                            if (read_byte) {
-                                SAIL_TRY(io->strict_read(io->stream, &byte, sizeof(byte)));
-                                index = (byte >> 4) & 0xf;
-                                read_byte = false;
-                            } else {
-                                index = byte & 0xf;
-                                read_byte = true;
-                            }
-
-                            *scan++ = index;
-                        }
-
-                        /* Odd number of bytes is accompanied with an additional byte. */
-                        uint8_t number_of_unencoded_bytes = (count_or_marker + 1) / 2;
-                        if ((number_of_unencoded_bytes % 2) != 0) {
-                            SAIL_TRY(io->seek(io->stream, 1, SEEK_CUR));
-                        }
-
-                        pixel_index += count_or_marker;
-                    }
-                } else {
-                    /* Normal RLE: count + value. */
-                    bool high_4_bits = true;
-                    uint8_t index;
-
-                    uint8_t byte;
-                    SAIL_TRY(io->strict_read(io->stream, &byte, sizeof(byte)));
-
-                    for (uint8_t k = 0; k < marker; k++) {
-                        if (high_4_bits) {
-                            index = (byte >> 4) & 0xf;
-                            high_4_bits = false;
-                        } else {
-                            index = byte & 0xf;
-                            high_4_bits = true;
-                        }
-
-                        *scan++ = index;
-                    }
+        SAIL_TRY(read_scan_line(bmp_state, image, scan));
+    }
 
-                    pixel_index += marker;
-                }
+    /* Give back the read-ahead data. */
+    SAIL_TRY(sail_io_reader_sync(bmp_state->io_reader));
 
-                /* Read a possible end-of-scan-line marker at the end of line. */
-                if (pixel_index == image->width) {
-                    SAIL_TRY(bmp_private_skip_end_of_scan_line(io));
-                }
-            } else if (bmp_state->version >= SAIL_BMP_V3 && bmp_state->v3.compression == SAIL_BI_RLE8) {
-                skip_pad_bytes = false;
-
-                uint8_t marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
-
-                if (marker == SAIL_BMP_UNENCODED_RUN_MARKER) {
-                    uint8_t count_or_marker;
-                    SAIL_TRY(io->strict_read(io->stream, &count_or_marker, sizeof(count_or_marker)));
-
-                    if (count_or_marker == SAIL_BMP_END_OF_SCAN_LINE_MARKER) {
-                        /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
-                        pixel_index = image->width + 1;
-                    } else if (count_or_marker == SAIL_BMP_END_OF_RLE_DATA_MARKER) {
-                        SAIL_LOG_ERROR("BMP: Unexpected end-of-rle-data marker");
-                        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
-                    } else if (count_or_marker == SAIL_BMP_DELTA_MARKER) {
-                        SAIL_LOG_ERROR("BMP: Delta marker is not supported");
-                        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_FORMAT);
-                    } else {
-                        for (uint8_t k = 0; k < count_or_marker; k++) {
-                            uint8_t index;
-                            SAIL_TRY(io->strict_read(io->stream, &index, sizeof(index)));
+    return SAIL_OK;
+}
 
-                            *scan++ = index;
-                        }
+sail_status_t bmp_private_read_rows(void *state, struct sail_io *io, const struct sail_image *image, void *rows, unsigned rows_count) {
 
-                        /* Odd number of pixels is accompanied with an additional byte. */
-                        if ((count_or_marker % 2) != 0) {
-                            SAIL_TRY(io->seek(io->stream, 1, SEEK_CUR));
-                        }
+    (void)io;
 
-                        pixel_index += count_or_marker;
-                    }
-                } else {
-                    /* Normal RLE: count + value. */
-                    uint8_t index;
-                    SAIL_TRY(io->strict_read(io->stream, &index, sizeof(index)));
+    struct bmp_state *bmp_state = state;
 
-                    for (uint8_t k = 0; k < marker; k++) {
-                        *scan++ = index;
-                    }
+    const bool rle = bmp_state->version >= SAIL_BMP_V3 &&
+                        (bmp_state->v3.compression == SAIL_BI_RLE4 || bmp_state->v3.compression == SAIL_BI_RLE8);
 
-                    pixel_index += marker;
-                }
+    /* Bottom-up RLE scan lines cannot be located without decoding the whole frame. */
+    if (bmp_state->flipped && rle) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
 
-                /* Read a possible end-of-scan-line marker at the end of line. */
-                if (pixel_index == image->width) {
-                    SAIL_TRY(bmp_private_skip_end_of_scan_line(io));
-                }
-            } else {
-                /* Read a whole scan line. */
-                SAIL_TRY(io->strict_read(io->stream, scan, bmp_state->bytes_in_row));
-                pixel_index += image->width;
-            }
+    for (unsigned row = 0; row < rows_count; row++, bmp_state->next_row++) {
+        /* Locate bottom-up scan lines. */
+        if (bmp_state->flipped) {
+            const size_t offset = bmp_state->pixels_offset +
+                                    (size_t)(image->height - 1 - bmp_state->next_row) * (bmp_state->bytes_in_row + bmp_state->pad_bytes);
+            SAIL_TRY(sail_io_reader_seek(bmp_state->io_reader, (long)offset, SEEK_SET));
         }
 
-        /* Skip pad bytes. */
-        if (skip_pad_bytes) {
-            SAIL_TRY(io->seek(io->stream, bmp_state->pad_bytes, SEEK_CUR));
-        }
+        SAIL_TRY(read_scan_line(bmp_state, image, (unsigned char *)rows + (size_t)row * image->bytes_per_line));
+    }
+
+    /* Give back the read-ahead data. */
+    if (bmp_state->next_row == image->height) {
+        SAIL_TRY(sail_io_reader_sync(bmp_state->io_reader));
     }
 
     return SAIL_OK;
@@ -54,6 +54,12 @@ SAIL_HIDDEN sail_status_t bmp_private_read_seek_next_frame(void *state, struct s
 
 SAIL_HIDDEN sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sail_image *image);
 
+/*
+ * Reads the next scan lines of the current frame. Returns SAIL_ERROR_NOT_IMPLEMENTED
+ * for bottom-up RLE-compressed frames.
+ */
+SAIL_HIDDEN sail_status_t bmp_private_read_rows(void *state, struct sail_io *io, const struct sail_image *image, void *rows, unsigned rows_count);
+
 SAIL_HIDDEN sail_status_t bmp_private_read_finish(void **state, struct sail_io *io);
 
 #endif
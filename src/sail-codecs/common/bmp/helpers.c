@@ -146,19 +146,19 @@ sail_status_t bmp_private_fetch_iccp(struct sail_io *io, long offset_of_data, ui
     return SAIL_OK;
 }
 
-sail_status_t bmp_private_skip_end_of_scan_line(struct sail_io *io) {
+sail_status_t bmp_private_skip_end_of_scan_line(struct sail_io_reader *io_reader) {
 
     uint8_t marker;
-    SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+    SAIL_TRY(sail_io_reader_read_u8(io_reader, &marker));
 
     if (marker == SAIL_BMP_UNENCODED_RUN_MARKER) {
-        SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+        SAIL_TRY(sail_io_reader_read_u8(io_reader, &marker));
 
         if (marker != SAIL_BMP_END_OF_SCAN_LINE_MARKER) {
-            SAIL_TRY(io->seek(io->stream, -2, SEEK_CUR));
+            SAIL_TRY(sail_io_reader_seek(io_reader, -2, SEEK_CUR));
         }
     } else {
-        SAIL_TRY(io->seek(io->stream, -1, SEEK_CUR));
+        SAIL_TRY(sail_io_reader_seek(io_reader, -1, SEEK_CUR));
     }
 
     return SAIL_OK;
@@ -35,6 +35,7 @@
 
 struct sail_iccp;
 struct sail_io;
+struct sail_io_reader;
 
 /* RLE markers. */
 enum
@@ -157,7 +158,7 @@ SAIL_HIDDEN sail_status_t bmp_private_bit_count_to_pixel_format(uint16_t bit_cou
 
 SAIL_HIDDEN sail_status_t bmp_private_fetch_iccp(struct sail_io *io, long offset_of_data, uint32_t profile_size, struct sail_iccp **iccp);
 
-SAIL_HIDDEN sail_status_t bmp_private_skip_end_of_scan_line(struct sail_io *io);
+SAIL_HIDDEN sail_status_t bmp_private_skip_end_of_scan_line(struct sail_io_reader *io_reader);
 
 SAIL_HIDDEN sail_status_t bmp_private_bytes_in_row(unsigned width, unsigned bit_count, unsigned *bytes_in_row);
 
@@ -425,6 +425,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_gif(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_gif(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_gif(void **state) {
 
     struct gif_state *gif_state = *state;
@@ -469,6 +479,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_gif(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_gif(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_gif(void **state) {
 
     (void)state;
@@ -52,6 +52,57 @@ sail_status_t ico_private_read_dir_entry(struct sail_io *io, struct SailIcoDirEn
     return SAIL_OK;
 }
 
+/* Width and height of 0 mean 256 pixels. */
+static unsigned dir_entry_dimension(uint8_t dimension) {
+
+    return (dimension == 0) ? 256 : dimension;
+}
+
+sail_status_t ico_private_find_nearest_dir_entry(struct sail_io *io, const struct SailIcoDirEntry *dir_entries, unsigned dir_entries_count,
+                                                    unsigned max_width, unsigned max_height, unsigned *index) {
+
+    bool found = false;
+    bool found_large_enough = false;
+    unsigned long found_area = 0;
+
+    for (unsigned i = 0; i < dir_entries_count; i++) {
+        const unsigned width  = dir_entry_dimension(dir_entries[i].width);
+        const unsigned height = dir_entry_dimension(dir_entries[i].height);
+        const unsigned long area = (unsigned long)width * height;
+        const bool large_enough = width >= max_width && height >= max_height;
+
+        /* Prefer the smallest image not less than requested, or the largest one otherwise. */
+        if (found) {
+            if (found_large_enough && (!large_enough || area >= found_area)) {
+                continue;
+            }
+            if (!found_large_enough && !large_enough && area <= found_area) {
+                continue;
+            }
+        }
+
+        /* PNG images are not supported. */
+        enum SailIcoImageType ico_image_type;
+        SAIL_TRY(io->seek(io->stream, (long)dir_entries[i].image_offset, SEEK_SET));
+        SAIL_TRY(ico_private_probe_image_type(io, &ico_image_type));
+
+        if (ico_image_type != SAIL_ICO_IMAGE_BMP) {
+            continue;
+        }
+
+        found              = true;
+        found_large_enough = large_enough;
+        found_area         = area;
+        *index             = i;
+    }
+
+    if (!found) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t ico_private_probe_image_type(struct sail_io *io, enum SailIcoImageType *ico_image_type) {
 
     size_t saved_offset;
@@ -63,6 +63,13 @@ SAIL_HIDDEN sail_status_t ico_private_read_header(struct sail_io *io, struct Sai
 
 SAIL_HIDDEN sail_status_t ico_private_read_dir_entry(struct sail_io *io, struct SailIcoDirEntry *dir_entry);
 
+/*
+ * Finds the BMP image which is the nearest to the requested maximum dimensions, i.e. the smallest
+ * image not less than them, or the largest image if all images are less. 0 means no limit.
+ */
+SAIL_HIDDEN sail_status_t ico_private_find_nearest_dir_entry(struct sail_io *io, const struct SailIcoDirEntry *dir_entries, unsigned dir_entries_count,
+                                                                unsigned max_width, unsigned max_height, unsigned *index);
+
 SAIL_HIDDEN sail_status_t ico_private_probe_image_type(struct sail_io *io, enum SailIcoImageType *ico_image_type);
 
 SAIL_HIDDEN sail_status_t ico_private_store_cur_hotspot(const struct SailIcoDirEntry *ico_dir_entry, struct sail_hash_map *special_properties);
@@ -49,6 +49,7 @@ struct ico_state {
     struct SailIcoHeader ico_header;
     struct SailIcoDirEntry *ico_dir_entries;
     unsigned current_frame;
+    unsigned frames_end;
 
     void *common_bmp_state;
 };
@@ -65,6 +66,7 @@ static sail_status_t alloc_ico_state(struct ico_state **ico_state) {
 
     (*ico_state)->ico_dir_entries  = NULL;
     (*ico_state)->current_frame    = 0;
+    (*ico_state)->frames_end       = 0;
     (*ico_state)->common_bmp_state = NULL;
 
     return SAIL_OK;
@@ -128,6 +130,19 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_ico(struct sail_io *io, const
         SAIL_TRY(ico_private_read_dir_entry(ico_state->io, &ico_state->ico_dir_entries[i]));
     }
 
+    ico_state->frames_end = ico_state->ico_header.images_count;
+
+    /* Load just the nearest image when smaller frames are requested. */
+    if (ico_state->load_options->max_width > 0 || ico_state->load_options->max_height > 0) {
+        SAIL_TRY(ico_private_find_nearest_dir_entry(ico_state->io,
+                                                    ico_state->ico_dir_entries,
+                                                    ico_state->ico_header.images_count,
+                                                    ico_state->load_options->max_width,
+                                                    ico_state->load_options->max_height,
+                                                    &ico_state->current_frame));
+        ico_state->frames_end = ico_state->current_frame + 1;
+    }
+
     return SAIL_OK;
 }
 
@@ -139,7 +154,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_ico(void *state, st
     enum SailIcoImageType ico_image_type;
 
     do {
-        if (ico_state->current_frame >= ico_state->ico_header.images_count) {
+        if (ico_state->current_frame >= ico_state->frames_end) {
             SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
         }
 
@@ -190,6 +205,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_ico(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_ico(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_ico(void **state) {
 
     struct ico_state *ico_state = *state;
@@ -235,6 +260,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_ico(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_ico(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_ico(void **state) {
 
     (void)state;
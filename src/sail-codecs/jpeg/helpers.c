@@ -63,6 +63,11 @@ enum SailPixelFormat jpeg_private_color_space_to_pixel_format(J_COLOR_SPACE colo
         case JCS_EXT_BGRA:  return SAIL_PIXEL_FORMAT_BPP32_BGRA;
         case JCS_EXT_ABGR:  return SAIL_PIXEL_FORMAT_BPP32_ABGR;
         case JCS_EXT_ARGB:  return SAIL_PIXEL_FORMAT_BPP32_ARGB;
+
+        case JCS_EXT_RGBX:  return SAIL_PIXEL_FORMAT_BPP32_RGBX;
+        case JCS_EXT_BGRX:  return SAIL_PIXEL_FORMAT_BPP32_BGRX;
+        case JCS_EXT_XBGR:  return SAIL_PIXEL_FORMAT_BPP32_XBGR;
+        case JCS_EXT_XRGB:  return SAIL_PIXEL_FORMAT_BPP32_XRGB;
 #endif
 
         case JCS_YCbCr:     return SAIL_PIXEL_FORMAT_BPP24_YCBCR;
@@ -86,6 +91,11 @@ J_COLOR_SPACE jpeg_private_pixel_format_to_color_space(enum SailPixelFormat pixe
         case SAIL_PIXEL_FORMAT_BPP32_BGRA:      return JCS_EXT_BGRA;
         case SAIL_PIXEL_FORMAT_BPP32_ABGR:      return JCS_EXT_ABGR;
         case SAIL_PIXEL_FORMAT_BPP32_ARGB:      return JCS_EXT_ARGB;
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX:      return JCS_EXT_RGBX;
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX:      return JCS_EXT_BGRX;
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR:      return JCS_EXT_XBGR;
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB:      return JCS_EXT_XRGB;
 #endif
 
         case SAIL_PIXEL_FORMAT_BPP24_YCBCR:     return JCS_YCbCr;
@@ -96,6 +106,63 @@ J_COLOR_SPACE jpeg_private_pixel_format_to_color_space(enum SailPixelFormat pixe
     }
 }
 
+J_COLOR_SPACE jpeg_private_output_color_space(J_COLOR_SPACE jpeg_color_space, enum SailPixelFormat pixel_format) {
+
+    const J_COLOR_SPACE color_space = jpeg_private_pixel_format_to_color_space(pixel_format);
+
+    if (color_space == jpeg_color_space) {
+        return color_space;
+    }
+
+    /* libjpeg converts only luminance and RGB-like sources. */
+    if (jpeg_color_space != JCS_GRAYSCALE && jpeg_color_space != JCS_YCbCr && jpeg_color_space != JCS_RGB) {
+        return JCS_UNKNOWN;
+    }
+
+    switch (color_space) {
+        case JCS_GRAYSCALE: return (jpeg_color_space == JCS_YCbCr) ? JCS_GRAYSCALE : JCS_UNKNOWN;
+        case JCS_RGB:       return JCS_RGB;
+
+#ifdef SAIL_HAVE_JPEG_JCS_EXT
+        case JCS_EXT_BGR:
+        case JCS_EXT_RGBA:
+        case JCS_EXT_BGRA:
+        case JCS_EXT_ABGR:
+        case JCS_EXT_ARGB:
+        case JCS_EXT_RGBX:
+        case JCS_EXT_BGRX:
+        case JCS_EXT_XBGR:
+        case JCS_EXT_XRGB:  return color_space;
+#endif
+
+        default:            return JCS_UNKNOWN;
+    }
+}
+
+unsigned jpeg_private_scale_denominator(unsigned width, unsigned height, unsigned max_width, unsigned max_height) {
+
+    if (max_width == 0 && max_height == 0) {
+        return 1;
+    }
+
+    unsigned scale_denominator = 1;
+
+    /* libjpeg rounds the scaled dimensions up. */
+    while (scale_denominator < 8) {
+        const unsigned next_denominator = scale_denominator * 2;
+        const unsigned scaled_width     = (width + next_denominator - 1) / next_denominator;
+        const unsigned scaled_height    = (height + next_denominator - 1) / next_denominator;
+
+        if (scaled_width < max_width || scaled_height < max_height) {
+            break;
+        }
+
+        scale_denominator = next_denominator;
+    }
+
+    return scale_denominator;
+}
+
 sail_status_t jpeg_private_fetch_meta_data(struct jpeg_decompress_struct *decompress_context, struct sail_meta_data_node **last_meta_data_node) {
 
     SAIL_CHECK_PTR(last_meta_data_node);
@@ -124,6 +191,17 @@ sail_status_t jpeg_private_fetch_meta_data(struct jpeg_decompress_struct *decomp
     return SAIL_OK;
 }
 
+enum SailOrientation jpeg_private_fetch_orientation(struct jpeg_decompress_struct *decompress_context) {
+
+    for (jpeg_saved_marker_ptr it = decompress_context->marker_list; it != NULL; it = it->next) {
+        if (it->marker == JPEG_APP0 + 1 && it->data_length >= 6 && memcmp(it->data, "Exif\0\0", 6) == 0) {
+            return sail_exif_orientation(it->data, it->data_length);
+        }
+    }
+
+    return SAIL_ORIENTATION_NORMAL;
+}
+
 sail_status_t jpeg_private_write_meta_data(struct jpeg_compress_struct *compress_context, const struct sail_meta_data_node *meta_data_node) {
 
     while (meta_data_node != NULL) {
@@ -155,8 +233,10 @@ sail_status_t jpeg_private_fetch_iccp(struct jpeg_decompress_struct *decompress_
                    ? "" : "not ");
 
     if (data != NULL && data_length > 0) {
+        /* jpeg_read_icc_profile() allocates the profile with malloc(). */
         SAIL_TRY_OR_CLEANUP(sail_alloc_iccp_from_data(data, data_length, iccp),
-                            /* cleanup */ sail_free(data));
+                            /* cleanup */ free(data));
+        free(data);
     }
 
     return SAIL_OK;
@@ -51,10 +51,24 @@ SAIL_HIDDEN enum SailPixelFormat jpeg_private_color_space_to_pixel_format(J_COLO
 
 SAIL_HIDDEN J_COLOR_SPACE jpeg_private_pixel_format_to_color_space(enum SailPixelFormat pixel_format);
 
+/*
+ * Returns the libjpeg output color space to decode the specified source color space into
+ * the requested pixel format, or JCS_UNKNOWN if libjpeg cannot produce it.
+ */
+SAIL_HIDDEN J_COLOR_SPACE jpeg_private_output_color_space(J_COLOR_SPACE jpeg_color_space, enum SailPixelFormat pixel_format);
+
+/*
+ * Returns the largest DCT scale denominator out of 1, 2, 4, and 8 that keeps the scaled
+ * dimensions not less than the requested maximum dimensions. 0 means no limit.
+ */
+SAIL_HIDDEN unsigned jpeg_private_scale_denominator(unsigned width, unsigned height, unsigned max_width, unsigned max_height);
+
 SAIL_HIDDEN sail_status_t jpeg_private_fetch_meta_data(struct jpeg_decompress_struct *decompress_context, struct sail_meta_data_node **last_meta_data_node);
 
 SAIL_HIDDEN sail_status_t jpeg_private_write_meta_data(struct jpeg_compress_struct *compress_context, const struct sail_meta_data_node *meta_data_node);
 
+SAIL_HIDDEN enum SailOrientation jpeg_private_fetch_orientation(struct jpeg_decompress_struct *decompress_context);
+
 #ifdef SAIL_HAVE_JPEG_ICCP
 SAIL_HIDDEN sail_status_t jpeg_private_fetch_iccp(struct jpeg_decompress_struct *decompress_context, struct sail_iccp **iccp);
 #endif
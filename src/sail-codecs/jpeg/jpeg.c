@@ -59,6 +59,16 @@ struct jpeg_state {
     bool frame_loaded;
     bool frame_saved;
     bool started_compress;
+
+    /*
+     * The region of interest. libjpeg crops scan lines at iMCU boundaries, so they are decoded into
+     * the scan line buffer and cut when libjpeg's crop doesn't match the region exactly.
+     */
+    bool roi;
+    unsigned roi_width;
+    unsigned roi_height;
+    unsigned roi_skip_bytes;
+    unsigned char *roi_scan_line;
 };
 
 static sail_status_t alloc_jpeg_state(struct jpeg_state **jpeg_state) {
@@ -75,6 +85,11 @@ static sail_status_t alloc_jpeg_state(struct jpeg_state **jpeg_state) {
     (*jpeg_state)->frame_loaded       = false;
     (*jpeg_state)->frame_saved        = false;
     (*jpeg_state)->started_compress   = false;
+    (*jpeg_state)->roi                = false;
+    (*jpeg_state)->roi_width          = 0;
+    (*jpeg_state)->roi_height         = 0;
+    (*jpeg_state)->roi_skip_bytes     = 0;
+    (*jpeg_state)->roi_scan_line      = NULL;
 
     return SAIL_OK;
 }
@@ -87,6 +102,7 @@ static void destroy_jpeg_state(struct jpeg_state *jpeg_state) {
 
     sail_free(jpeg_state->decompress_context);
     sail_free(jpeg_state->compress_context);
+    sail_free(jpeg_state->roi_scan_line);
 
     sail_destroy_load_options(jpeg_state->load_options);
     sail_destroy_save_options(jpeg_state->save_options);
@@ -94,6 +110,22 @@ static void destroy_jpeg_state(struct jpeg_state *jpeg_state) {
     sail_free(jpeg_state);
 }
 
+/* Reads the next scan line cutting it to the region of interest if necessary. */
+static void read_scan_line(struct jpeg_state *jpeg_state, unsigned char *scan_line) {
+
+    if (jpeg_state->roi_scan_line == NULL) {
+        JSAMPROW samprow = (JSAMPROW)scan_line;
+        (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
+    } else {
+        JSAMPROW samprow = (JSAMPROW)jpeg_state->roi_scan_line;
+        (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
+
+        memcpy(scan_line,
+               jpeg_state->roi_scan_line + jpeg_state->roi_skip_bytes,
+               (size_t)jpeg_state->roi_width * jpeg_state->decompress_context->output_components);
+    }
+}
+
 /*
  * Decoding functions.
  */
@@ -136,11 +168,19 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_jpeg(struct sail_io *io, const
     if (jpeg_state->load_options->options & SAIL_OPTION_ICCP) {
         jpeg_save_markers(jpeg_state->decompress_context, JPEG_APP0 + 2, 0xFFFF);
     }
+    if (jpeg_state->load_options->options & (SAIL_OPTION_META_DATA | SAIL_OPTION_APPLY_ORIENTATION)) {
+        jpeg_save_markers(jpeg_state->decompress_context, JPEG_APP0 + 1, 0xFFFF);
+    }
 
     jpeg_read_header(jpeg_state->decompress_context, true);
 
     /* Handle the requested color space. */
-    if (jpeg_state->decompress_context->jpeg_color_space == JCS_YCbCr) {
+    const J_COLOR_SPACE output_color_space =
+        jpeg_private_output_color_space(jpeg_state->decompress_context->jpeg_color_space, jpeg_state->load_options->output_pixel_format);
+
+    if (output_color_space != JCS_UNKNOWN) {
+        jpeg_state->decompress_context->out_color_space = output_color_space;
+    } else if (jpeg_state->decompress_context->jpeg_color_space == JCS_YCbCr) {
         jpeg_state->decompress_context->out_color_space = JCS_RGB;
     } else {
         jpeg_state->decompress_context->out_color_space = jpeg_state->decompress_context->jpeg_color_space;
@@ -149,9 +189,57 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_jpeg(struct sail_io *io, const
     /* We don't want colormapped output. */
     jpeg_state->decompress_context->quantize_colors = false;
 
+    /* Skip most of the IDCT work when smaller frames are requested. */
+    jpeg_state->decompress_context->scale_num   = 1;
+    jpeg_state->decompress_context->scale_denom =
+        jpeg_private_scale_denominator(jpeg_state->decompress_context->image_width,
+                                        jpeg_state->decompress_context->image_height,
+                                        jpeg_state->load_options->max_width,
+                                        jpeg_state->load_options->max_height);
+
     /* Launch decompression! */
     jpeg_start_decompress(jpeg_state->decompress_context);
 
+#ifdef SAIL_HAVE_JPEG_CROP
+    /* Skip the scan lines and the iMCU columns outside the region of interest. */
+    unsigned roi_x, roi_y;
+
+    if (sail_clip_roi(jpeg_state->load_options,
+                        jpeg_state->decompress_context->output_width, jpeg_state->decompress_context->output_height,
+                        &roi_x, &roi_y, &jpeg_state->roi_width, &jpeg_state->roi_height)) {
+        JDIMENSION x_offset   = roi_x;
+        JDIMENSION crop_width = jpeg_state->roi_width;
+
+        /*
+         * Fancy upsampling replicates the edge pixels of the cropped area. Decode one more
+         * column on both sides to get the same pixels as when decoding the whole frame.
+         */
+        if (x_offset > 0) {
+            x_offset--;
+            crop_width++;
+        }
+        if (x_offset + crop_width < jpeg_state->decompress_context->output_width) {
+            crop_width++;
+        }
+
+        jpeg_crop_scanline(jpeg_state->decompress_context, &x_offset, &crop_width);
+
+        if (x_offset != roi_x || crop_width != jpeg_state->roi_width) {
+            jpeg_state->roi_skip_bytes = (roi_x - x_offset) * jpeg_state->decompress_context->output_components;
+
+            void *ptr;
+            SAIL_TRY(sail_malloc((size_t)crop_width * jpeg_state->decompress_context->output_components, &ptr));
+            jpeg_state->roi_scan_line = ptr;
+        }
+
+        if (roi_y > 0) {
+            (void)jpeg_skip_scanlines(jpeg_state->decompress_context, roi_y);
+        }
+
+        jpeg_state->roi = true;
+    }
+#endif
+
     return SAIL_OK;
 }
 
@@ -177,12 +265,15 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_jpeg(void *state, s
     }
 
     /* Image properties. */
-    image_local->width                      = jpeg_state->decompress_context->output_width;
-    image_local->height                     = jpeg_state->decompress_context->output_height;
+    image_local->width                      = jpeg_state->roi ? jpeg_state->roi_width : jpeg_state->decompress_context->output_width;
+    image_local->height                     = jpeg_state->roi ? jpeg_state->roi_height : jpeg_state->decompress_context->output_height;
     image_local->pixel_format               = jpeg_private_color_space_to_pixel_format(jpeg_state->decompress_context->out_color_space);
     image_local->bytes_per_line             = sail_bytes_per_line(image_local->width, image_local->pixel_format);
     image_local->source_image->pixel_format = jpeg_private_color_space_to_pixel_format(jpeg_state->decompress_context->jpeg_color_space);
     image_local->source_image->compression  = SAIL_COMPRESSION_JPEG;
+    image_local->source_image->width        = jpeg_state->decompress_context->image_width;
+    image_local->source_image->height       = jpeg_state->decompress_context->image_height;
+    image_local->source_image->orientation  = jpeg_private_fetch_orientation(jpeg_state->decompress_context);
 
     /* Read meta data. */
     if (jpeg_state->load_options->options & SAIL_OPTION_META_DATA) {
@@ -221,10 +312,27 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_jpeg(void *state, struct sail
     }
 
     for (unsigned row = 0; row < image->height; row++) {
-        unsigned char *scanline = (unsigned char *)image->pixels + row * image->bytes_per_line;
+        read_scan_line(jpeg_state, (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line);
+    }
 
-        JSAMPROW samprow = (JSAMPROW)scanline;
-        (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
+    return SAIL_OK;
+}
+
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_jpeg(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    struct jpeg_state *jpeg_state = state;
+
+    if (jpeg_state->libjpeg_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (setjmp(jpeg_state->error_context.setjmp_buffer) != 0) {
+        jpeg_state->libjpeg_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        read_scan_line(jpeg_state, (unsigned char *)rows + (size_t)row * image->bytes_per_line);
     }
 
     return SAIL_OK;
@@ -386,6 +494,27 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_jpeg(void *state, const struc
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_jpeg(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    struct jpeg_state *jpeg_state = state;
+
+    if (jpeg_state->libjpeg_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (setjmp(jpeg_state->error_context.setjmp_buffer) != 0) {
+        jpeg_state->libjpeg_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        JSAMPROW samprow = (JSAMPROW)((const unsigned char *)rows + (size_t)row * image->bytes_per_line);
+        jpeg_write_scanlines(jpeg_state->compress_context, &samprow, 1);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_jpeg(void **state) {
 
     struct jpeg_state *jpeg_state = *state;
@@ -41,7 +41,7 @@ struct jpeg2000_state {
     struct sail_save_options *save_options;
 
     bool frame_loaded;
-    void *image_data;
+    void *image_data_to_free;
     jas_stream_t *jas_stream;
     jas_image_t *jas_image;
 
@@ -66,7 +66,7 @@ static sail_status_t alloc_jpeg2000_state(struct jpeg2000_state **jpeg2000_state
     (*jpeg2000_state)->save_options = NULL;
 
     (*jpeg2000_state)->frame_loaded    = false;
-    (*jpeg2000_state)->image_data      = NULL;
+    (*jpeg2000_state)->image_data_to_free = NULL;
     (*jpeg2000_state)->jas_stream      = NULL;
     (*jpeg2000_state)->jas_image       = NULL;
     (*jpeg2000_state)->number_channels = 0;
@@ -105,7 +105,7 @@ static void destroy_jpeg2000_state(struct jpeg2000_state *jpeg2000_state) {
     sail_destroy_load_options(jpeg2000_state->load_options);
     sail_destroy_save_options(jpeg2000_state->save_options);
 
-    sail_free(jpeg2000_state->image_data);
+    sail_free(jpeg2000_state->image_data_to_free);
 
     sail_free(jpeg2000_state);
 }
@@ -126,12 +126,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_jpeg2000(struct sail_io *io, c
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &jpeg2000_state->load_options));
 
-    /* Read the entire image to use the JasPer memory API. */
+    /* Get the entire image to use the JasPer memory API. */
+    const void *image_data;
     size_t image_size;
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &jpeg2000_state->image_data, &image_size));
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &image_data, &image_size, &jpeg2000_state->image_data_to_free));
 
-    /* This function may generate a warning on old versions of Jasper: conversion from size_t to int. */
-    jpeg2000_state->jas_stream = jas_stream_memopen(jpeg2000_state->image_data, image_size);
+    /*
+     * JasPer never writes into a memory stream opened for reading, so it's safe to cast away const.
+     * This function may generate a warning on old versions of Jasper: conversion from size_t to int.
+     */
+    jpeg2000_state->jas_stream = jas_stream_memopen((char *)image_data, image_size);
 
     if (jpeg2000_state->jas_stream == NULL) {
         SAIL_LOG_ERROR("JPEG2000: Failed to open the specified file");
@@ -309,6 +313,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_jpeg2000(void *state, struct
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_jpeg2000(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_jpeg2000(void **state) {
 
     struct jpeg2000_state *jpeg2000_state = *state;
@@ -349,6 +363,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_jpeg2000(void *state, const s
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_jpeg2000(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_jpeg2000(void **state) {
 
     (void)state;
@@ -151,18 +151,14 @@ sail_status_t pcx_private_build_palette(enum SailPixelFormat pixel_format, struc
     return SAIL_OK;
 }
 
-sail_status_t pcx_private_read_uncompressed(struct sail_io *io, unsigned bytes_per_plane_to_read, unsigned planes, unsigned char *buffer, struct sail_image *image) {
+sail_status_t pcx_private_read_uncompressed_scan_line(struct sail_io *io, unsigned bytes_per_plane_to_read, unsigned planes, unsigned char *buffer, unsigned char *scan) {
 
-    for (unsigned row = 0; row < image->height; row++) {
-        unsigned char *target_scan = (unsigned char *)image->pixels + image->bytes_per_line * row;
+    /* Read plane by plane and then merge them into the scan line. */
+    for (unsigned plane = 0; plane < planes; plane++) {
+        SAIL_TRY(io->strict_read(io->stream, buffer, bytes_per_plane_to_read));
 
-        /* Read plane by plane and then merge them into the image pixels. */
-        for (unsigned plane = 0; plane < planes; plane++) {
-            SAIL_TRY(io->strict_read(io->stream, buffer, bytes_per_plane_to_read));
-
-            for (unsigned column = 0; column < bytes_per_plane_to_read; column++) {
-                *(target_scan + column * planes + plane) = *(buffer + column);
-            }
+        for (unsigned column = 0; column < bytes_per_plane_to_read; column++) {
+            *(scan + column * planes + plane) = *(buffer + column);
         }
     }
 
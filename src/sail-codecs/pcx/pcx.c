@@ -45,6 +45,7 @@ static const uint8_t SAIL_PCX_RLE_COUNT_MASK = 0x3F;
  */
 struct pcx_state {
     struct sail_io *io;
+    struct sail_io_reader *io_reader;
     struct sail_load_options *load_options;
     struct sail_save_options *save_options;
 
@@ -52,6 +53,7 @@ struct pcx_state {
     unsigned char *scanline_buffer; /* buffer to read a single plane scan line. */
 
     bool frame_loaded;
+    unsigned next_row;
 };
 
 static sail_status_t alloc_pcx_state(struct pcx_state **pcx_state) {
@@ -61,11 +63,13 @@ static sail_status_t alloc_pcx_state(struct pcx_state **pcx_state) {
     *pcx_state = ptr;
 
     (*pcx_state)->io           = NULL;
+    (*pcx_state)->io_reader    = NULL;
     (*pcx_state)->load_options = NULL;
     (*pcx_state)->save_options = NULL;
 
     (*pcx_state)->scanline_buffer = NULL;
     (*pcx_state)->frame_loaded    = false;
+    (*pcx_state)->next_row        = 0;
 
     return SAIL_OK;
 }
@@ -76,6 +80,8 @@ static void destroy_pcx_state(struct pcx_state *pcx_state) {
         return;
     }
 
+    sail_destroy_io_reader(pcx_state->io_reader);
+
     sail_destroy_load_options(pcx_state->load_options);
     sail_destroy_save_options(pcx_state->save_options);
 
@@ -84,6 +90,65 @@ static void destroy_pcx_state(struct pcx_state *pcx_state) {
     sail_free(pcx_state);
 }
 
+/* Decodes all planes of a single RLE-compressed scan line and merges them into the scan line. */
+static sail_status_t read_rle_scan_line(struct pcx_state *pcx_state, unsigned bytes_per_line, unsigned char *scan) {
+
+    unsigned buffer_offset = 0;
+
+    for (unsigned bytes = 0; bytes < bytes_per_line;) {
+        uint8_t marker;
+        SAIL_TRY(sail_io_reader_read_u8(pcx_state->io_reader, &marker));
+
+        uint8_t count;
+        uint8_t value;
+
+        /* RLE marker set. */
+        if ((marker & SAIL_PCX_RLE_MARKER) == SAIL_PCX_RLE_MARKER) {
+            count = marker & SAIL_PCX_RLE_COUNT_MASK;
+            SAIL_TRY(sail_io_reader_read_u8(pcx_state->io_reader, &value));
+        } else {
+            /* Pixel value. */
+            count = 1;
+            value = marker;
+        }
+
+        bytes += count;
+
+        memset(pcx_state->scanline_buffer + buffer_offset, value, count);
+        buffer_offset += count;
+    }
+
+    /* Merge planes into the scan line. */
+    for (unsigned plane = 0; plane < pcx_state->pcx_header.planes; plane++) {
+        const unsigned buffer_plane_offset = plane * pcx_state->pcx_header.bytes_per_line;
+
+        for (unsigned column = 0; column < pcx_state->pcx_header.bytes_per_line; column++) {
+            *(scan + column * pcx_state->pcx_header.planes + plane) = *(pcx_state->scanline_buffer + buffer_plane_offset + column);
+        }
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_scan_lines(struct pcx_state *pcx_state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    for (unsigned row = 0; row < rows_count; row++, pcx_state->next_row++) {
+        unsigned char * const scan = (unsigned char *)rows + (size_t)image->bytes_per_line * row;
+
+        if (pcx_state->pcx_header.encoding == SAIL_PCX_NO_ENCODING) {
+            SAIL_TRY(pcx_private_read_uncompressed_scan_line(pcx_state->io, pcx_state->pcx_header.bytes_per_line, pcx_state->pcx_header.planes, pcx_state->scanline_buffer, scan));
+        } else {
+            SAIL_TRY(read_rle_scan_line(pcx_state, image->bytes_per_line, scan));
+
+            if (pcx_state->next_row + 1 == image->height) {
+                SAIL_TRY(sail_io_reader_sync(pcx_state->io_reader));
+            }
+        }
+    }
+
+    return SAIL_OK;
+}
+
 /*
  * Decoding functions.
  */
@@ -99,6 +164,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_pcx(struct sail_io *io, const
 
     /* Save I/O for further operations. */
     pcx_state->io = io;
+    SAIL_TRY(sail_alloc_io_reader(io, &pcx_state->io_reader));
 
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &pcx_state->load_options));
@@ -176,50 +242,14 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_pcx(void *state, st
 
 SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_pcx(void *state, struct sail_image *image) {
 
-    const struct pcx_state *pcx_state = state;
-
-    if (pcx_state->pcx_header.encoding == SAIL_PCX_NO_ENCODING) {
-        SAIL_TRY(pcx_private_read_uncompressed(pcx_state->io, pcx_state->pcx_header.bytes_per_line, pcx_state->pcx_header.planes, pcx_state->scanline_buffer, image));
-    } else {
-        for (unsigned row = 0; row < image->height; row++) {
-            unsigned buffer_offset = 0;
-
-            /* Decode all planes of a single scan line. */
-            for (unsigned bytes = 0; bytes < image->bytes_per_line;) {
-                uint8_t marker;
-                SAIL_TRY(pcx_state->io->strict_read(pcx_state->io->stream, &marker, sizeof(marker)));
-
-                uint8_t count;
-                uint8_t value;
-
-                /* RLE marker set. */
-                if ((marker & SAIL_PCX_RLE_MARKER) == SAIL_PCX_RLE_MARKER) {
-                    count = marker & SAIL_PCX_RLE_COUNT_MASK;
-                    SAIL_TRY(pcx_state->io->strict_read(pcx_state->io->stream, &value, sizeof(value)));
-                } else {
-                    /* Pixel value. */
-                    count = 1;
-                    value = marker;
-                }
-
-                bytes += count;
-
-                memset(pcx_state->scanline_buffer + buffer_offset, value, count);
-                buffer_offset += count;
-            }
+    SAIL_TRY(read_scan_lines(state, image, image->pixels, image->height));
 
-            /* Merge planes into the image pixels. */
-            unsigned char * const scan = (unsigned char *)image->pixels + image->bytes_per_line * row;
+    return SAIL_OK;
+}
 
-            for (unsigned plane = 0; plane < pcx_state->pcx_header.planes; plane++) {
-                const unsigned buffer_plane_offset = plane * pcx_state->pcx_header.bytes_per_line;
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_pcx(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
 
-                for (unsigned column = 0; column < pcx_state->pcx_header.bytes_per_line; column++) {
-                    *(scan + column * pcx_state->pcx_header.planes + plane) = *(pcx_state->scanline_buffer + buffer_plane_offset + column);
-                }
-            }
-        }
-    }
+    SAIL_TRY(read_scan_lines(state, image, rows, rows_count));
 
     return SAIL_OK;
 }
@@ -264,6 +294,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_pcx(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_pcx(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_pcx(void **state) {
 
     (void)state;
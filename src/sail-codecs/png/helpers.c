@@ -279,6 +279,73 @@ sail_status_t png_private_pixel_format_to_png_color_type(enum SailPixelFormat pi
     }
 }
 
+bool png_private_setup_output_pixel_format(png_structp png_ptr, png_infop info_ptr, int color_type, int bit_depth, enum SailPixelFormat pixel_format) {
+
+    bool bgr;
+    bool alpha;
+    bool filler;
+    bool alpha_first = false;
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:  bgr = false; alpha = false; filler = false; break;
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:  bgr = true;  alpha = false; filler = false; break;
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA: bgr = false; alpha = true;  filler = false; break;
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA: bgr = true;  alpha = true;  filler = false; break;
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB: bgr = false; alpha = true;  filler = false; alpha_first = true; break;
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR: bgr = true;  alpha = true;  filler = false; alpha_first = true; break;
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX: bgr = false; alpha = false; filler = true;  break;
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX: bgr = true;  alpha = false; filler = true;  break;
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB: bgr = false; alpha = false; filler = true;  alpha_first = true; break;
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR: bgr = true;  alpha = false; filler = true;  alpha_first = true; break;
+
+        default: {
+            return false;
+        }
+    }
+
+    /* Stripping 16-bit samples is left to libsail to keep the rounding consistent. */
+    if (bit_depth > 8) {
+        return false;
+    }
+
+    bool source_alpha = (color_type & PNG_COLOR_MASK_ALPHA) != 0;
+
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+        png_set_palette_to_rgb(png_ptr);
+
+#ifdef PNG_tRNS_SUPPORTED
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS) != 0) {
+            png_set_tRNS_to_alpha(png_ptr);
+            source_alpha = true;
+        }
+#endif
+    } else if ((color_type & PNG_COLOR_MASK_COLOR) == 0) {
+        if (bit_depth < 8) {
+            png_set_expand_gray_1_2_4_to_8(png_ptr);
+        }
+
+        png_set_gray_to_rgb(png_ptr);
+    }
+
+    if (source_alpha && !alpha) {
+        png_set_strip_alpha(png_ptr);
+    }
+
+    if (filler) {
+        png_set_filler(png_ptr, 0xFF, alpha_first ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
+    } else if (alpha && !source_alpha) {
+        png_set_add_alpha(png_ptr, 0xFF, alpha_first ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
+    } else if (alpha && alpha_first) {
+        png_set_swap_alpha(png_ptr);
+    }
+
+    if (bgr) {
+        png_set_bgr(png_ptr);
+    }
+
+    return true;
+}
+
 sail_status_t png_private_fetch_meta_data(png_structp png_ptr, png_infop info_ptr, struct sail_meta_data_node **target_meta_data_node) {
 
     SAIL_CHECK_PTR(png_ptr);
@@ -351,6 +418,18 @@ sail_status_t png_private_fetch_meta_data(png_structp png_ptr, png_infop info_pt
     return SAIL_OK;
 }
 
+enum SailOrientation png_private_fetch_orientation(png_structp png_ptr, png_infop info_ptr) {
+
+    png_bytep exif;
+    png_uint_32 exif_length;
+
+    if (png_get_eXIf_1(png_ptr, info_ptr, &exif_length, &exif) != 0) {
+        return sail_exif_orientation(exif, exif_length);
+    }
+
+    return SAIL_ORIENTATION_NORMAL;
+}
+
 sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_ptr, const struct sail_meta_data_node *meta_data_node) {
 
     SAIL_CHECK_PTR(png_ptr);
@@ -368,10 +447,11 @@ sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_pt
         SAIL_TRY(sail_malloc(count * sizeof(png_text), &ptr));
         png_text *lines = ptr;
 
-        /* Indexes in 'lines' that must be freed. 1 = free, 0 = don't free. */
-        SAIL_TRY(sail_malloc(count * sizeof(bool), &ptr));
-        int *lines_to_free = ptr;
-        memset(lines_to_free, 0, count);
+        /* Indexes in 'lines' that must be freed. */
+        SAIL_TRY_OR_CLEANUP(sail_malloc(count * sizeof(bool), &ptr),
+                            /* cleanup */ sail_free(lines));
+        bool *lines_to_free = ptr;
+        memset(lines_to_free, 0, count * sizeof(bool));
 
         unsigned index = 0;
 
@@ -419,7 +499,7 @@ sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_pt
                                             /* on error */ sail_free(hex_string); continue);
                         sail_free(hex_string);
 
-                        lines_to_free[index] = 1;
+                        lines_to_free[index] = true;
                     } else {
                         meta_data_key   = sail_meta_data_to_string(meta_data->key);
                         meta_data_value = sail_variant_to_string(meta_data->value);
@@ -438,7 +518,7 @@ sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_pt
 
         /* Cleanup. */
         for (unsigned i = 0; i < index; i++) {
-            if (lines_to_free[i] == 1) {
+            if (lines_to_free[i]) {
                 sail_free(lines[i].text);
             }
         }
@@ -550,12 +630,12 @@ sail_status_t png_private_blend_over(void *dst_raw, unsigned dst_offset, const v
             const uint8_t *src = src_raw;
             uint8_t *dst = (uint8_t *)dst_raw + dst_offset * bytes_per_pixel;
 
-            while (width--) {
-                const double src_a = *(src+1) / 255.0;
-                const double dst_a = *(dst+1) / 255.0;
+            for (; width > 0; width--, src += 2, dst += 2) {
+                const uint32_t src_a = *(src+1);
+                const uint32_t dst_a = (255 - src_a) * *(dst+1);
 
-                *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint8_t)((src_a + (1-src_a) * dst_a) * 255);           src++; dst++;
+                *(dst+0) = (uint8_t)((src_a * 255 * *(src+0) + dst_a * *(dst+0)) / (255 * 255));
+                *(dst+1) = (uint8_t)(src_a + dst_a / 255);
             }
             break;
         }
@@ -563,12 +643,12 @@ sail_status_t png_private_blend_over(void *dst_raw, unsigned dst_offset, const v
             const uint16_t *src = src_raw;
             uint16_t *dst = (uint16_t *)((uint8_t *)dst_raw + dst_offset * bytes_per_pixel);
 
-            while (width--) {
-                const double src_a = *(src+1) / 65535.0;
-                const double dst_a = *(dst+1) / 65535.0;
+            for (; width > 0; width--, src += 2, dst += 2) {
+                const uint64_t src_a = *(src+1);
+                const uint64_t dst_a = (65535 - src_a) * *(dst+1);
 
-                *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint16_t)((src_a + (1-src_a) * dst_a) * 65535);         src++; dst++;
+                *(dst+0) = (uint16_t)((src_a * 65535 * *(src+0) + dst_a * *(dst+0)) / (65535ULL * 65535));
+                *(dst+1) = (uint16_t)(src_a + dst_a / 65535);
             }
             break;
         }
@@ -576,14 +656,14 @@ sail_status_t png_private_blend_over(void *dst_raw, unsigned dst_offset, const v
             const uint8_t *src = src_raw;
             uint8_t *dst = (uint8_t *)dst_raw + dst_offset * bytes_per_pixel;
 
-            while (width--) {
-                const double src_a = *(src+3) / 255.0;
-                const double dst_a = *(dst+3) / 255.0;
+            for (; width > 0; width--, src += 4, dst += 4) {
+                const uint32_t src_a = *(src+3);
+                const uint32_t dst_a = (255 - src_a) * *(dst+3);
 
-                *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint8_t)((src_a + (1-src_a) * dst_a) * 255);           src++; dst++;
+                *(dst+0) = (uint8_t)((src_a * 255 * *(src+0) + dst_a * *(dst+0)) / (255 * 255));
+                *(dst+1) = (uint8_t)((src_a * 255 * *(src+1) + dst_a * *(dst+1)) / (255 * 255));
+                *(dst+2) = (uint8_t)((src_a * 255 * *(src+2) + dst_a * *(dst+2)) / (255 * 255));
+                *(dst+3) = (uint8_t)(src_a + dst_a / 255);
             }
             break;
         }
@@ -591,14 +671,14 @@ sail_status_t png_private_blend_over(void *dst_raw, unsigned dst_offset, const v
             const uint16_t *src = src_raw;
             uint16_t *dst = (uint16_t *)((uint8_t *)dst_raw + dst_offset * bytes_per_pixel);
 
-            while (width--) {
-                const double src_a = *(src+3) / 65535.0;
-                const double dst_a = *(dst+3) / 65535.0;
+            for (; width > 0; width--, src += 4, dst += 4) {
+                const uint64_t src_a = *(src+3);
+                const uint64_t dst_a = (65535 - src_a) * *(dst+3);
 
-                *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-                *dst = (uint16_t)((src_a + (1-src_a) * dst_a) * 65535);         src++; dst++;
+                *(dst+0) = (uint16_t)((src_a * 65535 * *(src+0) + dst_a * *(dst+0)) / (65535ULL * 65535));
+                *(dst+1) = (uint16_t)((src_a * 65535 * *(src+1) + dst_a * *(dst+1)) / (65535ULL * 65535));
+                *(dst+2) = (uint16_t)((src_a * 65535 * *(src+2) + dst_a * *(dst+2)) / (65535ULL * 65535));
+                *(dst+3) = (uint16_t)(src_a + dst_a / 65535);
             }
             break;
         }
@@ -50,10 +50,18 @@ SAIL_HIDDEN enum SailPixelFormat png_private_png_color_type_to_pixel_format(int
 
 SAIL_HIDDEN sail_status_t png_private_pixel_format_to_png_color_type(enum SailPixelFormat pixel_format, int *color_type, int *bit_depth);
 
+/*
+ * Sets up libpng transformations to decode 8-bit and less images into the specified RGB-like pixel format.
+ * Returns false if the pixel format cannot be produced by libpng, and no transformations are set up.
+ */
+SAIL_HIDDEN bool png_private_setup_output_pixel_format(png_structp png_ptr, png_infop info_ptr, int color_type, int bit_depth, enum SailPixelFormat pixel_format);
+
 SAIL_HIDDEN sail_status_t png_private_fetch_meta_data(png_structp png_ptr, png_infop info_ptr, struct sail_meta_data_node **target_meta_data_node);
 
 SAIL_HIDDEN sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_ptr, const struct sail_meta_data_node *meta_data_node);
 
+SAIL_HIDDEN enum SailOrientation png_private_fetch_orientation(png_structp png_ptr, png_infop info_ptr);
+
 SAIL_HIDDEN sail_status_t png_private_fetch_iccp(png_structp png_ptr, png_infop info_ptr, struct sail_iccp **iccp);
 
 SAIL_HIDDEN sail_status_t png_private_fetch_palette(png_structp png_ptr, png_infop info_ptr, struct sail_palette **palette);
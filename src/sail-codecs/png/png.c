@@ -237,8 +237,32 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_png(struct sail_io *io, const
     png_state->frames = 1;
 #endif
 
+    /* Decode into the requested pixel format. APNG frames are composed in the source pixel format. */
+    bool native_output_pixel_format = true;
+#ifdef PNG_APNG_SUPPORTED
+    native_output_pixel_format = !png_state->is_apng;
+#endif
+
+    if (native_output_pixel_format &&
+            png_private_setup_output_pixel_format(png_state->png_ptr,
+                                                  png_state->info_ptr,
+                                                  png_state->color_type,
+                                                  png_state->bit_depth,
+                                                  png_state->load_options->output_pixel_format)) {
+        png_state->first_image->pixel_format   = png_state->load_options->output_pixel_format;
+        png_state->first_image->bytes_per_line = sail_bytes_per_line(png_state->first_image->width, png_state->first_image->pixel_format);
+
+        sail_destroy_palette(png_state->first_image->palette);
+        png_state->first_image->palette = NULL;
+    }
+
     png_state->first_image->source_image->pixel_format = png_private_png_color_type_to_pixel_format(png_state->color_type, png_state->bit_depth);
     png_state->first_image->source_image->compression = SAIL_COMPRESSION_DEFLATE;
+    /*
+     * Orientation must be known before the first scan line. An eXIf chunk after IDAT is only
+     * reachable with png_read_end() after all the pixels, so it's ignored.
+     */
+    png_state->first_image->source_image->orientation = png_private_fetch_orientation(png_state->png_ptr, png_state->info_ptr);
 
     if (png_state->interlaced_passes > 1) {
         png_state->first_image->source_image->interlaced = true;
@@ -431,6 +455,36 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_png(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_png(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    struct png_state *png_state = state;
+
+    if (png_state->libpng_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Interlaced passes and APNG frames need the whole frame. */
+    bool whole_frame = png_state->interlaced_passes > 1;
+#ifdef PNG_APNG_SUPPORTED
+    whole_frame = whole_frame || png_state->is_apng;
+#endif
+
+    if (whole_frame) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+        png_state->libpng_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        png_read_row(png_state->png_ptr, (unsigned char *)rows + (size_t)row * image->bytes_per_line, NULL);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_png(void **state) {
 
     struct png_state *png_state = *state;
@@ -633,6 +687,31 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_png(void *state, const struct
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_png(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    struct png_state *png_state = state;
+
+    if (png_state->libpng_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Interlaced passes need the whole frame. */
+    if (png_state->interlaced_passes > 1) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+        png_state->libpng_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        png_write_row(png_state->png_ptr, (const unsigned char *)rows + (size_t)row * image->bytes_per_line);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_png(void **state) {
 
     struct png_state *png_state = *state;
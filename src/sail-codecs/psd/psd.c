@@ -38,6 +38,7 @@ static const unsigned SAIL_PSD_MAGIC = 0x38425053;
  */
 struct psd_state {
     struct sail_io *io;
+    struct sail_io_reader *io_reader;
     struct sail_load_options *load_options;
     struct sail_save_options *save_options;
 
@@ -57,6 +58,7 @@ static sail_status_t alloc_psd_state(struct psd_state **psd_state) {
     *psd_state = ptr;
 
     (*psd_state)->io           = NULL;
+    (*psd_state)->io_reader    = NULL;
     (*psd_state)->load_options = NULL;
     (*psd_state)->save_options = NULL;
 
@@ -79,6 +81,8 @@ static void destroy_psd_state(struct psd_state *psd_state) {
 
     sail_free(psd_state->scan_buffer);
 
+    sail_destroy_io_reader(psd_state->io_reader);
+
     sail_destroy_load_options(psd_state->load_options);
     sail_destroy_save_options(psd_state->save_options);
 
@@ -100,6 +104,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_psd(struct sail_io *io, const
 
     /* Save I/O for further operations. */
     psd_state->io = io;
+    SAIL_TRY(sail_alloc_io_reader(io, &psd_state->io_reader));
 
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &psd_state->load_options));
@@ -251,15 +256,15 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_psd(void *state, struct sail_
         for (unsigned channel = 0; channel < psd_state->channels; channel++) {
             for (unsigned row = 0; row < image->height; row++) {
                 for (unsigned count = 0; count < image->width; ) {
-                    unsigned char c;
-                    SAIL_TRY(psd_state->io->strict_read(psd_state->io->stream, &c, sizeof(c)));
+                    uint8_t c;
+                    SAIL_TRY(sail_io_reader_read_u8(psd_state->io_reader, &c));
 
                     if (c > 128) {
                         c ^= 0xff;
                         c += 2;
 
-                        unsigned char value;
-                        SAIL_TRY(psd_state->io->strict_read(psd_state->io->stream, &value, sizeof(value)));
+                        uint8_t value;
+                        SAIL_TRY(sail_io_reader_read_u8(psd_state->io_reader, &value));
 
                         for (unsigned i = count; i < count + c; i++) {
                             unsigned char *scan = (unsigned char *)image->pixels + row * image->bytes_per_line + i * bpp;
@@ -269,8 +274,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_psd(void *state, struct sail_
                         c++;
 
                         for (unsigned i = count; i < count + c; i++) {
-                            unsigned char value;
-                            SAIL_TRY(psd_state->io->strict_read(psd_state->io->stream, &value, sizeof(value)));
+                            uint8_t value;
+                            SAIL_TRY(sail_io_reader_read_u8(psd_state->io_reader, &value));
 
                             unsigned char *scan = (unsigned char *)image->pixels + row * image->bytes_per_line + i * bpp;
                             *(scan + channel) = value;
@@ -281,6 +286,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_psd(void *state, struct sail_
                 }
             }
         }
+
+        SAIL_TRY(sail_io_reader_sync(psd_state->io_reader));
     } else {
         for (unsigned channel = 0; channel < psd_state->channels; channel++) {
             for (unsigned row = 0; row < image->height; row++) {
@@ -297,6 +304,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_psd(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_psd(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_psd(void **state) {
 
     struct psd_state *psd_state = *state;
@@ -337,6 +354,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_psd(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_psd(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_psd(void **state) {
 
     (void)state;
@@ -44,8 +44,9 @@ struct qoi_state {
     bool frame_loaded;
     bool frame_saved;
 
-    void *image_data;
+    const void *image_data;
     size_t image_data_size;
+    void *image_data_to_free;
     void *pixels;
 
     qoi_desc qoi_desc;
@@ -64,9 +65,10 @@ static sail_status_t alloc_qoi_state(struct qoi_state **qoi_state) {
     (*qoi_state)->frame_loaded = false;
     (*qoi_state)->frame_saved  = false;
 
-    (*qoi_state)->image_data      = NULL;
-    (*qoi_state)->image_data_size = 0;
-    (*qoi_state)->pixels          = NULL;
+    (*qoi_state)->image_data         = NULL;
+    (*qoi_state)->image_data_size    = 0;
+    (*qoi_state)->image_data_to_free = NULL;
+    (*qoi_state)->pixels             = NULL;
 
     return SAIL_OK;
 }
@@ -80,7 +82,7 @@ static void destroy_qoi_state(struct qoi_state *qoi_state) {
     sail_destroy_load_options(qoi_state->load_options);
     sail_destroy_save_options(qoi_state->save_options);
 
-    sail_free(qoi_state->image_data);
+    sail_free(qoi_state->image_data_to_free);
     sail_free(qoi_state->pixels);
 
     sail_free(qoi_state);
@@ -102,8 +104,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_qoi(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &qoi_state->load_options));
 
-    /* Cache the entire file as the QOI API requires. */
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &qoi_state->image_data, &qoi_state->image_data_size));
+    /* Get the entire file as the QOI API requires. */
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &qoi_state->image_data, &qoi_state->image_data_size, &qoi_state->image_data_to_free));
 
     return SAIL_OK;
 }
@@ -172,6 +174,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_qoi(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_qoi(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_qoi(void **state) {
 
     struct qoi_state *qoi_state = *state;
@@ -226,31 +238,42 @@ SAIL_EXPORT sail_status_t sail_codec_save_seek_next_frame_v8_qoi(void *state, co
         }
     }
 
+    /* Pixels are encoded in sail_codec_save_frame_v8_qoi(). */
+    qoi_state->qoi_desc = (qoi_desc){
+        .width      = image->width,
+        .height     = image->height,
+        .channels   = channels,
+        .colorspace = QOI_SRGB
+    };
+
+    return SAIL_OK;
+}
+
+SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_qoi(void *state, const struct sail_image *image) {
+
+    struct qoi_state *qoi_state = state;
+
     int written;
-    qoi_state->pixels = qoi_encode(image->pixels, &(qoi_desc){
-    	                    .width      = image->width,
-                    	    .height     = image->height,
-                        	.channels   = channels,
-                        	.colorspace = QOI_SRGB
-                        }, &written);
+    qoi_state->pixels = qoi_encode(image->pixels, &qoi_state->qoi_desc, &written);
 
     if (qoi_state->pixels == NULL) {
         SAIL_LOG_ERROR("QOI: Encoding failed without any details");
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    SAIL_TRY(qoi_state->io->strict_write(qoi_state->io->stream, qoi_state->pixels, (size_t)written));
+
     return SAIL_OK;
 }
 
-SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_qoi(void *state, const struct sail_image *image) {
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_qoi(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
 
-    struct qoi_state *qoi_state = state;
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
 
-    const size_t pixels_size = (size_t)image->bytes_per_line * image->height;
-
-    SAIL_TRY(qoi_state->io->strict_write(qoi_state->io->stream, qoi_state->pixels, pixels_size));
-
-    return SAIL_OK;
+    return SAIL_ERROR_NOT_IMPLEMENTED;
 }
 
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_qoi(void **state) {
@@ -95,15 +95,19 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_svg(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &svg_state->load_options));
 
-    /* Read the entire image as the resvg API requires. */
-    void *image_data;
+    /* Get the entire image as the resvg API requires. */
+    const void *image_data;
     size_t image_size;
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &image_data, &image_size));
+    void *image_data_to_free;
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &image_data, &image_size, &image_data_to_free));
 
     svg_state->resvg_options = resvg_options_create();
 
     const int result = resvg_parse_tree_from_data(image_data, image_size, svg_state->resvg_options, &svg_state->resvg_tree);
 
+    /* resvg builds its own tree, so the data is not needed anymore. */
+    sail_free(image_data_to_free);
+
     if (result != RESVG_OK) {
         SAIL_LOG_ERROR("SVG: Failed to load image");
         SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
@@ -131,9 +135,14 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_svg(void *state, st
 
     image_local->source_image->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
     image_local->source_image->compression = SAIL_COMPRESSION_NONE;
+    image_local->source_image->width       = (unsigned)image_size.width;
+    image_local->source_image->height      = (unsigned)image_size.height;
+
+    /* Render at a reduced size when smaller frames are requested. */
+    sail_fit_max_size(image_local->source_image->width, image_local->source_image->height,
+                        svg_state->load_options->max_width, svg_state->load_options->max_height,
+                        &image_local->width, &image_local->height);
 
-    image_local->width          = (unsigned)image_size.width;
-    image_local->height         = (unsigned)image_size.height;
     image_local->pixel_format   = SAIL_PIXEL_FORMAT_BPP32_RGBA;
     image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
 
@@ -148,13 +157,28 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_svg(void *state, struct sail_
 
     memset(image->pixels, 0, (size_t)image->bytes_per_line * image->height);
 
-    const resvg_fit_to resvg_fit_to = { RESVG_FIT_TO_ORIGINAL, 0 };
+    const resvg_size image_size = resvg_get_image_size(svg_state->resvg_tree);
+
+    /* resvg scales the render tree with a transform, so the reduced size costs nothing extra. */
+    const resvg_fit_to resvg_fit_to = (image->width == (unsigned)image_size.width)
+                                        ? (resvg_fit_to){ RESVG_FIT_TO_ORIGINAL, 0 }
+                                        : (resvg_fit_to){ RESVG_FIT_TO_WIDTH, (float)image->width };
 
     resvg_render(svg_state->resvg_tree, resvg_fit_to, image->width, image->height, image->pixels);
 
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_svg(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_svg(void **state) {
 
     struct svg_state *svg_state = *state;
@@ -195,6 +219,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_svg(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_svg(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_svg(void **state) {
 
     (void)state;
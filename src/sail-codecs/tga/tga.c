@@ -40,6 +40,7 @@ static const int          TGA_FOOTER_SIZE = 26;
  */
 struct tga_state {
     struct sail_io *io;
+    struct sail_io_reader *io_reader;
     struct sail_load_options *load_options;
     struct sail_save_options *save_options;
 
@@ -50,6 +51,15 @@ struct tga_state {
     bool tga2;
     bool flipped_h;
     bool flipped_v;
+
+    /* Scan line streaming. */
+    size_t pixels_offset;
+    unsigned next_row;
+
+    /* The RLE packet continued across scan lines. */
+    unsigned rle_count;
+    bool rle_repeat;
+    unsigned char rle_pixel[4];
 };
 
 static sail_status_t alloc_tga_state(struct tga_state **tga_state) {
@@ -59,6 +69,7 @@ static sail_status_t alloc_tga_state(struct tga_state **tga_state) {
     *tga_state = ptr;
 
     (*tga_state)->io           = NULL;
+    (*tga_state)->io_reader    = NULL;
     (*tga_state)->load_options = NULL;
     (*tga_state)->save_options = NULL;
 
@@ -66,6 +77,10 @@ static sail_status_t alloc_tga_state(struct tga_state **tga_state) {
     (*tga_state)->tga2          = false;
     (*tga_state)->flipped_h     = false;
     (*tga_state)->flipped_v     = false;
+    (*tga_state)->pixels_offset = 0;
+    (*tga_state)->next_row      = 0;
+    (*tga_state)->rle_count     = 0;
+    (*tga_state)->rle_repeat    = false;
 
     return SAIL_OK;
 }
@@ -76,12 +91,67 @@ static void destroy_tga_state(struct tga_state *tga_state) {
         return;
     }
 
+    sail_destroy_io_reader(tga_state->io_reader);
+
     sail_destroy_load_options(tga_state->load_options);
     sail_destroy_save_options(tga_state->save_options);
 
     sail_free(tga_state);
 }
 
+/* Decodes the specified number of RLE-compressed pixels. Packets may continue in the next call. */
+static sail_status_t read_rle_pixels(struct tga_state *tga_state, unsigned char *pixels, size_t pixels_num) {
+
+    const unsigned pixel_size = (tga_state->file_header.bpp + 7) / 8;
+
+    while (pixels_num > 0) {
+        if (tga_state->rle_count == 0) {
+            uint8_t marker;
+            SAIL_TRY(sail_io_reader_read_u8(tga_state->io_reader, &marker));
+
+            tga_state->rle_count = (marker & 0x7F) + 1;
+
+            /* 7th bit set = RLE packet. */
+            tga_state->rle_repeat = (marker & 0x80) != 0;
+
+            if (tga_state->rle_repeat) {
+                SAIL_TRY(sail_io_reader_strict_read(tga_state->io_reader, tga_state->rle_pixel, pixel_size));
+            }
+        }
+
+        const unsigned count = (unsigned)((pixels_num < tga_state->rle_count) ? pixels_num : tga_state->rle_count);
+
+        if (tga_state->rle_repeat) {
+            for (unsigned j = 0; j < count; j++) {
+                memcpy(pixels, tga_state->rle_pixel, pixel_size);
+                pixels += pixel_size;
+            }
+        } else {
+            SAIL_TRY(sail_io_reader_strict_read(tga_state->io_reader, pixels, (size_t)count * pixel_size));
+            pixels += (size_t)count * pixel_size;
+        }
+
+        tga_state->rle_count -= count;
+        pixels_num           -= count;
+    }
+
+    return SAIL_OK;
+}
+
+static void mirror_scan_line(unsigned char *scan, unsigned width, unsigned pixel_size) {
+
+    unsigned char *left  = scan;
+    unsigned char *right = scan + (size_t)(width - 1) * pixel_size;
+
+    for (; left < right; left += pixel_size, right -= pixel_size) {
+        for (unsigned i = 0; i < pixel_size; i++) {
+            const unsigned char byte = left[i];
+            left[i]  = right[i];
+            right[i] = byte;
+        }
+    }
+}
+
 /*
  * Decoding functions.
  */
@@ -97,6 +167,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_tga(struct sail_io *io, const
 
     /* Save I/O for further operations. */
     tga_state->io = io;
+    SAIL_TRY(sail_alloc_io_reader(io, &tga_state->io_reader));
 
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &tga_state->load_options));
@@ -190,6 +261,10 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_tga(void *state, st
                             /* cleanup */ sail_destroy_image(image_local));
     }
 
+    /* Remember where scan lines start to stream bottom-up frames. */
+    SAIL_TRY_OR_CLEANUP(tga_state->io->tell(tga_state->io->stream, &tga_state->pixels_offset),
+                        /* cleanup */ sail_destroy_image(image_local));
+
     *image = image_local;
 
     return SAIL_OK;
@@ -209,34 +284,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_tga(void *state, struct sail_
         case TGA_INDEXED_RLE:
         case TGA_TRUE_COLOR_RLE:
         case TGA_GRAY_RLE: {
-            const unsigned pixel_size = (tga_state->file_header.bpp + 7) / 8;
-            const unsigned pixels_num = image->width * image->height;
-
-            unsigned char *pixels = image->pixels;
-
-            for (unsigned i = 0; i < pixels_num;) {
-                unsigned char marker;
-                SAIL_TRY(tga_state->io->strict_read(tga_state->io->stream, &marker, 1));
-
-                unsigned count = (marker & 0x7F) + 1;
-
-                /* 7th bit set = RLE packet. */
-                if (marker & 0x80) {
-                    unsigned char pixel[4];
-
-                    SAIL_TRY(tga_state->io->strict_read(tga_state->io->stream, pixel, pixel_size));
-
-                    for (unsigned j = 0; j < count; j++, i++) {
-                        memcpy(pixels, pixel, pixel_size);
-                        pixels += pixel_size;
-                    }
-                } else {
-                    for (unsigned j = 0; j < count; j++, i++) {
-                        SAIL_TRY(tga_state->io->strict_read(tga_state->io->stream, pixels, pixel_size));
-                        pixels += pixel_size;
-                    }
-                }
-            }
+            SAIL_TRY(read_rle_pixels(tga_state, image->pixels, (size_t)image->width * image->height));
+            SAIL_TRY(sail_io_reader_sync(tga_state->io_reader));
             break;
         }
     }
@@ -252,6 +301,53 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_tga(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_tga(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    struct tga_state *tga_state = state;
+
+    const unsigned pixel_size = (tga_state->file_header.bpp + 7) / 8;
+
+    for (unsigned row = 0; row < rows_count; row++, tga_state->next_row++) {
+        unsigned char *scan = (unsigned char *)rows + (size_t)row * image->bytes_per_line;
+
+        switch (tga_state->file_header.image_type) {
+            case TGA_INDEXED:
+            case TGA_TRUE_COLOR:
+            case TGA_GRAY: {
+                /* Locate bottom-up scan lines. */
+                if (tga_state->flipped_v) {
+                    const size_t offset = tga_state->pixels_offset + (size_t)(image->height - 1 - tga_state->next_row) * image->bytes_per_line;
+                    SAIL_TRY(tga_state->io->seek(tga_state->io->stream, (long)offset, SEEK_SET));
+                }
+
+                SAIL_TRY(tga_state->io->strict_read(tga_state->io->stream, scan, image->bytes_per_line));
+                break;
+            }
+            case TGA_INDEXED_RLE:
+            case TGA_TRUE_COLOR_RLE:
+            case TGA_GRAY_RLE: {
+                /* Bottom-up RLE scan lines cannot be located without decoding the whole frame. */
+                if (tga_state->flipped_v) {
+                    return SAIL_ERROR_NOT_IMPLEMENTED;
+                }
+
+                SAIL_TRY(read_rle_pixels(tga_state, scan, image->width));
+
+                if (tga_state->next_row + 1 == image->height) {
+                    SAIL_TRY(sail_io_reader_sync(tga_state->io_reader));
+                }
+                break;
+            }
+        }
+
+        if (tga_state->flipped_h) {
+            mirror_scan_line(scan, image->width, pixel_size);
+        }
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_tga(void **state) {
 
     struct tga_state *tga_state = *state;
@@ -292,6 +388,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_tga(void *state, const struct
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_tga(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_tga(void **state) {
 
     (void)state;
@@ -47,6 +47,9 @@ struct tiff_state {
     int save_compression;
     TIFFRGBAImage image;
     int line;
+    /* The top left corner of the region of interest. */
+    int roi_x;
+    int roi_y;
 };
 
 static sail_status_t alloc_tiff_state(struct tiff_state **tiff_state) {
@@ -58,6 +61,8 @@ static sail_status_t alloc_tiff_state(struct tiff_state **tiff_state) {
     (*tiff_state)->tiff             = NULL;
     (*tiff_state)->current_frame    = 0;
     (*tiff_state)->libtiff_error    = false;
+    (*tiff_state)->roi_x            = 0;
+    (*tiff_state)->roi_y            = 0;
     (*tiff_state)->load_options     = NULL;
     (*tiff_state)->save_options     = NULL;
     (*tiff_state)->save_compression = COMPRESSION_NONE;
@@ -155,6 +160,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_tiff(void *state, s
     }
 
     tiff_state->image.req_orientation = ORIENTATION_TOPLEFT;
+    tiff_state->line = 0;
 
     /* Fill the image properties. */
     if (!TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGEWIDTH,  &image_local->width) || !TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGELENGTH, &image_local->height)) {
@@ -163,6 +169,29 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_tiff(void *state, s
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    image_local->source_image->width  = image_local->width;
+    image_local->source_image->height = image_local->height;
+
+    /*
+     * Read just the strips or tiles covering the region of interest. Other orientations
+     * are flipped by libtiff against the requested area, so libsail crops them instead.
+     */
+    tiff_state->roi_x = 0;
+    tiff_state->roi_y = 0;
+
+    if (tiff_state->image.orientation == ORIENTATION_TOPLEFT) {
+        unsigned roi_x, roi_y;
+
+        if (sail_clip_roi(tiff_state->load_options, image_local->source_image->width, image_local->source_image->height,
+                            &roi_x, &roi_y, &image_local->width, &image_local->height)) {
+            tiff_state->roi_x = (int)roi_x;
+            tiff_state->roi_y = (int)roi_y;
+        }
+    }
+
+    tiff_state->image.col_offset = tiff_state->roi_x;
+    tiff_state->image.row_offset = tiff_state->roi_y;
+
     /* Fetch meta data. */
     if (tiff_state->load_options->options & SAIL_OPTION_META_DATA) {
         struct sail_meta_data_node **last_meta_data_node = &image_local->meta_data_node;
@@ -217,6 +246,34 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_tiff(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_tiff(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    struct tiff_state *tiff_state = state;
+
+    if (tiff_state->libtiff_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Bands of other orientations are flipped by libtiff against the band, not the frame. */
+    if (tiff_state->image.orientation != ORIENTATION_TOPLEFT) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    tiff_state->image.row_offset = tiff_state->roi_y + tiff_state->line;
+
+    if (!TIFFRGBAImageGet(&tiff_state->image, rows, image->width, rows_count)) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    tiff_state->line += (int)rows_count;
+
+    if ((unsigned)tiff_state->line == image->height) {
+        TIFFRGBAImageEnd(&tiff_state->image);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_tiff(void **state) {
 
     struct tiff_state *tiff_state = *state;
@@ -339,6 +396,30 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_tiff(void *state, const struc
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_tiff(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    struct tiff_state *tiff_state = state;
+
+    if (tiff_state->libtiff_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        if (TIFFWriteScanline(tiff_state->tiff, (unsigned char *)rows + (size_t)row * image->bytes_per_line, tiff_state->line++, 0) < 0) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    /* The last scan line finishes the directory. */
+    if ((unsigned)tiff_state->line == image->height) {
+        if (!TIFFWriteDirectory(tiff_state->tiff)) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_tiff(void **state) {
 
     struct tiff_state *tiff_state = *state;
@@ -25,6 +25,8 @@
 
 #include <string.h>
 
+#include <webp/decode.h>
+
 #include "sail-common.h"
 
 #include "helpers.h"
@@ -50,14 +52,14 @@ sail_status_t webp_private_blend_over(void *dst_raw, unsigned dst_offset, const
         const uint8_t *src = src_raw;
         uint8_t *dst = (uint8_t *)dst_raw + dst_offset * bytes_per_pixel;
 
-        while (width--) {
-            const double src_a = *(src+3) / 255.0;
-            const double dst_a = *(dst+3) / 255.0;
+        for (; width > 0; width--, src += 4, dst += 4) {
+            const uint32_t src_a = *(src+3);
+            const uint32_t dst_a = (255 - src_a) * *(dst+3);
 
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)((src_a + (1-src_a) * dst_a) * 255);           src++; dst++;
+            *(dst+0) = (uint8_t)((src_a * 255 * *(src+0) + dst_a * *(dst+0)) / (255 * 255));
+            *(dst+1) = (uint8_t)((src_a * 255 * *(src+1) + dst_a * *(dst+1)) / (255 * 255));
+            *(dst+2) = (uint8_t)((src_a * 255 * *(src+2) + dst_a * *(dst+2)) / (255 * 255));
+            *(dst+3) = (uint8_t)(src_a + dst_a / 255);
         }
     } else {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_BIT_DEPTH);
@@ -66,6 +68,59 @@ sail_status_t webp_private_blend_over(void *dst_raw, unsigned dst_offset, const
     return SAIL_OK;
 }
 
+WEBP_CSP_MODE webp_private_output_colorspace(enum SailPixelFormat output_pixel_format) {
+
+    return (output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) ? MODE_BGRA : MODE_RGBA;
+}
+
+sail_status_t webp_private_decode_into(const uint8_t *data, size_t data_size, WEBP_CSP_MODE colorspace,
+                                        void *pixels, size_t pixels_size, unsigned bytes_per_line) {
+
+    const uint8_t *result = (colorspace == MODE_BGRA)
+                                ? WebPDecodeBGRAInto(data, data_size, pixels, pixels_size, (int)bytes_per_line)
+                                : WebPDecodeRGBAInto(data, data_size, pixels, pixels_size, (int)bytes_per_line);
+
+    if (result == NULL) {
+        SAIL_LOG_ERROR("WEBP: Failed to decode image");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t webp_private_decode_scaled(const uint8_t *data, size_t data_size, WEBP_CSP_MODE colorspace, void *pixels,
+                                            unsigned width, unsigned height, unsigned bytes_per_line) {
+
+    WebPDecoderConfig config;
+
+    if (!WebPInitDecoderConfig(&config)) {
+        SAIL_LOG_ERROR("WEBP: Failed to initialize decoder configuration");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* libwebp scales while decoding, so the full-size frame is never allocated. */
+    config.options.use_scaling   = 1;
+    config.options.scaled_width  = (int)width;
+    config.options.scaled_height = (int)height;
+
+    config.output.colorspace         = colorspace;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba        = pixels;
+    config.output.u.RGBA.stride      = (int)bytes_per_line;
+    config.output.u.RGBA.size        = (size_t)bytes_per_line * height;
+
+    const VP8StatusCode status = WebPDecode(data, data_size, &config);
+
+    WebPFreeDecBuffer(&config.output);
+
+    if (status != VP8_STATUS_OK) {
+        SAIL_LOG_ERROR("WEBP: Failed to decode image, error code: %d", status);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t webp_private_fetch_iccp(WebPDemuxer *webp_demux, struct sail_iccp **iccp) {
 
     SAIL_CHECK_PTR(webp_demux);
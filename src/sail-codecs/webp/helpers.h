@@ -40,6 +40,24 @@ SAIL_HIDDEN void webp_private_fill_color(uint8_t *pixels, unsigned bytes_per_lin
 SAIL_HIDDEN sail_status_t webp_private_blend_over(void *dst_raw, unsigned dst_offset, const void *src_raw,
                                                     unsigned width, unsigned bytes_per_pixel);
 
+/*
+ * Returns the libwebp colorspace to decode frames in the requested output pixel format into.
+ * Only RGBA and BGRA are supported as blending and disposal work on 32-bit pixels with trailing alpha.
+ */
+SAIL_HIDDEN WEBP_CSP_MODE webp_private_output_colorspace(enum SailPixelFormat output_pixel_format);
+
+/*
+ * Decodes the specified image into the pixels in the specified colorspace.
+ */
+SAIL_HIDDEN sail_status_t webp_private_decode_into(const uint8_t *data, size_t data_size, WEBP_CSP_MODE colorspace,
+                                                    void *pixels, size_t pixels_size, unsigned bytes_per_line);
+
+/*
+ * Decodes the specified still image into the pixels in the specified colorspace scaled to the specified dimensions.
+ */
+SAIL_HIDDEN sail_status_t webp_private_decode_scaled(const uint8_t *data, size_t data_size, WEBP_CSP_MODE colorspace, void *pixels,
+                                                        unsigned width, unsigned height, unsigned bytes_per_line);
+
 SAIL_HIDDEN sail_status_t webp_private_fetch_iccp(WebPDemuxer *webp_demux, struct sail_iccp **iccp);
 
 SAIL_HIDDEN sail_status_t webp_private_fetch_meta_data(WebPDemuxer *webp_demux, struct sail_meta_data_node **last_meta_data_node);
@@ -47,6 +47,7 @@ struct webp_state {
     WebPDemuxer *webp_demux;
     WebPIterator *webp_iterator;
     unsigned frame_number;
+    WEBP_CSP_MODE colorspace;
     uint32_t background_color;
     uint32_t frame_count;
     unsigned bytes_per_pixel;
@@ -54,11 +55,13 @@ struct webp_state {
     unsigned frame_y;
     unsigned frame_width;
     unsigned frame_height;
+    bool scaled;
     WebPMuxAnimDispose frame_dispose_method;
     WebPMuxAnimBlend frame_blend_method;
 
-    void *image_data;
+    const void *image_data;
     size_t image_data_size;
+    void *image_data_to_free;
 };
 
 static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
@@ -74,6 +77,7 @@ static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
     (*webp_state)->webp_demux            = NULL;
     (*webp_state)->webp_iterator         = NULL;
     (*webp_state)->frame_number          = 0;
+    (*webp_state)->colorspace            = MODE_RGBA;
     (*webp_state)->background_color      = 0;
     (*webp_state)->frame_count           = 0;
     (*webp_state)->bytes_per_pixel       = 0;
@@ -81,11 +85,13 @@ static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
     (*webp_state)->frame_y               = 0;
     (*webp_state)->frame_width           = 0;
     (*webp_state)->frame_height          = 0;
+    (*webp_state)->scaled                = false;
     (*webp_state)->frame_dispose_method  = WEBP_MUX_DISPOSE_NONE;
     (*webp_state)->frame_blend_method    = WEBP_MUX_NO_BLEND;
 
-    (*webp_state)->image_data      = NULL;
-    (*webp_state)->image_data_size = 0;
+    (*webp_state)->image_data         = NULL;
+    (*webp_state)->image_data_size    = 0;
+    (*webp_state)->image_data_to_free = NULL;
 
     return SAIL_OK;
 }
@@ -101,7 +107,7 @@ static void destroy_webp_state(struct webp_state *webp_state) {
         sail_free(webp_state->webp_iterator);
     }
 
-    sail_free(webp_state->image_data);
+    sail_free(webp_state->image_data_to_free);
 
     WebPDemuxDelete(webp_state->webp_demux);
 
@@ -135,17 +141,28 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_webp(struct sail_io *io, const
 
     SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
 
-    void *ptr;
-    SAIL_TRY(sail_malloc(webp_state->image_data_size, &ptr));
-    webp_state->image_data = ptr;
+    if (io->features & SAIL_IO_FEATURE_CONTIGUOUS) {
+        /* Use the I/O buffer directly. */
+        size_t available_size;
+        SAIL_TRY(sail_borrow_data_from_io_contents(io, &webp_state->image_data, &available_size, &webp_state->image_data_to_free));
 
-    SAIL_TRY(io->strict_read(io->stream, webp_state->image_data, webp_state->image_data_size));
+        if (available_size < webp_state->image_data_size) {
+            SAIL_LOG_ERROR("WEBP: Image is truncated");
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+        }
+    } else {
+        SAIL_TRY(sail_malloc(webp_state->image_data_size, &webp_state->image_data_to_free));
+        webp_state->image_data = webp_state->image_data_to_free;
+
+        SAIL_TRY(io->strict_read(io->stream, webp_state->image_data_to_free, webp_state->image_data_size));
+    }
 
     /* Construct a WebP demuxer. */
     const WebPData data = { webp_state->image_data, webp_state->image_data_size };
 
     webp_state->webp_demux = WebPDemux(&data);
 
+    void *ptr;
     SAIL_TRY(sail_malloc(sizeof(WebPIterator), &ptr));
     webp_state->webp_iterator = ptr;
 
@@ -164,11 +181,44 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v8_webp(struct sail_io *io, const
 
     image_local->width          = WebPDemuxGetI(webp_state->webp_demux, WEBP_FF_CANVAS_WIDTH);
     image_local->height         = WebPDemuxGetI(webp_state->webp_demux, WEBP_FF_CANVAS_HEIGHT);
-    image_local->pixel_format   = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+
+    /* libwebp decodes into BGRA natively. */
+    webp_state->colorspace = webp_private_output_colorspace(webp_state->load_options->output_pixel_format);
+
+    if (webp_state->colorspace == MODE_BGRA) {
+        image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_BGRA;
+
+        /* The background color is filled as is, keep its bytes in the same places as in RGBA frames. */
+        webp_state->background_color = (webp_state->background_color & 0xFF00FF00) |
+                                        ((webp_state->background_color & 0xFF) << 16) |
+                                        ((webp_state->background_color >> 16) & 0xFF);
+    } else {
+        image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+    }
+
     image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
 
+    image_local->source_image->width  = image_local->width;
+    image_local->source_image->height = image_local->height;
+
     webp_state->bytes_per_pixel = image_local->bytes_per_line / image_local->width;
 
+    /* Still images are scaled down while decoding when smaller frames are requested. */
+    if (webp_state->frame_count == 1) {
+        unsigned scaled_width, scaled_height;
+        sail_fit_max_size(image_local->width, image_local->height,
+                            webp_state->load_options->max_width, webp_state->load_options->max_height,
+                            &scaled_width, &scaled_height);
+
+        if (scaled_width != image_local->width || scaled_height != image_local->height) {
+            image_local->width          = scaled_width;
+            image_local->height         = scaled_height;
+            image_local->bytes_per_line = sail_bytes_per_line(image_local->width, image_local->pixel_format);
+
+            webp_state->scaled = true;
+        }
+    }
+
     /* Fetch ICCP. */
     if (webp_state->load_options->options & SAIL_OPTION_ICCP) {
         SAIL_TRY_OR_CLEANUP(webp_private_fetch_iccp(webp_state->webp_demux, &image_local->iccp),
@@ -237,6 +287,13 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v8_webp(void *state, s
     webp_state->frame_dispose_method = webp_state->webp_iterator->dispose_method;
     webp_state->frame_blend_method   = webp_state->webp_iterator->blend_method;
 
+    if (webp_state->scaled) {
+        webp_state->frame_x      = 0;
+        webp_state->frame_y      = 0;
+        webp_state->frame_width  = webp_state->canvas_image->width;
+        webp_state->frame_height = webp_state->canvas_image->height;
+    }
+
     /* Construct image. */
     struct sail_image *image_local;
     SAIL_TRY(sail_copy_image_skeleton(webp_state->canvas_image, &image_local));
@@ -257,28 +314,35 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_webp(void *state, struct sail
 
     struct webp_state *webp_state = state;
 
+    if (webp_state->scaled) {
+        SAIL_TRY(webp_private_decode_scaled(webp_state->webp_iterator->fragment.bytes,
+                                            webp_state->webp_iterator->fragment.size,
+                                            webp_state->colorspace,
+                                            image->pixels,
+                                            image->width,
+                                            image->height,
+                                            image->bytes_per_line));
+        return SAIL_OK;
+    }
+
     switch (webp_state->frame_blend_method) {
         case WEBP_MUX_NO_BLEND: {
-            if (WebPDecodeRGBAInto(webp_state->webp_iterator->fragment.bytes,
-                                    webp_state->webp_iterator->fragment.size,
-                                    (uint8_t *)webp_state->canvas_image->pixels + webp_state->canvas_image->bytes_per_line * webp_state->frame_y +
-                                        webp_state->frame_x * webp_state->bytes_per_pixel,
-                                    (size_t)webp_state->canvas_image->bytes_per_line * webp_state->canvas_image->height,
-                                    webp_state->canvas_image->bytes_per_line) == NULL) {
-                SAIL_LOG_ERROR("WEBP: Failed to decode image");
-                SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
-            }
+            SAIL_TRY(webp_private_decode_into(webp_state->webp_iterator->fragment.bytes,
+                                                webp_state->webp_iterator->fragment.size,
+                                                webp_state->colorspace,
+                                                (uint8_t *)webp_state->canvas_image->pixels + webp_state->canvas_image->bytes_per_line * webp_state->frame_y +
+                                                    webp_state->frame_x * webp_state->bytes_per_pixel,
+                                                (size_t)webp_state->canvas_image->bytes_per_line * webp_state->canvas_image->height,
+                                                webp_state->canvas_image->bytes_per_line));
             break;
         }
         case WEBP_MUX_BLEND: {
-            if (WebPDecodeRGBAInto(webp_state->webp_iterator->fragment.bytes,
-                                    webp_state->webp_iterator->fragment.size,
-                                    image->pixels,
-                                    (size_t)image->bytes_per_line * image->height,
-                                    webp_state->frame_width * webp_state->bytes_per_pixel) == NULL) {
-                SAIL_LOG_ERROR("WEBP: Failed to decode image");
-                SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
-            }
+            SAIL_TRY(webp_private_decode_into(webp_state->webp_iterator->fragment.bytes,
+                                                webp_state->webp_iterator->fragment.size,
+                                                webp_state->colorspace,
+                                                image->pixels,
+                                                (size_t)image->bytes_per_line * image->height,
+                                                webp_state->frame_width * webp_state->bytes_per_pixel));
 
             uint8_t *dst_scanline = (uint8_t *)webp_state->canvas_image->pixels + webp_state->frame_y * image->bytes_per_line + webp_state->frame_x * webp_state->bytes_per_pixel;
             uint8_t *src_scanline = image->pixels;
@@ -300,6 +364,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v8_webp(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_rows_v8_webp(void *state, const struct sail_image *image, void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v8_webp(void **state) {
 
     struct webp_state *webp_state = *state;
@@ -340,6 +414,16 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v8_webp(void *state, const struc
     SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_rows_v8_webp(void *state, const struct sail_image *image, const void *rows, unsigned rows_count) {
+
+    (void)state;
+    (void)image;
+    (void)rows;
+    (void)rows_count;
+
+    return SAIL_ERROR_NOT_IMPLEMENTED;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v8_webp(void **state) {
 
     (void)state;
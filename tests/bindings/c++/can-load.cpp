@@ -23,6 +23,9 @@
     SOFTWARE.
 */
 
+#include <cstdint>
+#include <vector>
+
 #include "sail-c++.h"
 
 #include "munit.h"
@@ -200,6 +203,34 @@ static MunitResult test_can_load_abstract_io_memory4(const MunitParameter params
     return MUNIT_OK;
 }
 
+static MunitResult test_can_load_into_buffer(const MunitParameter params[], void *user_data) {
+
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const sail::image reference_image(path);
+    munit_assert(reference_image.is_valid());
+
+    /* Pad scan lines. */
+    const unsigned bytes_per_line = reference_image.bytes_per_line() + 5;
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(bytes_per_line) * reference_image.height());
+
+    sail::image_input input(path);
+    sail::image image;
+
+    munit_assert(input.next_frame(pixels.data(), pixels.size(), bytes_per_line, &image) == SAIL_OK);
+    munit_assert(image.is_valid());
+    munit_assert(image.pixels() == pixels.data());
+    munit_assert(image.bytes_per_line() == bytes_per_line);
+
+    for (unsigned row = 0; row < image.height(); row++) {
+        munit_assert_memory_equal(reference_image.bytes_per_line(), image.scan_line(row), reference_image.scan_line(row));
+    }
+
+    return MUNIT_OK;
+}
+
 static MunitParameterEnum test_params[] = {
     { (char *)"path", (char **)SAIL_TEST_IMAGES },
     { NULL, NULL },
@@ -214,6 +245,7 @@ static MunitTest test_suite_tests[] = {
     { (char *)"/can-load-abstract-io-memory2", test_can_load_abstract_io_memory2, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
     { (char *)"/can-load-abstract-io-memory3", test_can_load_abstract_io_memory3, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
     { (char *)"/can-load-abstract-io-memory4", test_can_load_abstract_io_memory4, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/can-load-into-buffer",         test_can_load_into_buffer,         NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
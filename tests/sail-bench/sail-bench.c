@@ -0,0 +1,1072 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h> /* atoi, qsort */
+#include <string.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+/*
+ * Benchmark suite. Generates deterministic synthetic images, runs them through the public API,
+ * and reports throughput and latency percentiles in JSON. Use it to get a reproducible baseline
+ * before and after performance changes. Run it on an idle machine with a fixed CPU frequency.
+ */
+
+/* Maximum number of -s options. */
+#define MAX_SIZES 16
+
+/* Upper limit of measured iterations per operation regardless of the minimum time. */
+#define MAX_ITERATIONS 10000
+
+/* Image sizes used when no -s options are specified. */
+static const unsigned DEFAULT_SIZES[][2] = {
+    {  256,  256 },
+    { 1024,  768 },
+    { 3000, 2000 },
+};
+
+/* Number of detections measured as a single sample. A single detection is too fast for the clock. */
+#define DETECTIONS_PER_SAMPLE 10000
+
+/* Columns to sort the conversion table by. */
+enum SortKey {
+    SORT_KEY_INPUT,
+    SORT_KEY_OUTPUT,
+    SORT_KEY_MPIX,
+    SORT_KEY_P50,
+    SORT_KEY_P99,
+};
+
+enum BenchCommand {
+    BENCH_COMMAND_CODECS,
+    BENCH_COMMAND_CONVERSIONS,
+    BENCH_COMMAND_DETECT,
+};
+
+struct bench_settings {
+
+    /* Codec name to benchmark or NULL to benchmark every codec. */
+    const char *codec;
+
+    /* Pixel format to benchmark or SAIL_PIXEL_FORMAT_UNKNOWN to benchmark every supported pixel format. */
+    enum SailPixelFormat pixel_format;
+
+    /* Pixel format to convert to or SAIL_PIXEL_FORMAT_UNKNOWN to convert to every possible pixel format. */
+    enum SailPixelFormat output_pixel_format;
+
+    unsigned sizes[MAX_SIZES][2];
+    unsigned sizes_count;
+
+    /* Every operation runs at least min_iterations times and at least min_time_ms milliseconds. */
+    unsigned min_iterations;
+    unsigned min_time_ms;
+
+    /* Conversion threads. See sail_conversion_options.threads. */
+    unsigned threads;
+
+    enum SortKey sort_key;
+
+    FILE *output;
+};
+
+/* Input data shared by all the operations of a single benchmark case. */
+struct bench_context {
+
+    const struct sail_codec_info *codec_info;
+
+    /* Synthetic image to save. */
+    const struct sail_image *image;
+
+    /* The synthetic image saved with the codec, or a file header to detect the codec from. */
+    const void *encoded;
+    size_t encoded_length;
+
+    /* The encoded image loaded back with default options. */
+    const struct sail_image *loaded;
+
+    /* Conversion matrix parameters. */
+    enum SailPixelFormat output_pixel_format;
+    const struct sail_conversion_options *conversion_options;
+};
+
+typedef sail_status_t (*bench_func_t)(const struct bench_context *context);
+
+struct bench_operation {
+    const char *api;
+    const char *operation;
+    bench_func_t func;
+};
+
+struct bench_result {
+    unsigned iterations;
+    double mpix_per_s;
+    double mean_us;
+    uint64_t min_us;
+    uint64_t p50_us;
+    uint64_t p99_us;
+};
+
+static void print_invalid_argument(void) {
+    fprintf(stderr, "Error: Invalid arguments. Run with -h to see command arguments.\n");
+}
+
+static bool codec_name_equals(const char *name1, const char *name2) {
+
+    for (; *name1 != '\0' && *name2 != '\0'; name1++, name2++) {
+        if (toupper((unsigned char)*name1) != toupper((unsigned char)*name2)) {
+            return false;
+        }
+    }
+
+    return *name1 == *name2;
+}
+
+/*
+ * Synthetic images.
+ */
+
+/* Numerical Recipes LCG. The fixed seed makes every run produce the same pixels. */
+static uint32_t next_random(uint32_t *seed) {
+
+    *seed = *seed * 1664525u + 1013904223u;
+
+    return *seed;
+}
+
+/*
+ * Fills the pixels with a diagonal gradient plus a small amount of noise. The result is neither
+ * trivially compressible nor pure noise, which keeps encoders on their typical code paths.
+ */
+static sail_status_t generate_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height, struct sail_image **image) {
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_alloc_image(&image_local));
+
+    image_local->width          = width;
+    image_local->height         = height;
+    image_local->pixel_format   = pixel_format;
+    image_local->bytes_per_line = sail_bytes_per_line(width, pixel_format);
+
+    const size_t pixels_size = (size_t)image_local->bytes_per_line * height;
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    uint32_t seed = 0x5A11;
+
+    for (unsigned row = 0; row < height; row++) {
+        unsigned char *scan = (unsigned char *)image_local->pixels + (size_t)image_local->bytes_per_line * row;
+
+        for (unsigned i = 0; i < image_local->bytes_per_line; i++) {
+            scan[i] = (unsigned char)((i + row) / 4 + (next_random(&seed) >> 29));
+        }
+    }
+
+    if (sail_is_indexed(pixel_format)) {
+        const unsigned bits_per_pixel = sail_bits_per_pixel(pixel_format);
+        const unsigned color_count = bits_per_pixel >= 8 ? 256 : 1u << bits_per_pixel;
+
+        SAIL_TRY_OR_CLEANUP(sail_alloc_palette_for_data(SAIL_PIXEL_FORMAT_BPP24_RGB, color_count, &image_local->palette),
+                            /* cleanup */ sail_destroy_image(image_local));
+
+        unsigned char *palette_data = image_local->palette->data;
+
+        for (unsigned i = 0; i < color_count; i++) {
+            const unsigned char value = (unsigned char)(i * 255 / (color_count - 1));
+
+            *palette_data++ = value;
+            *palette_data++ = (unsigned char)(255 - value);
+            *palette_data++ = (unsigned char)(value / 2);
+        }
+    }
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+/*
+ * Operations.
+ */
+
+static sail_status_t save_junior(const struct bench_context *context) {
+
+    void *buffer;
+    size_t buffer_length;
+
+    SAIL_TRY(sail_save_into_dynamic_memory(context->image, context->codec_info, &buffer, &buffer_length));
+
+    sail_free(buffer);
+
+    return SAIL_OK;
+}
+
+static sail_status_t save_advanced(const struct bench_context *context) {
+
+    void *state;
+    SAIL_TRY(sail_start_saving_into_dynamic_memory(context->codec_info, &state));
+
+    void *buffer;
+    size_t buffer_length;
+
+    SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, context->image),
+                        /* cleanup */ sail_stop_saving_into_dynamic_memory(state, &buffer, &buffer_length),
+                                      sail_free(buffer));
+
+    SAIL_TRY(sail_stop_saving_into_dynamic_memory(state, &buffer, &buffer_length));
+
+    sail_free(buffer);
+
+    return SAIL_OK;
+}
+
+static sail_status_t save_technical_diver(const struct bench_context *context) {
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_write_dynamic_memory(&io));
+
+    struct sail_save_options *save_options;
+    SAIL_TRY_OR_CLEANUP(sail_alloc_save_options_from_features(context->codec_info->save_features, &save_options),
+                        /* cleanup */ sail_destroy_io(io));
+
+    void *state;
+    SAIL_TRY_OR_CLEANUP(sail_start_saving_into_io_with_options(io, context->codec_info, save_options, &state),
+                        /* cleanup */ sail_destroy_save_options(save_options),
+                                      sail_destroy_io(io));
+
+    sail_destroy_save_options(save_options);
+
+    SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, context->image),
+                        /* cleanup */ sail_stop_saving(state),
+                                      sail_destroy_io(io));
+    SAIL_TRY_OR_CLEANUP(sail_stop_saving(state),
+                        /* cleanup */ sail_destroy_io(io));
+
+    sail_destroy_io(io);
+
+    return SAIL_OK;
+}
+
+static sail_status_t probe_advanced(const struct bench_context *context) {
+
+    struct sail_image *image;
+    SAIL_TRY(sail_probe_memory(context->encoded, context->encoded_length, &image, NULL));
+
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+static sail_status_t probe_technical_diver(const struct bench_context *context) {
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_memory(context->encoded, context->encoded_length, &io));
+
+    struct sail_image *image;
+    SAIL_TRY_OR_CLEANUP(sail_probe_io(io, &image, NULL),
+                        /* cleanup */ sail_destroy_io(io));
+
+    sail_destroy_image(image);
+    sail_destroy_io(io);
+
+    return SAIL_OK;
+}
+
+static sail_status_t load_junior(const struct bench_context *context) {
+
+    struct sail_image *image;
+    SAIL_TRY(sail_load_from_memory(context->encoded, context->encoded_length, &image));
+
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+static sail_status_t load_advanced(const struct bench_context *context) {
+
+    void *state;
+    SAIL_TRY(sail_start_loading_from_memory(context->encoded, context->encoded_length, context->codec_info, &state));
+
+    struct sail_image *image;
+    SAIL_TRY_OR_CLEANUP(sail_load_next_frame(state, &image),
+                        /* cleanup */ sail_stop_loading(state));
+
+    sail_destroy_image(image);
+
+    SAIL_TRY(sail_stop_loading(state));
+
+    return SAIL_OK;
+}
+
+static sail_status_t load_technical_diver(const struct bench_context *context) {
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_memory(context->encoded, context->encoded_length, &io));
+
+    struct sail_load_options *load_options;
+    SAIL_TRY_OR_CLEANUP(sail_alloc_load_options_from_features(context->codec_info->load_features, &load_options),
+                        /* cleanup */ sail_destroy_io(io));
+
+    void *state;
+    SAIL_TRY_OR_CLEANUP(sail_start_loading_from_io_with_options(io, context->codec_info, load_options, &state),
+                        /* cleanup */ sail_destroy_load_options(load_options),
+                                      sail_destroy_io(io));
+
+    sail_destroy_load_options(load_options);
+
+    struct sail_image *image;
+    SAIL_TRY_OR_CLEANUP(sail_load_next_frame(state, &image),
+                        /* cleanup */ sail_stop_loading(state),
+                                      sail_destroy_io(io));
+
+    sail_destroy_image(image);
+
+    SAIL_TRY_OR_CLEANUP(sail_stop_loading(state),
+                        /* cleanup */ sail_destroy_io(io));
+
+    sail_destroy_io(io);
+
+    return SAIL_OK;
+}
+
+static sail_status_t convert_manip(const struct bench_context *context) {
+
+    struct sail_image *image;
+    SAIL_TRY(sail_convert_image(context->loaded, SAIL_PIXEL_FORMAT_BPP32_RGBA, &image));
+
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+static sail_status_t convert_with_options(const struct bench_context *context) {
+
+    struct sail_image *image;
+    SAIL_TRY(sail_convert_image_with_options(context->image, context->output_pixel_format, context->conversion_options, &image));
+
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+/* The order matters: probe and load operations need the encoded image, convert needs the loaded one. */
+static const struct bench_operation OPERATIONS[] = {
+    { "junior",          "save",    save_junior           },
+    { "advanced",        "save",    save_advanced         },
+    { "technical-diver", "save",    save_technical_diver  },
+    { "advanced",        "probe",   probe_advanced        },
+    { "technical-diver", "probe",   probe_technical_diver },
+    { "junior",          "load",    load_junior           },
+    { "advanced",        "load",    load_advanced         },
+    { "technical-diver", "load",    load_technical_diver  },
+    { "manip",           "convert", convert_manip         },
+};
+
+/*
+ * Measurements.
+ */
+
+static int compare_samples(const void *a, const void *b) {
+
+    const uint64_t sample1 = *(const uint64_t *)a;
+    const uint64_t sample2 = *(const uint64_t *)b;
+
+    return (sample1 > sample2) - (sample1 < sample2);
+}
+
+/* Nearest-rank percentile of sorted samples. */
+static uint64_t percentile(const uint64_t *samples, unsigned count, unsigned percent) {
+
+    unsigned rank = (count * percent + 99) / 100;
+
+    return samples[rank == 0 ? 0 : rank - 1];
+}
+
+static sail_status_t measure(const struct bench_settings *settings, bench_func_t func,
+                                const struct bench_context *context, struct bench_result *result) {
+
+    /* Warm up caches and the codec, and make sure the operation works at all. */
+    SAIL_TRY(func(context));
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(uint64_t) * MAX_ITERATIONS, &ptr));
+    uint64_t *samples = ptr;
+
+    const uint64_t min_time_us = (uint64_t)settings->min_time_ms * 1000;
+    uint64_t total_us = 0;
+    unsigned count = 0;
+
+    while (count < settings->min_iterations || (total_us < min_time_us && count < MAX_ITERATIONS)) {
+        const uint64_t start_time = sail_now_microseconds();
+
+        SAIL_TRY_OR_CLEANUP(func(context),
+                            /* cleanup */ sail_free(samples));
+
+        samples[count] = sail_now_microseconds() - start_time;
+        total_us += samples[count];
+        count++;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), compare_samples);
+
+    result->iterations = count;
+    result->mean_us    = (double)total_us / count;
+    result->mpix_per_s = (total_us == 0 || context->image == NULL)
+                            ? 0
+                            : (double)context->image->width * context->image->height / result->mean_us;
+    result->min_us     = samples[0];
+    result->p50_us     = percentile(samples, count, 50);
+    result->p99_us     = percentile(samples, count, 99);
+
+    sail_free(samples);
+
+    return SAIL_OK;
+}
+
+static void print_result(const struct bench_settings *settings, const struct bench_context *context,
+                            const struct bench_operation *operation, const struct bench_result *result, bool *first) {
+
+    fprintf(settings->output, "%s\n    { \"codec\": \"%s\", \"pixel_format\": \"%s\", \"width\": %u, \"height\": %u, "
+                                "\"api\": \"%s\", \"operation\": \"%s\", \"encoded_bytes\": %lu, \"iterations\": %u, "
+                                "\"mpix_per_s\": %.3f, \"mean_us\": %.1f, \"min_us\": %lu, \"p50_us\": %lu, \"p99_us\": %lu }",
+            *first ? "" : ",",
+            context->codec_info->name, sail_pixel_format_to_string(context->image->pixel_format),
+            context->image->width, context->image->height,
+            operation->api, operation->operation, (unsigned long)context->encoded_length, result->iterations,
+            result->mpix_per_s, result->mean_us,
+            (unsigned long)result->min_us, (unsigned long)result->p50_us, (unsigned long)result->p99_us);
+
+    *first = false;
+}
+
+static void print_skipped(const struct bench_context *context, const char *api, const char *operation, sail_status_t status) {
+
+    fprintf(stderr, "Skipping %s %s %ux%u %s %s: error %d\n",
+            context->codec_info->name, sail_pixel_format_to_string(context->image->pixel_format),
+            context->image->width, context->image->height, api, operation, status);
+}
+
+/* Runs every operation on a single codec, pixel format, and size. */
+static sail_status_t bench_case(const struct bench_settings *settings, const struct sail_codec_info *codec_info,
+                                enum SailPixelFormat pixel_format, unsigned width, unsigned height, bool *first) {
+
+    struct sail_image *image;
+    SAIL_TRY(generate_image(pixel_format, width, height, &image));
+
+    struct bench_context context = {
+        .codec_info     = codec_info,
+        .image          = image,
+        .encoded        = NULL,
+        .encoded_length = 0,
+        .loaded         = NULL,
+    };
+
+    void *encoded;
+    sail_status_t status = sail_save_into_dynamic_memory(image, codec_info, &encoded, &context.encoded_length);
+
+    if (status != SAIL_OK) {
+        print_skipped(&context, "junior", "save", status);
+        sail_destroy_image(image);
+        return SAIL_OK;
+    }
+
+    context.encoded = encoded;
+
+    struct sail_image *loaded;
+    status = sail_load_from_memory(encoded, context.encoded_length, &loaded);
+
+    if (status == SAIL_OK) {
+        context.loaded = loaded;
+    } else {
+        loaded = NULL;
+    }
+
+    for (size_t i = 0; i < sizeof(OPERATIONS) / sizeof(OPERATIONS[0]); i++) {
+        const struct bench_operation *operation = &OPERATIONS[i];
+
+        if (operation->func == convert_manip && (loaded == NULL || !sail_can_convert(loaded->pixel_format, SAIL_PIXEL_FORMAT_BPP32_RGBA))) {
+            continue;
+        }
+
+        struct bench_result result;
+        status = measure(settings, operation->func, &context, &result);
+
+        if (status == SAIL_OK) {
+            print_result(settings, &context, operation, &result, first);
+        } else {
+            print_skipped(&context, operation->api, operation->operation, status);
+        }
+    }
+
+    sail_destroy_image(loaded);
+    sail_free(encoded);
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+static sail_status_t codecs_impl(const struct bench_settings *settings) {
+
+    fprintf(settings->output, "{\n  \"sail_version\": \"%s\",\n  \"min_iterations\": %u,\n  \"min_time_ms\": %u,\n  \"results\": [",
+            SAIL_VERSION_STRING, settings->min_iterations, settings->min_time_ms);
+
+    bool first = true;
+
+    for (const struct sail_codec_bundle_node *codec_bundle_node = sail_codec_bundle_list();
+            codec_bundle_node != NULL;
+            codec_bundle_node = codec_bundle_node->next) {
+        const struct sail_codec_info *codec_info = codec_bundle_node->codec_bundle->codec_info;
+
+        if (settings->codec != NULL && !codec_name_equals(settings->codec, codec_info->name)) {
+            continue;
+        }
+
+        const struct sail_save_features *save_features = codec_info->save_features;
+
+        for (unsigned i = 0; i < save_features->pixel_formats_length; i++) {
+            const enum SailPixelFormat pixel_format = save_features->pixel_formats[i];
+
+            if (settings->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN && settings->pixel_format != pixel_format) {
+                continue;
+            }
+
+            for (unsigned s = 0; s < settings->sizes_count; s++) {
+                SAIL_TRY(bench_case(settings, codec_info, pixel_format, settings->sizes[s][0], settings->sizes[s][1], &first));
+            }
+        }
+    }
+
+    fprintf(settings->output, "\n  ]\n}\n");
+
+    return SAIL_OK;
+}
+
+/*
+ * Conversion matrix.
+ */
+
+struct conversion_result {
+    enum SailPixelFormat input_pixel_format;
+    enum SailPixelFormat output_pixel_format;
+    bool blend_alpha;
+    unsigned width;
+    unsigned height;
+    struct bench_result result;
+};
+
+static enum SortKey conversion_sort_key;
+
+static int compare_conversion_results(const void *a, const void *b) {
+
+    const struct conversion_result *result1 = a;
+    const struct conversion_result *result2 = b;
+
+    switch (conversion_sort_key) {
+        case SORT_KEY_INPUT: {
+            if (result1->input_pixel_format != result2->input_pixel_format) {
+                return result1->input_pixel_format < result2->input_pixel_format ? -1 : 1;
+            }
+            break;
+        }
+        case SORT_KEY_OUTPUT: {
+            if (result1->output_pixel_format != result2->output_pixel_format) {
+                return result1->output_pixel_format < result2->output_pixel_format ? -1 : 1;
+            }
+            break;
+        }
+        /* The fastest first. */
+        case SORT_KEY_MPIX: {
+            if (result1->result.mpix_per_s != result2->result.mpix_per_s) {
+                return result1->result.mpix_per_s > result2->result.mpix_per_s ? -1 : 1;
+            }
+            break;
+        }
+        /* The slowest first. */
+        case SORT_KEY_P50: {
+            if (result1->result.p50_us != result2->result.p50_us) {
+                return result1->result.p50_us > result2->result.p50_us ? -1 : 1;
+            }
+            break;
+        }
+        case SORT_KEY_P99: {
+            if (result1->result.p99_us != result2->result.p99_us) {
+                return result1->result.p99_us > result2->result.p99_us ? -1 : 1;
+            }
+            break;
+        }
+    }
+
+    /* Keep the measurement order for equal keys, qsort() is not stable. */
+    return (result1 > result2) - (result1 < result2);
+}
+
+static void print_conversion_table(FILE *output, const struct conversion_result *results, size_t results_count) {
+
+    fprintf(output, "%-24s %-24s %-11s %6s %6s %10s %10s %10s %10s\n",
+            "INPUT", "OUTPUT", "OPTIONS", "WIDTH", "HEIGHT", "ITERATIONS", "MPIX/S", "P50_US", "P99_US");
+
+    for (size_t i = 0; i < results_count; i++) {
+        const struct conversion_result *result = &results[i];
+
+        fprintf(output, "%-24s %-24s %-11s %6u %6u %10u %10.3f %10lu %10lu\n",
+                sail_pixel_format_to_string(result->input_pixel_format),
+                sail_pixel_format_to_string(result->output_pixel_format),
+                result->blend_alpha ? "blend-alpha" : "drop-alpha",
+                result->width, result->height, result->result.iterations, result->result.mpix_per_s,
+                (unsigned long)result->result.p50_us, (unsigned long)result->result.p99_us);
+    }
+}
+
+/* Measures a single input pixel format and size converted to every possible output pixel format. */
+static sail_status_t conversions_case(const struct bench_settings *settings, enum SailPixelFormat input_pixel_format,
+                                        unsigned width, unsigned height, struct sail_conversion_options *options,
+                                        struct conversion_result **results, size_t *results_count, size_t *results_capacity) {
+
+    struct sail_image *image;
+    SAIL_TRY(generate_image(input_pixel_format, width, height, &image));
+
+    struct bench_context context = {
+        .codec_info         = NULL,
+        .image              = image,
+        .encoded            = NULL,
+        .encoded_length     = 0,
+        .loaded             = NULL,
+        .conversion_options = options,
+    };
+
+    for (int output_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN + 1; output_pixel_format <= SAIL_PIXEL_FORMAT_BPP64_YUVA; output_pixel_format++) {
+        if ((settings->output_pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN && settings->output_pixel_format != (enum SailPixelFormat)output_pixel_format) ||
+                !sail_can_convert(input_pixel_format, output_pixel_format)) {
+            continue;
+        }
+
+        context.output_pixel_format = output_pixel_format;
+
+        for (int blend_alpha = 0; blend_alpha <= 1; blend_alpha++) {
+            options->options = blend_alpha ? SAIL_CONVERSION_OPTION_BLEND_ALPHA : SAIL_CONVERSION_OPTION_DROP_ALPHA;
+
+            if (*results_count == *results_capacity) {
+                *results_capacity = *results_capacity == 0 ? 256 : *results_capacity * 2;
+
+                void *ptr = *results;
+                SAIL_TRY_OR_CLEANUP(sail_realloc(sizeof(struct conversion_result) * *results_capacity, &ptr),
+                                    /* cleanup */ sail_destroy_image(image));
+                *results = ptr;
+            }
+
+            struct conversion_result *result = &(*results)[*results_count];
+
+            const sail_status_t status = measure(settings, convert_with_options, &context, &result->result);
+
+            if (status != SAIL_OK) {
+                fprintf(stderr, "Skipping %s -> %s %ux%u: error %d\n", sail_pixel_format_to_string(input_pixel_format),
+                        sail_pixel_format_to_string(output_pixel_format), width, height, status);
+                continue;
+            }
+
+            result->input_pixel_format  = input_pixel_format;
+            result->output_pixel_format = output_pixel_format;
+            result->blend_alpha         = blend_alpha;
+            result->width               = width;
+            result->height              = height;
+
+            (*results_count)++;
+        }
+    }
+
+    sail_destroy_image(image);
+
+    return SAIL_OK;
+}
+
+static sail_status_t conversions_impl(const struct bench_settings *settings) {
+
+    struct sail_conversion_options *options;
+    SAIL_TRY(sail_alloc_conversion_options(&options));
+
+    options->threads = settings->threads;
+
+    struct conversion_result *results = NULL;
+    size_t results_count = 0;
+    size_t results_capacity = 0;
+
+    for (int input_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN + 1; input_pixel_format <= SAIL_PIXEL_FORMAT_BPP64_YUVA; input_pixel_format++) {
+        if (settings->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN && settings->pixel_format != (enum SailPixelFormat)input_pixel_format) {
+            continue;
+        }
+
+        for (unsigned s = 0; s < settings->sizes_count; s++) {
+            SAIL_TRY_OR_CLEANUP(conversions_case(settings, input_pixel_format, settings->sizes[s][0], settings->sizes[s][1],
+                                                    options, &results, &results_count, &results_capacity),
+                                /* cleanup */ sail_free(results),
+                                              sail_destroy_conversion_options(options));
+        }
+    }
+
+    sail_destroy_conversion_options(options);
+
+    conversion_sort_key = settings->sort_key;
+    qsort(results, results_count, sizeof(struct conversion_result), compare_conversion_results);
+
+    print_conversion_table(settings->output, results, results_count);
+
+    sail_free(results);
+
+    return SAIL_OK;
+}
+
+/*
+ * Codec detection.
+ */
+
+static sail_status_t detect_magic_number(const struct bench_context *context) {
+
+    for (unsigned i = 0; i < DETECTIONS_PER_SAMPLE; i++) {
+        const struct sail_codec_info *codec_info;
+        const sail_status_t status = sail_codec_info_by_magic_number_from_memory(context->encoded, context->encoded_length, &codec_info);
+
+        /* The header that matches no codec measures the worst case of trying every magic number. */
+        if (status != SAIL_OK && !(context->codec_info == NULL && status == SAIL_ERROR_CODEC_NOT_FOUND)) {
+            return status;
+        }
+    }
+
+    return SAIL_OK;
+}
+
+/* Builds a header from a magic number like "89 50 4E 47". "??" bytes become zeros. */
+static void magic_number_to_header(const char *magic_number, unsigned char header[SAIL_MAGIC_BUFFER_SIZE]) {
+
+    memset(header, 0, SAIL_MAGIC_BUFFER_SIZE);
+
+    for (unsigned i = 0; i < SAIL_MAGIC_BUFFER_SIZE && magic_number[0] != '\0' && magic_number[1] != '\0'; i++) {
+        unsigned byte;
+
+        if (sscanf(magic_number, "%02x", &byte) == 1) {
+            header[i] = (unsigned char)byte;
+        }
+
+        magic_number += 2;
+
+        while (*magic_number == ' ') {
+            magic_number++;
+        }
+    }
+}
+
+static sail_status_t detect_case(const struct bench_settings *settings, const struct sail_codec_info *codec_info,
+                                    const unsigned char header[SAIL_MAGIC_BUFFER_SIZE]) {
+
+    struct bench_context context = {
+        .codec_info     = codec_info,
+        .image          = NULL,
+        .encoded        = header,
+        .encoded_length = SAIL_MAGIC_BUFFER_SIZE,
+        .loaded         = NULL,
+    };
+
+    struct bench_result result;
+    const sail_status_t status = measure(settings, detect_magic_number, &context, &result);
+
+    if (status != SAIL_OK) {
+        fprintf(stderr, "Skipping detecting %s: error %d\n", codec_info == NULL ? "none" : codec_info->name, status);
+        return SAIL_OK;
+    }
+
+    fprintf(settings->output, "%-10s %10u %14.0f %10.1f %10.1f\n",
+            codec_info == NULL ? "none" : codec_info->name,
+            result.iterations,
+            result.mean_us == 0 ? 0 : DETECTIONS_PER_SAMPLE * 1000000.0 / result.mean_us,
+            result.p50_us * 1000.0 / DETECTIONS_PER_SAMPLE,
+            result.p99_us * 1000.0 / DETECTIONS_PER_SAMPLE);
+
+    return SAIL_OK;
+}
+
+static sail_status_t detect_impl(const struct bench_settings *settings) {
+
+    fprintf(settings->output, "%-10s %10s %14s %10s %10s\n", "CODEC", "ITERATIONS", "DETECTIONS/S", "P50_NS", "P99_NS");
+
+    unsigned char header[SAIL_MAGIC_BUFFER_SIZE];
+
+    for (const struct sail_codec_bundle_node *codec_bundle_node = sail_codec_bundle_list();
+            codec_bundle_node != NULL;
+            codec_bundle_node = codec_bundle_node->next) {
+        const struct sail_codec_info *codec_info = codec_bundle_node->codec_bundle->codec_info;
+
+        if ((settings->codec != NULL && !codec_name_equals(settings->codec, codec_info->name)) ||
+                codec_info->magic_number_node == NULL) {
+            continue;
+        }
+
+        magic_number_to_header(codec_info->magic_number_node->string, header);
+
+        SAIL_TRY(detect_case(settings, codec_info, header));
+    }
+
+    if (settings->codec == NULL) {
+        memset(header, 0xAB, sizeof(header));
+
+        SAIL_TRY(detect_case(settings, NULL, header));
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Command line.
+ */
+
+static sail_status_t parse_settings(int argc, char *argv[], enum BenchCommand command, struct bench_settings *settings, const char **output_path) {
+
+    const bool conversions = command == BENCH_COMMAND_CONVERSIONS;
+
+    *output_path = NULL;
+
+    /* Start parsing CLI options from the third argument. */
+    int i = 2;
+
+    while (i < argc) {
+        if (i == argc-1) {
+            fprintf(stderr, "Error: Missing value of '%s'.\n", argv[i]);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+        }
+
+        const char *value = argv[i+1];
+
+        if (!conversions && (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--codec") == 0)) {
+            settings->codec = value;
+        } else if ((command != BENCH_COMMAND_DETECT && (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--pixel-format") == 0)) ||
+                    (conversions && (strcmp(argv[i], "-P") == 0 || strcmp(argv[i], "--output-pixel-format") == 0))) {
+            const enum SailPixelFormat pixel_format = sail_pixel_format_from_string(value);
+
+            if (pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN) {
+                fprintf(stderr, "Error: Unknown pixel format '%s'.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+
+            if (argv[i][1] == 'P' || strcmp(argv[i], "--output-pixel-format") == 0) {
+                settings->output_pixel_format = pixel_format;
+            } else {
+                settings->pixel_format = pixel_format;
+            }
+        } else if (command != BENCH_COMMAND_DETECT && (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0)) {
+            unsigned width, height;
+
+            if (settings->sizes_count == MAX_SIZES) {
+                fprintf(stderr, "Error: Too many sizes, the maximum is %d.\n", MAX_SIZES);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+            if (sscanf(value, "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+                fprintf(stderr, "Error: Invalid size '%s'. Use WIDTHxHEIGHT.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+
+            settings->sizes[settings->sizes_count][0] = width;
+            settings->sizes[settings->sizes_count][1] = height;
+            settings->sizes_count++;
+        } else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--iterations") == 0) {
+            const int iterations = atoi(value);
+
+            if (iterations <= 0 || iterations > MAX_ITERATIONS) {
+                fprintf(stderr, "Error: Invalid number of iterations '%s'.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+
+            settings->min_iterations = (unsigned)iterations;
+        } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--time") == 0) {
+            const int time_ms = atoi(value);
+
+            if (time_ms < 0) {
+                fprintf(stderr, "Error: Invalid time '%s'.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+
+            settings->min_time_ms = (unsigned)time_ms;
+        } else if (conversions && (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0)) {
+            const int threads = atoi(value);
+
+            if (threads < 0) {
+                fprintf(stderr, "Error: Invalid number of threads '%s'.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+
+            settings->threads = (unsigned)threads;
+        } else if (conversions && strcmp(argv[i], "--sort") == 0) {
+            if (strcmp(value, "input") == 0) {
+                settings->sort_key = SORT_KEY_INPUT;
+            } else if (strcmp(value, "output") == 0) {
+                settings->sort_key = SORT_KEY_OUTPUT;
+            } else if (strcmp(value, "mpix") == 0) {
+                settings->sort_key = SORT_KEY_MPIX;
+            } else if (strcmp(value, "p50") == 0) {
+                settings->sort_key = SORT_KEY_P50;
+            } else if (strcmp(value, "p99") == 0) {
+                settings->sort_key = SORT_KEY_P99;
+            } else {
+                fprintf(stderr, "Error: Unknown sort column '%s'.\n", value);
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            *output_path = value;
+        } else {
+            fprintf(stderr, "Error: Unrecognized option '%s'.\n", argv[i]);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+        }
+
+        i += 2;
+    }
+
+    if (settings->sizes_count == 0) {
+        settings->sizes_count = sizeof(DEFAULT_SIZES) / sizeof(DEFAULT_SIZES[0]);
+        memcpy(settings->sizes, DEFAULT_SIZES, sizeof(DEFAULT_SIZES));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t run(int argc, char *argv[], enum BenchCommand command, unsigned min_time_ms) {
+
+    struct bench_settings settings = {
+        .codec               = NULL,
+        .pixel_format        = SAIL_PIXEL_FORMAT_UNKNOWN,
+        .output_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN,
+        .sizes_count         = 0,
+        .min_iterations      = 5,
+        .min_time_ms         = min_time_ms,
+        .threads             = 0,
+        .sort_key            = SORT_KEY_INPUT,
+        .output              = stdout,
+    };
+
+    const char *output_path;
+    SAIL_TRY(parse_settings(argc, argv, command, &settings, &output_path));
+
+    if (output_path != NULL) {
+        settings.output = fopen(output_path, "w");
+
+        if (settings.output == NULL) {
+            fprintf(stderr, "Error: Failed to open '%s' for writing.\n", output_path);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+        }
+    }
+
+    sail_status_t status;
+
+    switch (command) {
+        case BENCH_COMMAND_CODECS:      status = codecs_impl(&settings);      break;
+        case BENCH_COMMAND_CONVERSIONS: status = conversions_impl(&settings); break;
+        case BENCH_COMMAND_DETECT:      status = detect_impl(&settings);      break;
+        default:                        status = SAIL_ERROR_INVALID_ARGUMENT; break;
+    }
+
+    if (output_path != NULL) {
+        fclose(settings.output);
+    }
+
+    return status;
+}
+
+static sail_status_t codecs(int argc, char *argv[]) {
+
+    SAIL_TRY(run(argc, argv, BENCH_COMMAND_CODECS, 200));
+
+    return SAIL_OK;
+}
+
+static sail_status_t conversions(int argc, char *argv[]) {
+
+    /* The matrix has hundreds of pairs, use a shorter minimum time by default. */
+    SAIL_TRY(run(argc, argv, BENCH_COMMAND_CONVERSIONS, 50));
+
+    return SAIL_OK;
+}
+
+static sail_status_t detect(int argc, char *argv[]) {
+
+    SAIL_TRY(run(argc, argv, BENCH_COMMAND_DETECT, 200));
+
+    return SAIL_OK;
+}
+
+static void help(const char *app) {
+
+    fprintf(stderr, "SAIL benchmark suite.\n\n");
+    fprintf(stderr, "Usage: %s <command> <command arguments>\n", app);
+    fprintf(stderr, "       %s [-h | --help]\n", app);
+    fprintf(stderr, "Commands:\n");
+    fprintf(stderr, "    codecs [options] - Save, probe, load, and convert synthetic images with every codec\n");
+    fprintf(stderr, "                       and every pixel format it can save, and print the results in JSON.\n");
+    fprintf(stderr, "    conversions [options] - Convert synthetic images between every pair of pixel formats\n");
+    fprintf(stderr, "                            with and without blending alpha, and print the results in a table.\n");
+    fprintf(stderr, "    detect [options] - Detect codecs by magic numbers from memory, and print detections per second.\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "    -c | --codec <name>               - codecs, detect: Benchmark only the codec, e.g. PNG.\n");
+    fprintf(stderr, "    -p | --pixel-format <format>      - codecs, conversions: Benchmark only the (input) pixel format.\n");
+    fprintf(stderr, "    -P | --output-pixel-format <f>    - conversions: Benchmark only the output pixel format.\n");
+    fprintf(stderr, "    -s | --size <WIDTHxHEIGHT>        - codecs, conversions: Image size. Can be repeated.\n");
+    fprintf(stderr, "                                        Default: 256x256, 1024x768, 3000x2000.\n");
+    fprintf(stderr, "    -i | --iterations <count>         - Minimum number of measured iterations. Default: 5.\n");
+    fprintf(stderr, "    -t | --time <milliseconds>        - Minimum measured time per operation. Default: 200 (codecs, detect), 50 (conversions).\n");
+    fprintf(stderr, "    -j | --threads <count>            - conversions: Conversion threads. Default: 0.\n");
+    fprintf(stderr, "    --sort <input|output|mpix|p50|p99> - conversions: Sort the table. Default: input.\n");
+    fprintf(stderr, "    -o | --output <path>              - Write the results into the file instead of stdout.\n");
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 2) {
+        help(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+        help(argv[0]);
+        return 0;
+    }
+
+    /* Failures are reported per benchmark case. */
+    sail_set_log_barrier(SAIL_LOG_LEVEL_SILENCE);
+
+    if (strcmp(argv[1], "codecs") == 0) {
+        SAIL_TRY(codecs(argc, argv));
+    } else if (strcmp(argv[1], "conversions") == 0) {
+        SAIL_TRY(conversions(argc, argv));
+    } else if (strcmp(argv[1], "detect") == 0) {
+        SAIL_TRY(detect(argc, argv));
+    } else {
+        print_invalid_argument();
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    sail_finish();
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+/* Little-endian TIFF header with a software tag and an orientation tag in the first IFD. */
+static const unsigned char EXIF_LE[] = {
+    'E', 'x', 'i', 'f', 0, 0,
+    'I', 'I', 42, 0, 8, 0, 0, 0,
+    2, 0,
+    0x31, 0x01, 2, 0, 4, 0, 0, 0, 'S', 'A', 'I', 0,
+    0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+    0, 0, 0, 0,
+};
+
+/* Big-endian TIFF header without "Exif\0\0". */
+static const unsigned char EXIF_BE[] = {
+    'M', 'M', 0, 42, 0, 0, 0, 8,
+    0, 1,
+    0x01, 0x12, 0, 3, 0, 0, 0, 1, 0, 8, 0, 0,
+    0, 0, 0, 0,
+};
+
+static MunitResult test_valid(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    munit_assert(sail_exif_orientation(EXIF_LE, sizeof(EXIF_LE)) == SAIL_ORIENTATION_ROTATED_90);
+    munit_assert(sail_exif_orientation(EXIF_BE, sizeof(EXIF_BE)) == SAIL_ORIENTATION_ROTATED_270);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_invalid(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    munit_assert(sail_exif_orientation(NULL, 0) == SAIL_ORIENTATION_NORMAL);
+
+    /* Truncated IFD entries. */
+    munit_assert(sail_exif_orientation(EXIF_LE, 6 + 8) == SAIL_ORIENTATION_NORMAL);
+    munit_assert(sail_exif_orientation(EXIF_LE, 6 + 8 + 2 + 12 + 11) == SAIL_ORIENTATION_NORMAL);
+
+    unsigned char exif[sizeof(EXIF_BE)];
+
+    /* Unknown byte order. */
+    memcpy(exif, EXIF_BE, sizeof(exif));
+    exif[0] = 'X';
+    munit_assert(sail_exif_orientation(exif, sizeof(exif)) == SAIL_ORIENTATION_NORMAL);
+
+    /* The IFD offset points outside the profile. */
+    memcpy(exif, EXIF_BE, sizeof(exif));
+    exif[4] = 0xFF;
+    munit_assert(sail_exif_orientation(exif, sizeof(exif)) == SAIL_ORIENTATION_NORMAL);
+
+    /* The orientation tag is not SHORT. */
+    memcpy(exif, EXIF_BE, sizeof(exif));
+    exif[13] = 4;
+    munit_assert(sail_exif_orientation(exif, sizeof(exif)) == SAIL_ORIENTATION_NORMAL);
+
+    /* Out of range. */
+    memcpy(exif, EXIF_BE, sizeof(exif));
+    exif[19] = 9;
+    munit_assert(sail_exif_orientation(exif, sizeof(exif)) == SAIL_ORIENTATION_NORMAL);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/valid",   test_valid,   NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/invalid", test_invalid, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/exif-orientation",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
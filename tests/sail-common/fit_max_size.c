@@ -0,0 +1,96 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+static MunitResult test_no_limit(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    unsigned width, height;
+
+    sail_fit_max_size(640, 480, 0, 0, &width, &height);
+    munit_assert(width == 640 && height == 480);
+
+    sail_fit_max_size(640, 480, 640, 0, &width, &height);
+    munit_assert(width == 640 && height == 480);
+
+    sail_fit_max_size(640, 480, 1000, 100, &width, &height);
+    munit_assert(width == 640 && height == 480);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_fit(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    unsigned width, height;
+
+    sail_fit_max_size(640, 480, 320, 240, &width, &height);
+    munit_assert(width == 320 && height == 240);
+
+    /* The larger scale factor wins, so both dimensions are not less than requested. */
+    sail_fit_max_size(640, 480, 320, 100, &width, &height);
+    munit_assert(width == 320 && height == 240);
+
+    sail_fit_max_size(640, 480, 100, 240, &width, &height);
+    munit_assert(width == 320 && height == 240);
+
+    sail_fit_max_size(640, 480, 0, 120, &width, &height);
+    munit_assert(width == 160 && height == 120);
+
+    /* Round up. */
+    sail_fit_max_size(100, 33, 10, 0, &width, &height);
+    munit_assert(width == 10 && height == 4);
+
+    sail_fit_max_size(1000, 1, 10, 0, &width, &height);
+    munit_assert(width == 10 && height == 1);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/no-limit", test_no_limit, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/fit",      test_fit,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/fit-max-size",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -551,13 +551,14 @@ static MunitResult test_codec_feature_to_string(const MunitParameter params[], v
     (void)params;
     (void)user_data;
 
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_UNKNOWN),     "UNKNOWN");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_STATIC),      "STATIC");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ANIMATED),    "ANIMATED");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_MULTI_PAGED), "MULTI-PAGED");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_META_DATA),   "META-DATA");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_INTERLACED),  "INTERLACED");
-    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ICCP),        "ICCP");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_UNKNOWN),          "UNKNOWN");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_STATIC),           "STATIC");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ANIMATED),         "ANIMATED");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_MULTI_PAGED),      "MULTI-PAGED");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_META_DATA),        "META-DATA");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_INTERLACED),       "INTERLACED");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ICCP),             "ICCP");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_EXIF_ORIENTATION), "EXIF-ORIENTATION");
 
     return MUNIT_OK;
 }
@@ -569,13 +570,14 @@ static MunitResult test_codec_feature_from_string(const MunitParameter params[],
     munit_assert(sail_codec_feature_from_string(NULL)   == SAIL_CODEC_FEATURE_UNKNOWN);
     munit_assert(sail_codec_feature_from_string("Some") == SAIL_CODEC_FEATURE_UNKNOWN);
 
-    munit_assert(sail_codec_feature_from_string("UNKNOWN")     == SAIL_CODEC_FEATURE_UNKNOWN);
-    munit_assert(sail_codec_feature_from_string("STATIC")      == SAIL_CODEC_FEATURE_STATIC);
-    munit_assert(sail_codec_feature_from_string("ANIMATED")    == SAIL_CODEC_FEATURE_ANIMATED);
-    munit_assert(sail_codec_feature_from_string("MULTI-PAGED") == SAIL_CODEC_FEATURE_MULTI_PAGED);
-    munit_assert(sail_codec_feature_from_string("META-DATA")   == SAIL_CODEC_FEATURE_META_DATA);
-    munit_assert(sail_codec_feature_from_string("INTERLACED")  == SAIL_CODEC_FEATURE_INTERLACED);
-    munit_assert(sail_codec_feature_from_string("ICCP")        == SAIL_CODEC_FEATURE_ICCP);
+    munit_assert(sail_codec_feature_from_string("UNKNOWN")          == SAIL_CODEC_FEATURE_UNKNOWN);
+    munit_assert(sail_codec_feature_from_string("STATIC")           == SAIL_CODEC_FEATURE_STATIC);
+    munit_assert(sail_codec_feature_from_string("ANIMATED")         == SAIL_CODEC_FEATURE_ANIMATED);
+    munit_assert(sail_codec_feature_from_string("MULTI-PAGED")      == SAIL_CODEC_FEATURE_MULTI_PAGED);
+    munit_assert(sail_codec_feature_from_string("META-DATA")        == SAIL_CODEC_FEATURE_META_DATA);
+    munit_assert(sail_codec_feature_from_string("INTERLACED")       == SAIL_CODEC_FEATURE_INTERLACED);
+    munit_assert(sail_codec_feature_from_string("ICCP")             == SAIL_CODEC_FEATURE_ICCP);
+    munit_assert(sail_codec_feature_from_string("EXIF-ORIENTATION") == SAIL_CODEC_FEATURE_EXIF_ORIENTATION);
 
     return MUNIT_OK;
 }
@@ -36,6 +36,13 @@ static MunitResult test_alloc_options(const MunitParameter params[], void *user_
     munit_assert_not_null(load_options);
     munit_assert(load_options->options == 0);
     munit_assert_null(load_options->tuning);
+    munit_assert(load_options->max_width == 0);
+    munit_assert(load_options->max_height == 0);
+    munit_assert(load_options->roi_x == 0);
+    munit_assert(load_options->roi_y == 0);
+    munit_assert(load_options->roi_width == 0);
+    munit_assert(load_options->roi_height == 0);
+    munit_assert(!sail_has_roi(load_options));
 
     sail_destroy_load_options(load_options);
 
@@ -49,13 +56,25 @@ static MunitResult test_copy_options(const MunitParameter params[], void *user_d
     struct sail_load_options *load_options = NULL;
     munit_assert(sail_alloc_load_options(&load_options) == SAIL_OK);
 
-    load_options->options = SAIL_OPTION_ICCP;
+    load_options->options    = SAIL_OPTION_ICCP;
+    load_options->max_width  = 160;
+    load_options->max_height = 120;
+    load_options->roi_x      = 10;
+    load_options->roi_y      = 20;
+    load_options->roi_width  = 30;
+    load_options->roi_height = 40;
 
     struct sail_load_options *load_options_copy = NULL;
     munit_assert(sail_copy_load_options(load_options, &load_options_copy) == SAIL_OK);
     munit_assert_not_null(load_options_copy);
 
     munit_assert(load_options_copy->options == load_options->options);
+    munit_assert(load_options_copy->max_width == load_options->max_width);
+    munit_assert(load_options_copy->max_height == load_options->max_height);
+    munit_assert(load_options_copy->roi_x == load_options->roi_x);
+    munit_assert(load_options_copy->roi_y == load_options->roi_y);
+    munit_assert(load_options_copy->roi_width == load_options->roi_width);
+    munit_assert(load_options_copy->roi_height == load_options->roi_height);
     munit_assert_null(load_options_copy->tuning);
 
     sail_destroy_load_options(load_options_copy);
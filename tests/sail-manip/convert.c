@@ -0,0 +1,621 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+#ifdef SAIL_THREAD_SAFE
+    #ifdef SAIL_WIN32
+        #include <Windows.h>
+    #else
+        #include <pthread.h>
+    #endif
+
+/* Threads that converted bands told apart by the addresses of a thread local variable. */
+struct band_threads {
+#ifdef SAIL_WIN32
+    SRWLOCK lock;
+#else
+    pthread_mutex_t lock;
+#endif
+    const void *threads[64];
+    unsigned count;
+};
+
+static SAIL_THREAD_LOCAL char thread_marker;
+
+static void collect_band_threads(const struct sail_trace_event *event, void *user_data) {
+
+    struct band_threads *band_threads = user_data;
+
+    if (event->phase != SAIL_TRACE_PHASE_BEGIN || strcmp(event->name, "convert_band") != 0) {
+        return;
+    }
+
+#ifdef SAIL_WIN32
+    AcquireSRWLockExclusive(&band_threads->lock);
+#else
+    pthread_mutex_lock(&band_threads->lock);
+#endif
+
+    bool found = false;
+
+    for (unsigned i = 0; i < band_threads->count; i++) {
+        found = found || band_threads->threads[i] == &thread_marker;
+    }
+
+    if (!found && band_threads->count < sizeof(band_threads->threads) / sizeof(band_threads->threads[0])) {
+        band_threads->threads[band_threads->count++] = &thread_marker;
+    }
+
+#ifdef SAIL_WIN32
+    ReleaseSRWLockExclusive(&band_threads->lock);
+#else
+    pthread_mutex_unlock(&band_threads->lock);
+#endif
+}
+#endif
+
+static struct sail_image* create_image(unsigned width, unsigned height, enum SailPixelFormat pixel_format, const void *pixels) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = width;
+    image->height         = height;
+    image->pixel_format   = pixel_format;
+    image->bytes_per_line = sail_bytes_per_line(width, pixel_format);
+
+    const size_t pixels_size = (size_t)image->bytes_per_line * height;
+    munit_assert(sail_malloc(pixels_size, &image->pixels) == SAIL_OK);
+    memcpy(image->pixels, pixels, pixels_size);
+
+    return image;
+}
+
+struct rgb_layout {
+    enum SailPixelFormat pixel_format;
+    unsigned components;
+    int r;
+    int g;
+    int b;
+    int a;
+};
+
+static const struct rgb_layout RGB_LAYOUTS[] = {
+    { SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE, 1, 0, 0, 0, -1 },
+    { SAIL_PIXEL_FORMAT_BPP24_RGB,      3, 0, 1, 2, -1 },
+    { SAIL_PIXEL_FORMAT_BPP24_BGR,      3, 2, 1, 0, -1 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBX,     4, 0, 1, 2, -1 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRX,     4, 2, 1, 0, -1 },
+    { SAIL_PIXEL_FORMAT_BPP32_XRGB,     4, 1, 2, 3, -1 },
+    { SAIL_PIXEL_FORMAT_BPP32_XBGR,     4, 3, 2, 1, -1 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA,     4, 0, 1, 2, 3  },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRA,     4, 2, 1, 0, 3  },
+    { SAIL_PIXEL_FORMAT_BPP32_ARGB,     4, 1, 2, 3, 0  },
+    { SAIL_PIXEL_FORMAT_BPP32_ABGR,     4, 3, 2, 1, 0  },
+};
+
+static const size_t RGB_LAYOUTS_LENGTH = sizeof(RGB_LAYOUTS) / sizeof(RGB_LAYOUTS[0]);
+
+/* Per-pixel reference of a swizzle. */
+static void swizzle_reference(const struct rgb_layout *input, const struct rgb_layout *output, const uint8_t *scan_input, uint8_t *scan_output, unsigned width) {
+
+    for (unsigned column = 0; column < width; column++, scan_input += input->components, scan_output += output->components) {
+        memset(scan_output, 255, output->components);
+
+        scan_output[output->r] = scan_input[input->r];
+        scan_output[output->g] = scan_input[input->g];
+        scan_output[output->b] = scan_input[input->b];
+
+        if (output->a >= 0 && input->a >= 0) {
+            scan_output[output->a] = scan_input[input->a];
+        }
+    }
+}
+
+static MunitResult test_convert_rgb(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const uint8_t pixels[] = { 10, 20, 30, 40, 50, 60 };
+    struct sail_image *image = create_image(2, 1, SAIL_PIXEL_FORMAT_BPP24_RGB, pixels);
+
+    {
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP32_RGBA, &image_output) == SAIL_OK);
+
+        const uint8_t expected[] = { 10, 20, 30, 255, 40, 50, 60, 255 };
+        munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+        sail_destroy_image(image_output);
+    }
+
+    {
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP32_XBGR, &image_output) == SAIL_OK);
+
+        const uint8_t expected[] = { 255, 30, 20, 10, 255, 60, 50, 40 };
+        munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+        sail_destroy_image(image_output);
+    }
+
+    {
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP48_BGR, &image_output) == SAIL_OK);
+
+        const uint16_t expected[] = { 30 * 257, 20 * 257, 10 * 257, 60 * 257, 50 * 257, 40 * 257 };
+        munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+        sail_destroy_image(image_output);
+    }
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_convert_alpha(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const uint8_t pixels[] = { 200, 100, 0, 128, 1, 2, 3, 255 };
+    struct sail_image *image = create_image(2, 1, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+
+    /* Drop alpha. */
+    {
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP24_RGB, &image_output) == SAIL_OK);
+
+        const uint8_t expected[] = { 200, 100, 0, 1, 2, 3 };
+        munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+        sail_destroy_image(image_output);
+    }
+
+    /* Blend alpha. */
+    {
+        struct sail_conversion_options *options;
+        munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+
+        options->options = SAIL_CONVERSION_OPTION_BLEND_ALPHA;
+        options->background24.component1 = 0;
+        options->background24.component2 = 0;
+        options->background24.component3 = 100;
+
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image_with_options(image, SAIL_PIXEL_FORMAT_BPP24_BGR, options, &image_output) == SAIL_OK);
+
+        const uint8_t expected[] = { 49, 50, 100, 3, 2, 1 };
+        munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+        sail_destroy_image(image_output);
+        sail_destroy_conversion_options(options);
+    }
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_convert_grayscale(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* 1, 0, 1. */
+    const uint8_t pixels[] = { 0xA0 };
+    struct sail_image *image = create_image(3, 1, SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE, pixels);
+
+    struct sail_image *image_output;
+    munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP24_RGB, &image_output) == SAIL_OK);
+
+    const uint8_t expected[] = { 255, 255, 255, 0, 0, 0, 255, 255, 255 };
+    munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_update(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const uint8_t pixels[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    struct sail_image *image = create_image(3, 1, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+
+    munit_assert(sail_update_image(image, SAIL_PIXEL_FORMAT_BPP24_BGR) == SAIL_OK);
+    munit_assert(image->pixel_format == SAIL_PIXEL_FORMAT_BPP24_BGR);
+
+    const uint8_t expected[] = { 3, 2, 1, 7, 6, 5, 11, 10, 9 };
+    munit_assert_memory_equal(sizeof(expected), image->pixels, expected);
+
+    /* Larger output pixels. */
+    munit_assert(sail_update_image(image, SAIL_PIXEL_FORMAT_BPP48_RGB) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+/* Limits the SIMD implementations libsail-manip uses. NULL means the best supported one. */
+static void force_simd(const char *simd) {
+
+#ifdef SAIL_WIN32
+    _putenv_s("SAIL_FORCE_SIMD", simd == NULL ? "" : simd);
+#else
+    if (simd == NULL) {
+        unsetenv("SAIL_FORCE_SIMD");
+    } else {
+        setenv("SAIL_FORCE_SIMD", simd, 1);
+    }
+#endif
+}
+
+static MunitResult test_swizzle(const MunitParameter params[], void *user_data) {
+
+    (void)user_data;
+
+    const char *simd = munit_parameters_get(params, "simd");
+
+    /* Implementations the CPU doesn't support. */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    if (strcmp(simd, "neon") == 0 ||
+            (strcmp(simd, "ssse3") == 0 && !__builtin_cpu_supports("ssse3")) ||
+            (strcmp(simd, "avx2") == 0 && !__builtin_cpu_supports("avx2"))) {
+        return MUNIT_SKIP;
+    }
+#elif defined(__aarch64__)
+    if (strcmp(simd, "ssse3") == 0 || strcmp(simd, "avx2") == 0) {
+        return MUNIT_SKIP;
+    }
+#endif
+
+    /* Every implementation is compared with the per-pixel reference. */
+    force_simd(simd);
+
+    /* Cover both SIMD steps and scalar tails. */
+    static const unsigned widths[] = { 1, 5, 16, 21, 33, 67 };
+
+    for (size_t i = 0; i < RGB_LAYOUTS_LENGTH; i++) {
+        for (size_t o = 1; o < RGB_LAYOUTS_LENGTH; o++) {
+            for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+                const struct rgb_layout *input = &RGB_LAYOUTS[i];
+                const struct rgb_layout *output = &RGB_LAYOUTS[o];
+                const unsigned width = widths[w];
+                const unsigned height = 2;
+
+                uint8_t pixels[67 * 4 * 2];
+                for (size_t k = 0; k < sizeof(pixels); k++) {
+                    pixels[k] = (uint8_t)munit_rand_uint32();
+                }
+
+                struct sail_image *image = create_image(width, height, input->pixel_format, pixels);
+
+                uint8_t expected[67 * 4 * 2];
+                for (unsigned row = 0; row < height; row++) {
+                    swizzle_reference(input, output, pixels + row * width * input->components, expected + row * width * output->components, width);
+                }
+
+                struct sail_image *image_output;
+                munit_assert(sail_convert_image(image, output->pixel_format, &image_output) == SAIL_OK);
+                munit_assert_memory_equal((size_t)width * height * output->components, image_output->pixels, expected);
+                sail_destroy_image(image_output);
+
+                /* In place. Updating to the same pixel format is a no-op. */
+                if (i != o && output->components <= input->components && input->components > 1) {
+                    munit_assert(sail_update_image(image, output->pixel_format) == SAIL_OK);
+
+                    for (unsigned row = 0; row < height; row++) {
+                        munit_assert_memory_equal((size_t)width * output->components,
+                                                  (const uint8_t *)image->pixels + row * image->bytes_per_line,
+                                                  expected + row * width * output->components);
+                    }
+                }
+
+                sail_destroy_image(image);
+            }
+        }
+    }
+
+    force_simd(NULL);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_threads(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Large enough to be split into several bands with an uneven number of rows. */
+    const unsigned width = 1024;
+    const unsigned height = 1021;
+    static const enum SailPixelFormat output_pixel_formats[] = {
+        SAIL_PIXEL_FORMAT_BPP24_BGR,
+        SAIL_PIXEL_FORMAT_BPP48_RGB,
+        SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+    };
+
+    const size_t pixels_size = (size_t)width * height * 4;
+    void *pixels;
+    munit_assert(sail_malloc(pixels_size, &pixels) == SAIL_OK);
+    for (size_t k = 0; k < pixels_size; k++) {
+        ((uint8_t *)pixels)[k] = (uint8_t)munit_rand_uint32();
+    }
+
+    struct sail_image *image = create_image(width, height, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+    sail_free(pixels);
+
+    struct sail_conversion_options *options;
+    munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+    options->options      = SAIL_CONVERSION_OPTION_BLEND_ALPHA;
+    options->background24 = (sail_rgb24_t){ 10, 20, 30 };
+    options->background48 = (sail_rgb48_t){ 1000, 2000, 3000 };
+
+    for (size_t i = 0; i < sizeof(output_pixel_formats) / sizeof(output_pixel_formats[0]); i++) {
+        struct sail_image *expected;
+        options->threads = 1;
+        munit_assert(sail_convert_image_with_options(image, output_pixel_formats[i], options, &expected) == SAIL_OK);
+
+        struct sail_image *image_output;
+        options->threads = 8;
+#ifdef SAIL_THREAD_SAFE
+        struct band_threads band_threads;
+#ifdef SAIL_WIN32
+        InitializeSRWLock(&band_threads.lock);
+#else
+        pthread_mutex_init(&band_threads.lock, NULL);
+#endif
+        band_threads.count = 0;
+        sail_set_trace_callback(collect_band_threads, &band_threads);
+#endif
+        munit_assert(sail_convert_image_with_options(image, output_pixel_formats[i], options, &image_output) == SAIL_OK);
+#ifdef SAIL_THREAD_SAFE
+        sail_set_trace_callback(NULL, NULL);
+#ifndef SAIL_WIN32
+        pthread_mutex_destroy(&band_threads.lock);
+#endif
+        /* Bands are converted in several threads. */
+        munit_assert_uint(band_threads.count, >, 1);
+        munit_assert_uint(band_threads.count, <=, options->threads);
+#endif
+        munit_assert_memory_equal((size_t)expected->bytes_per_line * height, image_output->pixels, expected->pixels);
+        sail_destroy_image(image_output);
+
+        /* In place. */
+        if (sail_greater_equal_bits_per_pixel(image->pixel_format, output_pixel_formats[i])) {
+            struct sail_image *image_copy;
+            munit_assert(sail_copy_image(image, &image_copy) == SAIL_OK);
+            munit_assert(sail_update_image_with_options(image_copy, output_pixel_formats[i], options) == SAIL_OK);
+
+            for (unsigned row = 0; row < height; row++) {
+                munit_assert_memory_equal(expected->bytes_per_line,
+                                          (const uint8_t *)image_copy->pixels + (size_t)row * image_copy->bytes_per_line,
+                                          (const uint8_t *)expected->pixels + (size_t)row * expected->bytes_per_line);
+            }
+
+            sail_destroy_image(image_copy);
+        }
+
+        sail_destroy_image(expected);
+    }
+
+    sail_destroy_conversion_options(options);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_plan(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const unsigned width = 5;
+    const unsigned height = 3;
+    const enum SailPixelFormat output_pixel_format = SAIL_PIXEL_FORMAT_BPP48_BGR;
+
+    struct sail_conversion_plan *plan;
+    munit_assert(sail_alloc_conversion_plan(SAIL_PIXEL_FORMAT_BPP32_RGBA, width, output_pixel_format, NULL, &plan) == SAIL_OK);
+
+    /* The plan is reused for several frames. */
+    for (unsigned frame = 0; frame < 3; frame++) {
+        uint8_t pixels[5 * 3 * 4];
+        for (size_t k = 0; k < sizeof(pixels); k++) {
+            pixels[k] = (uint8_t)munit_rand_uint32();
+        }
+
+        struct sail_image *image = create_image(width, height, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+
+        struct sail_image *expected;
+        munit_assert(sail_convert_image(image, output_pixel_format, &expected) == SAIL_OK);
+
+        /* Caller-owned image. */
+        struct sail_image *image_output;
+        munit_assert(sail_copy_image(expected, &image_output) == SAIL_OK);
+        memset(image_output->pixels, 0, (size_t)image_output->bytes_per_line * height);
+
+        munit_assert(sail_convert_image_with_plan(plan, image, image_output) == SAIL_OK);
+        munit_assert_memory_equal((size_t)expected->bytes_per_line * height, image_output->pixels, expected->pixels);
+        sail_destroy_image(image_output);
+
+        /* Caller-owned buffer with padded scan lines. */
+        const unsigned bytes_per_line = expected->bytes_per_line + 7;
+        uint8_t buffer[(5 * 6 + 7) * 3];
+        munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, sizeof(buffer), bytes_per_line) == SAIL_OK);
+
+        for (unsigned row = 0; row < height; row++) {
+            munit_assert_memory_equal(expected->bytes_per_line,
+                                      buffer + row * bytes_per_line,
+                                      (const uint8_t *)expected->pixels + row * expected->bytes_per_line);
+        }
+
+        /* Too small buffer. */
+        munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, sizeof(buffer) - 1, bytes_per_line) == SAIL_ERROR_INVALID_ARGUMENT);
+        munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, sizeof(buffer), expected->bytes_per_line - 1) == SAIL_ERROR_INVALID_ARGUMENT);
+
+        sail_destroy_image(expected);
+        sail_destroy_image(image);
+    }
+
+    /* Plans don't depend on the height, e.g. the last shorter band of scan lines. */
+    uint8_t pixels[5 * 3 * 4] = { 0 };
+    uint8_t buffer[5 * 6 * 3];
+
+    struct sail_image *image = create_image(width, height - 1, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+    munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, width * 6 * (height - 1), width * 6) == SAIL_OK);
+    sail_destroy_image(image);
+
+    /* Images that don't match the plan. */
+    image = create_image(width - 1, height, SAIL_PIXEL_FORMAT_BPP32_RGBA, pixels);
+    munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, sizeof(buffer), width * 6) == SAIL_ERROR_INVALID_ARGUMENT);
+    sail_destroy_image(image);
+
+    image = create_image(width, height, SAIL_PIXEL_FORMAT_BPP32_BGRA, pixels);
+    munit_assert(sail_convert_image_with_plan_to_buffer(plan, image, buffer, sizeof(buffer), width * 6) == SAIL_ERROR_INVALID_ARGUMENT);
+    sail_destroy_image(image);
+
+    sail_destroy_conversion_plan(plan);
+
+    /* Unsupported conversions. */
+    munit_assert(sail_alloc_conversion_plan(SAIL_PIXEL_FORMAT_BPP32_RGBA, width, SAIL_PIXEL_FORMAT_BPP1_INDEXED, NULL, &plan) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_indexed(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const enum SailPixelFormat pixel_formats[] = {
+        SAIL_PIXEL_FORMAT_BPP1_INDEXED,
+        SAIL_PIXEL_FORMAT_BPP2_INDEXED,
+        SAIL_PIXEL_FORMAT_BPP4_INDEXED,
+        SAIL_PIXEL_FORMAT_BPP8_INDEXED,
+    };
+
+    /* Cover whole input bytes and partial trailing bytes. */
+    static const unsigned widths[] = { 1, 3, 8, 13 };
+
+    for (size_t i = 0; i < sizeof(pixel_formats) / sizeof(pixel_formats[0]); i++) {
+        for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            const unsigned bits = sail_bits_per_pixel(pixel_formats[i]);
+            const unsigned width = widths[w];
+            const unsigned height = 2;
+            const unsigned colors = 1u << bits;
+
+            uint8_t pixels[13 * 2];
+            for (size_t k = 0; k < sizeof(pixels); k++) {
+                pixels[k] = (uint8_t)munit_rand_uint32();
+            }
+
+            struct sail_image *image = create_image(width, height, pixel_formats[i], pixels);
+            munit_assert(sail_alloc_palette_for_data(SAIL_PIXEL_FORMAT_BPP24_RGB, colors, &image->palette) == SAIL_OK);
+            for (unsigned k = 0; k < colors * 3; k++) {
+                ((uint8_t *)image->palette->data)[k] = (uint8_t)munit_rand_uint32();
+            }
+
+            struct sail_image *image_output;
+            munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP32_BGRA, &image_output) == SAIL_OK);
+
+            for (unsigned row = 0; row < height; row++) {
+                const uint8_t *scan_input = (const uint8_t *)image->pixels + row * image->bytes_per_line;
+                const uint8_t *scan_output = (const uint8_t *)image_output->pixels + row * image_output->bytes_per_line;
+
+                for (unsigned column = 0; column < width; column++) {
+                    const unsigned bit = column * bits;
+                    const unsigned index = (scan_input[bit / 8] >> (8 - bits - bit % 8)) & (colors - 1);
+                    const uint8_t *entry = (const uint8_t *)image->palette->data + index * 3;
+                    const uint8_t expected[] = { entry[2], entry[1], entry[0], 255 };
+
+                    munit_assert_memory_equal(4, scan_output + column * 4, expected);
+                }
+            }
+
+            sail_destroy_image(image_output);
+
+            /* Indexes beyond the palette. */
+            memset(image->pixels, 0xFF, (size_t)image->bytes_per_line * height);
+            image->palette->color_count = colors - 1;
+            munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP32_BGRA, &image_output) == SAIL_ERROR_BROKEN_IMAGE);
+
+            sail_destroy_image(image);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static char *simd_levels[] = {
+    (char *)"none",
+    (char *)"ssse3",
+    (char *)"avx2",
+    (char *)"neon",
+    NULL,
+};
+
+static MunitParameterEnum simd_params[] = {
+    { (char *)"simd", simd_levels },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/rgb",       test_convert_rgb,       NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/alpha",     test_convert_alpha,     NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/grayscale", test_convert_grayscale, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/update",    test_update,            NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/swizzle",   test_swizzle,           NULL, NULL, MUNIT_TEST_OPTION_NONE, simd_params },
+    { (char *)"/threads",   test_threads,           NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/plan",      test_plan,              NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/indexed",   test_indexed,           NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/convert",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
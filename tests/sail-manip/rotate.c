@@ -0,0 +1,295 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#include <string.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+static const enum SailPixelFormat PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP24_RGB,
+    SAIL_PIXEL_FORMAT_BPP32_ARGB,
+    SAIL_PIXEL_FORMAT_BPP48_BGR,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+};
+
+static const size_t PIXEL_FORMATS_LENGTH = sizeof(PIXEL_FORMATS) / sizeof(PIXEL_FORMATS[0]);
+
+/* Cover partial tiles, partial SIMD blocks, and degenerate images. */
+static const unsigned DIMENSIONS[][2] = {
+    { 1,   1  },
+    { 7,   1  },
+    { 1,   9  },
+    { 67,  45 },
+    { 130, 9  },
+};
+
+static const size_t DIMENSIONS_LENGTH = sizeof(DIMENSIONS) / sizeof(DIMENSIONS[0]);
+
+static struct sail_image* create_random_image(unsigned width, unsigned height, enum SailPixelFormat pixel_format) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = width;
+    image->height         = height;
+    image->pixel_format   = pixel_format;
+    image->bytes_per_line = sail_bytes_per_line(width, pixel_format);
+
+    const size_t pixels_size = (size_t)image->bytes_per_line * height;
+    munit_assert(sail_malloc(pixels_size, &image->pixels) == SAIL_OK);
+
+    for (size_t k = 0; k < pixels_size; k++) {
+        ((uint8_t *)image->pixels)[k] = (uint8_t)munit_rand_uint32();
+    }
+
+    return image;
+}
+
+static const uint8_t* pixel_at(const struct sail_image *image, unsigned x, unsigned y) {
+
+    const unsigned bytes_per_pixel = sail_bits_per_pixel(image->pixel_format) / 8;
+
+    return (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * y + (size_t)x * bytes_per_pixel;
+}
+
+/* Checks that output(x, y) == image(map(x, y)) for every output pixel. */
+static void assert_remapped(const struct sail_image *image, const struct sail_image *image_output,
+                            void (*map)(const struct sail_image *image, unsigned x, unsigned y, unsigned *image_x, unsigned *image_y)) {
+
+    const unsigned bytes_per_pixel = sail_bits_per_pixel(image->pixel_format) / 8;
+
+    for (unsigned y = 0; y < image_output->height; y++) {
+        for (unsigned x = 0; x < image_output->width; x++) {
+            unsigned image_x;
+            unsigned image_y;
+            map(image, x, y, &image_x, &image_y);
+
+            munit_assert_memory_equal(bytes_per_pixel, pixel_at(image_output, x, y), pixel_at(image, image_x, image_y));
+        }
+    }
+}
+
+static void map_rotate_90(const struct sail_image *image, unsigned x, unsigned y, unsigned *image_x, unsigned *image_y) {
+    *image_x = y;
+    *image_y = image->height - 1 - x;
+}
+
+static void map_rotate_180(const struct sail_image *image, unsigned x, unsigned y, unsigned *image_x, unsigned *image_y) {
+    *image_x = image->width - 1 - x;
+    *image_y = image->height - 1 - y;
+}
+
+static void map_rotate_270(const struct sail_image *image, unsigned x, unsigned y, unsigned *image_x, unsigned *image_y) {
+    *image_x = image->width - 1 - y;
+    *image_y = x;
+}
+
+static void map_transpose(const struct sail_image *image, unsigned x, unsigned y, unsigned *image_x, unsigned *image_y) {
+    (void)image;
+
+    *image_x = y;
+    *image_y = x;
+}
+
+static MunitResult test_rotate(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const enum SailRotation rotations[] = { SAIL_ROTATION_90, SAIL_ROTATION_180, SAIL_ROTATION_270 };
+    void (*maps[])(const struct sail_image *, unsigned, unsigned, unsigned *, unsigned *) = { map_rotate_90, map_rotate_180, map_rotate_270 };
+
+    for (size_t f = 0; f < PIXEL_FORMATS_LENGTH; f++) {
+        munit_assert(sail_can_rotate(PIXEL_FORMATS[f]));
+
+        for (size_t d = 0; d < DIMENSIONS_LENGTH; d++) {
+            struct sail_image *image = create_random_image(DIMENSIONS[d][0], DIMENSIONS[d][1], PIXEL_FORMATS[f]);
+
+            for (size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+                struct sail_image *image_output;
+                munit_assert(sail_rotate_image(image, rotations[r], &image_output) == SAIL_OK);
+
+                const bool swapped = rotations[r] != SAIL_ROTATION_180;
+                munit_assert(image_output->width  == (swapped ? image->height : image->width));
+                munit_assert(image_output->height == (swapped ? image->width : image->height));
+                munit_assert(image_output->pixel_format == image->pixel_format);
+
+                assert_remapped(image, image_output, maps[r]);
+
+                sail_destroy_image(image_output);
+            }
+
+            struct sail_image *image_output;
+            munit_assert(sail_transpose_image(image, &image_output) == SAIL_OK);
+            munit_assert(image_output->width  == image->height);
+            munit_assert(image_output->height == image->width);
+            assert_remapped(image, image_output, map_transpose);
+            sail_destroy_image(image_output);
+
+            sail_destroy_image(image);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_full_turn(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = create_random_image(200, 77, SAIL_PIXEL_FORMAT_BPP32_RGBA);
+    munit_assert(sail_alloc_resolution(&image->resolution) == SAIL_OK);
+    image->resolution->x = 72;
+    image->resolution->y = 300;
+
+    struct sail_image *image_output;
+    munit_assert(sail_rotate_image(image, SAIL_ROTATION_90, &image_output) == SAIL_OK);
+    munit_assert(image_output->resolution->x == 300);
+    munit_assert(image_output->resolution->y == 72);
+
+    for (unsigned i = 0; i < 3; i++) {
+        struct sail_image *image_rotated;
+        munit_assert(sail_rotate_image(image_output, SAIL_ROTATION_90, &image_rotated) == SAIL_OK);
+        sail_destroy_image(image_output);
+        image_output = image_rotated;
+    }
+
+    munit_assert(image_output->width == image->width);
+    munit_assert(image_output->height == image->height);
+    munit_assert(image_output->resolution->x == 72);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image_output->pixels, image->pixels);
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_unsupported(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    munit_assert(!sail_can_rotate(SAIL_PIXEL_FORMAT_BPP1_INDEXED));
+    munit_assert(!sail_can_rotate(SAIL_PIXEL_FORMAT_BPP4_GRAYSCALE));
+
+    struct sail_image *image = create_random_image(10, 10, SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE);
+
+    struct sail_image *image_output = NULL;
+    munit_assert(sail_rotate_image(image, SAIL_ROTATION_90, &image_output) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    munit_assert(sail_transpose_image(image, &image_output) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    munit_assert_null(image_output);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static unsigned bit_at(const struct sail_image *image, unsigned bit, unsigned y) {
+
+    const uint8_t *scan = (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * y;
+
+    return (scan[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+static MunitResult test_mirror(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const enum SailPixelFormat pixel_formats[] = {
+        SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP2_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP4_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP24_RGB,
+        SAIL_PIXEL_FORMAT_BPP32_ARGB,
+        SAIL_PIXEL_FORMAT_BPP48_BGR,
+        SAIL_PIXEL_FORMAT_BPP64_RGBA,
+    };
+
+    for (size_t f = 0; f < sizeof(pixel_formats) / sizeof(pixel_formats[0]); f++) {
+        const unsigned bits_per_pixel = sail_bits_per_pixel(pixel_formats[f]);
+
+        for (size_t d = 0; d < DIMENSIONS_LENGTH; d++) {
+            struct sail_image *image = create_random_image(DIMENSIONS[d][0], DIMENSIONS[d][1], pixel_formats[f]);
+
+            struct sail_image *image_mirrored;
+            munit_assert(sail_copy_image(image, &image_mirrored) == SAIL_OK);
+            munit_assert(sail_mirror_horizontally(image_mirrored) == SAIL_OK);
+
+            /* Compare bit by bit to cover sub-byte pixels. */
+            for (unsigned y = 0; y < image->height; y++) {
+                for (unsigned x = 0; x < image->width; x++) {
+                    for (unsigned b = 0; b < bits_per_pixel; b++) {
+                        munit_assert_uint(bit_at(image_mirrored, x * bits_per_pixel + b, y),
+                                          ==,
+                                          bit_at(image, (image->width - 1 - x) * bits_per_pixel + b, y));
+                    }
+                }
+            }
+
+            munit_assert(sail_mirror_horizontally(image_mirrored) == SAIL_OK);
+            munit_assert(sail_mirror_vertically(image_mirrored) == SAIL_OK);
+
+            /* Padding bits are not preserved. */
+            for (unsigned y = 0; y < image->height; y++) {
+                for (unsigned bit = 0; bit < image->width * bits_per_pixel; bit++) {
+                    munit_assert_uint(bit_at(image_mirrored, bit, y), ==, bit_at(image, bit, image->height - 1 - y));
+                }
+            }
+
+            sail_destroy_image(image_mirrored);
+            sail_destroy_image(image);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/rotate",      test_rotate,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/full-turn",   test_full_turn,   NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/unsupported", test_unsupported, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/mirror",      test_mirror,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/rotate",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
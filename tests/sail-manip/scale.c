@@ -0,0 +1,474 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+static const enum SailScaling ALGORITHMS[] = {
+    SAIL_SCALING_BOX,
+    SAIL_SCALING_BILINEAR,
+    SAIL_SCALING_LANCZOS3,
+};
+
+static const size_t ALGORITHMS_LENGTH = sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]);
+
+static const enum SailPixelFormat PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP24_RGB,
+    SAIL_PIXEL_FORMAT_BPP48_BGR,
+    SAIL_PIXEL_FORMAT_BPP32_ARGB,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+};
+
+static const size_t PIXEL_FORMATS_LENGTH = sizeof(PIXEL_FORMATS) / sizeof(PIXEL_FORMATS[0]);
+
+static struct sail_image* create_image(unsigned width, unsigned height, enum SailPixelFormat pixel_format) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = width;
+    image->height         = height;
+    image->pixel_format   = pixel_format;
+    image->bytes_per_line = sail_bytes_per_line(width, pixel_format);
+
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * height, &image->pixels) == SAIL_OK);
+
+    return image;
+}
+
+static struct sail_image* create_random_image(unsigned width, unsigned height, enum SailPixelFormat pixel_format) {
+
+    struct sail_image *image = create_image(width, height, pixel_format);
+
+    const size_t pixels_size = (size_t)image->bytes_per_line * height;
+    for (size_t k = 0; k < pixels_size; k++) {
+        ((uint8_t *)image->pixels)[k] = (uint8_t)munit_rand_uint32();
+    }
+
+    return image;
+}
+
+static MunitResult test_formats(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    for (size_t i = 0; i < PIXEL_FORMATS_LENGTH; i++) {
+        munit_assert(sail_can_scale(PIXEL_FORMATS[i]));
+    }
+
+    munit_assert(!sail_can_scale(SAIL_PIXEL_FORMAT_BPP8_INDEXED));
+    munit_assert(!sail_can_scale(SAIL_PIXEL_FORMAT_BPP1_GRAYSCALE));
+    munit_assert(!sail_can_scale(SAIL_PIXEL_FORMAT_BPP32_CMYK));
+
+    struct sail_image *image = create_random_image(4, 4, SAIL_PIXEL_FORMAT_BPP32_CMYK);
+    struct sail_image *image_output = NULL;
+    munit_assert(sail_scale_image(image, 2, 2, SAIL_SCALING_BOX, &image_output) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    munit_assert_null(image_output);
+    sail_destroy_image(image);
+
+    image = create_random_image(4, 4, SAIL_PIXEL_FORMAT_BPP24_RGB);
+    munit_assert(sail_scale_image(image, 0, 2, SAIL_SCALING_BOX, &image_output) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_scale_image(image, 2, 0, SAIL_SCALING_BOX, &image_output) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert_null(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+/* Scaled flat images stay flat with any filter as the filter weights sum up to one. */
+static MunitResult test_flat(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const unsigned dimensions[][2] = { { 1, 1 }, { 7, 3 }, { 16, 16 }, { 33, 50 }, { 100, 9 } };
+
+    for (size_t i = 0; i < PIXEL_FORMATS_LENGTH; i++) {
+        struct sail_image *image = create_image(20, 30, PIXEL_FORMATS[i]);
+        memset(image->pixels, 0xA5, (size_t)image->bytes_per_line * image->height);
+
+        for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+            for (size_t d = 0; d < sizeof(dimensions) / sizeof(dimensions[0]); d++) {
+                struct sail_image *image_output;
+                munit_assert(sail_scale_image(image, dimensions[d][0], dimensions[d][1], ALGORITHMS[a], &image_output) == SAIL_OK);
+
+                munit_assert(image_output->width == dimensions[d][0]);
+                munit_assert(image_output->height == dimensions[d][1]);
+                munit_assert(image_output->pixel_format == image->pixel_format);
+                munit_assert(image_output->bytes_per_line == sail_bytes_per_line(image_output->width, image_output->pixel_format));
+
+                const uint8_t *pixels = image_output->pixels;
+                const size_t pixels_size = (size_t)image_output->bytes_per_line * image_output->height;
+
+                if (image->pixel_format == SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA || image->pixel_format == SAIL_PIXEL_FORMAT_BPP64_RGBA) {
+                    /* 16-bit colors premultiplied by alpha and divided back may be off by one. */
+                    for (size_t k = 0; k < pixels_size / 2; k++) {
+                        munit_assert_int(abs(((const uint16_t *)pixels)[k] - 0xA5A5), <=, 1);
+                    }
+                } else {
+                    for (size_t k = 0; k < pixels_size; k++) {
+                        munit_assert_uint8(pixels[k], ==, 0xA5);
+                    }
+                }
+
+                sail_destroy_image(image_output);
+            }
+        }
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+/*
+ * Images with identical rows or columns keep them when stretched along them. Lines are long enough
+ * for the SIMD blocks of the 8-bit passes and their scalar tails.
+ */
+static MunitResult test_stretch_lines(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const enum SailPixelFormat pixel_formats[] = {
+        SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+        SAIL_PIXEL_FORMAT_BPP24_RGB,
+        SAIL_PIXEL_FORMAT_BPP32_RGBX,
+    };
+
+    for (size_t i = 0; i < sizeof(pixel_formats) / sizeof(pixel_formats[0]); i++) {
+        const unsigned bytes_per_pixel = sail_bits_per_pixel(pixel_formats[i]) / 8;
+
+        /* Identical rows. */
+        struct sail_image *image = create_random_image(37, 5, pixel_formats[i]);
+
+        for (unsigned row = 1; row < image->height; row++) {
+            memcpy((uint8_t *)image->pixels + (size_t)image->bytes_per_line * row, image->pixels, image->bytes_per_line);
+        }
+
+        for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+            struct sail_image *image_output;
+            munit_assert(sail_scale_image(image, image->width, 23, ALGORITHMS[a], &image_output) == SAIL_OK);
+
+            for (unsigned row = 0; row < image_output->height; row++) {
+                munit_assert_memory_equal(image->bytes_per_line,
+                                          (const uint8_t *)image_output->pixels + (size_t)image_output->bytes_per_line * row,
+                                          image->pixels);
+            }
+
+            sail_destroy_image(image_output);
+        }
+
+        sail_destroy_image(image);
+
+        /* Identical columns. */
+        image = create_random_image(5, 37, pixel_formats[i]);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            uint8_t *scan = (uint8_t *)image->pixels + (size_t)image->bytes_per_line * row;
+
+            for (unsigned column = 1; column < image->width; column++) {
+                memcpy(scan + column * bytes_per_pixel, scan, bytes_per_pixel);
+            }
+        }
+
+        for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+            struct sail_image *image_output;
+            munit_assert(sail_scale_image(image, 41, image->height, ALGORITHMS[a], &image_output) == SAIL_OK);
+
+            for (unsigned row = 0; row < image_output->height; row++) {
+                const uint8_t *scan = (const uint8_t *)image_output->pixels + (size_t)image_output->bytes_per_line * row;
+
+                for (unsigned column = 0; column < image_output->width; column++) {
+                    munit_assert_memory_equal(bytes_per_pixel, scan + column * bytes_per_pixel,
+                                              (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * row);
+                }
+            }
+
+            sail_destroy_image(image_output);
+        }
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_box(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const uint8_t pixels[] = {
+        0,   2,   10,  20,
+        4,   6,   30,  40,
+        100, 100, 255, 255,
+        200, 200, 255, 255,
+    };
+
+    /* Averages of 2x2 blocks. */
+    static const uint8_t expected[] = {
+        3,   25,
+        150, 255,
+    };
+
+    struct sail_image *image = create_image(4, 4, SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE);
+    memcpy(image->pixels, pixels, sizeof(pixels));
+
+    struct sail_image *image_output;
+    munit_assert(sail_scale_image(image, 2, 2, SAIL_SCALING_BOX, &image_output) == SAIL_OK);
+    munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+    sail_destroy_image(image_output);
+
+    /* Upscaling replicates pixels. */
+    munit_assert(sail_scale_image(image, 8, 8, SAIL_SCALING_BOX, &image_output) == SAIL_OK);
+    for (unsigned row = 0; row < 8; row++) {
+        for (unsigned column = 0; column < 8; column++) {
+            munit_assert_uint8(((const uint8_t *)image_output->pixels)[row * 8 + column], ==, pixels[row / 2 * 4 + column / 2]);
+        }
+    }
+    sail_destroy_image(image_output);
+
+    sail_destroy_image(image);
+
+    /* Large factors reduce blocks of pixels first. */
+    static const uint16_t quadrants[] = { 10, 20000, 300, 65535 };
+
+    image = create_image(48, 36, SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE);
+    for (unsigned row = 0; row < image->height; row++) {
+        for (unsigned column = 0; column < image->width; column++) {
+            ((uint16_t *)image->pixels)[row * image->width + column] = quadrants[row / 18 * 2 + column / 24];
+        }
+    }
+
+    munit_assert(sail_scale_image(image, 2, 2, SAIL_SCALING_BOX, &image_output) == SAIL_OK);
+    munit_assert_memory_equal(sizeof(quadrants), image_output->pixels, quadrants);
+    sail_destroy_image(image_output);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_bilinear(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const uint16_t pixels[] = { 0, 1000 };
+
+    struct sail_image *image = create_image(2, 1, SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE);
+    memcpy(image->pixels, pixels, sizeof(pixels));
+
+    /* Output pixel centers at 0.25 and 0.75 of the input pixels distance, edges are clamped. */
+    static const uint16_t expected[] = { 0, 250, 750, 1000 };
+
+    struct sail_image *image_output;
+    munit_assert(sail_scale_image(image, 4, 1, SAIL_SCALING_BILINEAR, &image_output) == SAIL_OK);
+    munit_assert_memory_equal(sizeof(expected), image_output->pixels, expected);
+    sail_destroy_image(image_output);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+/*
+ * An opaque white square inside a transparent black border. Transparent pixels must not bleed
+ * their color into the square, so all visible pixels stay white.
+ */
+static MunitResult test_transparent_border(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    static const struct {
+        enum SailPixelFormat pixel_format;
+        unsigned components;
+        unsigned alpha;
+    } formats[] = {
+        { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA, 2, 1 },
+        { SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA, 2, 1 },
+        { SAIL_PIXEL_FORMAT_BPP32_ARGB,            4, 0 },
+        { SAIL_PIXEL_FORMAT_BPP64_RGBA,            4, 3 },
+    };
+
+    static const unsigned dimensions[][2] = { { 3, 3 }, { 5, 7 }, { 13, 13 }, { 40, 30 } };
+
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        const unsigned components = formats[i].components;
+        const bool is16 = sail_bits_per_pixel(formats[i].pixel_format) / components == 16;
+        const unsigned max = is16 ? 65535 : 255;
+
+        struct sail_image *image = create_image(16, 12, formats[i].pixel_format);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            for (unsigned column = 0; column < image->width; column++) {
+                const bool inside = row >= 4 && row < 8 && column >= 4 && column < 12;
+
+                for (unsigned c = 0; c < components; c++) {
+                    const unsigned value = inside ? max : 0;
+                    const size_t index = ((size_t)row * image->width + column) * components + c;
+
+                    if (is16) {
+                        ((uint16_t *)image->pixels)[index] = (uint16_t)value;
+                    } else {
+                        ((uint8_t *)image->pixels)[index] = (uint8_t)value;
+                    }
+                }
+            }
+        }
+
+        for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+            for (size_t d = 0; d < sizeof(dimensions) / sizeof(dimensions[0]); d++) {
+                struct sail_image *image_output;
+                munit_assert(sail_scale_image(image, dimensions[d][0], dimensions[d][1], ALGORITHMS[a], &image_output) == SAIL_OK);
+
+                unsigned visible = 0;
+
+                for (size_t k = 0; k < (size_t)image_output->width * image_output->height; k++) {
+                    const size_t pixel = k * components;
+                    const unsigned alpha = is16 ? ((const uint16_t *)image_output->pixels)[pixel + formats[i].alpha]
+                                                : ((const uint8_t *)image_output->pixels)[pixel + formats[i].alpha];
+
+                    if (alpha > 0) {
+                        visible++;
+                    }
+
+                    for (unsigned c = 0; c < components; c++) {
+                        if (c == formats[i].alpha) {
+                            continue;
+                        }
+
+                        const unsigned value = is16 ? ((const uint16_t *)image_output->pixels)[pixel + c]
+                                                    : ((const uint8_t *)image_output->pixels)[pixel + c];
+                        munit_assert_uint(value, ==, (alpha > 0) ? max : 0);
+                    }
+                }
+
+                munit_assert_uint(visible, >, 0);
+
+                sail_destroy_image(image_output);
+            }
+        }
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_same_size(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+        struct sail_image *image = create_random_image(13, 11, SAIL_PIXEL_FORMAT_BPP24_BGR);
+
+        struct sail_image *image_output;
+        munit_assert(sail_scale_image(image, image->width, image->height, ALGORITHMS[a], &image_output) == SAIL_OK);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image_output->pixels, image->pixels);
+        sail_destroy_image(image_output);
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_threads(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_conversion_options *options;
+    munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+
+    /* Large enough to be split into several bands with an uneven number of rows. */
+    static const unsigned dimensions[][2] = { { 300, 203 }, { 1500, 1021 }, { 100, 60 } };
+
+    for (size_t i = 0; i < PIXEL_FORMATS_LENGTH; i += 3) {
+        struct sail_image *image = create_random_image(640, 480, PIXEL_FORMATS[i]);
+
+        for (size_t a = 0; a < ALGORITHMS_LENGTH; a++) {
+            for (size_t d = 0; d < sizeof(dimensions) / sizeof(dimensions[0]); d++) {
+                struct sail_image *expected;
+                options->threads = 1;
+                munit_assert(sail_scale_image_with_options(image, dimensions[d][0], dimensions[d][1], ALGORITHMS[a], options, &expected) == SAIL_OK);
+
+                struct sail_image *image_output;
+                options->threads = 8;
+                munit_assert(sail_scale_image_with_options(image, dimensions[d][0], dimensions[d][1], ALGORITHMS[a], options, &image_output) == SAIL_OK);
+                munit_assert_memory_equal((size_t)expected->bytes_per_line * expected->height, image_output->pixels, expected->pixels);
+
+                sail_destroy_image(image_output);
+                sail_destroy_image(expected);
+            }
+        }
+
+        sail_destroy_image(image);
+    }
+
+    sail_destroy_conversion_options(options);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/formats",            test_formats,            NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/flat",               test_flat,               NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/stretch-lines",      test_stretch_lines,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/box",                test_box,                NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/bilinear",           test_bilinear,           NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/transparent-border", test_transparent_border, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/same-size",          test_same_size,          NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/threads",            test_threads,            NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/scale",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
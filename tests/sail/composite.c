@@ -0,0 +1,119 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+/*
+ * A 4x1 BPP32-RGBA APNG. The second frame is composited over the first one with APNG_BLEND_OP_OVER.
+ */
+static const uint8_t APNG_BLEND_OVER[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+    0x08, 0x06, 0x00, 0x00, 0x00, 0xf9, 0x3c, 0x0f, 0xcd, 0x00, 0x00, 0x00,
+    0x08, 0x61, 0x63, 0x54, 0x4c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0xf3, 0x8d, 0x93, 0x70, 0x00, 0x00, 0x00, 0x1a, 0x66, 0x63, 0x54,
+    0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x0a, 0x00, 0x00, 0x64, 0xf5, 0xbd, 0x6a, 0x00, 0x00, 0x00, 0x19, 0x49,
+    0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0x38, 0x91, 0x62, 0xf4, 0x9f, 0x81,
+    0xe1, 0xff, 0x7f, 0x2e, 0x11, 0xb9, 0xff, 0x51, 0x51, 0x51, 0xff, 0x01,
+    0x3f, 0xbd, 0x07, 0xa4, 0x24, 0xa0, 0xe9, 0xde, 0x00, 0x00, 0x00, 0x1a,
+    0x66, 0x63, 0x54, 0x4c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x0a, 0x00, 0x01, 0x88, 0x81, 0x67, 0x28, 0x00, 0x00,
+    0x00, 0x1d, 0x66, 0x64, 0x41, 0x54, 0x00, 0x00, 0x00, 0x02, 0x78, 0x9c,
+    0x63, 0x60, 0xf8, 0xcf, 0xd0, 0xf0, 0x9f, 0x81, 0xc1, 0x41, 0x23, 0xa0,
+    0xe2, 0x3f, 0x23, 0x13, 0x33, 0x03, 0x00, 0x2f, 0x01, 0x04, 0xb4, 0x52,
+    0x1f, 0x04, 0x95, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+    0x42, 0x60, 0x82,
+};
+
+static const uint8_t APNG_FIRST_FRAME[] = {
+    200, 100, 50, 255,   0, 0, 255, 255,   10, 20, 30, 255,   90, 90, 90, 255,
+};
+
+/* The second frame is (0,255,0,128), (255,0,0,64), (40,80,120,255), (1,2,3,0). */
+static const uint8_t APNG_SECOND_FRAME_COMPOSITED[] = {
+    99, 177, 24, 255,    64, 0, 191, 255,   40, 80, 120, 255,   90, 90, 90, 255,
+};
+
+static MunitResult test_apng_blend_over(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("png", &codec_info) == SAIL_OK);
+
+    void *state = NULL;
+    munit_assert(sail_start_loading_from_memory(APNG_BLEND_OVER, sizeof(APNG_BLEND_OVER), codec_info, &state) == SAIL_OK);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(image->width == 4);
+    munit_assert(image->height == 1);
+    munit_assert(image->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA);
+    munit_assert_memory_equal(sizeof(APNG_FIRST_FRAME), image->pixels, APNG_FIRST_FRAME);
+    sail_destroy_image(image);
+
+    /* libpng without the APNG patch reads the default image only. */
+    const struct sail_codec_info *apng_codec_info;
+    if (sail_codec_info_from_extension("apng", &apng_codec_info) != SAIL_OK) {
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+        return MUNIT_SKIP;
+    }
+
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(image->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA);
+    munit_assert_memory_equal(sizeof(APNG_SECOND_FRAME_COMPOSITED), image->pixels, APNG_SECOND_FRAME_COMPOSITED);
+    sail_destroy_image(image);
+
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_ERROR_NO_MORE_FRAMES);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/apng-blend-over", test_apng_blend_over, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/composite",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
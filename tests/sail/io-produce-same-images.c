@@ -24,13 +24,16 @@
 */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "sail.h"
+#include "sail-manip.h"
 
 #include "sail-comparators.h"
 
 #include "munit.h"
 
+#include "test-helpers.h"
 #include "test-images.h"
 
 static MunitResult test_io_produce_same_images(const MunitParameter params[], void *user_data) {
@@ -63,20 +66,390 @@ static MunitResult test_io_produce_same_images(const MunitParameter params[], vo
 
     munit_assert(sail_test_compare_images(image_file, image_mem) == SAIL_OK);
 
+    /* Load with stdio file I/O. sail_load_from_file() maps files into memory. */
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_file(path, &io) == SAIL_OK);
+    munit_assert(sail_start_loading_from_io(io, codec_info, &state) == SAIL_OK);
+
+    struct sail_image *image_stdio = NULL;
+    munit_assert(sail_load_next_frame(state, &image_stdio) == SAIL_OK);
+    munit_assert_not_null(image_stdio);
+
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+    sail_destroy_io(io);
+
+    munit_assert(sail_test_compare_images(image_file, image_stdio) == SAIL_OK);
+
     sail_free(data);
+    sail_destroy_image(image_stdio);
     sail_destroy_image(image_mem);
     sail_destroy_image(image_file);
 
     return MUNIT_OK;
 }
 
+static MunitResult test_io_mmap_contiguous(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    void *data;
+    size_t data_length;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_length) == SAIL_OK);
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_mmap(path, &io) == SAIL_OK);
+    munit_assert(sail_check_io_valid(io) == SAIL_OK);
+    munit_assert(io->features & SAIL_IO_FEATURE_CONTIGUOUS);
+
+    /* Skip some bytes to check the position is respected. */
+    const size_t offset = data_length / 2;
+    munit_assert(io->seek(io->stream, (long)offset, SEEK_SET) == SAIL_OK);
+
+    const void *borrowed_data;
+    size_t borrowed_data_length;
+    void *data_to_free;
+    munit_assert(sail_borrow_data_from_io_contents(io, &borrowed_data, &borrowed_data_length, &data_to_free) == SAIL_OK);
+
+    munit_assert_null(data_to_free);
+    munit_assert(borrowed_data_length == data_length - offset);
+    munit_assert_memory_equal(borrowed_data_length, borrowed_data, (const char *)data + offset);
+
+    /* The position must not change. */
+    size_t position;
+    munit_assert(io->tell(io->stream, &position) == SAIL_OK);
+    munit_assert(position == offset);
+
+    sail_destroy_io(io);
+    sail_free(data);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_io_memory_contiguous(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    void *data;
+    size_t data_length;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_length) == SAIL_OK);
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_memory(data, data_length, &io) == SAIL_OK);
+    munit_assert(sail_check_io_valid(io) == SAIL_OK);
+    munit_assert(io->features & SAIL_IO_FEATURE_CONTIGUOUS);
+
+    const size_t offset = data_length / 2;
+    munit_assert(io->seek(io->stream, (long)offset, SEEK_SET) == SAIL_OK);
+
+    const void *borrowed_data;
+    size_t borrowed_data_length;
+    void *data_to_free;
+    munit_assert(sail_borrow_data_from_io_contents(io, &borrowed_data, &borrowed_data_length, &data_to_free) == SAIL_OK);
+
+    /* No copy must be made. */
+    munit_assert_null(data_to_free);
+    munit_assert_ptr_equal(borrowed_data, (const char *)data + offset);
+    munit_assert(borrowed_data_length == data_length - offset);
+
+    sail_destroy_io(io);
+    sail_free(data);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_io_dynamic_memory(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_write_dynamic_memory(&io) == SAIL_OK);
+    munit_assert(sail_check_io_valid(io) == SAIL_OK);
+
+    /* Write enough to grow the buffer several times. */
+    unsigned char chunk[1000];
+    const size_t chunks = 300;
+
+    for (size_t i = 0; i < chunks; i++) {
+        memset(chunk, (int)(i & 0xff), sizeof(chunk));
+        munit_assert(io->strict_write(io->stream, chunk, sizeof(chunk)) == SAIL_OK);
+    }
+
+    /* Overwrite the beginning. */
+    const unsigned char marker = 0xAB;
+    munit_assert(io->seek(io->stream, 0, SEEK_SET) == SAIL_OK);
+    munit_assert(io->strict_write(io->stream, &marker, 1) == SAIL_OK);
+
+    /* Write past the end leaving a zeroed gap. */
+    munit_assert(io->seek(io->stream, 10, SEEK_END) == SAIL_OK);
+    munit_assert(io->strict_write(io->stream, &marker, 1) == SAIL_OK);
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_take_buffer_from_dynamic_memory_io(io, &buffer, &buffer_length) == SAIL_OK);
+    munit_assert(buffer_length == chunks * sizeof(chunk) + 11);
+
+    const unsigned char *bytes = buffer;
+    munit_assert_uint8(bytes[0], ==, marker);
+    munit_assert_uint8(bytes[1], ==, 0);
+    munit_assert_uint8(bytes[chunks * sizeof(chunk) - 1], ==, (chunks - 1) & 0xff);
+    munit_assert_uint8(bytes[chunks * sizeof(chunk)], ==, 0);
+    munit_assert_uint8(bytes[buffer_length - 1], ==, marker);
+
+    sail_free(buffer);
+
+    /* The I/O object is empty after taking the buffer. */
+    munit_assert(sail_take_buffer_from_dynamic_memory_io(io, &buffer, &buffer_length) == SAIL_OK);
+    munit_assert_null(buffer);
+    munit_assert(buffer_length == 0);
+
+    sail_destroy_io(io);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_save_dynamic_memory(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    bool can_save = false;
+
+    for (unsigned i = 0; i < codec_info->save_features->pixel_formats_length; i++) {
+        if (codec_info->save_features->pixel_formats[i] == image->pixel_format) {
+            can_save = true;
+            break;
+        }
+    }
+
+    if (!can_save) {
+        sail_destroy_image(image);
+        return MUNIT_SKIP;
+    }
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+    munit_assert_not_null(buffer);
+    munit_assert(buffer_length > 0);
+
+    struct sail_image *image_mem = NULL;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &image_mem) == SAIL_OK);
+
+    munit_assert(image_mem->width == image->width);
+    munit_assert(image_mem->height == image->height);
+    munit_assert(image_mem->pixel_format == image->pixel_format);
+    munit_assert(image_mem->bytes_per_line == image->bytes_per_line);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image_mem->pixels, image->pixels);
+
+    sail_destroy_image(image_mem);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_into_buffer(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_file = NULL;
+    munit_assert(sail_load_from_file(path, &image_file) == SAIL_OK);
+
+    /* Pad scan lines. */
+    const unsigned bytes_per_line = image_file->bytes_per_line + 3;
+    const size_t pixels_size = (size_t)bytes_per_line * image_file->height;
+
+    void *pixels;
+    munit_assert(sail_malloc(pixels_size, &pixels) == SAIL_OK);
+
+    void *state;
+    munit_assert(sail_start_loading_from_file(path, NULL, &state) == SAIL_OK);
+
+    /* Too small buffers are rejected. */
+    struct sail_image *image_into = NULL;
+    munit_assert(sail_load_next_frame_into(state, pixels, pixels_size - 1, bytes_per_line, &image_into) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(sail_start_loading_from_file(path, NULL, &state) == SAIL_OK);
+    munit_assert(sail_load_next_frame_into(state, pixels, pixels_size, bytes_per_line, &image_into) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert_null(image_into->pixels);
+    munit_assert(image_into->bytes_per_line == bytes_per_line);
+    munit_assert(image_into->width == image_file->width);
+    munit_assert(image_into->height == image_file->height);
+
+    for (unsigned row = 0; row < image_file->height; row++) {
+        munit_assert_memory_equal(image_file->bytes_per_line,
+                                  (const char *)pixels + (size_t)row * bytes_per_line,
+                                  (const char *)image_file->pixels + (size_t)row * image_file->bytes_per_line);
+    }
+
+    sail_destroy_image(image_into);
+    sail_free(pixels);
+    sail_destroy_image(image_file);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_output_pixel_format(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+    const enum SailPixelFormat output_pixel_format = sail_pixel_format_from_string(munit_parameters_get(params, "output-pixel-format"));
+
+    struct sail_image *image_file = NULL;
+    munit_assert(sail_load_from_file(path, &image_file) == SAIL_OK);
+
+    /* Frames already in the requested pixel format are loaded as is. */
+    struct sail_image *image_expected = NULL;
+
+    if (image_file->pixel_format == output_pixel_format) {
+        munit_assert(sail_copy_image(image_file, &image_expected) == SAIL_OK);
+    } else if (sail_convert_image(image_file, output_pixel_format, &image_expected) != SAIL_OK) {
+        sail_destroy_image(image_file);
+        return MUNIT_SKIP;
+    }
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->output_pixel_format = output_pixel_format;
+
+    /* Allocated pixels. */
+    void *state;
+    munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(image->pixel_format == output_pixel_format);
+    munit_assert(image->bytes_per_line == image_expected->bytes_per_line);
+    munit_assert_null(image->palette);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, image_expected->pixels);
+
+    /* Caller's pixels with padded scan lines. */
+    const unsigned bytes_per_line = image_expected->bytes_per_line + 5;
+    const size_t pixels_size = (size_t)bytes_per_line * image_expected->height;
+
+    void *pixels;
+    munit_assert(sail_malloc(pixels_size, &pixels) == SAIL_OK);
+
+    munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+
+    struct sail_image *image_into = NULL;
+    munit_assert(sail_load_next_frame_into(state, pixels, pixels_size, bytes_per_line, &image_into) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(image_into->pixel_format == output_pixel_format);
+    munit_assert(image_into->bytes_per_line == bytes_per_line);
+
+    for (unsigned row = 0; row < image_expected->height; row++) {
+        munit_assert_memory_equal(image_expected->bytes_per_line,
+                                  (const char *)pixels + (size_t)row * bytes_per_line,
+                                  (const char *)image_expected->pixels + (size_t)row * image_expected->bytes_per_line);
+    }
+
+    sail_destroy_image(image_into);
+    sail_free(pixels);
+    sail_destroy_image(image);
+    sail_destroy_load_options(load_options);
+    sail_destroy_image(image_expected);
+    sail_destroy_image(image_file);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_rows(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_file = NULL;
+    munit_assert(sail_load_from_file(path, &image_file) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    /* Stdio file I/O to check codecs seeking to scan lines. */
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_file(path, &io) == SAIL_OK);
+
+    void *state;
+    munit_assert(sail_start_loading_from_io(io, codec_info, &state) == SAIL_OK);
+    test_read_rows_and_compare(state, image_file);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    sail_destroy_io(io);
+
+    /* Scan lines converted to the requested pixel format. */
+    struct sail_image *image_expected = NULL;
+
+    if (image_file->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA) {
+        munit_assert(sail_copy_image(image_file, &image_expected) == SAIL_OK);
+    } else if (sail_convert_image(image_file, SAIL_PIXEL_FORMAT_BPP32_RGBA, &image_expected) != SAIL_OK) {
+        sail_destroy_image(image_file);
+        return MUNIT_OK;
+    }
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->output_pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+
+    munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+    test_read_rows_and_compare(state, image_expected);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    sail_destroy_load_options(load_options);
+    sail_destroy_image(image_expected);
+    sail_destroy_image(image_file);
+
+    return MUNIT_OK;
+}
+
+static char *output_pixel_formats[] = {
+    (char *)"BPP8-GRAYSCALE",
+    (char *)"BPP24-RGB",
+    (char *)"BPP24-BGR",
+    (char *)"BPP32-RGBA",
+    (char *)"BPP32-ARGB",
+    (char *)"BPP32-BGRX",
+    (char *)"BPP32-XBGR",
+    NULL,
+};
+
 static MunitParameterEnum test_params[] = {
     { (char *)"path", (char **)SAIL_TEST_IMAGES },
     { NULL, NULL },
 };
 
+static MunitParameterEnum output_pixel_format_params[] = {
+    { (char *)"path",                (char **)SAIL_TEST_IMAGES },
+    { (char *)"output-pixel-format", output_pixel_formats },
+    { NULL, NULL },
+};
+
 static MunitTest test_suite_tests[] = {
-    { (char *)"/io-produce-same-images", test_io_produce_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/io-produce-same-images",   test_io_produce_same_images,   NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/io-mmap-contiguous",       test_io_mmap_contiguous,       NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/io-memory-contiguous",     test_io_memory_contiguous,     NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/io-dynamic-memory",        test_io_dynamic_memory,        NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/save-dynamic-memory",      test_save_dynamic_memory,      NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/load-into-buffer",         test_load_into_buffer,         NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/load-output-pixel-format", test_load_output_pixel_format, NULL, NULL, MUNIT_TEST_OPTION_NONE, output_pixel_format_params },
+    { (char *)"/load-rows",                test_load_rows,                NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
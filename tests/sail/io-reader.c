@@ -0,0 +1,135 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdio.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#define DATA_SIZE (3 * SAIL_IO_READER_BUFFER_SIZE + 17)
+
+static unsigned char data_at(size_t i) {
+    return (unsigned char)(i * 31 + 7);
+}
+
+static MunitResult test_io_reader(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned char *data;
+    munit_assert(sail_malloc(DATA_SIZE, (void **)&data) == SAIL_OK);
+
+    for (size_t i = 0; i < DATA_SIZE; i++) {
+        data[i] = data_at(i);
+    }
+
+    /* Test both the zero-copy and the read-ahead modes. */
+    for (int contiguous = 0; contiguous <= 1; contiguous++) {
+        struct sail_io *io;
+        munit_assert(sail_alloc_io_read_memory(data, DATA_SIZE, &io) == SAIL_OK);
+
+        if (!contiguous) {
+            io->features &= ~SAIL_IO_FEATURE_CONTIGUOUS;
+        }
+
+        struct sail_io_reader *reader;
+        munit_assert(sail_alloc_io_reader(io, &reader) == SAIL_OK);
+
+        /* Small reads. */
+        for (size_t i = 0; i < 10; i++) {
+            uint8_t value;
+            munit_assert(sail_io_reader_read_u8(reader, &value) == SAIL_OK);
+            munit_assert_uint8(value, ==, data_at(i));
+        }
+
+        uint16_t value16;
+        munit_assert(sail_io_reader_read_u16_le(reader, &value16) == SAIL_OK);
+        munit_assert_uint16(value16, ==, data_at(10) | (data_at(11) << 8));
+
+        uint32_t value32;
+        munit_assert(sail_io_reader_read_u32_be(reader, &value32) == SAIL_OK);
+        munit_assert_uint32(value32, ==, ((uint32_t)data_at(12) << 24) | ((uint32_t)data_at(13) << 16) | ((uint32_t)data_at(14) << 8) | data_at(15));
+
+        /* Seek back within the window. */
+        munit_assert(sail_io_reader_seek(reader, -2, SEEK_CUR) == SAIL_OK);
+        munit_assert(sail_io_reader_read_u16_be(reader, &value16) == SAIL_OK);
+        munit_assert_uint16(value16, ==, (data_at(14) << 8) | data_at(15));
+
+        /* A read crossing the window boundary. */
+        const size_t large_size = 2 * SAIL_IO_READER_BUFFER_SIZE;
+        unsigned char *large;
+        munit_assert(sail_malloc(large_size, (void **)&large) == SAIL_OK);
+        munit_assert(sail_io_reader_strict_read(reader, large, large_size) == SAIL_OK);
+        munit_assert_memory_equal(large_size, large, data + 16);
+        sail_free(large);
+
+        /* Sync and use the I/O object directly. */
+        munit_assert(sail_io_reader_sync(reader) == SAIL_OK);
+
+        size_t position;
+        munit_assert(io->tell(io->stream, &position) == SAIL_OK);
+        munit_assert(position == 16 + large_size);
+
+        uint8_t value;
+        munit_assert(io->strict_read(io->stream, &value, 1) == SAIL_OK);
+        munit_assert_uint8(value, ==, data_at(position));
+
+        /* The reader continues from the I/O position. */
+        munit_assert(sail_io_reader_read_u8(reader, &value) == SAIL_OK);
+        munit_assert_uint8(value, ==, data_at(position + 1));
+
+        /* Reading past the end must fail. */
+        munit_assert(sail_io_reader_seek(reader, DATA_SIZE - 1, SEEK_SET) == SAIL_OK);
+        munit_assert(sail_io_reader_read_u8(reader, &value) == SAIL_OK);
+        munit_assert_uint8(value, ==, data_at(DATA_SIZE - 1));
+        munit_assert(sail_io_reader_read_u8(reader, &value) != SAIL_OK);
+
+        sail_destroy_io_reader(reader);
+        sail_destroy_io(io);
+    }
+
+    sail_free(data);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/read", test_io_reader, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/io-reader",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
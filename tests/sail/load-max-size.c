@@ -0,0 +1,105 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-helpers.h"
+#include "test-images.h"
+
+static MunitResult test_load_max_size(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    /* JPEG decodes frames at a reduced resolution natively. */
+    void *buffer;
+    size_t buffer_length;
+    const struct sail_codec_info *codec_info;
+    test_transcode_file_into_memory(path, "jpeg", &buffer, &buffer_length, &codec_info);
+
+    struct sail_image *image_full = NULL;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &image_full) == SAIL_OK);
+    munit_assert(image_full->source_image->width == image_full->width);
+    munit_assert(image_full->source_image->height == image_full->height);
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->max_width  = (image_full->width + 3) / 4;
+    load_options->max_height = (image_full->height + 3) / 4;
+
+    void *state = NULL;
+    munit_assert(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, &state) == SAIL_OK);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(image->width >= load_options->max_width);
+    munit_assert(image->height >= load_options->max_height);
+    munit_assert(image->width <= image_full->width);
+    munit_assert(image->height <= image_full->height);
+    munit_assert(image->source_image->width == image_full->width);
+    munit_assert(image->source_image->height == image_full->height);
+
+    /* Scaled down at least twice with DCT scaling. */
+    if (image_full->width >= 8 && image_full->height >= 8) {
+        munit_assert(image->width <= (image_full->width + 1) / 2);
+        munit_assert(image->height <= (image_full->height + 1) / 2);
+    }
+
+    sail_destroy_image(image);
+    sail_destroy_load_options(load_options);
+    sail_destroy_image(image_full);
+    sail_free(buffer);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/load-max-size", test_load_max_size, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/load-max-size",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,179 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+#include "test-helpers.h"
+#include "test-images.h"
+
+static void crop_image(const struct sail_image *image, unsigned x, unsigned y, unsigned width, unsigned height, struct sail_image **image_cropped) {
+
+    struct sail_image *image_local;
+    munit_assert(sail_alloc_image(&image_local) == SAIL_OK);
+
+    image_local->width          = width;
+    image_local->height         = height;
+    image_local->pixel_format   = image->pixel_format;
+    image_local->bytes_per_line = sail_bytes_per_line(width, image->pixel_format);
+
+    munit_assert(sail_malloc((size_t)image_local->bytes_per_line * height, &image_local->pixels) == SAIL_OK);
+
+    for (unsigned row = 0; row < height; row++) {
+        sail_crop_scan_line((const char *)image->pixels + (size_t)(y + row) * image->bytes_per_line,
+                            image->pixel_format,
+                            x,
+                            width,
+                            (char *)image_local->pixels + (size_t)row * image_local->bytes_per_line);
+    }
+
+    *image_cropped = image_local;
+}
+
+static void load_roi_and_compare(const char *path, const void *buffer, size_t buffer_length, const struct sail_codec_info *codec_info) {
+
+    struct sail_image *image_full = NULL;
+
+    if (path != NULL) {
+        munit_assert(sail_load_from_file(path, &image_full) == SAIL_OK);
+    } else {
+        munit_assert(sail_load_from_memory(buffer, buffer_length, &image_full) == SAIL_OK);
+    }
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->roi_x      = image_full->width / 4;
+    load_options->roi_y      = image_full->height / 3;
+    load_options->roi_width  = (image_full->width + 1) / 2;
+    load_options->roi_height = (image_full->height + 1) / 2;
+    /* Ignored. */
+    load_options->max_width  = 1;
+    load_options->max_height = 1;
+
+    struct sail_image *image_expected = NULL;
+    crop_image(image_full,
+               load_options->roi_x, load_options->roi_y,
+               load_options->roi_width, load_options->roi_height,
+               &image_expected);
+
+    /* Whole frames. */
+    void *state = NULL;
+
+    if (path != NULL) {
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+    } else {
+        munit_assert(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, &state) == SAIL_OK);
+    }
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(image->width == image_expected->width);
+    munit_assert(image->height == image_expected->height);
+    munit_assert(image->pixel_format == image_expected->pixel_format);
+    munit_assert(image->bytes_per_line == image_expected->bytes_per_line);
+    munit_assert(image->source_image->width == image_full->width);
+    munit_assert(image->source_image->height == image_full->height);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, image_expected->pixels);
+
+    sail_destroy_image(image);
+
+    /* Scan lines. */
+    if (path != NULL) {
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+    } else {
+        munit_assert(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, &state) == SAIL_OK);
+    }
+
+    test_read_rows_and_compare(state, image_expected);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    /* No intersection. */
+    load_options->roi_x = image_full->width;
+
+    if (path != NULL) {
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+    } else {
+        munit_assert(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, &state) == SAIL_OK);
+    }
+
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    sail_destroy_image(image_expected);
+    sail_destroy_load_options(load_options);
+    sail_destroy_image(image_full);
+}
+
+static MunitResult test_load_roi(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const struct sail_codec_info *input_codec_info;
+    munit_assert(sail_codec_info_from_path(path, &input_codec_info) == SAIL_OK);
+
+    load_roi_and_compare(path, NULL, 0, input_codec_info);
+
+    /* JPEG decodes regions natively. */
+    void *buffer;
+    size_t buffer_length;
+    const struct sail_codec_info *output_codec_info;
+    test_transcode_file_into_memory(path, "jpeg", &buffer, &buffer_length, &output_codec_info);
+
+    load_roi_and_compare(NULL, buffer, buffer_length, output_codec_info);
+
+    sail_free(buffer);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/load-roi", test_load_roi, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/load-roi",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,104 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+static MunitResult test_magic_number_from_path(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const struct sail_codec_info *codec_info_by_extension;
+    munit_assert(sail_codec_info_from_path(path, &codec_info_by_extension) == SAIL_OK);
+
+    /* Some formats like TGA have no magic numbers. */
+    if (codec_info_by_extension->magic_number_node == NULL) {
+        return MUNIT_SKIP;
+    }
+
+    const struct sail_codec_info *codec_info_by_magic_number;
+    munit_assert(sail_codec_info_by_magic_number_from_path(path, &codec_info_by_magic_number) == SAIL_OK);
+
+    munit_assert_ptr_equal(codec_info_by_magic_number, codec_info_by_extension);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_magic_number_unknown(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned char buffer[SAIL_MAGIC_BUFFER_SIZE];
+    memset(buffer, 0xEE, sizeof(buffer));
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_by_magic_number_from_memory(buffer, sizeof(buffer), &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_magic_number_too_short(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* PNG signature shorter than the magic buffer. */
+    const unsigned char buffer[] = { 0x89, 0x50, 0x4E, 0x47 };
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_by_magic_number_from_memory(buffer, sizeof(buffer), &codec_info) != SAIL_OK);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/from-path",   test_magic_number_from_path, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/unknown",     test_magic_number_unknown,   NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/too-short",   test_magic_number_too_short, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/magic-number",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,288 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+/* EXIF orientation values 1-8 in order. */
+static const enum SailOrientation ORIENTATIONS[] = {
+    SAIL_ORIENTATION_NORMAL,
+    SAIL_ORIENTATION_MIRRORED_HORIZONTALLY,
+    SAIL_ORIENTATION_ROTATED_180,
+    SAIL_ORIENTATION_MIRRORED_VERTICALLY,
+    SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270,
+    SAIL_ORIENTATION_ROTATED_90,
+    SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90,
+    SAIL_ORIENTATION_ROTATED_270,
+};
+
+static const size_t ORIENTATIONS_LENGTH = sizeof(ORIENTATIONS) / sizeof(ORIENTATIONS[0]);
+
+/* A big-endian TIFF header with a single orientation entry in the first IFD. */
+static void fill_exif(unsigned char exif[26], unsigned orientation) {
+
+    const unsigned char tiff[26] = {
+        'M', 'M', 0, 42, 0, 0, 0, 8,
+        0, 1,
+        0x01, 0x12, 0, 3, 0, 0, 0, 1, 0, (unsigned char)orientation, 0, 0,
+        0, 0, 0, 0,
+    };
+
+    memcpy(exif, tiff, sizeof(tiff));
+}
+
+/* Inserts an APP1 segment with the EXIF profile after SOI. */
+static void insert_jpeg_exif(const unsigned char *data, size_t data_length, unsigned orientation,
+                             unsigned char **output, size_t *output_length) {
+
+    const size_t segment_length = 2 + 2 + 6 + 26;
+
+    void *ptr;
+    munit_assert(sail_malloc(data_length + segment_length, &ptr) == SAIL_OK);
+    unsigned char *output_local = ptr;
+
+    memcpy(output_local, data, 2);
+
+    unsigned char *segment = output_local + 2;
+    segment[0] = 0xFF;
+    segment[1] = 0xE1;
+    segment[2] = 0;
+    segment[3] = (unsigned char)(segment_length - 2);
+    memcpy(segment + 4, "Exif\0\0", 6);
+    fill_exif(segment + 10, orientation);
+
+    memcpy(output_local + 2 + segment_length, data + 2, data_length - 2);
+
+    *output        = output_local;
+    *output_length = data_length + segment_length;
+}
+
+static uint32_t png_crc(const unsigned char *data, size_t length) {
+
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+
+        for (unsigned k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+static void write_png_uint32(unsigned char *data, uint32_t value) {
+
+    data[0] = (unsigned char)(value >> 24);
+    data[1] = (unsigned char)(value >> 16);
+    data[2] = (unsigned char)(value >> 8);
+    data[3] = (unsigned char)value;
+}
+
+/* Inserts an eXIf chunk after the signature and IHDR. */
+static void insert_png_exif(const unsigned char *data, size_t data_length, unsigned orientation,
+                            unsigned char **output, size_t *output_length) {
+
+    const size_t header_length = 8 + 25;
+    const size_t chunk_length  = 4 + 4 + 26 + 4;
+
+    void *ptr;
+    munit_assert(sail_malloc(data_length + chunk_length, &ptr) == SAIL_OK);
+    unsigned char *output_local = ptr;
+
+    memcpy(output_local, data, header_length);
+
+    unsigned char *chunk = output_local + header_length;
+    write_png_uint32(chunk, 26);
+    memcpy(chunk + 4, "eXIf", 4);
+    fill_exif(chunk + 8, orientation);
+    write_png_uint32(chunk + 8 + 26, png_crc(chunk + 4, 4 + 26));
+
+    memcpy(output_local + header_length + chunk_length, data + header_length, data_length - header_length);
+
+    *output        = output_local;
+    *output_length = data_length + chunk_length;
+}
+
+/* Maps the upright pixel to the stored pixel. */
+static void map_upright_pixel(enum SailOrientation orientation, unsigned width, unsigned height,
+                              unsigned x, unsigned y, unsigned *stored_x, unsigned *stored_y) {
+
+    switch (orientation) {
+        case SAIL_ORIENTATION_NORMAL:                            *stored_x = x;             *stored_y = y;              break;
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY:             *stored_x = width - 1 - x; *stored_y = y;              break;
+        case SAIL_ORIENTATION_MIRRORED_VERTICALLY:               *stored_x = x;             *stored_y = height - 1 - y; break;
+        case SAIL_ORIENTATION_ROTATED_180:                       *stored_x = width - 1 - x; *stored_y = height - 1 - y; break;
+        case SAIL_ORIENTATION_ROTATED_90:                        *stored_x = y;             *stored_y = height - 1 - x; break;
+        case SAIL_ORIENTATION_ROTATED_270:                       *stored_x = width - 1 - y; *stored_y = x;              break;
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90:  *stored_x = width - 1 - y; *stored_y = height - 1 - x; break;
+        case SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270: *stored_x = y;             *stored_y = x;              break;
+    }
+}
+
+static void assert_upright(const struct sail_image *stored, const struct sail_image *upright, enum SailOrientation orientation) {
+
+    const bool swapped = orientation == SAIL_ORIENTATION_ROTATED_90 || orientation == SAIL_ORIENTATION_ROTATED_270 ||
+                            orientation == SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_90 ||
+                            orientation == SAIL_ORIENTATION_MIRRORED_HORIZONTALLY_ROTATED_270;
+
+    munit_assert(upright->width  == (swapped ? stored->height : stored->width));
+    munit_assert(upright->height == (swapped ? stored->width : stored->height));
+    munit_assert(upright->pixel_format == stored->pixel_format);
+
+    const unsigned bytes_per_pixel = sail_bits_per_pixel(stored->pixel_format) / 8;
+
+    for (unsigned y = 0; y < upright->height; y++) {
+        for (unsigned x = 0; x < upright->width; x++) {
+            unsigned stored_x, stored_y;
+            map_upright_pixel(orientation, stored->width, stored->height, x, y, &stored_x, &stored_y);
+
+            munit_assert_memory_equal(bytes_per_pixel,
+                                      (const unsigned char *)upright->pixels + (size_t)upright->bytes_per_line * y + (size_t)x * bytes_per_pixel,
+                                      (const unsigned char *)stored->pixels + (size_t)stored->bytes_per_line * stored_y + (size_t)stored_x * bytes_per_pixel);
+        }
+    }
+}
+
+static struct sail_image* load(const void *buffer, size_t buffer_length, const struct sail_codec_info *codec_info,
+                               int options, unsigned roi_width, unsigned roi_height) {
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->options   |= options;
+    load_options->roi_x      = (roi_width > 0) ? 1 : 0;
+    load_options->roi_y      = (roi_height > 0) ? 2 : 0;
+    load_options->roi_width  = roi_width;
+    load_options->roi_height = roi_height;
+
+    void *state = NULL;
+    munit_assert(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, &state) == SAIL_OK);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    sail_destroy_load_options(load_options);
+
+    return image;
+}
+
+static void test_codec(const char *extension, enum SailPixelFormat pixel_format,
+                       void (*insert_exif)(const unsigned char *, size_t, unsigned, unsigned char **, size_t *)) {
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension(extension, &codec_info) == SAIL_OK);
+    munit_assert(codec_info->load_features->features & SAIL_CODEC_FEATURE_EXIF_ORIENTATION);
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = 37;
+    image->height         = 23;
+    image->pixel_format   = pixel_format;
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    const size_t pixels_size = (size_t)image->bytes_per_line * image->height;
+    munit_assert(sail_malloc(pixels_size, &image->pixels) == SAIL_OK);
+
+    for (size_t i = 0; i < pixels_size; i++) {
+        ((unsigned char *)image->pixels)[i] = (unsigned char)munit_rand_uint32();
+    }
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    for (size_t i = 0; i < ORIENTATIONS_LENGTH; i++) {
+        unsigned char *exif_buffer;
+        size_t exif_buffer_length;
+        insert_exif(buffer, buffer_length, (unsigned)i + 1, &exif_buffer, &exif_buffer_length);
+
+        /* Scan lines are streamed from the codec. */
+        struct sail_image *stored = load(exif_buffer, exif_buffer_length, codec_info, 0, 0, 0);
+        struct sail_image *upright = load(exif_buffer, exif_buffer_length, codec_info, SAIL_OPTION_APPLY_ORIENTATION, 0, 0);
+
+        munit_assert(stored->source_image->orientation == ORIENTATIONS[i]);
+        munit_assert(upright->source_image->orientation == ORIENTATIONS[i]);
+        assert_upright(stored, upright, ORIENTATIONS[i]);
+
+        sail_destroy_image(upright);
+        sail_destroy_image(stored);
+
+        /* The region of interest is in the stored frame. */
+        stored = load(exif_buffer, exif_buffer_length, codec_info, 0, 30, 17);
+        upright = load(exif_buffer, exif_buffer_length, codec_info, SAIL_OPTION_APPLY_ORIENTATION, 30, 17);
+
+        assert_upright(stored, upright, ORIENTATIONS[i]);
+
+        sail_destroy_image(upright);
+        sail_destroy_image(stored);
+        sail_free(exif_buffer);
+    }
+
+    sail_free(buffer);
+    sail_destroy_image(image);
+}
+
+static MunitResult test_jpeg(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    test_codec("jpg", SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE, insert_jpeg_exif);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_png(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    test_codec("png", SAIL_PIXEL_FORMAT_BPP24_RGB, insert_png_exif);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/jpeg", test_jpeg, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/png",  test_png,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/orientation",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
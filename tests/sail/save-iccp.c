@@ -0,0 +1,95 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+static MunitResult test_jpeg_iccp(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("jpeg", &codec_info) == SAIL_OK);
+
+    if (!(codec_info->save_features->features & SAIL_CODEC_FEATURE_ICCP)) {
+        return MUNIT_SKIP;
+    }
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = 8;
+    image->height         = 8;
+    image->pixel_format   = SAIL_PIXEL_FORMAT_BPP24_RGB;
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    munit_assert(sail_calloc(1, (size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    /* JPEG doesn't validate ICC profiles. */
+    uint8_t profile[300];
+    for (unsigned i = 0; i < sizeof(profile); i++) {
+        profile[i] = (uint8_t)i;
+    }
+
+    munit_assert(sail_alloc_iccp_from_data(profile, sizeof(profile), &image->iccp) == SAIL_OK);
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    struct sail_image *image_loaded;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &image_loaded) == SAIL_OK);
+
+    munit_assert_not_null(image_loaded->iccp);
+    munit_assert(image_loaded->iccp->data_length == sizeof(profile));
+    munit_assert_memory_equal(sizeof(profile), image_loaded->iccp->data, profile);
+
+    sail_destroy_image(image_loaded);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/jpeg", test_jpeg_iccp, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/save-iccp",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,128 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+static void append_meta_data(struct sail_meta_data_node ***last_meta_data_node, enum SailMetaData key, const char *value) {
+
+    struct sail_meta_data_node *meta_data_node;
+    munit_assert(sail_alloc_meta_data_node(&meta_data_node) == SAIL_OK);
+    munit_assert(sail_alloc_meta_data_from_known_key(key, &meta_data_node->meta_data) == SAIL_OK);
+    munit_assert(sail_alloc_variant(&meta_data_node->meta_data->value) == SAIL_OK);
+
+    if (key == SAIL_META_DATA_IPTC) {
+        munit_assert(sail_set_variant_data(meta_data_node->meta_data->value, value, strlen(value) + 1) == SAIL_OK);
+    } else {
+        munit_assert(sail_set_variant_string(meta_data_node->meta_data->value, value) == SAIL_OK);
+    }
+
+    **last_meta_data_node = meta_data_node;
+    *last_meta_data_node = &meta_data_node->next;
+}
+
+static const struct sail_meta_data* find_meta_data(const struct sail_meta_data_node *meta_data_node, enum SailMetaData key) {
+
+    for (; meta_data_node != NULL; meta_data_node = meta_data_node->next) {
+        if (meta_data_node->meta_data->key == key) {
+            return meta_data_node->meta_data;
+        }
+    }
+
+    return NULL;
+}
+
+/* PNG saves every meta data entry as a text chunk, and hex encodes binary profiles. */
+static MunitResult test_png_text(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = 4;
+    image->height         = 4;
+    image->pixel_format   = SAIL_PIXEL_FORMAT_BPP24_RGB;
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    munit_assert(sail_calloc(1, (size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    struct sail_meta_data_node **last_meta_data_node = &image->meta_data_node;
+    append_meta_data(&last_meta_data_node, SAIL_META_DATA_ARTIST,      "Artist");
+    append_meta_data(&last_meta_data_node, SAIL_META_DATA_IPTC,        "IPTC");
+    append_meta_data(&last_meta_data_node, SAIL_META_DATA_COMMENT,     "Comment");
+    append_meta_data(&last_meta_data_node, SAIL_META_DATA_DESCRIPTION, "Description");
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("png", &codec_info) == SAIL_OK);
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    struct sail_image *image_loaded;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &image_loaded) == SAIL_OK);
+
+    static const enum SailMetaData string_keys[] = { SAIL_META_DATA_ARTIST, SAIL_META_DATA_COMMENT, SAIL_META_DATA_DESCRIPTION };
+    static const char * const string_values[] = { "Artist", "Comment", "Description" };
+
+    for (size_t i = 0; i < sizeof(string_keys) / sizeof(string_keys[0]); i++) {
+        const struct sail_meta_data *meta_data = find_meta_data(image_loaded->meta_data_node, string_keys[i]);
+        munit_assert_not_null(meta_data);
+        munit_assert_string_equal(sail_variant_to_string(meta_data->value), string_values[i]);
+    }
+
+    const struct sail_meta_data *iptc = find_meta_data(image_loaded->meta_data_node, SAIL_META_DATA_IPTC);
+    munit_assert_not_null(iptc);
+    munit_assert_memory_equal(4, sail_variant_to_data(iptc->value), "IPTC");
+
+    sail_destroy_image(image_loaded);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/png-text", test_png_text, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/save-meta-data",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,116 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+static sail_status_t copy_rows_from_image(unsigned first_row, void *rows, unsigned rows_count, void *user_data) {
+
+    const struct sail_image *image = user_data;
+
+    memcpy(rows, (const char *)image->pixels + (size_t)first_row * image->bytes_per_line, (size_t)rows_count * image->bytes_per_line);
+
+    return SAIL_OK;
+}
+
+static MunitResult test_save_rows(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    bool can_save = false;
+
+    for (unsigned i = 0; i < codec_info->save_features->pixel_formats_length; i++) {
+        if (codec_info->save_features->pixel_formats[i] == image->pixel_format) {
+            can_save = true;
+            break;
+        }
+    }
+
+    if (!can_save) {
+        sail_destroy_image(image);
+        return MUNIT_SKIP;
+    }
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    /* Written in bands of a few scan lines. */
+    void *state;
+    munit_assert(sail_start_saving_into_dynamic_memory(codec_info, &state) == SAIL_OK);
+    munit_assert(sail_write_next_frame_from_rows(state, image, 3, copy_rows_from_image, image) == SAIL_OK);
+
+    /* No scan lines left. */
+    munit_assert(sail_write_rows(state, image->pixels, 1) != SAIL_OK);
+
+    void *buffer_rows;
+    size_t buffer_rows_length;
+    munit_assert(sail_stop_saving_into_dynamic_memory(state, &buffer_rows, &buffer_rows_length) == SAIL_OK);
+
+    munit_assert(buffer_rows_length == buffer_length);
+    munit_assert_memory_equal(buffer_length, buffer_rows, buffer);
+
+    sail_free(buffer_rows);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/save-rows", test_save_rows, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/save-rows",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,91 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-helpers.h"
+
+void test_read_rows_and_compare(void *state, const struct sail_image *image_expected) {
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_start_frame_rows(state, &image) == SAIL_OK);
+
+    munit_assert_null(image->pixels);
+    munit_assert(image->width == image_expected->width);
+    munit_assert(image->height == image_expected->height);
+    munit_assert(image->pixel_format == image_expected->pixel_format);
+    munit_assert(image->bytes_per_line == image_expected->bytes_per_line);
+
+    const unsigned band_rows = 3;
+
+    void *rows;
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * band_rows, &rows) == SAIL_OK);
+
+    for (unsigned row = 0; row < image->height; row += band_rows) {
+        const unsigned rows_count = (image->height - row < band_rows) ? image->height - row : band_rows;
+
+        munit_assert(sail_read_rows(state, rows, rows_count) == SAIL_OK);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * rows_count,
+                                  rows,
+                                  (const char *)image_expected->pixels + (size_t)row * image->bytes_per_line);
+    }
+
+    /* No scan lines left. */
+    munit_assert(sail_read_rows(state, rows, 1) != SAIL_OK);
+
+    sail_free(rows);
+    sail_destroy_image(image);
+}
+
+void test_transcode_file_into_memory(const char *path, const char *extension,
+                                     void **buffer, size_t *buffer_length, const struct sail_codec_info **codec_info) {
+
+    const struct sail_codec_info *input_codec_info;
+    munit_assert(sail_codec_info_from_path(path, &input_codec_info) == SAIL_OK);
+
+    const struct sail_codec_info *output_codec_info;
+    munit_assert(sail_codec_info_from_extension(extension, &output_codec_info) == SAIL_OK);
+
+    struct sail_io *input_io;
+    munit_assert(sail_alloc_io_read_file(path, &input_io) == SAIL_OK);
+
+    struct sail_io *output_io;
+    munit_assert(sail_alloc_io_read_write_dynamic_memory(&output_io) == SAIL_OK);
+
+    size_t written;
+    munit_assert(sail_transcode_io(input_io, input_codec_info, output_io, output_codec_info, NULL, &written) == SAIL_OK);
+
+    munit_assert(sail_take_buffer_from_dynamic_memory_io(output_io, buffer, buffer_length) == SAIL_OK);
+    munit_assert(written == *buffer_length);
+
+    sail_destroy_io(output_io);
+    sail_destroy_io(input_io);
+
+    if (codec_info != NULL) {
+        *codec_info = output_codec_info;
+    }
+}
@@ -0,0 +1,47 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TEST_HELPERS_H
+#define SAIL_TEST_HELPERS_H
+
+#include <stddef.h>
+
+struct sail_codec_info;
+struct sail_image;
+
+/*
+ * Reads the frame in bands of a few scan lines with sail_read_rows() and compares them
+ * with the expected image. Fails the test on mismatches.
+ */
+void test_read_rows_and_compare(void *state, const struct sail_image *image_expected);
+
+/*
+ * Transcodes the file into a new buffer in the format with the specified file extension.
+ * Fails the test on errors. The buffer must be freed with sail_free().
+ */
+void test_transcode_file_into_memory(const char *path, const char *extension,
+                                     void **buffer, size_t *buffer_length, const struct sail_codec_info **codec_info);
+
+#endif
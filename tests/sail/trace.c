@@ -0,0 +1,268 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+#define MAX_EVENTS 1024
+
+struct events {
+    struct sail_trace_event events[MAX_EVENTS];
+    unsigned count;
+};
+
+static void collect_event(const struct sail_trace_event *event, void *user_data) {
+
+    struct events *events = user_data;
+
+    munit_assert(events->count < MAX_EVENTS);
+    events->events[events->count++] = *event;
+}
+
+/* Returns the end event of the first completed stage with the specified name or NULL. */
+static const struct sail_trace_event* find_end_event(const struct events *events, const char *name) {
+
+    for (unsigned i = 0; i < events->count; i++) {
+        if (events->events[i].phase == SAIL_TRACE_PHASE_END && strcmp(events->events[i].name, name) == 0) {
+            return &events->events[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Every end event closes the innermost open begin event. */
+static void assert_nested(const struct events *events) {
+
+    const struct sail_trace_event *stack[MAX_EVENTS];
+    unsigned depth = 0;
+
+    for (unsigned i = 0; i < events->count; i++) {
+        const struct sail_trace_event *event = &events->events[i];
+
+        if (event->phase == SAIL_TRACE_PHASE_BEGIN) {
+            stack[depth++] = event;
+        } else {
+            munit_assert_uint(depth, >, 0);
+            depth--;
+            munit_assert_string_equal(stack[depth]->name, event->name);
+            munit_assert_string_equal(stack[depth]->category, event->category);
+            munit_assert_uint64(stack[depth]->timestamp, <=, event->timestamp);
+        }
+    }
+
+    munit_assert_uint(depth, ==, 0);
+}
+
+static struct sail_image* create_image(void) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width          = 37;
+    image->height         = 23;
+    image->pixel_format   = SAIL_PIXEL_FORMAT_BPP24_RGB;
+    image->bytes_per_line = sail_bytes_per_line(image->width, image->pixel_format);
+
+    const size_t pixels_size = (size_t)image->bytes_per_line * image->height;
+    munit_assert(sail_malloc(pixels_size, &image->pixels) == SAIL_OK);
+
+    for (size_t i = 0; i < pixels_size; i++) {
+        ((unsigned char *)image->pixels)[i] = (unsigned char)munit_rand_uint32();
+    }
+
+    return image;
+}
+
+static MunitResult test_load(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("png", &codec_info) == SAIL_OK);
+
+    struct sail_image *image = create_image();
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    static struct events events;
+    events.count = 0;
+    sail_set_trace_callback(collect_event, &events);
+    munit_assert(sail_trace_is_enabled());
+
+    struct sail_image *loaded;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &loaded) == SAIL_OK);
+
+    sail_set_trace_callback(NULL, NULL);
+    munit_assert(!sail_trace_is_enabled());
+
+    assert_nested(&events);
+
+    static const char * const CODEC_STAGES[] = { "load_init", "load_seek_next_frame", "load_frame", "load_finish" };
+
+    for (size_t i = 0; i < sizeof(CODEC_STAGES) / sizeof(CODEC_STAGES[0]); i++) {
+        const struct sail_trace_event *event = find_end_event(&events, CODEC_STAGES[i]);
+
+        munit_assert_not_null(event);
+        munit_assert_string_equal(event->category, "codec");
+        munit_assert_string_equal(event->codec, "PNG");
+        munit_assert(event->status == SAIL_OK);
+    }
+
+    munit_assert_uint64(find_end_event(&events, "load_frame")->pixels, ==, (uint64_t)image->width * image->height);
+
+    const struct sail_trace_event *alloc_event = find_end_event(&events, "alloc_pixels");
+    munit_assert_not_null(alloc_event);
+    munit_assert_uint64(alloc_event->bytes, ==, (uint64_t)loaded->bytes_per_line * loaded->height);
+
+    /* The codec reads the data through the I/O callbacks. */
+    uint64_t bytes_read = 0;
+
+    for (unsigned i = 0; i < events.count; i++) {
+        const struct sail_trace_event *event = &events.events[i];
+
+        if (event->phase == SAIL_TRACE_PHASE_END && strcmp(event->category, "io") == 0) {
+            munit_assert_string_equal(event->codec, "PNG");
+            bytes_read += event->bytes;
+        }
+    }
+
+    munit_assert_uint64(bytes_read, >, 0);
+
+    /* No events when disabled. */
+    const unsigned count = events.count;
+    sail_destroy_image(loaded);
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &loaded) == SAIL_OK);
+    munit_assert_uint(events.count, ==, count);
+
+    sail_destroy_image(loaded);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_convert(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = create_image();
+
+    static struct events events;
+    events.count = 0;
+    sail_set_trace_callback(collect_event, &events);
+
+    struct sail_image *converted;
+    munit_assert(sail_convert_image(image, SAIL_PIXEL_FORMAT_BPP32_RGBA, &converted) == SAIL_OK);
+
+    sail_set_trace_callback(NULL, NULL);
+
+    assert_nested(&events);
+    munit_assert_uint(events.count, ==, 2);
+
+    const struct sail_trace_event *event = find_end_event(&events, "convert");
+    munit_assert_not_null(event);
+    munit_assert_string_equal(event->category, "manip");
+    munit_assert_null(event->codec);
+    munit_assert_uint64(event->pixels, ==, (uint64_t)image->width * image->height);
+    munit_assert_uint64(event->bytes, ==, (uint64_t)converted->bytes_per_line * converted->height);
+
+    sail_destroy_image(converted);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_chrome_trace(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char *path = "sail-trace-test.json";
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("png", &codec_info) == SAIL_OK);
+
+    struct sail_image *image = create_image();
+
+    munit_assert(sail_start_chrome_trace(path) == SAIL_OK);
+    munit_assert(sail_start_chrome_trace(path) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_dynamic_memory(image, codec_info, &buffer, &buffer_length) == SAIL_OK);
+
+    munit_assert(sail_stop_chrome_trace() == SAIL_OK);
+    munit_assert(!sail_trace_is_enabled());
+    munit_assert(sail_stop_chrome_trace() == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    void *data;
+    size_t data_size;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_size) == SAIL_OK);
+    remove(path);
+
+    /* Make it a string. */
+    munit_assert(sail_realloc(data_size + 1, &data) == SAIL_OK);
+    char *json = data;
+    json[data_size] = '\0';
+
+    munit_assert(strncmp(json, "[\n", 2) == 0);
+    munit_assert(strcmp(json + data_size - 2, "]\n") == 0);
+    munit_assert_not_null(strstr(json, "{\"name\":\"save_frame\",\"cat\":\"codec\",\"ph\":\"B\","));
+    munit_assert_not_null(strstr(json, "\"args\":{\"codec\":\"PNG\",\"bytes\":0,\"pixels\":851,\"status\":0}"));
+    munit_assert_not_null(strstr(json, "{\"name\":\"io_write\",\"cat\":\"io\",\"ph\":\"E\","));
+
+    sail_free(data);
+    sail_free(buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/chrome-trace", test_chrome_trace, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/convert",      test_convert,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/load",         test_load,         NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/trace",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,100 @@
+/*  This file is part of SAIL (https://github.com/HappySeaFox/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+#include "test-helpers.h"
+#include "test-images.h"
+
+static MunitResult test_transcode(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    void *buffer;
+    size_t buffer_length;
+    const struct sail_codec_info *output_codec_info;
+    test_transcode_file_into_memory(path, "png", &buffer, &buffer_length, &output_codec_info);
+
+    /* Expected pixels are converted into the closest pixel format the output codec supports. */
+    struct sail_image *image_file = NULL;
+    munit_assert(sail_load_from_file(path, &image_file) == SAIL_OK);
+
+    const enum SailPixelFormat output_pixel_format = sail_closest_pixel_format_from_save_features(image_file->pixel_format,
+                                                                                                  output_codec_info->save_features);
+    munit_assert(output_pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN);
+
+    struct sail_image *image_expected = NULL;
+
+    if (image_file->pixel_format == output_pixel_format) {
+        munit_assert(sail_copy_image(image_file, &image_expected) == SAIL_OK);
+    } else {
+        munit_assert(sail_convert_image(image_file, output_pixel_format, &image_expected) == SAIL_OK);
+    }
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_from_memory(buffer, buffer_length, &image) == SAIL_OK);
+
+    munit_assert(image->width == image_expected->width);
+    munit_assert(image->height == image_expected->height);
+    munit_assert(image->pixel_format == image_expected->pixel_format);
+    munit_assert(image->bytes_per_line == image_expected->bytes_per_line);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, image_expected->pixels);
+
+    sail_destroy_image(image);
+    sail_free(buffer);
+    sail_destroy_image(image_expected);
+    sail_destroy_image(image_file);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/transcode", test_transcode, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/transcode",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}